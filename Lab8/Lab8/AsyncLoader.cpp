@@ -0,0 +1,108 @@
+#include "AsyncLoader.h"
+
+AsyncLoader::AsyncLoader() :
+    m_nextTicket(1),
+    m_running(0),
+    m_stop(false)
+{
+}
+
+AsyncLoader::~AsyncLoader() {
+    Terminate();
+}
+
+bool AsyncLoader::Init(uint32_t threadCount, const ThreadHook& onThreadStart, const ThreadHook& onThreadExit) {
+    Terminate();
+
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    m_onThreadStart = onThreadStart;
+    m_onThreadExit = onThreadExit;
+    m_stop = false;
+
+    for (uint32_t i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&AsyncLoader::WorkerLoop, this);
+    return true;
+}
+
+void AsyncLoader::Terminate() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_queue.clear();
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_completed.clear();
+    m_running = 0;
+}
+
+uint32_t AsyncLoader::Submit(const Job& job) {
+    uint32_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_threads.empty() || m_stop)
+            return 0;
+
+        ticket = m_nextTicket++;
+        if (m_nextTicket == 0)
+            m_nextTicket = 1;
+        m_queue.push_back({ ticket, job });
+    }
+    m_wake.notify_one();
+    return ticket;
+}
+
+size_t AsyncLoader::Collect(std::vector<Completion>& completions, size_t maxCount) {
+    completions.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_completed.empty() && completions.size() < maxCount) {
+        completions.push_back(m_completed.front());
+        m_completed.pop_front();
+    }
+    return completions.size();
+}
+
+uint32_t AsyncLoader::GetPending() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return static_cast<uint32_t>(m_queue.size() + m_completed.size()) + m_running;
+}
+
+void AsyncLoader::WorkerLoop() {
+    if (m_onThreadStart)
+        m_onThreadStart();
+
+    for (;;) {
+        QueuedJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+            if (m_stop)
+                break;
+
+            job = std::move(m_queue.front());
+            m_queue.pop_front();
+            ++m_running;
+        }
+
+        bool succeeded = job.job();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_running;
+        // После Terminate результат уже никому не нужен
+        if (!m_stop)
+            m_completed.push_back({ job.ticket, succeeded });
+    }
+
+    if (m_onThreadExit)
+        m_onThreadExit();
+}
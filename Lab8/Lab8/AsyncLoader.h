@@ -0,0 +1,69 @@
+#ifndef ASYNC_LOADER_H
+#define ASYNC_LOADER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Фоновый пул для долгих задач (чтение и декодирование файлов). В отличие от JobSystem
+// никого не ждёт: задачи ставятся в очередь, а завершённые забираются потоком кадра через
+// Collect. Не зависит от D3D11.
+class AsyncLoader
+{
+public:
+    // Возвращает false, если задача не удалась
+    typedef std::function<bool()> Job;
+    // Вызываются в каждом рабочем потоке при старте и перед выходом (например, для COM)
+    typedef std::function<void()> ThreadHook;
+
+    struct Completion
+    {
+        uint32_t ticket;
+        bool succeeded;
+    };
+
+    AsyncLoader();
+    ~AsyncLoader();
+
+    // threadCount = 0 - по числу логических ядер
+    bool Init(uint32_t threadCount, const ThreadHook& onThreadStart = ThreadHook(), const ThreadHook& onThreadExit = ThreadHook());
+    // Невыполненные задачи отбрасываются, выполняемые дожидаются
+    void Terminate();
+
+    // Номер задачи, по которому её результат придёт в Collect; 0 - пул не запущен
+    uint32_t Submit(const Job& job);
+    // Забирает до maxCount завершённых задач в порядке завершения
+    size_t Collect(std::vector<Completion>& completions, size_t maxCount);
+
+    // Поставлены, но ещё не забраны через Collect
+    uint32_t GetPending() const;
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_threads.size()); }
+
+private:
+    struct QueuedJob
+    {
+        uint32_t ticket;
+        Job job;
+    };
+
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    ThreadHook m_onThreadStart;
+    ThreadHook m_onThreadExit;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<QueuedJob> m_queue;
+    std::deque<Completion> m_completed;
+    uint32_t m_nextTicket;
+    uint32_t m_running;
+    bool m_stop;
+};
+
+#endif
@@ -0,0 +1,62 @@
+// Уровень цепочки уменьшения свечения: 13 выборок (как в CoD: Advanced Warfare),
+// на первом уровне отсекаются пиксели темнее порога
+cbuffer BloomParams : register(b0)
+{
+    float2 srcTexelSize;
+    uint2 dstSize;
+    float threshold;
+    float knee;
+    uint firstLevel;
+    float padding;
+};
+
+Texture2D<float4> sourceTexture : register(t0);
+SamplerState samLinear : register(s0);
+RWTexture2D<float4> outputTexture : register(u0);
+
+float3 Sample(float2 uv, float2 offset)
+{
+    return sourceTexture.SampleLevel(samLinear, uv + offset * srcTexelSize, 0).rgb;
+}
+
+// Мягкий порог: плавный переход шириной knee вокруг threshold
+float3 Prefilter(float3 color)
+{
+    float brightness = max(color.r, max(color.g, color.b));
+    float soft = clamp(brightness - threshold + knee, 0.0f, 2.0f * knee);
+    soft = soft * soft / (4.0f * knee + 1e-5f);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 1e-5f);
+    return color * contribution;
+}
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= dstSize.x || id.y >= dstSize.y)
+        return;
+
+    float2 uv = (id.xy + 0.5f) / dstSize;
+    float3 a = Sample(uv, float2(-2, -2));
+    float3 b = Sample(uv, float2(0, -2));
+    float3 c = Sample(uv, float2(2, -2));
+    float3 d = Sample(uv, float2(-1, -1));
+    float3 e = Sample(uv, float2(1, -1));
+    float3 f = Sample(uv, float2(-2, 0));
+    float3 g = Sample(uv, float2(0, 0));
+    float3 h = Sample(uv, float2(2, 0));
+    float3 i = Sample(uv, float2(-1, 1));
+    float3 j = Sample(uv, float2(1, 1));
+    float3 k = Sample(uv, float2(-2, 2));
+    float3 l = Sample(uv, float2(0, 2));
+    float3 m = Sample(uv, float2(2, 2));
+
+    float3 color = (d + e + i + j) * 0.125f;
+    color += (a + b + f + g) * 0.03125f;
+    color += (b + c + g + h) * 0.03125f;
+    color += (f + g + k + l) * 0.03125f;
+    color += (g + h + l + m) * 0.03125f;
+
+    if (firstLevel)
+        color = Prefilter(color);
+    outputTexture[id.xy] = float4(color, 1.0f);
+}
@@ -0,0 +1,38 @@
+// Уровень цепочки увеличения свечения: размытый шатром 3x3 нижний уровень плюс
+// уровень уменьшения того же размера. Пишет в отдельную текстуру: типизированное
+// чтение-запись float16 через UAV в D3D11 не гарантировано
+cbuffer BloomParams : register(b0)
+{
+    float2 srcTexelSize;
+    uint2 dstSize;
+    float threshold;
+    float radius;
+    uint firstLevel;
+    float padding;
+};
+
+Texture2D<float4> lowerTexture : register(t0);
+Texture2D<float4> currentTexture : register(t1);
+SamplerState samLinear : register(s0);
+RWTexture2D<float4> outputTexture : register(u0);
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= dstSize.x || id.y >= dstSize.y)
+        return;
+
+    float2 uv = (id.xy + 0.5f) / dstSize;
+    float2 offset = srcTexelSize * radius;
+    float3 color = lowerTexture.SampleLevel(samLinear, uv, 0).rgb * 4.0f;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(-offset.x, 0), 0).rgb * 2.0f;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(offset.x, 0), 0).rgb * 2.0f;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(0, -offset.y), 0).rgb * 2.0f;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(0, offset.y), 0).rgb * 2.0f;
+    color += lowerTexture.SampleLevel(samLinear, uv - offset, 0).rgb;
+    color += lowerTexture.SampleLevel(samLinear, uv + offset, 0).rgb;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(-offset.x, offset.y), 0).rgb;
+    color += lowerTexture.SampleLevel(samLinear, uv + float2(offset.x, -offset.y), 0).rgb;
+
+    outputTexture[id.xy] = float4(currentTexture[id.xy].rgb + color / 16.0f, 1.0f);
+}
@@ -0,0 +1,140 @@
+#include "framework.h"
+#include "Camera.h"
+#include "SceneFrame.h"
+
+Camera::Camera() :
+    m_position(0.0f, 0.0f, 0.0f),
+    m_yaw(0.0f),
+    m_pitch(0.0f),
+    m_width(1),
+    m_height(1),
+    m_fovY(XM_PIDIV4),
+    m_nearZ(0.1f),
+    m_farZ(100.0f),
+    m_dirty(DirtyAll),
+    m_frustumPlanes{},
+    m_stats{}
+{
+}
+
+void Camera::SetPosition(const XMFLOAT3& position) {
+    m_position = position;
+    m_dirty |= DirtyView | DirtyViewProj | DirtyFrustum;
+}
+
+void Camera::Move(float dx, float dy, float dz) {
+    if (dx == 0.0f && dy == 0.0f && dz == 0.0f)
+        return;
+    m_position.x += dx;
+    m_position.y += dy;
+    m_position.z += dz;
+    m_dirty |= DirtyView | DirtyViewProj | DirtyFrustum;
+}
+
+void Camera::Rotate(float yaw, float pitch) {
+    m_yaw += yaw;
+    m_pitch += pitch;
+
+    m_yaw = fmodf(m_yaw, XM_2PI);
+    if (m_yaw > XM_PI) m_yaw -= XM_2PI;
+    if (m_yaw < -XM_PI) m_yaw += XM_2PI;
+
+    if (m_pitch > XM_PIDIV2) m_pitch = XM_PIDIV2;
+    if (m_pitch < -XM_PIDIV2) m_pitch = -XM_PIDIV2;
+
+    m_dirty |= DirtyView | DirtyViewProj | DirtyFrustum;
+}
+
+void Camera::SetViewport(uint32_t width, uint32_t height) {
+    // Свёрнутое окно присылает нулевой размер - оставляем прежнюю проекцию
+    if (width == 0 || height == 0 || (width == m_width && height == m_height))
+        return;
+    m_width = width;
+    m_height = height;
+    m_dirty |= DirtyProj | DirtyViewProj | DirtyFrustum;
+}
+
+void Camera::SetLens(float fovY, float nearZ, float farZ) {
+    m_fovY = fovY;
+    m_nearZ = nearZ;
+    m_farZ = farZ;
+    m_dirty |= DirtyProj | DirtyViewProj | DirtyFrustum;
+}
+
+float Camera::GetAspect() const {
+    return static_cast<float>(m_width) / m_height;
+}
+
+void Camera::UpdateView() {
+    if (!(m_dirty & DirtyView))
+        return;
+
+    XMMATRIX rotLR = XMMatrixRotationY(m_yaw);
+    XMMATRIX rotUD = XMMatrixRotationX(m_pitch);
+    // Порядок поворотов зависит от того, с какой стороны сцены камера
+    XMMATRIX totalRot = m_position.z <= 0 ? rotLR * rotUD : rotUD * rotLR;
+
+    XMVECTOR eyePos = XMVectorSet(m_position.x, m_position.y, m_position.z, 0.0f);
+    XMVECTOR focusPoint = XMVectorAdd(eyePos, XMVector3TransformNormal(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), totalRot));
+    XMStoreFloat4x4(&m_view, XMMatrixLookAtLH(eyePos, focusPoint, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)));
+
+    m_dirty &= ~DirtyView;
+    ++m_stats.viewUpdates;
+}
+
+void Camera::UpdateProj() {
+    if (!(m_dirty & DirtyProj))
+        return;
+
+    XMStoreFloat4x4(&m_proj, XMMatrixPerspectiveFovLH(m_fovY, GetAspect(), m_nearZ, m_farZ));
+
+    m_dirty &= ~DirtyProj;
+    ++m_stats.projUpdates;
+}
+
+void Camera::UpdateViewProj() {
+    if (!(m_dirty & DirtyViewProj))
+        return;
+
+    UpdateView();
+    UpdateProj();
+    XMMATRIX proj = XMLoadFloat4x4(&m_proj);
+    XMStoreFloat4x4(&m_viewProj, XMLoadFloat4x4(&m_view) * proj);
+    XMMATRIX skyboxView = XMMatrixRotationY(-m_yaw) * XMMatrixRotationX(-m_pitch);
+    XMStoreFloat4x4(&m_skyboxViewProj, skyboxView * proj);
+
+    m_dirty &= ~DirtyViewProj;
+}
+
+XMMATRIX Camera::GetView() {
+    UpdateView();
+    return XMLoadFloat4x4(&m_view);
+}
+
+XMMATRIX Camera::GetProj() {
+    UpdateProj();
+    return XMLoadFloat4x4(&m_proj);
+}
+
+XMMATRIX Camera::GetViewProj() {
+    UpdateViewProj();
+    return XMLoadFloat4x4(&m_viewProj);
+}
+
+XMMATRIX Camera::GetSkyboxViewProj() {
+    UpdateViewProj();
+    return XMLoadFloat4x4(&m_skyboxViewProj);
+}
+
+const XMFLOAT4* Camera::GetFrustumPlanes() {
+    if (!(m_dirty & DirtyFrustum))
+        return m_frustumPlanes;
+
+    UpdateViewProj();
+    // Та же выборка плоскостей, что у замера кадра без окна
+    SceneFrame::ExtractFrustumPlanes(&m_viewProj.m[0][0], reinterpret_cast<float(*)[4]>(m_frustumPlanes));
+
+    m_dirty &= ~DirtyFrustum;
+    ++m_stats.frustumUpdates;
+    return m_frustumPlanes;
+}
@@ -0,0 +1,81 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <DirectXMath.h>
+#include <cstdint>
+
+using namespace DirectX;
+
+// Камера и область вывода. Матрицы и плоскости отсечения пересчитываются лениво -
+// только при первом обращении после изменения положения, поворота или размера окна.
+// Размер окна задаётся снаружи (из Resize), сама камера Win32 не вызывает.
+class Camera
+{
+public:
+    struct Stats
+    {
+        uint64_t viewUpdates;
+        uint64_t projUpdates;
+        uint64_t frustumUpdates;
+    };
+
+    Camera();
+
+    void SetPosition(const XMFLOAT3& position);
+    void Move(float dx, float dy, float dz);
+    // Рыскание заворачивается в [-pi, pi], тангаж ограничен +-pi/2
+    void Rotate(float yaw, float pitch);
+    void SetViewport(uint32_t width, uint32_t height);
+    void SetLens(float fovY, float nearZ, float farZ);
+
+    const XMFLOAT3& GetPosition() const { return m_position; }
+    float GetYaw() const { return m_yaw; }
+    float GetPitch() const { return m_pitch; }
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+    float GetAspect() const;
+    float GetFovY() const { return m_fovY; }
+
+    XMMATRIX GetView();
+    XMMATRIX GetProj();
+    XMMATRIX GetViewProj();
+    // Небо: только поворот камеры, без переноса
+    XMMATRIX GetSkyboxViewProj();
+    // Нормализованные плоскости: лево, право, низ, верх, ближняя, дальняя
+    const XMFLOAT4* GetFrustumPlanes();
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    enum DirtyFlags
+    {
+        DirtyView = 1,
+        DirtyProj = 2,
+        DirtyViewProj = 4,
+        DirtyFrustum = 8,
+        DirtyAll = DirtyView | DirtyProj | DirtyViewProj | DirtyFrustum
+    };
+
+    void UpdateView();
+    void UpdateProj();
+    void UpdateViewProj();
+
+    XMFLOAT3 m_position;
+    float m_yaw;
+    float m_pitch;
+    uint32_t m_width;
+    uint32_t m_height;
+    float m_fovY;
+    float m_nearZ;
+    float m_farZ;
+
+    uint32_t m_dirty;
+    XMFLOAT4X4 m_view;
+    XMFLOAT4X4 m_proj;
+    XMFLOAT4X4 m_viewProj;
+    XMFLOAT4X4 m_skyboxViewProj;
+    XMFLOAT4 m_frustumPlanes[6];
+    Stats m_stats;
+};
+
+#endif
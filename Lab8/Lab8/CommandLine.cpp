@@ -0,0 +1,166 @@
+#include "CommandLine.h"
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    const CommandLineOption* FindOption(const CommandLineOption* pOptions, size_t optionCount, const std::string& name) {
+        for (size_t i = 0; i < optionCount; ++i) {
+            if (name == pOptions[i].name)
+                return &pOptions[i];
+        }
+        return nullptr;
+    }
+
+    bool IsUint(const std::string& value) {
+        if (value.empty() || value.size() > 9)
+            return false;
+        for (char c : value) {
+            if (c < '0' || c > '9')
+                return false;
+        }
+        return true;
+    }
+}
+
+bool CommandLine::Parse(int argc, char** argv, const CommandLineOption* pOptions, size_t optionCount) {
+    std::vector<std::string> tokens;
+    for (int i = 1; i < argc; ++i)
+        tokens.push_back(argv[i]);
+    return ParseTokens(tokens, pOptions, optionCount);
+}
+
+bool CommandLine::Parse(const wchar_t* cmdLine, const CommandLineOption* pOptions, size_t optionCount) {
+    // Слова через пробел, кавычки только группируют; символы вне ASCII заменяются на '?',
+    // чтобы такой ключ не совпал ни с одним известным
+    std::vector<std::string> tokens;
+    std::string token;
+    bool quoted = false;
+    bool hasToken = false;
+    for (const wchar_t* c = cmdLine; c && *c; ++c) {
+        if (*c == L'"') {
+            quoted = !quoted;
+            hasToken = true;
+        }
+        else if (!quoted && (*c == L' ' || *c == L'\t')) {
+            if (hasToken)
+                tokens.push_back(token);
+            token.clear();
+            hasToken = false;
+        }
+        else {
+            token.push_back(*c < 0x80 ? static_cast<char>(*c) : '?');
+            hasToken = true;
+        }
+    }
+    if (hasToken)
+        tokens.push_back(token);
+    return ParseTokens(tokens, pOptions, optionCount);
+}
+
+bool CommandLine::ParseTokens(const std::vector<std::string>& tokens, const CommandLineOption* pOptions, size_t optionCount) {
+    m_entries.clear();
+    m_error.clear();
+    m_helpRequested = false;
+
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const std::string& token = tokens[i];
+        size_t start = token.find_first_not_of("-/");
+        std::string name = start == std::string::npos ? std::string() : token.substr(start);
+
+        std::string value;
+        bool inlineValue = false;
+        size_t equals = name.find('=');
+        if (equals != std::string::npos) {
+            value = name.substr(equals + 1);
+            name.erase(equals);
+            inlineValue = true;
+        }
+
+        if (name == "help" || name == "h" || name == "?") {
+            m_helpRequested = true;
+            return false;
+        }
+
+        const CommandLineOption* pOption = FindOption(pOptions, optionCount, name);
+        if (!pOption) {
+            m_error = "Unknown option: " + token;
+            return false;
+        }
+
+        if (pOption->value == OptionValue::None) {
+            if (inlineValue) {
+                m_error = "Option takes no value: " + token;
+                return false;
+            }
+        }
+        else if (!inlineValue) {
+            if (i + 1 >= tokens.size()) {
+                m_error = "Missing value for option: " + name;
+                return false;
+            }
+            value = tokens[++i];
+        }
+
+        if (pOption->value == OptionValue::Uint && !IsUint(value)) {
+            m_error = "Invalid number for option " + name + ": " + value;
+            return false;
+        }
+
+        // Повтор ключа - действует последнее значение
+        Entry entry = { pOption->name, value };
+        bool replaced = false;
+        for (Entry& existing : m_entries) {
+            if (strcmp(existing.name, entry.name) == 0) {
+                existing.value = value;
+                replaced = true;
+            }
+        }
+        if (!replaced)
+            m_entries.push_back(entry);
+    }
+    return true;
+}
+
+const CommandLine::Entry* CommandLine::Find(const char* name) const {
+    for (const Entry& entry : m_entries) {
+        if (strcmp(entry.name, name) == 0)
+            return &entry;
+    }
+    return nullptr;
+}
+
+bool CommandLine::Has(const char* name) const {
+    return Find(name) != nullptr;
+}
+
+const char* CommandLine::GetText(const char* name) const {
+    const Entry* pEntry = Find(name);
+    return pEntry && !pEntry->value.empty() ? pEntry->value.c_str() : nullptr;
+}
+
+uint32_t CommandLine::GetUint(const char* name, uint32_t defaultValue) const {
+    const char* text = GetText(name);
+    if (!text)
+        return defaultValue;
+
+    unsigned long value = strtoul(text, nullptr, 10);
+    return value > 0 ? static_cast<uint32_t>(value) : defaultValue;
+}
+
+std::string CommandLine::GetUsage(const CommandLineOption* pOptions, size_t optionCount) {
+    std::string usage;
+    for (size_t i = 0; i < optionCount; ++i) {
+        const CommandLineOption& option = pOptions[i];
+        if (!usage.empty())
+            usage += ' ';
+        usage += '[';
+        usage += option.name;
+        if (option.value != OptionValue::None) {
+            usage += ' ';
+            usage += option.valueHint ? option.valueHint : option.value == OptionValue::Uint ? "N" : "VALUE";
+        }
+        usage += ']';
+    }
+    return usage;
+}
@@ -0,0 +1,67 @@
+#ifndef COMMAND_LINE_H
+#define COMMAND_LINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Общий разбор ключей для Lab8.exe, framebench и benchcull.
+// Ключ пишется как "name value", "-name value" или "--name=value"; ключ без значения - режим
+// (benchcull, benchframes). Неизвестный ключ, ключ без значения и не число там, где ждётся
+// число, - ошибка разбора. "help", "-h", "/?" - запрос справки.
+enum class OptionValue
+{
+    None,
+    Uint,
+    Text
+};
+
+struct CommandLineOption
+{
+    const char* name;
+    OptionValue value;
+    const char* valueHint;  // в справке; nullptr - "N" для чисел, "VALUE" для текста
+};
+
+class CommandLine
+{
+public:
+    CommandLine() :
+        m_helpRequested(false)
+    {
+    }
+
+    // argv[0] - имя программы и пропускается
+    bool Parse(int argc, char** argv, const CommandLineOption* pOptions, size_t optionCount);
+    // Строка целиком, как lpCmdLine у wWinMain; ключи и значения - ASCII
+    bool Parse(const wchar_t* cmdLine, const CommandLineOption* pOptions, size_t optionCount);
+
+    bool Has(const char* name) const;
+    // nullptr - ключа нет или у него нет значения
+    const char* GetText(const char* name) const;
+    // Нет ключа или 0 - defaultValue
+    uint32_t GetUint(const char* name, uint32_t defaultValue) const;
+
+    bool HelpRequested() const { return m_helpRequested; }
+    const std::string& GetError() const { return m_error; }
+
+    // "[instances N] [path static|orbit|flythrough]"
+    static std::string GetUsage(const CommandLineOption* pOptions, size_t optionCount);
+
+private:
+    struct Entry
+    {
+        const char* name;
+        std::string value;
+    };
+
+    bool ParseTokens(const std::vector<std::string>& tokens, const CommandLineOption* pOptions, size_t optionCount);
+    const Entry* Find(const char* name) const;
+
+    std::vector<Entry> m_entries;
+    std::string m_error;
+    bool m_helpRequested;
+};
+
+#endif
@@ -0,0 +1,241 @@
+#include "CullingBenchmark.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+
+namespace
+{
+    // Раскладка как у SceneInstance: матрица 4x4 по строкам + индекс текстуры
+    struct BenchInstance
+    {
+        float model[16];
+        uint32_t texInd;
+        uint32_t countInstance;
+        float padding[2];
+    };
+
+    const size_t ChunkSize = 4096;
+
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void RebuildRange(std::vector<BenchInstance>& instances, std::vector<BenchInstance>& gpuInstances,
+        const float scaleRotation[16], size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            float* model = instances[i].model;
+            float x = model[12], y = model[13], z = model[14];
+            memcpy(model, scaleRotation, sizeof(float) * 12);
+            model[12] = x;
+            model[13] = y;
+            model[14] = z;
+            model[15] = 1.0f;
+
+            // Как и в рендере, в буфер для GPU уходит транспонированная матрица
+            float* gpuModel = gpuInstances[i].model;
+            for (int r = 0; r < 4; ++r) {
+                for (int c = 0; c < 4; ++c)
+                    gpuModel[c * 4 + r] = model[r * 4 + c];
+            }
+            gpuInstances[i].texInd = instances[i].texInd;
+            gpuInstances[i].countInstance = static_cast<uint32_t>(instances.size());
+        }
+    }
+
+    // Кубы случайно разбросаны вокруг камеры; зерно фиксировано, чтобы прогоны были сравнимы.
+    // Пирамида с углом обзора 90 градусов смотрит вдоль +Z
+    void BuildScene(size_t instanceCount, std::vector<BenchInstance>& instances, FrustumCuller& culler) {
+        instances.resize(instanceCount);
+        culler.Resize(instanceCount);
+
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        const float extent = 0.5f * 0.95f;
+        for (size_t i = 0; i < instanceCount; ++i) {
+            BenchInstance& instance = instances[i];
+            memset(&instance, 0, sizeof(instance));
+            instance.model[12] = position(random);
+            instance.model[13] = position(random) * 0.1f;
+            instance.model[14] = position(random);
+            instance.model[15] = 1.0f;
+            instance.texInd = static_cast<uint32_t>(i % 2);
+            culler.SetBox(i, instance.model[12], instance.model[13], instance.model[14], extent, extent, extent);
+        }
+
+        const float k = 0.70710678f;
+        const float planes[6][4] = {
+            { k, 0.0f, k, 0.0f },
+            { -k, 0.0f, k, 0.0f },
+            { 0.0f, k, k, 0.0f },
+            { 0.0f, -k, k, 0.0f },
+            { 0.0f, 0.0f, 1.0f, -0.1f },
+            { 0.0f, 0.0f, -1.0f, 1000.0f }
+        };
+        culler.SetPlanes(planes);
+    }
+
+    // Сжатие результатов кусков в порядке их номеров: итог не зависит от числа потоков
+    size_t MergeChunks(std::vector<uint32_t>& visible, const std::vector<size_t>& chunkVisible, size_t chunkSize) {
+        size_t total = 0;
+        for (size_t chunk = 0; chunk < chunkVisible.size(); ++chunk) {
+            size_t begin = chunk * chunkSize;
+            if (total != begin && chunkVisible[chunk] > 0)
+                memmove(visible.data() + total, visible.data() + begin, sizeof(uint32_t) * chunkVisible[chunk]);
+            total += chunkVisible[chunk];
+        }
+        return total;
+    }
+}
+
+bool RunCullingBenchmark(size_t instanceCount, uint32_t maxThreads, uint32_t iterations,
+    std::vector<CullingBenchmarkResult>& results) {
+    results.clear();
+    if (instanceCount == 0 || maxThreads == 0 || iterations == 0)
+        return false;
+
+    std::vector<BenchInstance> instances;
+    std::vector<BenchInstance> gpuInstances(instanceCount);
+    FrustumCuller culler;
+    BuildScene(instanceCount, instances, culler);
+
+    const size_t chunkSize = JobSystem::AlignChunk(JobSystem::AlignChunk(ChunkSize, sizeof(float)), sizeof(BenchInstance));
+    const size_t chunkCount = JobSystem::GetChunkCount(instanceCount, chunkSize);
+
+    std::vector<uint32_t> visible(instanceCount);
+    std::vector<uint32_t> reference;
+    std::vector<size_t> chunkVisible(chunkCount);
+    JobSystem jobs;
+
+    for (uint32_t threads = 1; threads <= maxThreads; threads *= 2) {
+        jobs.Init(threads);
+
+        CullingBenchmarkResult result = {};
+        result.threadCount = threads;
+        result.matchesSingleThread = true;
+
+        float angle = 0.0f;
+        for (uint32_t iteration = 0; iteration <= iterations; ++iteration) {
+            angle += 0.01f;
+            float scale = 0.5f;
+            float scaleRotation[16] = {
+                scale * cosf(angle), 0.0f, -scale * sinf(angle), 0.0f,
+                0.0f, scale, 0.0f, 0.0f,
+                scale * sinf(angle), 0.0f, scale * cosf(angle), 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+
+            auto start = std::chrono::high_resolution_clock::now();
+            jobs.ParallelFor(instanceCount, chunkSize, [&](size_t begin, size_t end, size_t) {
+                RebuildRange(instances, gpuInstances, scaleRotation, begin, end);
+            });
+            double rebuildMs = ElapsedMs(start);
+
+            start = std::chrono::high_resolution_clock::now();
+            jobs.ParallelFor(instanceCount, chunkSize, [&](size_t begin, size_t end, size_t chunk) {
+                chunkVisible[chunk] = culler.Cull(visible.data() + begin, begin, end);
+            });
+            size_t visibleCount = MergeChunks(visible, chunkVisible, chunkSize);
+            double cullMs = ElapsedMs(start);
+
+            // Совмещённый проход, как в кадре рендера
+            start = std::chrono::high_resolution_clock::now();
+            jobs.ParallelFor(instanceCount, chunkSize, [&](size_t begin, size_t end, size_t chunk) {
+                RebuildRange(instances, gpuInstances, scaleRotation, begin, end);
+                chunkVisible[chunk] = culler.Cull(visible.data() + begin, begin, end);
+            });
+            visibleCount = MergeChunks(visible, chunkVisible, chunkSize);
+            double totalMs = ElapsedMs(start);
+
+            // Первая итерация - прогрев
+            if (iteration == 0)
+                continue;
+
+            result.rebuildMs += rebuildMs / iterations;
+            result.cullMs += cullMs / iterations;
+            result.totalMs += totalMs / iterations;
+            result.visibleCount = visibleCount;
+
+            if (threads == 1 && iteration == 1)
+                reference.assign(visible.begin(), visible.begin() + visibleCount);
+            else if (visibleCount != reference.size() ||
+                memcmp(visible.data(), reference.data(), sizeof(uint32_t) * visibleCount) != 0)
+                result.matchesSingleThread = false;
+        }
+
+        result.stolenChunks = jobs.GetStolenChunks();
+        results.push_back(result);
+
+        if (threads > maxThreads / 2)
+            break;
+    }
+
+    jobs.Terminate();
+    return true;
+}
+
+bool RunCullingPathBenchmark(size_t instanceCount, uint32_t iterations, std::vector<CullingPathResult>& results) {
+    results.clear();
+    if (instanceCount == 0 || iterations == 0)
+        return false;
+
+    std::vector<BenchInstance> instances;
+    FrustumCuller culler;
+    BuildScene(instanceCount, instances, culler);
+
+    // Все пути до лучшего, что есть у процессора; эталон - Scalar
+    std::vector<uint32_t> visible(instanceCount);
+    std::vector<uint32_t> reference;
+    const FrustumCuller::Path best = FrustumCuller::DetectBestPath();
+    for (int path = 0; path <= static_cast<int>(best); ++path) {
+        culler.SetPath(static_cast<FrustumCuller::Path>(path));
+
+        CullingPathResult result = {};
+        result.path = culler.GetPath();
+        result.matchesScalar = true;
+        for (uint32_t iteration = 0; iteration <= iterations; ++iteration) {
+            auto start = std::chrono::high_resolution_clock::now();
+            size_t visibleCount = culler.Cull(visible.data());
+            double cullMs = ElapsedMs(start);
+
+            // Первая итерация - прогрев
+            if (iteration == 0)
+                continue;
+
+            result.cullMs += cullMs / iterations;
+            result.visibleCount = visibleCount;
+            if (path == 0 && iteration == 1)
+                reference.assign(visible.begin(), visible.begin() + visibleCount);
+            else if (visibleCount != reference.size() ||
+                memcmp(visible.data(), reference.data(), sizeof(uint32_t) * visibleCount) != 0)
+                result.matchesScalar = false;
+        }
+        results.push_back(result);
+    }
+    return true;
+}
+
+bool WriteCullingBenchmarkCsv(const char* path, const std::vector<CullingBenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "threads,rebuild_ms,cull_ms,total_ms,speedup,visible,stolen_chunks,deterministic\n";
+    file << std::fixed << std::setprecision(3);
+    double baseMs = results.empty() ? 0.0 : results[0].totalMs;
+    for (const CullingBenchmarkResult& result : results) {
+        file << result.threadCount << ','
+            << result.rebuildMs << ','
+            << result.cullMs << ','
+            << result.totalMs << ','
+            << (result.totalMs > 0.0 ? baseMs / result.totalMs : 0.0) << ','
+            << result.visibleCount << ','
+            << result.stolenChunks << ','
+            << (result.matchesSingleThread ? 1 : 0) << '\n';
+    }
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,36 @@
+#ifndef CULLING_BENCHMARK_H
+#define CULLING_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FrustumCuller.h"
+
+// Замер масштабирования пересборки матриц и отсечения на CPU по числу потоков.
+// Работает без окна и устройства: та же нарезка на куски, что в RenderClass::RenderCubes.
+struct CullingBenchmarkResult
+{
+    uint32_t threadCount;
+    double rebuildMs;
+    double cullMs;
+    double totalMs;
+    size_t visibleCount;
+    uint64_t stolenChunks;
+    bool matchesSingleThread;
+};
+
+// Один поток, вся сцена одним вызовом Cull: скорость каждого пути и совпадение списка видимых со Scalar
+struct CullingPathResult
+{
+    FrustumCuller::Path path;
+    double cullMs;
+    size_t visibleCount;
+    bool matchesScalar;
+};
+
+bool RunCullingBenchmark(size_t instanceCount, uint32_t maxThreads, uint32_t iterations,
+    std::vector<CullingBenchmarkResult>& results);
+bool RunCullingPathBenchmark(size_t instanceCount, uint32_t iterations, std::vector<CullingPathResult>& results);
+bool WriteCullingBenchmarkCsv(const char* path, const std::vector<CullingBenchmarkResult>& results);
+
+#endif
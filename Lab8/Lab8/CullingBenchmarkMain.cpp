@@ -0,0 +1,58 @@
+#include "CullingBenchmark.h"
+#include "CommandLine.h"
+#include <cstdio>
+
+// Замер отсечения без Win32: benchcull [instances N]. Пути SIMD сравниваются со Scalar
+// по скорости и списку видимых, затем пересборка и отсечение идут на 1-64 потоках;
+// результаты по потокам пишутся в cull_benchmark.csv, как у Lab8.exe benchcull.
+// Код возврата 1 - путь или число потоков дали другой список видимых.
+namespace
+{
+    const CommandLineOption Options[] = {
+        { "instances", OptionValue::Uint, nullptr }
+    };
+    const size_t OptionCount = sizeof(Options) / sizeof(Options[0]);
+}
+
+int main(int argc, char** argv) {
+    CommandLine commandLine;
+    if (!commandLine.Parse(argc, argv, Options, OptionCount)) {
+        FILE* pOut = commandLine.HelpRequested() ? stdout : stderr;
+        if (!commandLine.HelpRequested())
+            fprintf(pOut, "%s\n", commandLine.GetError().c_str());
+        fprintf(pOut, "Usage: benchcull %s\n", CommandLine::GetUsage(Options, OptionCount).c_str());
+        return commandLine.HelpRequested() ? 0 : 1;
+    }
+
+    uint32_t count = commandLine.GetUint("instances", 1000000);
+
+    std::vector<CullingPathResult> pathResults;
+    if (!RunCullingPathBenchmark(count, 20, pathResults)) {
+        fprintf(stderr, "Culling benchmark failed\n");
+        return 1;
+    }
+
+    bool matches = true;
+    double scalarMs = pathResults[0].cullMs;
+    for (const CullingPathResult& result : pathResults) {
+        printf("%s: %.3f ms, speedup %.2fx, visible %zu%s\n", FrustumCuller::GetPathName(result.path), result.cullMs,
+            result.cullMs > 0.0 ? scalarMs / result.cullMs : 0.0, result.visibleCount,
+            result.matchesScalar ? "" : " MISMATCH");
+        matches = matches && result.matchesScalar;
+    }
+
+    std::vector<CullingBenchmarkResult> results;
+    if (!RunCullingBenchmark(count, 64, 20, results) || !WriteCullingBenchmarkCsv("cull_benchmark.csv", results)) {
+        fprintf(stderr, "Culling benchmark failed\n");
+        return 1;
+    }
+
+    double baseMs = results[0].totalMs;
+    for (const CullingBenchmarkResult& result : results) {
+        printf("threads %u: %.3f ms (rebuild %.3f, cull %.3f), speedup %.2fx, stolen %llu%s\n", result.threadCount,
+            result.totalMs, result.rebuildMs, result.cullMs, result.totalMs > 0.0 ? baseMs / result.totalMs : 0.0,
+            static_cast<unsigned long long>(result.stolenChunks), result.matchesSingleThread ? "" : " MISMATCH");
+        matches = matches && result.matchesSingleThread;
+    }
+    return matches ? 0 : 1;
+}
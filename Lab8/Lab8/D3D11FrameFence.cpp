@@ -0,0 +1,51 @@
+#include "framework.h"
+#include "D3D11FrameFence.h"
+
+void D3D11FrameFenceDevice::Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext) {
+    m_pDevice = pDevice;
+    m_pContext = pContext;
+}
+
+void D3D11FrameFenceDevice::Terminate() {
+    for (uint32_t i = 0; i < m_fences.size(); ++i)
+        DestroyFence(i);
+    m_fences.clear();
+    m_pDevice = nullptr;
+    m_pContext = nullptr;
+}
+
+bool D3D11FrameFenceDevice::CreateFence(uint32_t fence) {
+    if (!m_pDevice)
+        return false;
+
+    if (fence >= m_fences.size())
+        m_fences.resize(fence + 1, nullptr);
+    DestroyFence(fence);
+
+    D3D11_QUERY_DESC queryDesc = {};
+    queryDesc.Query = D3D11_QUERY_EVENT;
+    return SUCCEEDED(m_pDevice->CreateQuery(&queryDesc, &m_fences[fence]));
+}
+
+void D3D11FrameFenceDevice::DestroyFence(uint32_t fence) {
+    if (fence < m_fences.size() && m_fences[fence]) {
+        m_fences[fence]->Release();
+        m_fences[fence] = nullptr;
+    }
+}
+
+void D3D11FrameFenceDevice::Signal(uint32_t fence) {
+    if (fence < m_fences.size() && m_fences[fence])
+        m_pContext->End(m_fences[fence]);
+}
+
+bool D3D11FrameFenceDevice::IsComplete(uint32_t fence, bool flush) {
+    // Без запроса ждать нечего
+    if (fence >= m_fences.size() || !m_fences[fence])
+        return true;
+
+    BOOL done = FALSE;
+    HRESULT hr = m_pContext->GetData(m_fences[fence], &done, sizeof(done), flush ? 0 : D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    // Потерянное устройство: запрос никогда не завершится
+    return FAILED(hr) || (hr == S_OK && done);
+}
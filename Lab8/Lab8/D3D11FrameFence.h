@@ -0,0 +1,32 @@
+#ifndef D3D11_FRAME_FENCE_H
+#define D3D11_FRAME_FENCE_H
+
+#include <d3d11.h>
+#include <vector>
+#include "FrameResources.h"
+
+// Fence на D3D11: D3D11_QUERY_EVENT, выставленный в немедленном контексте.
+class D3D11FrameFenceDevice : public IFrameFenceDevice
+{
+public:
+    D3D11FrameFenceDevice() :
+        m_pDevice(nullptr),
+        m_pContext(nullptr)
+    {
+    }
+
+    void Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+    void Terminate();
+
+    bool CreateFence(uint32_t fence) override;
+    void DestroyFence(uint32_t fence) override;
+    void Signal(uint32_t fence) override;
+    bool IsComplete(uint32_t fence, bool flush) override;
+
+private:
+    ID3D11Device* m_pDevice;
+    ID3D11DeviceContext* m_pContext;
+    std::vector<ID3D11Query*> m_fences;
+};
+
+#endif
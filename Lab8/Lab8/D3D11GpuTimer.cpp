@@ -0,0 +1,97 @@
+#include "framework.h"
+#include "D3D11GpuTimer.h"
+
+void D3D11GpuTimerDevice::Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext) {
+    m_pDevice = pDevice;
+    m_pContext = pContext;
+}
+
+void D3D11GpuTimerDevice::Terminate() {
+    for (uint32_t i = 0; i < m_frames.size(); ++i)
+        DestroyFrame(i);
+    m_frames.clear();
+    m_pDevice = nullptr;
+    m_pContext = nullptr;
+}
+
+bool D3D11GpuTimerDevice::CreateFrame(uint32_t frame, uint32_t timestampCount) {
+    if (!m_pDevice)
+        return false;
+
+    if (frame >= m_frames.size())
+        m_frames.resize(frame + 1, Frame{ nullptr, std::vector<ID3D11Query*>() });
+    DestroyFrame(frame);
+
+    D3D11_QUERY_DESC queryDesc = {};
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+    HRESULT hr = m_pDevice->CreateQuery(&queryDesc, &m_frames[frame].pDisjoint);
+    if (FAILED(hr))
+        return false;
+
+    queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+    m_frames[frame].timestamps.assign(timestampCount, nullptr);
+    for (uint32_t i = 0; i < timestampCount; ++i) {
+        hr = m_pDevice->CreateQuery(&queryDesc, &m_frames[frame].timestamps[i]);
+        if (FAILED(hr))
+            return false;
+    }
+    return true;
+}
+
+void D3D11GpuTimerDevice::DestroyFrame(uint32_t frame) {
+    if (frame >= m_frames.size())
+        return;
+
+    if (m_frames[frame].pDisjoint) {
+        m_frames[frame].pDisjoint->Release();
+        m_frames[frame].pDisjoint = nullptr;
+    }
+
+    for (ID3D11Query*& pQuery : m_frames[frame].timestamps) {
+        if (pQuery) {
+            pQuery->Release();
+            pQuery = nullptr;
+        }
+    }
+    m_frames[frame].timestamps.clear();
+}
+
+void D3D11GpuTimerDevice::BeginFrame(uint32_t frame) {
+    if (frame < m_frames.size() && m_frames[frame].pDisjoint)
+        m_pContext->Begin(m_frames[frame].pDisjoint);
+}
+
+void D3D11GpuTimerDevice::Timestamp(uint32_t frame, uint32_t index) {
+    if (frame < m_frames.size() && index < m_frames[frame].timestamps.size())
+        m_pContext->End(m_frames[frame].timestamps[index]);
+}
+
+void D3D11GpuTimerDevice::EndFrame(uint32_t frame) {
+    if (frame < m_frames.size() && m_frames[frame].pDisjoint)
+        m_pContext->End(m_frames[frame].pDisjoint);
+}
+
+bool D3D11GpuTimerDevice::TryResolve(uint32_t frame, const uint32_t* pIndices, uint32_t count,
+    uint64_t* pTimestamps, uint64_t* pFrequency, bool* pValid) {
+    if (frame >= m_frames.size() || !m_frames[frame].pDisjoint)
+        return false;
+
+    // DONOTFLUSH: не готово - вернёмся в следующем кадре, конвейер не сбрасываем
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+    if (m_pContext->GetData(m_frames[frame].pDisjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+        return false;
+
+    const std::vector<ID3D11Query*>& timestamps = m_frames[frame].timestamps;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (pIndices[i] >= timestamps.size())
+            return false;
+        UINT64 value = 0;
+        if (m_pContext->GetData(timestamps[pIndices[i]], &value, sizeof(value), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+            return false;
+        pTimestamps[i] = value;
+    }
+
+    *pFrequency = disjoint.Frequency;
+    *pValid = !disjoint.Disjoint;
+    return true;
+}
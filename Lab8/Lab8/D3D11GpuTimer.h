@@ -0,0 +1,41 @@
+#ifndef D3D11_GPU_TIMER_H
+#define D3D11_GPU_TIMER_H
+
+#include <d3d11.h>
+#include <vector>
+#include "FrameProfiler.h"
+
+// Кадры GPU-таймера на D3D11: D3D11_QUERY_TIMESTAMP_DISJOINT + набор D3D11_QUERY_TIMESTAMP.
+class D3D11GpuTimerDevice : public IGpuTimerDevice
+{
+public:
+    D3D11GpuTimerDevice() :
+        m_pDevice(nullptr),
+        m_pContext(nullptr)
+    {
+    }
+
+    void Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+    void Terminate();
+
+    bool CreateFrame(uint32_t frame, uint32_t timestampCount) override;
+    void DestroyFrame(uint32_t frame) override;
+    void BeginFrame(uint32_t frame) override;
+    void Timestamp(uint32_t frame, uint32_t index) override;
+    void EndFrame(uint32_t frame) override;
+    bool TryResolve(uint32_t frame, const uint32_t* pIndices, uint32_t count,
+        uint64_t* pTimestamps, uint64_t* pFrequency, bool* pValid) override;
+
+private:
+    struct Frame
+    {
+        ID3D11Query* pDisjoint;
+        std::vector<ID3D11Query*> timestamps;
+    };
+
+    ID3D11Device* m_pDevice;
+    ID3D11DeviceContext* m_pContext;
+    std::vector<Frame> m_frames;
+};
+
+#endif
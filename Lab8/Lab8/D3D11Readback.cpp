@@ -0,0 +1,96 @@
+#include "framework.h"
+#include "D3D11Readback.h"
+
+void D3D11ReadbackDevice::Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext) {
+    m_pDevice = pDevice;
+    m_pContext = pContext;
+}
+
+void D3D11ReadbackDevice::Terminate() {
+    for (uint32_t i = 0; i < m_slots.size(); ++i)
+        DestroySlot(i);
+    m_slots.clear();
+    m_pDevice = nullptr;
+    m_pContext = nullptr;
+}
+
+bool D3D11ReadbackDevice::CreateSlot(uint32_t slot, uint32_t byteWidth) {
+    if (!m_pDevice)
+        return false;
+
+    if (slot >= m_slots.size())
+        m_slots.resize(slot + 1, Slot{ nullptr, nullptr });
+    DestroySlot(slot);
+
+    D3D11_BUFFER_DESC desc = {};
+    desc.ByteWidth = byteWidth;
+    desc.Usage = D3D11_USAGE_STAGING;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+    HRESULT hr = m_pDevice->CreateBuffer(&desc, nullptr, &m_slots[slot].pStaging);
+    if (FAILED(hr))
+        return false;
+
+    D3D11_QUERY_DESC queryDesc = {};
+    queryDesc.Query = D3D11_QUERY_EVENT;
+    hr = m_pDevice->CreateQuery(&queryDesc, &m_slots[slot].pFence);
+    return SUCCEEDED(hr);
+}
+
+void D3D11ReadbackDevice::DestroySlot(uint32_t slot) {
+    if (slot >= m_slots.size())
+        return;
+
+    if (m_slots[slot].pStaging) {
+        m_slots[slot].pStaging->Release();
+        m_slots[slot].pStaging = nullptr;
+    }
+
+    if (m_slots[slot].pFence) {
+        m_slots[slot].pFence->Release();
+        m_slots[slot].pFence = nullptr;
+    }
+}
+
+void D3D11ReadbackDevice::CopyToSlot(uint32_t slot, uint32_t dstOffset, void* pSource, uint32_t srcOffset, uint32_t byteCount) {
+    if (slot >= m_slots.size() || !m_slots[slot].pStaging || !pSource)
+        return;
+
+    D3D11_BOX box = {};
+    box.left = srcOffset;
+    box.right = srcOffset + byteCount;
+    box.top = 0;
+    box.bottom = 1;
+    box.front = 0;
+    box.back = 1;
+    m_pContext->CopySubresourceRegion(m_slots[slot].pStaging, 0, dstOffset, 0, 0,
+        static_cast<ID3D11Buffer*>(pSource), 0, &box);
+}
+
+void D3D11ReadbackDevice::SignalSlot(uint32_t slot) {
+    if (slot < m_slots.size() && m_slots[slot].pFence)
+        m_pContext->End(m_slots[slot].pFence);
+}
+
+bool D3D11ReadbackDevice::IsSlotReady(uint32_t slot) {
+    if (slot >= m_slots.size() || !m_slots[slot].pFence)
+        return false;
+
+    BOOL done = FALSE;
+    HRESULT hr = m_pContext->GetData(m_slots[slot].pFence, &done, sizeof(done), D3D11_ASYNC_GETDATA_DONOTFLUSH);
+    return hr == S_OK && done;
+}
+
+bool D3D11ReadbackDevice::ReadSlot(uint32_t slot, void* pDst, uint32_t byteCount) {
+    if (slot >= m_slots.size() || !m_slots[slot].pStaging)
+        return false;
+
+    // Fence уже пройден, DO_NOT_WAIT лишь страхует от блокировки
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    HRESULT hr = m_pContext->Map(m_slots[slot].pStaging, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+    if (FAILED(hr))
+        return false;
+
+    memcpy(pDst, mapped.pData, byteCount);
+    m_pContext->Unmap(m_slots[slot].pStaging, 0);
+    return true;
+}
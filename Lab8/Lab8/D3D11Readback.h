@@ -0,0 +1,40 @@
+#ifndef D3D11_READBACK_H
+#define D3D11_READBACK_H
+
+#include <d3d11.h>
+#include <vector>
+#include "ReadbackRing.h"
+
+// Слоты кольца чтения на D3D11: STAGING-буфер + D3D11_QUERY_EVENT.
+class D3D11ReadbackDevice : public IReadbackDevice
+{
+public:
+    D3D11ReadbackDevice() :
+        m_pDevice(nullptr),
+        m_pContext(nullptr)
+    {
+    }
+
+    void Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext);
+    void Terminate();
+
+    bool CreateSlot(uint32_t slot, uint32_t byteWidth) override;
+    void DestroySlot(uint32_t slot) override;
+    void CopyToSlot(uint32_t slot, uint32_t dstOffset, void* pSource, uint32_t srcOffset, uint32_t byteCount) override;
+    void SignalSlot(uint32_t slot) override;
+    bool IsSlotReady(uint32_t slot) override;
+    bool ReadSlot(uint32_t slot, void* pDst, uint32_t byteCount) override;
+
+private:
+    struct Slot
+    {
+        ID3D11Buffer* pStaging;
+        ID3D11Query* pFence;
+    };
+
+    ID3D11Device* m_pDevice;
+    ID3D11DeviceContext* m_pContext;
+    std::vector<Slot> m_slots;
+};
+
+#endif
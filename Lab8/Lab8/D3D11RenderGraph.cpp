@@ -0,0 +1,103 @@
+#include "framework.h"
+#include "D3D11RenderGraph.h"
+
+void D3D11RenderGraphResources::Init(ID3D11Device* pDevice) {
+    Terminate();
+    m_pDevice = pDevice;
+}
+
+void D3D11RenderGraphResources::Terminate() {
+    for (Slot& slot : m_slots)
+        ReleaseSlot(slot);
+    m_slots.clear();
+    m_pDevice = nullptr;
+}
+
+HRESULT D3D11RenderGraphResources::Realize(const RenderGraph& graph) {
+    uint32_t count = graph.GetPhysicalCount();
+    for (uint32_t i = count; i < m_slots.size(); i++)
+        ReleaseSlot(m_slots[i]);
+    m_slots.resize(count, Slot{});
+
+    for (uint32_t i = 0; i < count; i++) {
+        const RenderGraphTextureDesc& desc = graph.GetPhysicalDesc(i);
+        Slot& slot = m_slots[i];
+        if (slot.pTexture && memcmp(&slot.desc, &desc, sizeof(desc)) == 0)
+            continue;
+
+        ReleaseSlot(slot);
+        HRESULT hr = CreateSlot(desc, slot);
+        if (FAILED(hr))
+            return hr;
+    }
+    return S_OK;
+}
+
+HRESULT D3D11RenderGraphResources::CreateSlot(const RenderGraphTextureDesc& desc, Slot& slot) {
+    D3D11_TEXTURE2D_DESC texDesc = {};
+    texDesc.Width = desc.width;
+    texDesc.Height = desc.height;
+    texDesc.MipLevels = 1;
+    texDesc.ArraySize = 1;
+    texDesc.Format = static_cast<DXGI_FORMAT>(desc.format);
+    texDesc.SampleDesc.Count = 1;
+    texDesc.Usage = D3D11_USAGE_DEFAULT;
+    texDesc.BindFlags = desc.bindFlags;
+
+    HRESULT hr = m_pDevice->CreateTexture2D(&texDesc, nullptr, &slot.pTexture);
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_RENDER_TARGET))
+        hr = m_pDevice->CreateRenderTargetView(slot.pTexture, nullptr, &slot.pRTV);
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_SHADER_RESOURCE))
+        hr = m_pDevice->CreateShaderResourceView(slot.pTexture, nullptr, &slot.pSRV);
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_DEPTH_STENCIL))
+        hr = m_pDevice->CreateDepthStencilView(slot.pTexture, nullptr, &slot.pDSV);
+    if (SUCCEEDED(hr) && (desc.bindFlags & D3D11_BIND_UNORDERED_ACCESS))
+        hr = m_pDevice->CreateUnorderedAccessView(slot.pTexture, nullptr, &slot.pUAV);
+
+    if (FAILED(hr)) {
+        ReleaseSlot(slot);
+        return hr;
+    }
+    slot.desc = desc;
+    ++m_createdTextures;
+    return S_OK;
+}
+
+void D3D11RenderGraphResources::ReleaseSlot(Slot& slot) {
+    if (slot.pUAV) slot.pUAV->Release();
+    if (slot.pDSV) slot.pDSV->Release();
+    if (slot.pSRV) slot.pSRV->Release();
+    if (slot.pRTV) slot.pRTV->Release();
+    if (slot.pTexture) slot.pTexture->Release();
+    slot = Slot{};
+}
+
+const D3D11RenderGraphResources::Slot* D3D11RenderGraphResources::FindSlot(const RenderGraph& graph, uint32_t resource) const {
+    uint32_t physical = graph.GetPhysical(resource);
+    return physical < m_slots.size() ? &m_slots[physical] : nullptr;
+}
+
+ID3D11Texture2D* D3D11RenderGraphResources::GetTexture(const RenderGraph& graph, uint32_t resource) const {
+    const Slot* pSlot = FindSlot(graph, resource);
+    return pSlot ? pSlot->pTexture : nullptr;
+}
+
+ID3D11RenderTargetView* D3D11RenderGraphResources::GetRTV(const RenderGraph& graph, uint32_t resource) const {
+    const Slot* pSlot = FindSlot(graph, resource);
+    return pSlot ? pSlot->pRTV : nullptr;
+}
+
+ID3D11ShaderResourceView* D3D11RenderGraphResources::GetSRV(const RenderGraph& graph, uint32_t resource) const {
+    const Slot* pSlot = FindSlot(graph, resource);
+    return pSlot ? pSlot->pSRV : nullptr;
+}
+
+ID3D11DepthStencilView* D3D11RenderGraphResources::GetDSV(const RenderGraph& graph, uint32_t resource) const {
+    const Slot* pSlot = FindSlot(graph, resource);
+    return pSlot ? pSlot->pDSV : nullptr;
+}
+
+ID3D11UnorderedAccessView* D3D11RenderGraphResources::GetUAV(const RenderGraph& graph, uint32_t resource) const {
+    const Slot* pSlot = FindSlot(graph, resource);
+    return pSlot ? pSlot->pUAV : nullptr;
+}
@@ -0,0 +1,54 @@
+#ifndef D3D11_RENDER_GRAPH_H
+#define D3D11_RENDER_GRAPH_H
+
+#include <d3d11.h>
+#include <vector>
+#include "RenderGraph.h"
+
+// Физические текстуры скомпилированного графа. В D3D11 нет размещаемых ресурсов,
+// поэтому общий пул - это сами текстуры: временные ресурсы графа, попавшие в один слот,
+// делят одну текстуру. При перекомпиляции слоты с тем же описанием сохраняются.
+class D3D11RenderGraphResources
+{
+public:
+    D3D11RenderGraphResources() :
+        m_pDevice(nullptr),
+        m_createdTextures(0)
+    {
+    }
+
+    void Init(ID3D11Device* pDevice);
+    void Terminate();
+
+    HRESULT Realize(const RenderGraph& graph);
+
+    // Виды текстуры, в которую попал ресурс графа; nullptr, если его нет
+    ID3D11Texture2D* GetTexture(const RenderGraph& graph, uint32_t resource) const;
+    ID3D11RenderTargetView* GetRTV(const RenderGraph& graph, uint32_t resource) const;
+    ID3D11ShaderResourceView* GetSRV(const RenderGraph& graph, uint32_t resource) const;
+    ID3D11DepthStencilView* GetDSV(const RenderGraph& graph, uint32_t resource) const;
+    ID3D11UnorderedAccessView* GetUAV(const RenderGraph& graph, uint32_t resource) const;
+
+    uint32_t GetCreatedTextures() const { return m_createdTextures; }
+
+private:
+    struct Slot
+    {
+        RenderGraphTextureDesc desc;
+        ID3D11Texture2D* pTexture;
+        ID3D11RenderTargetView* pRTV;
+        ID3D11ShaderResourceView* pSRV;
+        ID3D11DepthStencilView* pDSV;
+        ID3D11UnorderedAccessView* pUAV;
+    };
+
+    HRESULT CreateSlot(const RenderGraphTextureDesc& desc, Slot& slot);
+    static void ReleaseSlot(Slot& slot);
+    const Slot* FindSlot(const RenderGraph& graph, uint32_t resource) const;
+
+    ID3D11Device* m_pDevice;
+    std::vector<Slot> m_slots;
+    uint32_t m_createdTextures;
+};
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef D3D11_STATE_TRACKER_H
+#define D3D11_STATE_TRACKER_H
+
+#include <d3d11_1.h>
+#include "StateTracker.h"
+
+// Типы D3D11 для StateTrackerT
+struct D3D11StateApi
+{
+    typedef ID3D11DeviceContext Context;
+    typedef ID3D11DeviceContext1 Context1;
+    typedef ID3D11InputLayout InputLayout;
+    typedef ID3D11Buffer Buffer;
+    typedef ID3D11VertexShader VertexShader;
+    typedef ID3D11PixelShader PixelShader;
+    typedef ID3D11ComputeShader ComputeShader;
+    typedef ID3D11ShaderResourceView ShaderResourceView;
+    typedef ID3D11UnorderedAccessView UnorderedAccessView;
+    typedef ID3D11SamplerState SamplerState;
+    typedef ID3D11RenderTargetView RenderTargetView;
+    typedef ID3D11DepthStencilView DepthStencilView;
+    typedef ID3D11DepthStencilState DepthStencilState;
+    typedef ID3D11BlendState BlendState;
+    typedef ID3D11RasterizerState RasterizerState;
+    typedef D3D11_VIEWPORT Viewport;
+    typedef DXGI_FORMAT Format;
+    typedef D3D11_PRIMITIVE_TOPOLOGY Topology;
+};
+
+typedef StateTrackerT<D3D11StateApi> StateTracker;
+
+#endif
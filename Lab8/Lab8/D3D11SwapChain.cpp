@@ -0,0 +1,149 @@
+#include "framework.h"
+#include "D3D11SwapChain.h"
+
+namespace
+{
+    UINT ClampBufferCount(UINT bufferCount) {
+        if (bufferCount < D3D11SwapChain::MinBufferCount)
+            return D3D11SwapChain::MinBufferCount;
+        return bufferCount > D3D11SwapChain::MaxBufferCount ? D3D11SwapChain::MaxBufferCount : bufferCount;
+    }
+}
+
+HRESULT D3D11SwapChain::Init(ID3D11Device* pDevice, HWND hWnd, UINT bufferCount, UINT maxFrameLatency) {
+    Terminate();
+
+    m_pDevice = pDevice;
+    m_bufferCount = ClampBufferCount(bufferCount);
+    m_maxFrameLatency = maxFrameLatency > 0 ? maxFrameLatency : 1;
+
+    // Фабрика - та, что создала адаптер устройства
+    IDXGIDevice* pDxgiDevice = nullptr;
+    IDXGIAdapter* pAdapter = nullptr;
+    IDXGIFactory2* pFactory = nullptr;
+    HRESULT hr = pDevice->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void**>(&pDxgiDevice));
+    if (SUCCEEDED(hr))
+        hr = pDxgiDevice->GetAdapter(&pAdapter);
+    if (SUCCEEDED(hr))
+        hr = pAdapter->GetParent(__uuidof(IDXGIFactory2), reinterpret_cast<void**>(&pFactory));
+    if (pAdapter) pAdapter->Release();
+    if (pDxgiDevice) pDxgiDevice->Release();
+    if (FAILED(hr))
+        return hr;
+
+    IDXGIFactory5* pFactory5 = nullptr;
+    if (SUCCEEDED(pFactory->QueryInterface(__uuidof(IDXGIFactory5), reinterpret_cast<void**>(&pFactory5)))) {
+        BOOL allowTearing = FALSE;
+        m_tearingSupported = SUCCEEDED(pFactory5->CheckFeatureSupport(DXGI_FEATURE_PRESENT_ALLOW_TEARING, &allowTearing, sizeof(allowTearing))) && allowTearing;
+        pFactory5->Release();
+    }
+
+    DXGI_SWAP_CHAIN_DESC1 desc = {};
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.BufferCount = m_bufferCount;
+    desc.Scaling = DXGI_SCALING_STRETCH;
+    desc.AlphaMode = DXGI_ALPHA_MODE_UNSPECIFIED;
+
+    // FLIP_DISCARD - с Windows 10, FLIP_SEQUENTIAL - с 8.1, иначе прежняя DISCARD
+    const DXGI_SWAP_EFFECT effects[] = { DXGI_SWAP_EFFECT_FLIP_DISCARD, DXGI_SWAP_EFFECT_FLIP_SEQUENTIAL, DXGI_SWAP_EFFECT_DISCARD };
+    for (DXGI_SWAP_EFFECT effect : effects) {
+        m_flipModel = effect != DXGI_SWAP_EFFECT_DISCARD;
+        m_flags = 0;
+        if (m_flipModel) {
+            m_flags |= DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
+            if (m_tearingSupported)
+                m_flags |= DXGI_SWAP_CHAIN_FLAG_ALLOW_TEARING;
+        }
+        desc.SwapEffect = effect;
+        desc.Flags = m_flags;
+        // Последний проход постобработки - вычислительный шейдер, он пишет в буфер через UAV.
+        // Старая модель DISCARD этого не умеет: там результат копируется
+        desc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT | (m_flipModel ? DXGI_USAGE_UNORDERED_ACCESS : 0);
+        hr = pFactory->CreateSwapChainForHwnd(pDevice, hWnd, &desc, nullptr, nullptr, &m_pSwapChain);
+        if (SUCCEEDED(hr))
+            break;
+    }
+    pFactory->Release();
+    if (FAILED(hr)) {
+        m_flipModel = false;
+        m_tearingSupported = false;
+        return hr;
+    }
+    if (!m_flipModel)
+        m_tearingSupported = false;
+
+    if (m_flags & DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT &&
+        SUCCEEDED(m_pSwapChain->QueryInterface(__uuidof(IDXGISwapChain2), reinterpret_cast<void**>(&m_pSwapChain2))))
+        m_waitableObject = m_pSwapChain2->GetFrameLatencyWaitableObject();
+
+    SetMaximumFrameLatency(m_maxFrameLatency);
+    return S_OK;
+}
+
+void D3D11SwapChain::Terminate() {
+    if (m_waitableObject) {
+        CloseHandle(m_waitableObject);
+        m_waitableObject = nullptr;
+    }
+
+    if (m_pSwapChain2) {
+        m_pSwapChain2->Release();
+        m_pSwapChain2 = nullptr;
+    }
+
+    if (m_pSwapChain) {
+        m_pSwapChain->Release();
+        m_pSwapChain = nullptr;
+    }
+
+    m_pDevice = nullptr;
+    m_flipModel = false;
+    m_tearingSupported = false;
+}
+
+HRESULT D3D11SwapChain::Resize(UINT width, UINT height) {
+    if (!m_pSwapChain)
+        return E_FAIL;
+    // Флаги обязаны совпадать с флагами создания, иначе объект ожидания перестаёт работать
+    return m_pSwapChain->ResizeBuffers(m_bufferCount, width, height, DXGI_FORMAT_R8G8B8A8_UNORM, m_flags);
+}
+
+HRESULT D3D11SwapChain::GetBackBuffer(ID3D11Texture2D** ppBackBuffer) {
+    if (!m_pSwapChain)
+        return E_FAIL;
+    return m_pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(ppBackBuffer));
+}
+
+HRESULT D3D11SwapChain::Present(UINT syncInterval, bool allowTearing) {
+    if (!m_pSwapChain)
+        return E_FAIL;
+    UINT flags = allowTearing && syncInterval == 0 && m_tearingSupported ? DXGI_PRESENT_ALLOW_TEARING : 0;
+    return m_pSwapChain->Present(syncInterval, flags);
+}
+
+void D3D11SwapChain::SetBufferCount(UINT bufferCount) {
+    m_bufferCount = ClampBufferCount(bufferCount);
+}
+
+void D3D11SwapChain::SetMaximumFrameLatency(UINT maxFrameLatency) {
+    m_maxFrameLatency = maxFrameLatency > 0 ? maxFrameLatency : 1;
+    if (m_pSwapChain2) {
+        m_pSwapChain2->SetMaximumFrameLatency(m_maxFrameLatency);
+        return;
+    }
+
+    if (!m_pDevice)
+        return;
+    IDXGIDevice1* pDxgiDevice = nullptr;
+    if (SUCCEEDED(m_pDevice->QueryInterface(__uuidof(IDXGIDevice1), reinterpret_cast<void**>(&pDxgiDevice)))) {
+        pDxgiDevice->SetMaximumFrameLatency(m_maxFrameLatency);
+        pDxgiDevice->Release();
+    }
+}
+
+bool D3D11SwapChain::WaitForFrame(uint32_t timeoutMs) {
+    if (!m_waitableObject)
+        return true;
+    return WaitForSingleObjectEx(m_waitableObject, timeoutMs, TRUE) == WAIT_OBJECT_0;
+}
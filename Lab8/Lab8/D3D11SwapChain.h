@@ -0,0 +1,64 @@
+#ifndef D3D11_SWAP_CHAIN_H
+#define D3D11_SWAP_CHAIN_H
+
+#include <d3d11.h>
+#include <dxgi1_5.h>
+#include "FramePacer.h"
+
+// Цепочка обмена модели flip (FLIP_DISCARD) с объектом ожидания задержки кадров.
+// На системах без flip-модели - прежняя DISCARD без объекта ожидания; тогда задержку
+// ограничивает IDXGIDevice1::SetMaximumFrameLatency.
+class D3D11SwapChain : public IFrameWaiter
+{
+public:
+    static const UINT MinBufferCount = 2;
+    static const UINT MaxBufferCount = 4;
+
+    D3D11SwapChain() :
+        m_pDevice(nullptr),
+        m_pSwapChain(nullptr),
+        m_pSwapChain2(nullptr),
+        m_waitableObject(nullptr),
+        m_bufferCount(MinBufferCount),
+        m_maxFrameLatency(1),
+        m_flags(0),
+        m_flipModel(false),
+        m_tearingSupported(false)
+    {
+    }
+
+    HRESULT Init(ID3D11Device* pDevice, HWND hWnd, UINT bufferCount, UINT maxFrameLatency);
+    void Terminate();
+
+    // Все ссылки на задний буфер к этому моменту должны быть отпущены
+    HRESULT Resize(UINT width, UINT height);
+    HRESULT GetBackBuffer(ID3D11Texture2D** ppBackBuffer);
+    // Разрывы только при syncInterval == 0 и поддержке системы
+    HRESULT Present(UINT syncInterval, bool allowTearing);
+
+    // Число буферов применяется при следующем Resize
+    void SetBufferCount(UINT bufferCount);
+    void SetMaximumFrameLatency(UINT maxFrameLatency);
+
+    bool WaitForFrame(uint32_t timeoutMs) override;
+
+    bool IsCreated() const { return m_pSwapChain != nullptr; }
+    bool IsFlipModel() const { return m_flipModel; }
+    bool IsTearingSupported() const { return m_tearingSupported; }
+    bool HasWaitableObject() const { return m_waitableObject != nullptr; }
+    UINT GetBufferCount() const { return m_bufferCount; }
+    UINT GetMaximumFrameLatency() const { return m_maxFrameLatency; }
+
+private:
+    ID3D11Device* m_pDevice;
+    IDXGISwapChain1* m_pSwapChain;
+    IDXGISwapChain2* m_pSwapChain2;
+    HANDLE m_waitableObject;
+    UINT m_bufferCount;
+    UINT m_maxFrameLatency;
+    UINT m_flags;
+    bool m_flipModel;
+    bool m_tearingSupported;
+};
+
+#endif
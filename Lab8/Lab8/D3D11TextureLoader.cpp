@@ -0,0 +1,364 @@
+#include "framework.h"
+#include "D3D11TextureLoader.h"
+#include "DDSTextureLoader11.h"
+#include "DDS.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+namespace
+{
+    // После WIC_LOADER_FORCE_RGBA32 у всех картинок 4 байта на пиксель
+    const UINT RGBA32Bytes = 4;
+    const UINT CubeFaces = 6;
+}
+
+bool D3D11TextureLoader::Init(ID3D11Device* pDevice, uint32_t threadCount) {
+    Terminate();
+    m_pDevice = pDevice;
+    m_loaded = 0;
+    m_failed = 0;
+
+    // WIC требует COM в каждом потоке, который декодирует
+    return m_async.Init(threadCount,
+        []() { CoInitializeEx(nullptr, COINIT_MULTITHREADED); },
+        []() { CoUninitialize(); });
+}
+
+void D3D11TextureLoader::Terminate() {
+    // Сначала останавливаем потоки: задачи пишут в запросы
+    m_async.Terminate();
+    m_jobs.clear();
+    m_ready.clear();
+    m_requests.clear();
+    m_pDevice = nullptr;
+}
+
+HRESULT D3D11TextureLoader::LoadArray(const std::vector<std::wstring>& files, uint32_t width, uint32_t height, bool srgb,
+    uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView) {
+    if (files.empty() || files.size() > D3D11_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION ||
+        width == 0 || height == 0 || width > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION || height > D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION)
+        return E_INVALIDARG;
+
+    HRESULT hr = CreatePlaceholder(RequestKind::Array, static_cast<uint32_t>(files.size()), placeholderRGBA, ppView);
+    if (FAILED(hr))
+        return hr;
+
+    std::unique_ptr<Request> request(new Request());
+    request->kind = RequestKind::Array;
+    request->ppView = ppView;
+    request->files = files;
+    request->arrayBuilder.Init(static_cast<uint32_t>(files.size()), width, height, TextureArrayBuilder::Channels::RGBA, srgb, MipGenerator::Filter::Kaiser);
+    return Submit(std::move(request));
+}
+
+HRESULT D3D11TextureLoader::LoadCubeCross(const std::wstring& file, uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView) {
+    HRESULT hr = CreatePlaceholder(RequestKind::CubeCross, 6, placeholderRGBA, ppView);
+    if (FAILED(hr))
+        return hr;
+
+    std::unique_ptr<Request> request(new Request());
+    request->kind = RequestKind::CubeCross;
+    request->ppView = ppView;
+    request->files.push_back(file);
+    return Submit(std::move(request));
+}
+
+HRESULT D3D11TextureLoader::LoadDDS(const std::wstring& file, uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView) {
+    HRESULT hr = CreatePlaceholder(RequestKind::DDS, 1, placeholderRGBA, ppView);
+    if (FAILED(hr))
+        return hr;
+
+    std::unique_ptr<Request> request(new Request());
+    request->kind = RequestKind::DDS;
+    request->ppView = ppView;
+    request->files.push_back(file);
+    return Submit(std::move(request));
+}
+
+HRESULT D3D11TextureLoader::CreatePlaceholder(RequestKind kind, uint32_t arraySize, uint32_t rgba, ID3D11ShaderResourceView** ppView) {
+    if (!m_pDevice || !ppView)
+        return E_INVALIDARG;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = 1;
+    desc.Height = 1;
+    desc.MipLevels = 1;
+    desc.ArraySize = arraySize;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    desc.MiscFlags = kind == RequestKind::CubeCross ? D3D11_RESOURCE_MISC_TEXTURECUBE : 0;
+
+    std::vector<D3D11_SUBRESOURCE_DATA> initData(arraySize);
+    for (D3D11_SUBRESOURCE_DATA& data : initData) {
+        data.pSysMem = &rgba;
+        data.SysMemPitch = RGBA32Bytes;
+    }
+
+    ID3D11Texture2D* pTexture = nullptr;
+    HRESULT hr = m_pDevice->CreateTexture2D(&desc, initData.data(), &pTexture);
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    switch (kind) {
+    case RequestKind::Array:
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+        srvDesc.Texture2DArray.MipLevels = 1;
+        srvDesc.Texture2DArray.ArraySize = arraySize;
+        break;
+    case RequestKind::CubeCross:
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+        srvDesc.TextureCube.MipLevels = 1;
+        break;
+    default:
+        srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+        srvDesc.Texture2D.MipLevels = 1;
+        break;
+    }
+
+    hr = m_pDevice->CreateShaderResourceView(pTexture, &srvDesc, ppView);
+    pTexture->Release();
+    return hr;
+}
+
+HRESULT D3D11TextureLoader::Submit(std::unique_ptr<Request> request) {
+    Request* pRequest = request.get();
+    const uint32_t count = static_cast<uint32_t>(pRequest->files.size());
+    pRequest->remaining = count;
+    pRequest->failed = false;
+    if (pRequest->kind == RequestKind::DDS)
+        pRequest->ddsFile.reset(new MappedFile());
+    else {
+        pRequest->images.resize(count);
+        if (pRequest->kind == RequestKind::CubeCross)
+            pRequest->mips.resize(CubeFaces);
+    }
+    m_requests.push_back(std::move(request));
+
+    // Слои массива декодируются независимо, каждый своей задачей
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t ticket = m_async.Submit([pRequest, i]() {
+            if (pRequest->kind == RequestKind::DDS)
+                return MapDDS(pRequest->files[i], pRequest->ddsFile.get());
+            return DecodeImage(pRequest->files[i], &pRequest->images[i]) && BuildMips(pRequest, i);
+        });
+
+        if (ticket == 0) {
+            pRequest->failed = true;
+            if (--pRequest->remaining == 0)
+                m_ready.push_back(pRequest);
+            continue;
+        }
+        m_jobs[ticket] = { pRequest, i };
+    }
+    return S_OK;
+}
+
+uint32_t D3D11TextureLoader::Update(uint32_t maxCreates) {
+    if (m_requests.empty())
+        return 0;
+
+    m_async.Collect(m_completions, m_jobs.size());
+    for (const AsyncLoader::Completion& completion : m_completions) {
+        auto it = m_jobs.find(completion.ticket);
+        if (it == m_jobs.end())
+            continue;
+
+        Request* pRequest = it->second.pRequest;
+        m_jobs.erase(it);
+        if (!completion.succeeded)
+            pRequest->failed = true;
+        if (--pRequest->remaining == 0)
+            m_ready.push_back(pRequest);
+    }
+
+    // Создание ресурсов ограничено, чтобы кадр с пачкой готовых текстур не растягивался
+    uint32_t replaced = 0;
+    for (uint32_t created = 0; created < maxCreates && !m_ready.empty(); ++created) {
+        Request* pRequest = m_ready.front();
+        m_ready.pop_front();
+
+        ID3D11ShaderResourceView* pView = nullptr;
+        HRESULT hr = E_FAIL;
+        if (!pRequest->failed) {
+            switch (pRequest->kind) {
+            case RequestKind::Array: hr = CreateArray(*pRequest, &pView); break;
+            case RequestKind::CubeCross: hr = CreateCube(*pRequest, &pView); break;
+            default: hr = CreateDDS(*pRequest, &pView); break;
+            }
+        }
+
+        if (SUCCEEDED(hr)) {
+            if (*pRequest->ppView)
+                (*pRequest->ppView)->Release();
+            *pRequest->ppView = pView;
+            ++m_loaded;
+            ++replaced;
+        } else {
+            // Заглушка остаётся: сцена рисуется, просто без текстуры
+            std::wstring message = L"Не удалось загрузить текстуру " + pRequest->files[0] + L"\n";
+            OutputDebugString(message.c_str());
+            ++m_failed;
+        }
+        Finish(pRequest);
+    }
+    return replaced;
+}
+
+HRESULT D3D11TextureLoader::CreateArray(Request& request, ID3D11ShaderResourceView** ppView) {
+    // Слои уже приведены к общему размеру и с мипами: текстура создаётся неизменяемой одним вызовом
+    const TextureArrayBuilder& builder = request.arrayBuilder;
+    if (!builder.IsComplete())
+        return E_FAIL;
+
+    const UINT arraySize = builder.GetLayerCount();
+    const UINT mipLevels = builder.GetMipCount();
+    std::vector<D3D11_SUBRESOURCE_DATA> initData(arraySize * mipLevels);
+    for (UINT slice = 0; slice < arraySize; ++slice) {
+        for (UINT mip = 0; mip < mipLevels; ++mip) {
+            const MipGenerator::Level& level = builder.GetLevel(slice, mip);
+            D3D11_SUBRESOURCE_DATA& data = initData[D3D11CalcSubresource(mip, slice, mipLevels)];
+            data.pSysMem = level.pPixels;
+            data.SysMemPitch = static_cast<UINT>(level.rowPitch);
+            data.SysMemSlicePitch = static_cast<UINT>(level.rowPitch * level.height);
+        }
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = builder.GetWidth();
+    desc.Height = builder.GetHeight();
+    desc.MipLevels = mipLevels;
+    desc.ArraySize = arraySize;
+    desc.Format = builder.IsSRGB() ? DXGI_FORMAT_R8G8B8A8_UNORM_SRGB : DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    ID3D11Texture2D* pTexture = nullptr;
+    HRESULT hr = m_pDevice->CreateTexture2D(&desc, initData.data(), &pTexture);
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
+    srvDesc.Texture2DArray.MipLevels = mipLevels;
+    srvDesc.Texture2DArray.ArraySize = arraySize;
+
+    hr = m_pDevice->CreateShaderResourceView(pTexture, &srvDesc, ppView);
+    pTexture->Release();
+    return hr;
+}
+
+HRESULT D3D11TextureLoader::CreateCube(Request& request, ID3D11ShaderResourceView** ppView) {
+    // Размер креста проверен при построении мипов
+    const WICImage& image = request.images[0];
+    const UINT faceSize = image.width / 4;
+
+    // Уровень 0 каждой грани указывает прямо в строки креста, остальные - в цепочки мипов
+    const UINT mipLevels = request.mips[0].GetLevelCount();
+    D3D11_SUBRESOURCE_DATA faces[CubeFaces * D3D11_REQ_MIP_LEVELS] = {};
+    for (UINT face = 0; face < CubeFaces; ++face) {
+        for (UINT mip = 0; mip < mipLevels; ++mip) {
+            const MipGenerator::Level& level = request.mips[face].GetLevel(mip);
+            D3D11_SUBRESOURCE_DATA& data = faces[D3D11CalcSubresource(mip, face, mipLevels)];
+            data.pSysMem = level.pPixels;
+            data.SysMemPitch = static_cast<UINT>(level.rowPitch);
+        }
+    }
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = faceSize;
+    desc.Height = faceSize;
+    desc.MipLevels = mipLevels;
+    desc.ArraySize = CubeFaces;
+    desc.Format = image.format;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_IMMUTABLE;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    desc.MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE;
+
+    ID3D11Texture2D* pTexture = nullptr;
+    HRESULT hr = m_pDevice->CreateTexture2D(&desc, faces, &pTexture);
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = desc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
+    srvDesc.TextureCube.MipLevels = mipLevels;
+
+    hr = m_pDevice->CreateShaderResourceView(pTexture, &srvDesc, ppView);
+    pTexture->Release();
+    return hr;
+}
+
+HRESULT D3D11TextureLoader::CreateDDS(Request& request, ID3D11ShaderResourceView** ppView) {
+    // Начальные данные текстуры указывают прямо в отображение файла
+    const MappedFile& file = *request.ddsFile;
+    return CreateDDSTextureFromMemory(m_pDevice, file.GetData(), file.GetSize(), nullptr, ppView);
+}
+
+void D3D11TextureLoader::Finish(Request* pRequest) {
+    auto it = std::find_if(m_requests.begin(), m_requests.end(),
+        [pRequest](const std::unique_ptr<Request>& request) { return request.get() == pRequest; });
+    if (it != m_requests.end())
+        m_requests.erase(it);
+}
+
+bool D3D11TextureLoader::DecodeImage(const std::wstring& file, WICImage* pImage) {
+    return SUCCEEDED(LoadWICImageFromFile(file.c_str(), 0, WIC_LOADER_FORCE_RGBA32, *pImage));
+}
+
+bool D3D11TextureLoader::BuildMips(Request* pRequest, uint32_t slice) {
+    const WICImage& image = pRequest->images[slice];
+    if (pRequest->kind == RequestKind::Array) {
+        // Размер и цветовое пространство задаёт массив, слой к ним приводится
+        TextureArrayBuilder::Image layer = { image.pixels.get(), image.width, image.height, image.rowPitch, TextureArrayBuilder::Channels::RGBA };
+        return pRequest->arrayBuilder.SetLayer(slice, layer);
+    }
+
+    // Цвет в sRGB усредняется в линейном пространстве, UNORM - как данные
+    const bool srgb = image.format == DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+
+    const UINT faceSize = image.width / 4;
+    if (faceSize == 0 || image.height != faceSize * 3)
+        return false;
+    for (UINT face = 0; face < CubeFaces; ++face) {
+        if (!pRequest->mips[face].Generate(GetCrossFace(image, face), faceSize, faceSize, image.rowPitch, srgb, MipGenerator::Filter::Kaiser))
+            return false;
+    }
+    return true;
+}
+
+const uint8_t* D3D11TextureLoader::GetCrossFace(const WICImage& image, uint32_t face) {
+    // Развёртка 4x3: +X, -X, +Y, -Y, +Z, -Z
+    const UINT faceSize = image.width / 4;
+    UINT x = 0, y = 0;
+    switch (face) {
+    case 0: x = 2 * faceSize; y = faceSize; break;
+    case 1: x = 0 * faceSize; y = faceSize; break;
+    case 2: x = 1 * faceSize; y = 0 * faceSize; break;
+    case 3: x = 1 * faceSize; y = 2 * faceSize; break;
+    case 4: x = 1 * faceSize; y = faceSize; break;
+    case 5: x = 3 * faceSize; y = faceSize; break;
+    }
+    return image.pixels.get() + y * image.rowPitch + x * RGBA32Bytes;
+}
+
+bool D3D11TextureLoader::MapDDS(const std::wstring& file, MappedFile* pFile) {
+    // Заголовок целиком проверит CreateDDSTextureFromMemory
+    if (!pFile->Open(file) || pFile->GetSize() < DDS_MIN_HEADER_SIZE || *reinterpret_cast<const uint32_t*>(pFile->GetData()) != DDS_MAGIC)
+        return false;
+
+    // Страницы подтягиваются с диска здесь, а не при создании текстуры в потоке кадра
+    const size_t PageSize = 4096;
+    volatile uint8_t sink = 0;
+    for (size_t offset = 0; offset < pFile->GetSize(); offset += PageSize)
+        sink = sink + pFile->GetData()[offset];
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef D3D11_TEXTURE_LOADER_H
+#define D3D11_TEXTURE_LOADER_H
+
+#include <d3d11.h>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AsyncLoader.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "TextureArrayBuilder.h"
+#include "WICTextureLoader.h"
+
+// Асинхронная загрузка текстур. Load* сразу кладёт в *ppView заглушку 1x1 и ставит
+// чтение, декодирование и построение мипов в фоновый пул; Update в потоке кадра создаёт
+// неизменяемые ресурсы сразу со всеми мипами и подменяет заглушку. Владелец *ppView - вызывающий.
+class D3D11TextureLoader
+{
+public:
+    D3D11TextureLoader() :
+        m_pDevice(nullptr),
+        m_loaded(0),
+        m_failed(0)
+    {
+    }
+
+    // threadCount = 0 - по числу логических ядер
+    bool Init(ID3D11Device* pDevice, uint32_t threadCount);
+    // Незавершённые загрузки отменяются, заглушки остаются на месте
+    void Terminate();
+
+    // Массив текстур (Texture2DArray) из любого числа картинок: каждая приводится к width x height;
+    // srgb - цвет в слоях хранится в sRGB
+    HRESULT LoadArray(const std::vector<std::wstring>& files, uint32_t width, uint32_t height, bool srgb,
+        uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView);
+    // Кубическая карта из развёртки-креста 4x3
+    HRESULT LoadCubeCross(const std::wstring& file, uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView);
+    // DDS как есть; заглушка - Texture2D
+    HRESULT LoadDDS(const std::wstring& file, uint32_t placeholderRGBA, ID3D11ShaderResourceView** ppView);
+
+    // Создаёт не больше maxCreates текстур из готовых картинок; возвращает число подменённых видов
+    uint32_t Update(uint32_t maxCreates);
+
+    // Запросы, для которых текстура ещё не создана
+    uint32_t GetPending() const { return static_cast<uint32_t>(m_requests.size()); }
+    uint32_t GetLoaded() const { return m_loaded; }
+    uint32_t GetFailed() const { return m_failed; }
+
+private:
+    enum class RequestKind
+    {
+        Array,
+        CubeCross,
+        DDS
+    };
+
+    // Рабочие потоки пишут только свой элемент images/mips/слой arrayBuilder/ddsFile,
+    // поток кадра читает их после получения завершения из AsyncLoader
+    struct Request
+    {
+        RequestKind kind;
+        ID3D11ShaderResourceView** ppView;
+        std::vector<std::wstring> files;
+        std::vector<DirectX::WICImage> images;
+        // Цепочки мипов граней креста
+        std::vector<MipGenerator> mips;
+        TextureArrayBuilder arrayBuilder;
+        std::unique_ptr<MappedFile> ddsFile;
+        uint32_t remaining;
+        bool failed;
+    };
+
+    struct JobRef
+    {
+        Request* pRequest;
+        uint32_t slice;
+    };
+
+    HRESULT CreatePlaceholder(RequestKind kind, uint32_t arraySize, uint32_t rgba, ID3D11ShaderResourceView** ppView);
+    HRESULT Submit(std::unique_ptr<Request> request);
+    HRESULT CreateArray(Request& request, ID3D11ShaderResourceView** ppView);
+    HRESULT CreateCube(Request& request, ID3D11ShaderResourceView** ppView);
+    HRESULT CreateDDS(Request& request, ID3D11ShaderResourceView** ppView);
+    void Finish(Request* pRequest);
+
+    static bool DecodeImage(const std::wstring& file, DirectX::WICImage* pImage);
+    static bool BuildMips(Request* pRequest, uint32_t slice);
+    static const uint8_t* GetCrossFace(const DirectX::WICImage& image, uint32_t face);
+    static bool MapDDS(const std::wstring& file, MappedFile* pFile);
+
+    ID3D11Device* m_pDevice;
+    AsyncLoader m_async;
+    std::vector<std::unique_ptr<Request>> m_requests;
+    std::unordered_map<uint32_t, JobRef> m_jobs;
+    std::deque<Request*> m_ready;
+    std::vector<AsyncLoader::Completion> m_completions;
+    uint32_t m_loaded;
+    uint32_t m_failed;
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "framework.h"
+#include "D3D11TextureStreamer.h"
+#include "LoaderHelpers.h"
+
+using namespace DirectX;
+
+namespace
+{
+    UINT MipSize(UINT size, uint32_t mip)
+    {
+        return (size >> mip) ? (size >> mip) : 1;
+    }
+}
+
+bool D3D11TextureStreamer::Init(ID3D11Device* pDevice, uint32_t threadCount) {
+    Terminate();
+    m_pDevice = pDevice;
+    m_uploadedBytes = 0;
+    m_reallocations = 0;
+    return m_async.Init(threadCount);
+}
+
+void D3D11TextureStreamer::Terminate() {
+    // Задачи читают отображения файлов - сначала останавливаем потоки
+    m_async.Terminate();
+    m_fetches.clear();
+    for (Texture& texture : m_textures) {
+        if (texture.pTexture)
+            texture.pTexture->Release();
+    }
+    m_textures.clear();
+    m_streamer.Clear();
+    m_pDevice = nullptr;
+}
+
+HRESULT D3D11TextureStreamer::Add(const std::wstring& file, uint32_t tailSize, ID3D11ShaderResourceView** ppView, uint32_t* pTexture) {
+    if (!m_pDevice || !ppView)
+        return E_INVALIDARG;
+
+    Texture texture = {};
+    texture.file = file;
+    texture.ddsFile.reset(new MappedFile());
+    texture.ppView = ppView;
+
+    const DDS_HEADER* header = nullptr;
+    const uint8_t* bitData = nullptr;
+    size_t bitSize = 0;
+    HRESULT hr = LoaderHelpers::LoadTextureDataFromMappedFile(file.c_str(), *texture.ddsFile, &header, &bitData, &bitSize);
+    if (FAILED(hr))
+        return hr;
+
+    if ((header->flags & DDS_HEADER_FLAGS_VOLUME) || (header->caps2 & DDS_CUBEMAP))
+        return E_NOTIMPL;
+
+    if ((header->ddspf.flags & DDS_FOURCC) && MAKEFOURCC('D', 'X', '1', '0') == header->ddspf.fourCC) {
+        auto d3d10ext = reinterpret_cast<const DDS_HEADER_DXT10*>(reinterpret_cast<const uint8_t*>(header) + sizeof(DDS_HEADER));
+        if (d3d10ext->resourceDimension != DDS_DIMENSION_TEXTURE2D || d3d10ext->arraySize != 1 ||
+            (d3d10ext->miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE))
+            return E_NOTIMPL;
+        texture.format = d3d10ext->dxgiFormat;
+    } else {
+        texture.format = LoaderHelpers::GetDXGIFormat(header->ddspf);
+    }
+    if (texture.format == DXGI_FORMAT_UNKNOWN || LoaderHelpers::BitsPerPixel(texture.format) == 0)
+        return E_NOTIMPL;
+
+    texture.width = header->width;
+    texture.height = header->height;
+    uint32_t mipCount = header->mipMapCount ? header->mipMapCount : 1;
+    if (mipCount > TextureStreamer::MaxMips || mipCount > D3D11_REQ_MIP_LEVELS)
+        return E_NOTIMPL;
+
+    texture.mips.resize(mipCount);
+    size_t width = 0;
+    size_t height = 0;
+    size_t depth = 0;
+    size_t skipMip = 0;
+    hr = LoaderHelpers::FillInitData(texture.width, texture.height, 1, mipCount, 1, texture.format, 0, bitSize, bitData,
+        width, height, depth, skipMip, texture.mips.data());
+    if (FAILED(hr))
+        return hr;
+
+    // Хвост - с первого мипа не больше tailSize; у сжатых форматов верхний мип хвоста
+    // должен делиться на блоки 4x4
+    const bool compressed = LoaderHelpers::IsCompressed(texture.format);
+    uint32_t tailMip = 0;
+    while (tailMip + 1 < mipCount && (MipSize(texture.width, tailMip) > tailSize || MipSize(texture.height, tailMip) > tailSize))
+        ++tailMip;
+    while (compressed && tailMip > 0 && (((texture.width >> tailMip) % 4) || ((texture.height >> tailMip) % 4)))
+        --tailMip;
+
+    uint64_t mipBytes[TextureStreamer::MaxMips] = {};
+    for (uint32_t i = 0; i < mipCount; ++i)
+        mipBytes[i] = texture.mips[i].SysMemSlicePitch;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = MipSize(texture.width, tailMip);
+    desc.Height = MipSize(texture.height, tailMip);
+    desc.MipLevels = mipCount - tailMip;
+    desc.ArraySize = 1;
+    desc.Format = texture.format;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    hr = m_pDevice->CreateTexture2D(&desc, texture.mips.data() + tailMip, &texture.pTexture);
+    if (FAILED(hr))
+        return hr;
+
+    ID3D11ShaderResourceView* pView = nullptr;
+    hr = CreateView(texture, texture.pTexture, &pView);
+    if (FAILED(hr)) {
+        texture.pTexture->Release();
+        return hr;
+    }
+    if (*ppView)
+        (*ppView)->Release();
+    *ppView = pView;
+
+    uint32_t index = m_streamer.Add(mipBytes, mipCount, tailMip);
+    m_textures.push_back(std::move(texture));
+    if (pTexture)
+        *pTexture = index;
+    return S_OK;
+}
+
+void D3D11TextureStreamer::SetScreenSize(uint32_t texture, float screenPixels) {
+    const Texture& data = m_textures[texture];
+    m_streamer.SetWantedMip(texture, TextureStreamer::SelectMip(data.width, data.height, m_streamer.GetTexture(texture).mipCount, screenPixels));
+}
+
+uint32_t D3D11TextureStreamer::Update(ID3D11DeviceContext* pContext, uint32_t maxFetches) {
+    if (m_textures.empty())
+        return 0;
+
+    // Прочитанные мипы - в текстуру, и открываем их для выборки
+    m_async.Collect(m_completions, m_fetches.size());
+    for (const AsyncLoader::Completion& completion : m_completions) {
+        auto it = m_fetches.find(completion.ticket);
+        if (it == m_fetches.end())
+            continue;
+
+        FetchRef fetch = it->second;
+        m_fetches.erase(it);
+        if (!m_streamer.OnFetched(fetch.texture, fetch.mip, completion.succeeded))
+            continue;
+
+        Texture& texture = m_textures[fetch.texture];
+        const D3D11_SUBRESOURCE_DATA& mip = texture.mips[fetch.mip];
+        const uint32_t allocatedMip = m_streamer.GetTexture(fetch.texture).allocatedMip;
+        pContext->UpdateSubresource(texture.pTexture, fetch.mip - allocatedMip, nullptr, mip.pSysMem, mip.SysMemPitch, mip.SysMemSlicePitch);
+        pContext->SetResourceMinLOD(texture.pTexture, static_cast<FLOAT>(fetch.mip - allocatedMip));
+        m_uploadedBytes += mip.SysMemSlicePitch;
+    }
+
+    uint32_t replaced = 0;
+    m_streamer.Plan(m_actions, maxFetches);
+    for (const TextureStreamer::Action& action : m_actions) {
+        if (action.kind == TextureStreamer::ActionKind::Reallocate) {
+            // При неудаче текстура остаётся прежней, план повторится в следующем кадре
+            if (SUCCEEDED(Reallocate(pContext, action.texture, action.mip))) {
+                m_streamer.OnReallocated(action.texture, action.mip);
+                ++m_reallocations;
+                ++replaced;
+            }
+            continue;
+        }
+
+        const D3D11_SUBRESOURCE_DATA mip = m_textures[action.texture].mips[action.mip];
+        uint32_t ticket = m_async.Submit([mip]() { return TouchPages(mip); });
+        if (ticket == 0) {
+            m_streamer.OnFetched(action.texture, action.mip, false);
+            continue;
+        }
+        m_fetches[ticket] = { action.texture, action.mip };
+    }
+    return replaced;
+}
+
+HRESULT D3D11TextureStreamer::Reallocate(ID3D11DeviceContext* pContext, uint32_t index, uint32_t allocatedMip) {
+    Texture& texture = m_textures[index];
+    const TextureStreamer::TextureState& state = m_streamer.GetTexture(index);
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    texture.pTexture->GetDesc(&desc);
+    desc.Width = MipSize(texture.width, allocatedMip);
+    desc.Height = MipSize(texture.height, allocatedMip);
+    desc.MipLevels = state.mipCount - allocatedMip;
+
+    ID3D11Texture2D* pNewTexture = nullptr;
+    HRESULT hr = m_pDevice->CreateTexture2D(&desc, nullptr, &pNewTexture);
+    if (FAILED(hr))
+        return hr;
+
+    ID3D11ShaderResourceView* pView = nullptr;
+    hr = CreateView(texture, pNewTexture, &pView);
+    if (FAILED(hr)) {
+        pNewTexture->Release();
+        return hr;
+    }
+
+    // Загруженные мипы, которые остаются, копируются на GPU без повторного чтения файла
+    const uint32_t residentMip = state.residentMip > allocatedMip ? state.residentMip : allocatedMip;
+    for (uint32_t mip = residentMip; mip < state.mipCount; ++mip)
+        pContext->CopySubresourceRegion(pNewTexture, mip - allocatedMip, 0, 0, 0, texture.pTexture, mip - state.allocatedMip, nullptr);
+    pContext->SetResourceMinLOD(pNewTexture, static_cast<FLOAT>(residentMip - allocatedMip));
+
+    texture.pTexture->Release();
+    texture.pTexture = pNewTexture;
+    if (*texture.ppView)
+        (*texture.ppView)->Release();
+    *texture.ppView = pView;
+    return S_OK;
+}
+
+HRESULT D3D11TextureStreamer::CreateView(Texture& texture, ID3D11Texture2D* pTexture, ID3D11ShaderResourceView** ppView) {
+    D3D11_SHADER_RESOURCE_VIEW_DESC desc = {};
+    desc.Format = texture.format;
+    desc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    desc.Texture2D.MipLevels = static_cast<UINT>(-1);
+    return m_pDevice->CreateShaderResourceView(pTexture, &desc, ppView);
+}
+
+bool D3D11TextureStreamer::TouchPages(const D3D11_SUBRESOURCE_DATA& mip) {
+    // Страницы мипа подтягиваются с диска здесь, а не в UpdateSubresource в потоке кадра
+    const size_t PageSize = 4096;
+    const uint8_t* pData = static_cast<const uint8_t*>(mip.pSysMem);
+    volatile uint8_t sink = 0;
+    for (size_t offset = 0; offset < mip.SysMemSlicePitch; offset += PageSize)
+        sink = sink + pData[offset];
+    if (mip.SysMemSlicePitch > 0)
+        sink = sink + pData[mip.SysMemSlicePitch - 1];
+    return true;
+}
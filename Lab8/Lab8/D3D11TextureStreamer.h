@@ -0,0 +1,87 @@
+#ifndef D3D11_TEXTURE_STREAMER_H
+#define D3D11_TEXTURE_STREAMER_H
+
+#include <d3d11.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "AsyncLoader.h"
+#include "MappedFile.h"
+#include "TextureStreamer.h"
+
+// Потоковая подгрузка мипов DDS. При добавлении в видеопамять попадает только хвост
+// (мипы не больше tailSize), остальное подтягивается из отображённого файла по мере
+// того, как текстура становится крупнее на экране. Выборка ограничивается загруженными
+// мипами через SetResourceMinLOD. Тайловых ресурсов на FL11_0 нет, поэтому расширение
+// и выселение пересоздают текстуру с другим числом мипов и копируют загруженные на GPU.
+// Владелец *ppView - вызывающий; вид подменяется при каждом пересоздании.
+class D3D11TextureStreamer
+{
+public:
+    D3D11TextureStreamer() :
+        m_pDevice(nullptr),
+        m_uploadedBytes(0),
+        m_reallocations(0)
+    {
+    }
+
+    bool Init(ID3D11Device* pDevice, uint32_t threadCount);
+    // Загрузки в полёте отменяются; виды в *ppView остаются за вызывающим
+    void Terminate();
+
+    // Только 2D DDS без массивов и кубов; для остальных - E_NOTIMPL
+    HRESULT Add(const std::wstring& file, uint32_t tailSize, ID3D11ShaderResourceView** ppView, uint32_t* pTexture);
+
+    // Размер текстуры на экране в пикселях по большей стороне
+    void SetScreenSize(uint32_t texture, float screenPixels);
+    void SetBudget(uint64_t bytes) { m_streamer.SetBudget(bytes); }
+    uint64_t GetBudget() const { return m_streamer.GetBudget(); }
+
+    // Дописывает прочитанные мипы, выполняет план и ставит не больше maxFetches чтений;
+    // возвращает число подменённых видов
+    uint32_t Update(ID3D11DeviceContext* pContext, uint32_t maxFetches);
+
+    const TextureStreamer& GetStreamer() const { return m_streamer; }
+    uint64_t GetUploadedBytes() const { return m_uploadedBytes; }
+    uint32_t GetReallocations() const { return m_reallocations; }
+
+private:
+    struct Texture
+    {
+        std::wstring file;
+        std::unique_ptr<MappedFile> ddsFile;
+        DXGI_FORMAT format;
+        uint32_t width;
+        uint32_t height;
+        // Указывают в отображение файла, по одному на мип
+        std::vector<D3D11_SUBRESOURCE_DATA> mips;
+        ID3D11Texture2D* pTexture;
+        ID3D11ShaderResourceView** ppView;
+    };
+
+    struct FetchRef
+    {
+        uint32_t texture;
+        uint32_t mip;
+    };
+
+    // Текстура с мипами [allocatedMip, mipCount); из старой копируются загруженные мипы
+    HRESULT Reallocate(ID3D11DeviceContext* pContext, uint32_t texture, uint32_t allocatedMip);
+    HRESULT CreateView(Texture& texture, ID3D11Texture2D* pTexture, ID3D11ShaderResourceView** ppView);
+
+    static bool TouchPages(const D3D11_SUBRESOURCE_DATA& mip);
+
+    ID3D11Device* m_pDevice;
+    AsyncLoader m_async;
+    TextureStreamer m_streamer;
+    std::vector<Texture> m_textures;
+    std::unordered_map<uint32_t, FetchRef> m_fetches;
+    std::vector<TextureStreamer::Action> m_actions;
+    std::vector<AsyncLoader::Completion> m_completions;
+    uint64_t m_uploadedBytes;
+    uint32_t m_reallocations;
+};
+
+#endif
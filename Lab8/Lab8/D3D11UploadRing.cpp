@@ -0,0 +1,117 @@
+#include "framework.h"
+#include "D3D11UploadRing.h"
+#include <cstring>
+
+namespace
+{
+    // Смещение и размер участка - в константах по 16 байт, кратно 16 константам (256 байт)
+    const UINT ConstantSize = 16;
+    const UINT RingAlignment = 256;
+}
+
+HRESULT D3D11UploadRing::Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, bool allowOffsets, UINT capacity) {
+    Terminate();
+    m_pDevice = pDevice;
+    m_pContext = pContext;
+
+    D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+    bool supported = allowOffsets &&
+        SUCCEEDED(m_pDevice->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+        options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+
+    if (supported) {
+        D3D11_BUFFER_DESC desc = {};
+        desc.ByteWidth = capacity;
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        HRESULT hr = m_pDevice->CreateBuffer(&desc, nullptr, &m_pRing);
+        if (FAILED(hr))
+            return hr;
+        m_allocator.Init(capacity, RingAlignment);
+        m_frameReserve = FrameReserve;
+        if (m_frameReserve > capacity)
+            m_frameReserve = capacity;
+    }
+    else {
+        m_allocator.Init(FallbackBufferSize, RingAlignment);
+    }
+    return S_OK;
+}
+
+void D3D11UploadRing::Terminate() {
+    if (m_pRing) {
+        m_pRing->Release();
+        m_pRing = nullptr;
+    }
+    for (ID3D11Buffer* pBuffer : m_fallback)
+        pBuffer->Release();
+    m_fallback.clear();
+    m_fallbackUsed = 0;
+    m_frameReserve = 0;
+    m_allocator.Reset();
+    m_pDevice = nullptr;
+    m_pContext = nullptr;
+}
+
+void D3D11UploadRing::BeginFrame() {
+    m_allocator.BeginFrame();
+    // Выделения кадра не должны пересекать оборот кольца
+    if (m_pRing)
+        m_allocator.Reserve(m_frameReserve);
+    m_fallbackUsed = 0;
+}
+
+bool D3D11UploadRing::Upload(const void* pData, UINT size, UploadAllocation* pAllocation) {
+    // Смещение прошлого кадра указывает на уже перезаписанные данные, поэтому не оставляем его
+    *pAllocation = UploadAllocation();
+    if (!m_pRing)
+        return UploadFallback(pData, size, pAllocation);
+
+    UINT offset = 0;
+    bool discard = false;
+    if (!m_allocator.Allocate(size, &offset, &discard))
+        return false;
+
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_pContext->Map(m_pRing, 0, discard ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mapped)))
+        return false;
+    memcpy(static_cast<uint8_t*>(mapped.pData) + offset, pData, size);
+    m_pContext->Unmap(m_pRing, 0);
+
+    pAllocation->pBuffer = m_pRing;
+    pAllocation->firstConstant = offset / ConstantSize;
+    pAllocation->numConstants = ((size + RingAlignment - 1) & ~(RingAlignment - 1)) / ConstantSize;
+    return true;
+}
+
+bool D3D11UploadRing::UploadFallback(const void* pData, UINT size, UploadAllocation* pAllocation) {
+    if (size == 0 || size > FallbackBufferSize)
+        return false;
+
+    // Буферы пула раздаются по порядку в течение кадра, чтобы два выделения одного вызова отрисовки не делили буфер
+    if (m_fallbackUsed == m_fallback.size()) {
+        D3D11_BUFFER_DESC desc = {};
+        desc.ByteWidth = FallbackBufferSize;
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        ID3D11Buffer* pBuffer = nullptr;
+        if (FAILED(m_pDevice->CreateBuffer(&desc, nullptr, &pBuffer)))
+            return false;
+        m_fallback.push_back(pBuffer);
+    }
+
+    ID3D11Buffer* pBuffer = m_fallback[m_fallbackUsed++];
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_pContext->Map(pBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        return false;
+    memcpy(mapped.pData, pData, size);
+    m_pContext->Unmap(pBuffer, 0);
+    m_allocator.RecordExternalUpload(size, true);
+
+    pAllocation->pBuffer = pBuffer;
+    pAllocation->firstConstant = 0;
+    pAllocation->numConstants = 0;
+    return true;
+}
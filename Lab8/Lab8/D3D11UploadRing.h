@@ -0,0 +1,59 @@
+#ifndef D3D11_UPLOAD_RING_H
+#define D3D11_UPLOAD_RING_H
+
+#include <d3d11_1.h>
+#include <vector>
+#include "UploadRing.h"
+
+// Участок константных данных для привязки: при numConstants != 0 - через *SetConstantBuffers1
+struct UploadAllocation
+{
+    ID3D11Buffer* pBuffer;
+    UINT firstConstant;
+    UINT numConstants;
+};
+
+// Кольцо константных данных на D3D11: один большой DYNAMIC-буфер, запись с WRITE_NO_OVERWRITE
+// и привязка участков по смещению (D3D11.1 ConstantBufferOffsetting).
+// Без поддержки смещений каждое выделение получает свой маленький буфер с WRITE_DISCARD, как раньше.
+class D3D11UploadRing
+{
+public:
+    static const UINT DefaultCapacity = 1024 * 1024;
+    static const UINT FallbackBufferSize = 4096;
+    // Худший случай констант за кадр: на столько кольцо освобождается в BeginFrame
+    static const UINT FrameReserve = 64 * 1024;
+
+    D3D11UploadRing() :
+        m_pDevice(nullptr),
+        m_pContext(nullptr),
+        m_pRing(nullptr),
+        m_fallbackUsed(0),
+        m_frameReserve(0)
+    {
+    }
+
+    HRESULT Init(ID3D11Device* pDevice, ID3D11DeviceContext* pContext, bool allowOffsets, UINT capacity = DefaultCapacity);
+    void Terminate();
+
+    void BeginFrame();
+    // При неудаче *pAllocation обнуляется: pBuffer == nullptr, привязывать нечего
+    bool Upload(const void* pData, UINT size, UploadAllocation* pAllocation);
+
+    bool UsesOffsets() const { return m_pRing != nullptr; }
+    UploadRingAllocator& GetAllocator() { return m_allocator; }
+    const UploadRingAllocator& GetAllocator() const { return m_allocator; }
+
+private:
+    bool UploadFallback(const void* pData, UINT size, UploadAllocation* pAllocation);
+
+    ID3D11Device* m_pDevice;
+    ID3D11DeviceContext* m_pContext;
+    ID3D11Buffer* m_pRing;
+    UploadRingAllocator m_allocator;
+    std::vector<ID3D11Buffer*> m_fallback;
+    size_t m_fallbackUsed;
+    UINT m_frameReserve;
+};
+
+#endif
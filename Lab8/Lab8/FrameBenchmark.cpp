@@ -0,0 +1,405 @@
+#include "FrameBenchmark.h"
+#include "FrameProfiler.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "SceneFrame.h"
+#include "Simulation.h"
+#include "UploadRing.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+    const float Pi2 = 6.283185307f;
+    const uint32_t MaterialCount = 2;
+
+    struct Float3
+    {
+        float x, y, z;
+    };
+
+    Float3 Subtract(Float3 a, Float3 b) { return Float3{ a.x - b.x, a.y - b.y, a.z - b.z }; }
+    float Dot(Float3 a, Float3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+    Float3 Cross(Float3 a, Float3 b) { return Float3{ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+    Float3 Normalize(Float3 v) {
+        float length = sqrtf(Dot(v, v));
+        return length > 0.0f ? Float3{ v.x / length, v.y / length, v.z / length } : v;
+    }
+
+    void Multiply(const float a[16], const float b[16], float out[16]) {
+        for (int r = 0; r < 4; ++r) {
+            for (int c = 0; c < 4; ++c) {
+                out[r * 4 + c] = a[r * 4 + 0] * b[0 * 4 + c] + a[r * 4 + 1] * b[1 * 4 + c] +
+                    a[r * 4 + 2] * b[2 * 4 + c] + a[r * 4 + 3] * b[3 * 4 + c];
+            }
+        }
+    }
+
+    // Те же формулы, что у XMMatrixLookAtLH и XMMatrixPerspectiveFovLH
+    void LookAtLH(Float3 eye, Float3 focus, Float3 up, float out[16]) {
+        Float3 z = Normalize(Subtract(focus, eye));
+        Float3 x = Normalize(Cross(up, z));
+        Float3 y = Cross(z, x);
+        const float view[16] = {
+            x.x, y.x, z.x, 0.0f,
+            x.y, y.y, z.y, 0.0f,
+            x.z, y.z, z.z, 0.0f,
+            -Dot(x, eye), -Dot(y, eye), -Dot(z, eye), 1.0f
+        };
+        memcpy(out, view, sizeof(view));
+    }
+
+    void PerspectiveFovLH(float fov, float aspect, float nearZ, float farZ, float out[16]) {
+        float h = 1.0f / tanf(fov * 0.5f);
+        float w = h / aspect;
+        float range = farZ / (farZ - nearZ);
+        const float proj[16] = {
+            w, 0.0f, 0.0f, 0.0f,
+            0.0f, h, 0.0f, 0.0f,
+            0.0f, 0.0f, range, 1.0f,
+            0.0f, 0.0f, -range * nearZ, 0.0f
+        };
+        memcpy(out, proj, sizeof(proj));
+    }
+
+    // Нулевое устройство: кольцо загрузки пишет в обычную память
+    class NullUploadBuffer
+    {
+    public:
+        bool Init(uint32_t capacity) {
+            m_memory.assign(capacity, 0);
+            return m_allocator.Init(capacity, 256);
+        }
+
+        // Как D3D11UploadRing::BeginFrame: кольцо оборачивается только между кадрами
+        void BeginFrame() {
+            m_allocator.BeginFrame();
+            m_allocator.Reserve(FrameReserve);
+        }
+
+        void Upload(const void* pData, uint32_t size) {
+            uint32_t offset = 0;
+            bool discard = false;
+            if (m_allocator.Allocate(size, &offset, &discard))
+                memcpy(m_memory.data() + offset, pData, size);
+        }
+
+        UploadRingAllocator& GetAllocator() { return m_allocator; }
+
+    private:
+        static const uint32_t FrameReserve = 64 * 1024;
+
+        UploadRingAllocator m_allocator;
+        std::vector<uint8_t> m_memory;
+    };
+
+    double Percentile(const std::vector<float>& sorted, double percent) {
+        if (sorted.empty())
+            return 0.0;
+        // Ранговый метод: наименьшее значение, не меньше которого percent% выборки
+        size_t rank = static_cast<size_t>(ceil(percent / 100.0 * sorted.size()));
+        return sorted[rank > 0 ? rank - 1 : 0];
+    }
+
+    FrameBenchmarkTiming MakeTiming(const char* name, std::vector<float>& values, float mean) {
+        std::sort(values.begin(), values.end());
+        FrameBenchmarkTiming timing = {};
+        timing.name = name;
+        timing.meanMs = mean;
+        timing.p50Ms = Percentile(values, 50.0);
+        timing.p95Ms = Percentile(values, 95.0);
+        timing.p99Ms = Percentile(values, 99.0);
+        timing.maxMs = values.empty() ? 0.0 : values.back();
+        return timing;
+    }
+
+    uint64_t HashBytes(uint64_t hash, const void* pData, size_t size) {
+        const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= pBytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    // Кадр RenderClass без устройства: те же стадии SceneFrame, камера по сценарию, загрузки в память
+    class FrameSimulation
+    {
+    public:
+        explicit FrameSimulation(const FrameBenchmarkConfig& config) :
+            m_config(config),
+            m_visibleTotal(0),
+            m_checksum(0)
+        {
+            m_animation.Reset();
+            ResetCounters();
+        }
+
+        bool Init() {
+            m_scene.Generate(m_config.instanceCount, MaterialCount);
+            m_gpuInstances.resize(m_scene.GetCount());
+            m_models.resize(m_scene.GetCount() + SceneFrame::LightCount);
+            m_visibleIds.reserve(m_scene.GetCount());
+            return m_jobs.Init(m_config.threadCount) && m_constants.Init(1024 * 1024);
+        }
+
+        void Terminate() { m_jobs.Terminate(); }
+
+        void RunFrame(uint32_t frame, FrameProfiler& profiler) {
+            profiler.BeginFrame();
+            m_constants.BeginFrame();
+            // Ровно один шаг анимации на кадр: результат не зависит от того, как быстро идут кадры
+            m_animation.Step();
+
+            float eye[3];
+            {
+                ProfileScope scope(profiler, "Camera");
+                UpdateCamera(frame, eye);
+            }
+
+            ScenePointLight lights[SceneFrame::LightCount];
+            {
+                ProfileScope scope(profiler, "Lights");
+                UpdateLights(lights);
+            }
+
+            size_t visible;
+            {
+                ProfileScope scope(profiler, "Instances");
+                visible = m_scene.Update(m_jobs, m_animation.cubeAngle, m_gpuInstances.data(), true, m_visibleIds);
+            }
+
+            {
+                ProfileScope scope(profiler, "Gather");
+                // Как в RenderClass::PrepareCubes: маркеры источников лежат в хвосте буфера экземпляров
+                m_scene.Gather(m_visibleIds.data(), visible, m_models.data());
+                for (uint32_t i = 0; i < SceneFrame::LightCount; ++i)
+                    SceneFrame::BuildLightModel(lights[i], m_models[m_scene.GetCount() + i]);
+                m_constants.GetAllocator().RecordExternalUpload(sizeof(SceneInstance) * (visible + SceneFrame::LightCount), true);
+            }
+
+            {
+                ProfileScope scope(profiler, "Sort");
+                SceneParallelogram parallelograms[SceneFrame::ParallelogramCount];
+                SceneFrame::BuildParallelograms(m_animation.parallelogramTime, eye, parallelograms);
+                for (const SceneParallelogram& parallelogram : parallelograms) {
+                    m_constants.Upload(parallelogram.model, sizeof(parallelogram.model));
+                    m_constants.Upload(parallelogram.color, sizeof(parallelogram.color));
+                }
+            }
+
+            profiler.EndFrame();
+
+            m_visibleTotal += visible;
+            m_checksum = HashBytes(m_checksum, &visible, sizeof(visible));
+            m_checksum = HashBytes(m_checksum, m_visibleIds.data(), sizeof(uint32_t) * visible);
+        }
+
+        void ResetCounters() {
+            m_visibleTotal = 0;
+            m_checksum = 14695981039346656037ull;
+            m_constants.GetAllocator().Reset();
+        }
+
+        uint64_t GetVisibleTotal() const { return m_visibleTotal; }
+        uint64_t GetChecksum() const { return m_checksum; }
+        uint64_t GetUploadBytes() { return m_constants.GetAllocator().GetTotalBytes(); }
+
+    private:
+        void UpdateCamera(uint32_t frame, float eyeOut[3]) {
+            // Положение камеры - функция номера кадра, поэтому прогон повторяется точно
+            float t = m_config.frameCount > 0 ? static_cast<float>(frame % m_config.frameCount) / m_config.frameCount : 0.0f;
+            float radius = m_scene.GetRadius() > 10.0f ? m_scene.GetRadius() : 10.0f;
+            Float3 eye = { 0.0f, 1.5f, -10.0f };
+            Float3 focus = { 0.0f, 1.5f, 0.0f };
+            switch (m_config.path) {
+            case CameraPath::Orbit:
+                eye = Float3{ radius * cosf(Pi2 * t), 3.0f, radius * sinf(Pi2 * t) };
+                focus = Float3{ 0.0f, 0.0f, 0.0f };
+                break;
+            case CameraPath::FlyThrough:
+                eye = Float3{ 0.0f, 1.5f, -radius + 2.0f * radius * t };
+                focus = Float3{ sinf(Pi2 * t), 1.5f, eye.z + 1.0f };
+                break;
+            default:
+                break;
+            }
+
+            float view[16], proj[16], vp[16];
+            LookAtLH(eye, focus, Float3{ 0.0f, 1.0f, 0.0f }, view);
+            PerspectiveFovLH(Pi2 / 8.0f, m_config.aspect, 0.1f, 100.0f, proj);
+            Multiply(view, proj, vp);
+
+            float planes[6][4];
+            SceneFrame::ExtractFrustumPlanes(vp, planes);
+            m_scene.GetCuller().SetPlanes(planes);
+
+            // Камера кадра и небо, как в PrepareCubes и PrepareSkybox
+            float constants[20];
+            SceneFrame::Transpose(vp, constants);
+            constants[16] = eye.x;
+            constants[17] = eye.y;
+            constants[18] = eye.z;
+            constants[19] = 0.0f;
+            m_constants.Upload(constants, sizeof(constants));
+            m_constants.Upload(constants, sizeof(float) * 16);
+            eyeOut[0] = eye.x;
+            eyeOut[1] = eye.y;
+            eyeOut[2] = eye.z;
+        }
+
+        void UpdateLights(ScenePointLight lights[SceneFrame::LightCount]) {
+            SceneFrame::BuildLights(m_animation.lightOrbit, lights);
+            m_constants.Upload(lights, sizeof(ScenePointLight) * SceneFrame::LightCount);
+            for (uint32_t i = 0; i < SceneFrame::LightCount; ++i) {
+                float color[4] = { lights[i].color[0], lights[i].color[1], lights[i].color[2], 1.0f };
+                m_constants.Upload(color, sizeof(color));
+            }
+        }
+
+        FrameBenchmarkConfig m_config;
+        SceneFrame m_scene;
+        std::vector<SceneInstance> m_gpuInstances;
+        std::vector<SceneInstance> m_models;
+        std::vector<uint32_t> m_visibleIds;
+        JobSystem m_jobs;
+        NullUploadBuffer m_constants;
+        AnimationState m_animation;
+        uint64_t m_visibleTotal;
+        uint64_t m_checksum;
+    };
+
+    void WriteTimingCsv(std::ofstream& file, const FrameBenchmarkResult& result, const FrameBenchmarkTiming& timing) {
+        file << GetCameraPathName(result.config.path) << ','
+            << result.config.instanceCount << ','
+            << result.config.frameCount << ','
+            << result.config.threadCount << ','
+            << timing.name << ','
+            << timing.meanMs << ','
+            << timing.p50Ms << ','
+            << timing.p95Ms << ','
+            << timing.p99Ms << ','
+            << timing.maxMs << '\n';
+    }
+
+    void WriteTimingJson(std::ofstream& file, const FrameBenchmarkTiming& timing) {
+        file << "{ \"name\": \"" << timing.name << "\""
+            << ", \"mean_ms\": " << timing.meanMs
+            << ", \"p50_ms\": " << timing.p50Ms
+            << ", \"p95_ms\": " << timing.p95Ms
+            << ", \"p99_ms\": " << timing.p99Ms
+            << ", \"max_ms\": " << timing.maxMs << " }";
+    }
+}
+
+const char* GetCameraPathName(CameraPath path) {
+    switch (path) {
+    case CameraPath::Orbit:
+        return "orbit";
+    case CameraPath::FlyThrough:
+        return "flythrough";
+    default:
+        return "static";
+    }
+}
+
+bool ParseCameraPath(const char* name, CameraPath* pPath) {
+    const CameraPath paths[] = { CameraPath::Static, CameraPath::Orbit, CameraPath::FlyThrough };
+    for (CameraPath path : paths) {
+        if (strcmp(name, GetCameraPathName(path)) == 0) {
+            *pPath = path;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool RunFrameBenchmark(const FrameBenchmarkConfig& config, FrameBenchmarkResult& result) {
+    if (config.instanceCount == 0 || config.frameCount == 0 || config.aspect <= 0.0f)
+        return false;
+
+    FrameSimulation simulation(config);
+    if (!simulation.Init())
+        return false;
+
+    // Прогрев идёт до Init профилировщика: участки вне кадра не записываются
+    FrameProfiler profiler;
+    for (uint32_t frame = 0; frame < config.warmupFrames; ++frame)
+        simulation.RunFrame(frame, profiler);
+    simulation.ResetCounters();
+
+    if (!profiler.Init(nullptr, 0, config.frameCount)) {
+        simulation.Terminate();
+        return false;
+    }
+    for (uint32_t frame = 0; frame < config.frameCount; ++frame)
+        simulation.RunFrame(frame, profiler);
+
+    result.config = config;
+    std::vector<float> values;
+    float mean = profiler.GetHistory(FrameProfiler::MaxScopes, false, values);
+    result.frame = MakeTiming("Frame", values, mean);
+
+    result.passes.clear();
+    for (uint32_t scope = 0; scope < profiler.GetScopeCount(); ++scope) {
+        mean = profiler.GetHistory(scope, false, values);
+        result.passes.push_back(MakeTiming(profiler.GetScopeName(scope), values, mean));
+    }
+
+    result.visibleTotal = simulation.GetVisibleTotal();
+    result.uploadBytes = simulation.GetUploadBytes();
+    result.checksum = simulation.GetChecksum();
+    simulation.Terminate();
+    return true;
+}
+
+bool WriteFrameBenchmarkCsv(const char* path, const std::vector<FrameBenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "path,instances,frames,threads,pass,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n";
+    file << std::fixed << std::setprecision(4);
+    for (const FrameBenchmarkResult& result : results) {
+        WriteTimingCsv(file, result, result.frame);
+        for (const FrameBenchmarkTiming& pass : result.passes)
+            WriteTimingCsv(file, result, pass);
+    }
+    return static_cast<bool>(file);
+}
+
+bool WriteFrameBenchmarkJson(const char* path, const std::vector<FrameBenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n  \"runs\": [";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const FrameBenchmarkResult& result = results[i];
+        file << (i == 0 ? "\n" : ",\n");
+        file << "    {\n"
+            << "      \"path\": \"" << GetCameraPathName(result.config.path) << "\",\n"
+            << "      \"instances\": " << result.config.instanceCount << ",\n"
+            << "      \"frames\": " << result.config.frameCount << ",\n"
+            << "      \"warmup_frames\": " << result.config.warmupFrames << ",\n"
+            << "      \"threads\": " << result.config.threadCount << ",\n"
+            << "      \"visible_total\": " << result.visibleTotal << ",\n"
+            << "      \"upload_bytes\": " << result.uploadBytes << ",\n"
+            << "      \"checksum\": \"" << std::hex << result.checksum << std::dec << "\",\n"
+            << "      \"frame\": ";
+        WriteTimingJson(file, result.frame);
+        file << ",\n      \"passes\": [";
+        for (size_t p = 0; p < result.passes.size(); ++p) {
+            file << (p == 0 ? "\n        " : ",\n        ");
+            WriteTimingJson(file, result.passes[p]);
+        }
+        file << "\n      ]\n    }";
+    }
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
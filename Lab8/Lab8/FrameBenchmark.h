@@ -0,0 +1,58 @@
+#ifndef FRAME_BENCHMARK_H
+#define FRAME_BENCHMARK_H
+
+#include <cstdint>
+#include <vector>
+
+// Прогон CPU-части кадра RenderClass без окна и без GPU: камера по сценарию, а свет, пересборка
+// матриц с отсечением, сборка видимых экземпляров и сортировка прозрачных параллелограммов -
+// те же стадии SceneFrame, что вызывает RenderClass.
+// Вместо устройства - нулевой бэкенд: загрузки пишутся в память через UploadRingAllocator,
+// GPU-время не меряется. Прогон детерминирован: камера зависит только от номера кадра,
+// сцена - только от числа кубов. Не зависит от Win32 и D3D11.
+enum class CameraPath
+{
+    Static,
+    Orbit,
+    FlyThrough
+};
+
+struct FrameBenchmarkConfig
+{
+    uint32_t instanceCount;
+    uint32_t frameCount;
+    uint32_t warmupFrames;
+    uint32_t threadCount;   // 0 - по числу логических ядер
+    CameraPath path;
+    float aspect;
+};
+
+struct FrameBenchmarkTiming
+{
+    const char* name;
+    double meanMs;
+    double p50Ms;
+    double p95Ms;
+    double p99Ms;
+    double maxMs;
+};
+
+struct FrameBenchmarkResult
+{
+    FrameBenchmarkConfig config;
+    FrameBenchmarkTiming frame;
+    std::vector<FrameBenchmarkTiming> passes;
+    uint64_t visibleTotal;
+    uint64_t uploadBytes;
+    // Хеш списков видимых объектов по всем кадрам: совпадает между прогонами и при любом числе потоков
+    uint64_t checksum;
+};
+
+const char* GetCameraPathName(CameraPath path);
+bool ParseCameraPath(const char* name, CameraPath* pPath);
+
+bool RunFrameBenchmark(const FrameBenchmarkConfig& config, FrameBenchmarkResult& result);
+bool WriteFrameBenchmarkJson(const char* path, const std::vector<FrameBenchmarkResult>& results);
+bool WriteFrameBenchmarkCsv(const char* path, const std::vector<FrameBenchmarkResult>& results);
+
+#endif
@@ -0,0 +1,74 @@
+#include "FrameBenchmark.h"
+#include "CommandLine.h"
+#include <cstdio>
+
+// Замер кадра без Win32: framebench [instances N] [frames N] [threads N] [path static|orbit|flythrough].
+// Те же параметры и файлы результатов, что у Lab8.exe benchframes; собирается CMakeLists.txt рядом.
+namespace
+{
+    const CommandLineOption Options[] = {
+        { "instances", OptionValue::Uint, nullptr },
+        { "frames", OptionValue::Uint, nullptr },
+        { "threads", OptionValue::Uint, nullptr },
+        { "path", OptionValue::Text, "static|orbit|flythrough" }
+    };
+    const size_t OptionCount = sizeof(Options) / sizeof(Options[0]);
+}
+
+int main(int argc, char** argv) {
+    CommandLine commandLine;
+    if (!commandLine.Parse(argc, argv, Options, OptionCount)) {
+        FILE* pOut = commandLine.HelpRequested() ? stdout : stderr;
+        if (!commandLine.HelpRequested())
+            fprintf(pOut, "%s\n", commandLine.GetError().c_str());
+        fprintf(pOut, "Usage: framebench %s\n", CommandLine::GetUsage(Options, OptionCount).c_str());
+        return commandLine.HelpRequested() ? 0 : 1;
+    }
+
+    // Без явного числа кубов и сценария - сетка из трёх размеров сцены по двум сценариям
+    std::vector<uint32_t> counts = { 10000, 100000, 1000000 };
+    if (commandLine.Has("instances"))
+        counts.assign(1, commandLine.GetUint("instances", 23));
+
+    std::vector<CameraPath> paths = { CameraPath::Orbit, CameraPath::FlyThrough };
+    const char* pathOption = commandLine.GetText("path");
+    if (pathOption) {
+        CameraPath path;
+        if (!ParseCameraPath(pathOption, &path)) {
+            fprintf(stderr, "Unknown camera path: %s\n", pathOption);
+            return 1;
+        }
+        paths.assign(1, path);
+    }
+
+    FrameBenchmarkConfig config = {};
+    config.frameCount = commandLine.GetUint("frames", 600);
+    config.warmupFrames = 60;
+    config.threadCount = commandLine.GetUint("threads", 0);
+    config.aspect = 16.0f / 9.0f;
+
+    std::vector<FrameBenchmarkResult> results;
+    for (CameraPath path : paths) {
+        for (uint32_t count : counts) {
+            config.instanceCount = count;
+            config.path = path;
+
+            FrameBenchmarkResult result;
+            if (!RunFrameBenchmark(config, result)) {
+                fprintf(stderr, "Frame benchmark failed\n");
+                return 1;
+            }
+            results.push_back(result);
+
+            printf("%s, %u cubes: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, checksum %016llx\n",
+                GetCameraPathName(path), count, result.frame.p50Ms, result.frame.p95Ms, result.frame.p99Ms,
+                static_cast<unsigned long long>(result.checksum));
+        }
+    }
+
+    if (!WriteFrameBenchmarkJson("frame_benchmark.json", results) || !WriteFrameBenchmarkCsv("frame_benchmark.csv", results)) {
+        fprintf(stderr, "Failed to write frame benchmark results\n");
+        return 1;
+    }
+    return 0;
+}
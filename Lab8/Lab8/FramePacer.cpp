@@ -0,0 +1,111 @@
+#include "FramePacer.h"
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    int64_t SteadyNanoseconds() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+SteadyFrameClock::SteadyFrameClock() :
+    m_origin(SteadyNanoseconds())
+{
+}
+
+double SteadyFrameClock::Now() {
+    return (SteadyNanoseconds() - m_origin) * 1e-9;
+}
+
+void SteadyFrameClock::SleepUntil(double seconds) {
+    const double spinSeconds = 0.002;
+    double remaining = seconds - Now();
+    if (remaining > spinSeconds)
+        std::this_thread::sleep_for(std::chrono::duration<double>(remaining - spinSeconds));
+    while (Now() < seconds)
+        std::this_thread::yield();
+}
+
+void MockFrameClock::SleepUntil(double seconds) {
+    ++m_sleepCount;
+    if (seconds > m_now)
+        m_now = seconds;
+    m_now += m_oversleep;
+}
+
+bool MockFrameWaiter::WaitForFrame(uint32_t timeoutMs) {
+    ++m_waitCount;
+    m_lastTimeoutMs = timeoutMs;
+    if (!m_signaled) {
+        m_pClock->Advance(timeoutMs * 0.001);
+        return false;
+    }
+    m_pClock->Advance(m_delay);
+    return true;
+}
+
+FramePacer::FramePacer() :
+    m_pClock(nullptr),
+    m_pWaiter(nullptr),
+    m_mode(PresentMode::VSync),
+    m_frameCap(60),
+    m_nextDeadline(0.0),
+    m_lastFrameStart(0.0),
+    m_hasDeadline(false),
+    m_stats{}
+{
+}
+
+void FramePacer::Init(IFrameClock* pClock, IFrameWaiter* pWaiter) {
+    m_pClock = pClock;
+    m_pWaiter = pWaiter;
+    m_hasDeadline = false;
+    m_stats = Stats{};
+    m_lastFrameStart = m_pClock ? m_pClock->Now() : 0.0;
+}
+
+void FramePacer::SetMode(PresentMode mode) {
+    if (mode != m_mode)
+        m_hasDeadline = false;
+    m_mode = mode;
+}
+
+void FramePacer::SetFrameCap(uint32_t framesPerSecond) {
+    if (framesPerSecond != m_frameCap)
+        m_hasDeadline = false;
+    m_frameCap = framesPerSecond;
+}
+
+void FramePacer::BeginFrame() {
+    if (!m_pClock)
+        return;
+
+    double waitStart = m_pClock->Now();
+
+    // Цепочка обмена сигналит, когда в очереди меньше максимальной задержки кадров:
+    // ввод читается как можно ближе к показу кадра
+    if (m_pWaiter && !m_pWaiter->WaitForFrame(WaitTimeoutMs))
+        ++m_stats.waitTimeouts;
+
+    if (m_mode == PresentMode::Capped && m_frameCap > 0) {
+        double period = 1.0 / m_frameCap;
+        double now = m_pClock->Now();
+        if (!m_hasDeadline || now > m_nextDeadline + period) {
+            if (m_hasDeadline)
+                ++m_stats.missedDeadlines;
+            m_nextDeadline = now;
+            m_hasDeadline = true;
+        }
+        else if (now < m_nextDeadline) {
+            m_pClock->SleepUntil(m_nextDeadline);
+        }
+        m_nextDeadline += period;
+    }
+
+    double frameStart = m_pClock->Now();
+    m_stats.lastWaitMs = (frameStart - waitStart) * 1000.0;
+    m_stats.lastIntervalMs = (frameStart - m_lastFrameStart) * 1000.0;
+    m_lastFrameStart = frameStart;
+    ++m_stats.frames;
+}
@@ -0,0 +1,143 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <cstdint>
+
+// Источник времени для темпа кадров; в проверках подменяется искусственными часами
+class IFrameClock
+{
+public:
+    virtual ~IFrameClock() = default;
+
+    virtual double Now() = 0;
+    virtual void SleepUntil(double seconds) = 0;
+};
+
+// Ожидание, пока цепочка обмена готова принять новый кадр (объект ожидания DXGI)
+class IFrameWaiter
+{
+public:
+    virtual ~IFrameWaiter() = default;
+
+    // false - истёк таймаут
+    virtual bool WaitForFrame(uint32_t timeoutMs) = 0;
+};
+
+// Часы на std::chrono::steady_clock: сон с запасом, последние 2 мс - активное ожидание
+class SteadyFrameClock : public IFrameClock
+{
+public:
+    SteadyFrameClock();
+
+    double Now() override;
+    void SleepUntil(double seconds) override;
+
+private:
+    int64_t m_origin;
+};
+
+// Искусственные часы: время идёт только через Advance и SleepUntil. Сон может
+// просыпать срок на oversleep секунд, как таймер системы.
+class MockFrameClock : public IFrameClock
+{
+public:
+    explicit MockFrameClock(double oversleep = 0.0) :
+        m_now(0.0),
+        m_oversleep(oversleep),
+        m_sleepCount(0)
+    {
+    }
+
+    void Advance(double seconds) { m_now += seconds; }
+    uint32_t GetSleepCount() const { return m_sleepCount; }
+
+    double Now() override { return m_now; }
+    void SleepUntil(double seconds) override;
+
+private:
+    double m_now;
+    double m_oversleep;
+    uint32_t m_sleepCount;
+};
+
+// Объект ожидания поверх MockFrameClock: каждое ожидание длится delay секунд,
+// при signaled == false - весь таймаут и заканчивается неудачей
+class MockFrameWaiter : public IFrameWaiter
+{
+public:
+    explicit MockFrameWaiter(MockFrameClock* pClock) :
+        m_pClock(pClock),
+        m_delay(0.0),
+        m_signaled(true),
+        m_lastTimeoutMs(0),
+        m_waitCount(0)
+    {
+    }
+
+    void SetWait(double delay, bool signaled) { m_delay = delay; m_signaled = signaled; }
+    uint32_t GetLastTimeoutMs() const { return m_lastTimeoutMs; }
+    uint32_t GetWaitCount() const { return m_waitCount; }
+
+    bool WaitForFrame(uint32_t timeoutMs) override;
+
+private:
+    MockFrameClock* m_pClock;
+    double m_delay;
+    bool m_signaled;
+    uint32_t m_lastTimeoutMs;
+    uint32_t m_waitCount;
+};
+
+enum class PresentMode
+{
+    VSync,      // Present(1): кадр на обновление экрана
+    Unlocked,   // Present(0) с разрывами, если их разрешает система, - для замеров
+    Capped      // Present(0), частота ограничена таймером
+};
+
+// Темп кадров: перед работой CPU над кадром ждёт цепочку обмена, в режиме Capped -
+// ещё и срок кадра. Сроки идут с шагом периода от предыдущего, поэтому ошибка
+// сна не накапливается; после пропуска срока отсчёт начинается заново, без догонялок.
+class FramePacer
+{
+public:
+    struct Stats
+    {
+        uint64_t frames;
+        uint64_t waitTimeouts;
+        uint64_t missedDeadlines;
+        double lastWaitMs;      // ожидание цепочки обмена и срока кадра
+        double lastIntervalMs;  // между началами соседних кадров
+    };
+
+    static const uint32_t WaitTimeoutMs = 100;
+
+    FramePacer();
+
+    // pWaiter == nullptr - цепочка без объекта ожидания
+    void Init(IFrameClock* pClock, IFrameWaiter* pWaiter);
+
+    void SetMode(PresentMode mode);
+    void SetFrameCap(uint32_t framesPerSecond);
+    PresentMode GetMode() const { return m_mode; }
+    uint32_t GetFrameCap() const { return m_frameCap; }
+
+    void BeginFrame();
+
+    uint32_t GetSyncInterval() const { return m_mode == PresentMode::VSync ? 1 : 0; }
+    bool AllowTearing() const { return m_mode == PresentMode::Unlocked; }
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    IFrameClock* m_pClock;
+    IFrameWaiter* m_pWaiter;
+    PresentMode m_mode;
+    uint32_t m_frameCap;
+    double m_nextDeadline;
+    double m_lastFrameStart;
+    bool m_hasDeadline;
+    Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,348 @@
+#include "FrameProfiler.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+    // Метки времени: 0 и 1 - начало и конец кадра, участок i - 2 + 2i и 3 + 2i
+    const uint32_t FrameBeginIndex = 0;
+    const uint32_t FrameEndIndex = 1;
+
+    uint32_t ScopeBeginIndex(uint32_t scope) { return 2 + 2 * scope; }
+    uint32_t ScopeEndIndex(uint32_t scope) { return 3 + 2 * scope; }
+
+    float TicksToMs(uint64_t begin, uint64_t end, uint64_t frequency) {
+        return end > begin ? static_cast<float>(static_cast<double>(end - begin) * 1000.0 / frequency) : 0.0f;
+    }
+
+    void WriteJsonString(std::ofstream& file, const char* text) {
+        file << '"';
+        for (const char* p = text; *p; ++p) {
+            if (*p == '"' || *p == '\\')
+                file << '\\';
+            file << *p;
+        }
+        file << '"';
+    }
+}
+
+bool FrameProfiler::Init(IGpuTimerDevice* pDevice, uint32_t latencyFrames, uint32_t historySize) {
+    Terminate();
+
+    if (historySize == 0)
+        return false;
+
+    FrameRecord empty = {};
+    m_records.assign(historySize, empty);
+    m_scopeNames.reserve(MaxScopes);
+    m_stack.reserve(MaxScopes);
+
+    if (!pDevice)
+        return true;
+
+    // Кадров в пути должно быть больше задержки GPU, иначе измерения будут пропускаться
+    if (latencyFrames == 0)
+        return false;
+
+    m_pDevice = pDevice;
+    GpuSlot slot = {};
+    m_gpuSlots.assign(latencyFrames, slot);
+    for (uint32_t i = 0; i < latencyFrames; ++i) {
+        if (!m_pDevice->CreateFrame(i, MaxTimestamps)) {
+            Terminate();
+            return false;
+        }
+    }
+    return true;
+}
+
+void FrameProfiler::Terminate() {
+    if (m_pDevice) {
+        for (uint32_t i = 0; i < m_gpuSlots.size(); ++i)
+            m_pDevice->DestroyFrame(i);
+    }
+
+    m_pDevice = nullptr;
+    m_gpuSlots.clear();
+    m_records.clear();
+    m_scopeNames.clear();
+    m_stack.clear();
+    m_frame = 0;
+    m_inFrame = false;
+    m_gpuSlot = NoSlot;
+    m_droppedGpuFrames = 0;
+}
+
+float FrameProfiler::SinceFrameStart() const {
+    return std::chrono::duration<float, std::milli>(Clock::now() - m_frameStart).count();
+}
+
+void FrameProfiler::BeginFrame() {
+    if (m_records.empty())
+        return;
+    if (m_inFrame)
+        EndFrame();
+
+    ResolveGpu();
+
+    ++m_frame;
+    FrameRecord& record = GetRecord(m_frame);
+    memset(&record, 0, sizeof(record));
+    record.frame = m_frame;
+
+    m_inFrame = true;
+    m_frameStart = Clock::now();
+
+    m_gpuSlot = NoSlot;
+    if (!m_pDevice)
+        return;
+
+    uint32_t slotIndex = static_cast<uint32_t>(m_frame % m_gpuSlots.size());
+    if (m_gpuSlots[slotIndex].pending) {
+        // GPU отстаёт сильнее, чем кадров в пути, - кадр меряем только на CPU
+        ++m_droppedGpuFrames;
+        return;
+    }
+
+    m_gpuSlot = slotIndex;
+    m_gpuSlots[slotIndex].indexCount = 0;
+    m_pDevice->BeginFrame(slotIndex);
+    Timestamp(FrameBeginIndex);
+}
+
+void FrameProfiler::EndFrame() {
+    if (!m_inFrame)
+        return;
+
+    FrameRecord& record = GetRecord(m_frame);
+    record.cpuMs = SinceFrameStart();
+
+    if (m_gpuSlot != NoSlot) {
+        Timestamp(FrameEndIndex);
+        m_pDevice->EndFrame(m_gpuSlot);
+
+        GpuSlot& slot = m_gpuSlots[m_gpuSlot];
+        slot.frame = m_frame;
+        slot.pending = true;
+        m_gpuSlot = NoSlot;
+    }
+
+    m_stack.clear();
+    m_inFrame = false;
+}
+
+uint32_t FrameProfiler::BeginScope(const char* name, bool gpu) {
+    if (!m_inFrame)
+        return MaxScopes;
+
+    uint32_t scope = 0;
+    while (scope < m_scopeNames.size() && m_scopeNames[scope] != name && strcmp(m_scopeNames[scope], name) != 0)
+        ++scope;
+    if (scope == m_scopeNames.size()) {
+        if (scope == MaxScopes)
+            return MaxScopes;
+        m_scopeNames.push_back(name);
+    }
+
+    FrameRecord& record = GetRecord(m_frame);
+    ScopeTiming& timing = record.scopes[scope];
+    timing.active = true;
+    // Область, открытая повторно за кадр, снова пишет метки. Место оставляется под концы
+    // открытых областей и конец кадра; если его не хватает, область меряется только на CPU
+    timing.gpu = false;
+    if (gpu && m_gpuSlot != NoSlot) {
+        uint32_t needed = m_gpuSlots[m_gpuSlot].indexCount + 3;
+        for (uint32_t open : m_stack)
+            needed += record.scopes[open].gpu ? 1 : 0;
+        timing.gpu = needed <= MaxTimestamps;
+    }
+    timing.depth = static_cast<uint32_t>(m_stack.size());
+    timing.cpuStartMs = SinceFrameStart();
+    if (timing.gpu)
+        Timestamp(ScopeBeginIndex(scope));
+
+    m_stack.push_back(scope);
+    return scope;
+}
+
+void FrameProfiler::EndScope(uint32_t scope) {
+    if (!m_inFrame || scope >= MaxScopes)
+        return;
+
+    ScopeTiming& timing = GetRecord(m_frame).scopes[scope];
+    timing.cpuMs = SinceFrameStart() - timing.cpuStartMs;
+    if (timing.gpu)
+        Timestamp(ScopeEndIndex(scope));
+
+    if (!m_stack.empty() && m_stack.back() == scope)
+        m_stack.pop_back();
+}
+
+void FrameProfiler::Timestamp(uint32_t index) {
+    GpuSlot& slot = m_gpuSlots[m_gpuSlot];
+    if (slot.indexCount >= MaxTimestamps)
+        return;
+    slot.indices[slot.indexCount++] = index;
+    m_pDevice->Timestamp(m_gpuSlot, index);
+}
+
+void FrameProfiler::ResolveGpu() {
+    if (!m_pDevice)
+        return;
+
+    uint64_t timestamps[MaxTimestamps];
+    uint64_t byIndex[MaxTimestamps];
+    for (uint32_t i = 0; i < m_gpuSlots.size(); ++i) {
+        GpuSlot& slot = m_gpuSlots[i];
+        uint64_t frequency = 0;
+        bool valid = false;
+        if (!slot.pending || !m_pDevice->TryResolve(i, slot.indices, slot.indexCount, timestamps, &frequency, &valid))
+            continue;
+        slot.pending = false;
+
+        // Запись могла быть уже вытеснена из истории
+        FrameRecord& record = GetRecord(slot.frame);
+        if (record.frame != slot.frame || !valid || frequency == 0)
+            continue;
+
+        memset(byIndex, 0, sizeof(byIndex));
+        for (uint32_t k = 0; k < slot.indexCount; ++k)
+            byIndex[slot.indices[k]] = timestamps[k];
+
+        uint64_t frameBegin = byIndex[FrameBeginIndex];
+        record.gpuMs = TicksToMs(frameBegin, byIndex[FrameEndIndex], frequency);
+        for (uint32_t scope = 0; scope < MaxScopes; ++scope) {
+            ScopeTiming& timing = record.scopes[scope];
+            if (!timing.active || !timing.gpu)
+                continue;
+            timing.gpuStartMs = TicksToMs(frameBegin, byIndex[ScopeBeginIndex(scope)], frequency);
+            timing.gpuMs = TicksToMs(byIndex[ScopeBeginIndex(scope)], byIndex[ScopeEndIndex(scope)], frequency);
+        }
+        record.gpuResolved = true;
+    }
+}
+
+template <typename Visitor>
+void FrameProfiler::ForEachRecord(Visitor visitor) const {
+    // Только завершённые кадры, от старого к новому
+    if (m_records.empty())
+        return;
+    uint64_t last = m_inFrame ? m_frame - 1 : m_frame;
+    uint64_t size = m_records.size();
+    uint64_t first = last >= size ? last - size + 1 : 1;
+    for (uint64_t frame = first; frame <= last; ++frame) {
+        const FrameRecord& record = m_records[frame % size];
+        if (record.frame == frame)
+            visitor(record);
+    }
+}
+
+float FrameProfiler::GetHistory(uint32_t scope, bool gpu, std::vector<float>& values) const {
+    values.clear();
+    double sum = 0.0;
+    ForEachRecord([&](const FrameRecord& record) {
+        if (gpu && !record.gpuResolved)
+            return;
+
+        float value;
+        if (scope >= MaxScopes) {
+            value = gpu ? record.gpuMs : record.cpuMs;
+        }
+        else {
+            const ScopeTiming& timing = record.scopes[scope];
+            if (!timing.active || (gpu && !timing.gpu))
+                return;
+            value = gpu ? timing.gpuMs : timing.cpuMs;
+        }
+        values.push_back(value);
+        sum += value;
+    });
+    return values.empty() ? 0.0f : static_cast<float>(sum / values.size());
+}
+
+const FrameProfiler::FrameRecord* FrameProfiler::GetLatest(bool gpuResolved) const {
+    const FrameRecord* pLatest = nullptr;
+    ForEachRecord([&](const FrameRecord& record) {
+        if (!gpuResolved || record.gpuResolved)
+            pLatest = &record;
+    });
+    return pLatest;
+}
+
+bool FrameProfiler::WriteCsv(const char* path) const {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "frame,scope,depth,cpu_start_ms,cpu_ms,gpu_start_ms,gpu_ms\n";
+    file << std::fixed << std::setprecision(4);
+    ForEachRecord([&](const FrameRecord& record) {
+        file << record.frame << ",Frame,,0," << record.cpuMs << ',';
+        if (record.gpuResolved)
+            file << "0," << record.gpuMs;
+        else
+            file << ',';
+        file << '\n';
+
+        for (uint32_t scope = 0; scope < m_scopeNames.size(); ++scope) {
+            const ScopeTiming& timing = record.scopes[scope];
+            if (!timing.active)
+                continue;
+            file << record.frame << ',' << m_scopeNames[scope] << ',' << timing.depth << ','
+                << timing.cpuStartMs << ',' << timing.cpuMs << ',';
+            if (record.gpuResolved && timing.gpu)
+                file << timing.gpuStartMs << ',' << timing.gpuMs;
+            else
+                file << ',';
+            file << '\n';
+        }
+    });
+    return static_cast<bool>(file);
+}
+
+bool FrameProfiler::WriteJson(const char* path) const {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    // Неизмеренное на GPU время - null
+    file << std::fixed << std::setprecision(4);
+    file << "{\n  \"frames\": [";
+    bool firstFrame = true;
+    ForEachRecord([&](const FrameRecord& record) {
+        file << (firstFrame ? "\n" : ",\n");
+        firstFrame = false;
+
+        file << "    { \"frame\": " << record.frame << ", \"cpu_ms\": " << record.cpuMs << ", \"gpu_ms\": ";
+        if (record.gpuResolved)
+            file << record.gpuMs;
+        else
+            file << "null";
+        file << ", \"scopes\": [";
+
+        bool firstScope = true;
+        for (uint32_t scope = 0; scope < m_scopeNames.size(); ++scope) {
+            const ScopeTiming& timing = record.scopes[scope];
+            if (!timing.active)
+                continue;
+            file << (firstScope ? "" : ", ");
+            firstScope = false;
+
+            bool hasGpu = record.gpuResolved && timing.gpu;
+            file << "{ \"name\": ";
+            WriteJsonString(file, m_scopeNames[scope]);
+            file << ", \"depth\": " << timing.depth
+                << ", \"cpu_start_ms\": " << timing.cpuStartMs << ", \"cpu_ms\": " << timing.cpuMs
+                << ", \"gpu_start_ms\": ";
+            if (hasGpu)
+                file << timing.gpuStartMs << ", \"gpu_ms\": " << timing.gpuMs;
+            else
+                file << "null, \"gpu_ms\": null";
+            file << " }";
+        }
+        file << "] }";
+    });
+    file << "\n  ]\n}\n";
+    return static_cast<bool>(file);
+}
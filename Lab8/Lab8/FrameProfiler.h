@@ -0,0 +1,138 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Абстракция GPU-таймера: кадр = пара disjoint-запросов + набор меток времени.
+// Результаты читаются без ожидания через несколько кадров.
+class IGpuTimerDevice
+{
+public:
+    virtual ~IGpuTimerDevice() = default;
+
+    virtual bool CreateFrame(uint32_t frame, uint32_t timestampCount) = 0;
+    virtual void DestroyFrame(uint32_t frame) = 0;
+    virtual void BeginFrame(uint32_t frame) = 0;
+    virtual void Timestamp(uint32_t frame, uint32_t index) = 0;
+    virtual void EndFrame(uint32_t frame) = 0;
+    // false - данные ещё не готовы; *pValid = false, если частота менялась (disjoint)
+    virtual bool TryResolve(uint32_t frame, const uint32_t* pIndices, uint32_t count,
+        uint64_t* pTimestamps, uint64_t* pFrequency, bool* pValid) = 0;
+};
+
+// Профилировщик кадра: именованные участки с временем на CPU сразу и на GPU с задержкой.
+// Хранит последние historySize кадров для гистограмм и выгрузки в CSV/JSON.
+// Каждый участок вызывается не больше одного раза за кадр.
+class FrameProfiler
+{
+public:
+    static const uint32_t MaxScopes = 24;
+
+    struct ScopeTiming
+    {
+        float cpuStartMs;
+        float cpuMs;
+        float gpuStartMs;
+        float gpuMs;
+        uint32_t depth;
+        bool active;
+        bool gpu;
+    };
+
+    struct FrameRecord
+    {
+        uint64_t frame;
+        float cpuMs;
+        float gpuMs;
+        bool gpuResolved;
+        ScopeTiming scopes[MaxScopes];
+    };
+
+    FrameProfiler() :
+        m_pDevice(nullptr),
+        m_frame(0),
+        m_inFrame(false),
+        m_gpuSlot(NoSlot),
+        m_droppedGpuFrames(0)
+    {
+    }
+
+    // pDevice == nullptr - только CPU
+    bool Init(IGpuTimerDevice* pDevice, uint32_t latencyFrames, uint32_t historySize);
+    void Terminate();
+
+    void BeginFrame();
+    void EndFrame();
+
+    uint32_t BeginScope(const char* name, bool gpu = true);
+    void EndScope(uint32_t scope);
+
+    uint32_t GetScopeCount() const { return static_cast<uint32_t>(m_scopeNames.size()); }
+    const char* GetScopeName(uint32_t scope) const { return m_scopeNames[scope]; }
+    bool HasGpu() const { return m_pDevice != nullptr; }
+    uint64_t GetDroppedGpuFrames() const { return m_droppedGpuFrames; }
+
+    // Значения по порядку кадров, от старого к новому; возвращает среднее.
+    // scope == MaxScopes - кадр целиком
+    float GetHistory(uint32_t scope, bool gpu, std::vector<float>& values) const;
+    const FrameRecord* GetLatest(bool gpuResolved) const;
+
+    bool WriteCsv(const char* path) const;
+    bool WriteJson(const char* path) const;
+
+private:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    static const uint32_t NoSlot = ~0u;
+    // Начало и конец кадра плюс по паре на область
+    static const uint32_t MaxTimestamps = 2 + 2 * MaxScopes;
+
+    struct GpuSlot
+    {
+        uint64_t frame;
+        bool pending;
+        uint32_t indexCount;
+        uint32_t indices[MaxTimestamps];
+    };
+
+    float SinceFrameStart() const;
+    void ResolveGpu();
+    void Timestamp(uint32_t index);
+    FrameRecord& GetRecord(uint64_t frame) { return m_records[frame % m_records.size()]; }
+    template <typename Visitor> void ForEachRecord(Visitor visitor) const;
+
+    IGpuTimerDevice* m_pDevice;
+    std::vector<GpuSlot> m_gpuSlots;
+    std::vector<FrameRecord> m_records;
+    std::vector<const char*> m_scopeNames;
+    std::vector<uint32_t> m_stack;
+    Clock::time_point m_frameStart;
+    uint64_t m_frame;
+    bool m_inFrame;
+    uint32_t m_gpuSlot;
+    uint64_t m_droppedGpuFrames;
+};
+
+// Участок на время жизни объекта
+class ProfileScope
+{
+public:
+    ProfileScope(FrameProfiler& profiler, const char* name, bool gpu = true) :
+        m_profiler(profiler),
+        m_scope(profiler.BeginScope(name, gpu))
+    {
+    }
+
+    ~ProfileScope() { m_profiler.EndScope(m_scope); }
+
+private:
+    ProfileScope(const ProfileScope&);
+    ProfileScope& operator=(const ProfileScope&);
+
+    FrameProfiler& m_profiler;
+    uint32_t m_scope;
+};
+
+#endif
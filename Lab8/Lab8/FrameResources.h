@@ -0,0 +1,109 @@
+#ifndef FRAME_RESOURCES_H
+#define FRAME_RESOURCES_H
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Абстракция fence: отметка в очереди команд и проверка, прошёл ли её GPU.
+class IFrameFenceDevice
+{
+public:
+    virtual ~IFrameFenceDevice() = default;
+
+    virtual bool CreateFence(uint32_t fence) = 0;
+    virtual void DestroyFence(uint32_t fence) = 0;
+    virtual void Signal(uint32_t fence) = 0;
+    // flush == false - не отправлять накопленные команды, только проверить
+    virtual bool IsComplete(uint32_t fence, bool flush) = 0;
+};
+
+// N копий ресурса, который каждый кадр переписывается целиком. Кадр frame работает с копией
+// frame % N; перед повторным использованием копии ждём fence, выставленный в конце кадра,
+// который пользовался ею последним. Пока копий хватает, CPU собирает кадр N + 1, не дожидаясь,
+// пока GPU дочитает кадр N. Сами ресурсы создаёт и освобождает владелец через Get(i).
+template <typename T>
+class FrameResources
+{
+public:
+    FrameResources() :
+        m_pFences(nullptr),
+        m_current(0),
+        m_acquired(false),
+        m_stalls(0)
+    {
+    }
+
+    bool Init(IFrameFenceDevice* pFences, uint32_t count) {
+        Terminate();
+        if (!pFences || count == 0)
+            return false;
+
+        m_pFences = pFences;
+        m_copies.assign(count, Copy{ T(), false });
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!m_pFences->CreateFence(i)) {
+                Terminate();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Terminate() {
+        if (m_pFences) {
+            for (uint32_t i = 0; i < m_copies.size(); ++i)
+                m_pFences->DestroyFence(i);
+        }
+        m_pFences = nullptr;
+        m_copies.clear();
+        m_current = 0;
+        m_acquired = false;
+        m_stalls = 0;
+    }
+
+    // Начало кадра: выбирает копию и, если GPU ещё читает её с прошлого круга, ждёт
+    T& Acquire(uint64_t frame) {
+        m_current = static_cast<uint32_t>(frame % m_copies.size());
+        Copy& copy = m_copies[m_current];
+        if (copy.pending && !m_pFences->IsComplete(m_current, false)) {
+            ++m_stalls;
+            while (!m_pFences->IsComplete(m_current, true))
+                std::this_thread::yield();
+        }
+        copy.pending = false;
+        m_acquired = true;
+        return copy.value;
+    }
+
+    // Конец кадра: после последней команды, использующей текущую копию
+    void Signal() {
+        if (!m_acquired)
+            return;
+        m_pFences->Signal(m_current);
+        m_copies[m_current].pending = true;
+        m_acquired = false;
+    }
+
+    T& GetCurrent() { return m_copies[m_current].value; }
+    T& Get(uint32_t index) { return m_copies[index].value; }
+    uint32_t GetCount() const { return static_cast<uint32_t>(m_copies.size()); }
+    uint32_t GetCurrentIndex() const { return m_current; }
+    // Сколько раз CPU пришлось ждать GPU: копий меньше, чем кадров в пути
+    uint64_t GetStalls() const { return m_stalls; }
+
+private:
+    struct Copy
+    {
+        T value;
+        bool pending;
+    };
+
+    IFrameFenceDevice* m_pFences;
+    std::vector<Copy> m_copies;
+    uint32_t m_current;
+    bool m_acquired;
+    uint64_t m_stalls;
+};
+
+#endif
@@ -0,0 +1,303 @@
+#include "FrustumCuller.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FRUSTUM_CULLER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FRUSTUM_CULLER_SSE2_TARGET
+#define FRUSTUM_CULLER_AVX2_TARGET
+#else
+#define FRUSTUM_CULLER_SSE2_TARGET __attribute__((target("sse2")))
+#define FRUSTUM_CULLER_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+FrustumCuller::FrustumCuller() :
+    m_planeX{},
+    m_planeY{},
+    m_planeZ{},
+    m_planeW{},
+    m_planeAbsX{},
+    m_planeAbsY{},
+    m_planeAbsZ{},
+    m_path(DetectBestPath())
+{
+}
+
+void FrustumCuller::SetPlanes(const float planes[6][4]) {
+    for (int i = 0; i < 6; ++i) {
+        m_planeX[i] = planes[i][0];
+        m_planeY[i] = planes[i][1];
+        m_planeZ[i] = planes[i][2];
+        m_planeW[i] = planes[i][3];
+        m_planeAbsX[i] = fabsf(planes[i][0]);
+        m_planeAbsY[i] = fabsf(planes[i][1]);
+        m_planeAbsZ[i] = fabsf(planes[i][2]);
+    }
+}
+
+void FrustumCuller::Resize(size_t count) {
+    m_centerX.resize(count);
+    m_centerY.resize(count);
+    m_centerZ.resize(count);
+    m_extentX.resize(count);
+    m_extentY.resize(count);
+    m_extentZ.resize(count);
+}
+
+void FrustumCuller::SetBox(size_t index, float centerX, float centerY, float centerZ, float extentX, float extentY, float extentZ) {
+    m_centerX[index] = centerX;
+    m_centerY[index] = centerY;
+    m_centerZ[index] = centerZ;
+    m_extentX[index] = extentX;
+    m_extentY[index] = extentY;
+    m_extentZ[index] = extentZ;
+}
+
+size_t FrustumCuller::Cull(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    if (end > GetCount())
+        end = GetCount();
+    if (begin >= end)
+        return 0;
+
+    switch (m_path) {
+    case Path::AVX2:
+        return CullAVX2(pOutIndices, begin, end);
+    case Path::SSE2:
+        return CullSSE2(pOutIndices, begin, end);
+    default:
+        return CullScalar(pOutIndices, begin, end);
+    }
+}
+
+// Эталонная реализация; SIMD-версии повторяют тот же порядок операций, поэтому результаты совпадают побитно
+size_t FrustumCuller::CullScalar(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            float distance = (m_centerX[i] * m_planeX[p] + m_centerY[i] * m_planeY[p]) + (m_centerZ[i] * m_planeZ[p] + m_planeW[p]);
+            float radius = (m_extentX[i] * m_planeAbsX[p] + m_extentY[i] * m_planeAbsY[p]) + m_extentZ[i] * m_planeAbsZ[p];
+            if (distance + radius < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside)
+            pOutIndices[count++] = static_cast<uint32_t>(i);
+    }
+    return count;
+}
+
+float FrustumCuller::GetNearestDistance(float x, float y, float z, size_t begin, size_t end) const {
+    float nearestSq = FLT_MAX;
+    for (size_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            float distance = (m_centerX[i] * m_planeX[p] + m_centerY[i] * m_planeY[p]) + (m_centerZ[i] * m_planeZ[p] + m_planeW[p]);
+            float radius = (m_extentX[i] * m_planeAbsX[p] + m_extentY[i] * m_planeAbsY[p]) + m_extentZ[i] * m_planeAbsZ[p];
+            if (distance + radius < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside)
+            continue;
+
+        float dx = std::max(std::fabs(m_centerX[i] - x) - m_extentX[i], 0.0f);
+        float dy = std::max(std::fabs(m_centerY[i] - y) - m_extentY[i], 0.0f);
+        float dz = std::max(std::fabs(m_centerZ[i] - z) - m_extentZ[i], 0.0f);
+        nearestSq = std::min(nearestSq, dx * dx + dy * dy + dz * dz);
+    }
+    return nearestSq == FLT_MAX ? FLT_MAX : std::sqrt(nearestSq);
+}
+
+#if defined(FRUSTUM_CULLER_X86)
+
+FRUSTUM_CULLER_SSE2_TARGET
+size_t FrustumCuller::CullSSE2(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm_set1_ps(m_planeX[p]);
+        planeY[p] = _mm_set1_ps(m_planeY[p]);
+        planeZ[p] = _mm_set1_ps(m_planeZ[p]);
+        planeW[p] = _mm_set1_ps(m_planeW[p]);
+        absX[p] = _mm_set1_ps(m_planeAbsX[p]);
+        absY[p] = _mm_set1_ps(m_planeAbsY[p]);
+        absZ[p] = _mm_set1_ps(m_planeAbsZ[p]);
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+        __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+        __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&m_extentX[i]);
+        __m128 ey = _mm_loadu_ps(&m_extentY[i]);
+        __m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+
+        __m128 inside = _mm_cmpeq_ps(zero, zero);
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, planeX[p]), _mm_mul_ps(cy, planeY[p])),
+                _mm_add_ps(_mm_mul_ps(cz, planeZ[p]), planeW[p]));
+            __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, absX[p]), _mm_mul_ps(ey, absY[p])), _mm_mul_ps(ez, absZ[p]));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        // Сжатие без ветвлений: индекс пишется всегда, счётчик растёт только для видимых
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k) {
+            pOutIndices[count] = static_cast<uint32_t>(i + k);
+            count += (mask >> k) & 1;
+        }
+    }
+    return count + CullScalar(pOutIndices + count, i, end);
+}
+
+namespace
+{
+    struct CompactTable
+    {
+        // Для каждой 8-битной маски - перестановка, сдвигающая видимые дорожки в начало
+        alignas(32) uint32_t permutation[256][8];
+        uint8_t popCount[256];
+
+        CompactTable() {
+            for (int mask = 0; mask < 256; ++mask) {
+                int count = 0;
+                for (int lane = 0; lane < 8; ++lane) {
+                    if (mask & (1 << lane))
+                        permutation[mask][count++] = static_cast<uint32_t>(lane);
+                }
+                popCount[mask] = static_cast<uint8_t>(count);
+                for (int lane = count; lane < 8; ++lane)
+                    permutation[mask][lane] = 0;
+            }
+        }
+    };
+
+    const CompactTable& GetCompactTable() {
+        static const CompactTable table;
+        return table;
+    }
+}
+
+FRUSTUM_CULLER_AVX2_TARGET
+size_t FrustumCuller::CullAVX2(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    const CompactTable& table = GetCompactTable();
+
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6], absX[6], absY[6], absZ[6];
+    for (int p = 0; p < 6; ++p) {
+        planeX[p] = _mm256_set1_ps(m_planeX[p]);
+        planeY[p] = _mm256_set1_ps(m_planeY[p]);
+        planeZ[p] = _mm256_set1_ps(m_planeZ[p]);
+        planeW[p] = _mm256_set1_ps(m_planeW[p]);
+        absX[p] = _mm256_set1_ps(m_planeAbsX[p]);
+        absY[p] = _mm256_set1_ps(m_planeAbsY[p]);
+        absZ[p] = _mm256_set1_ps(m_planeAbsZ[p]);
+    }
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    size_t count = 0;
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&m_centerX[i]);
+        __m256 cy = _mm256_loadu_ps(&m_centerY[i]);
+        __m256 cz = _mm256_loadu_ps(&m_centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&m_extentX[i]);
+        __m256 ey = _mm256_loadu_ps(&m_extentY[i]);
+        __m256 ez = _mm256_loadu_ps(&m_extentZ[i]);
+
+        __m256 inside = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, planeX[p]), _mm256_mul_ps(cy, planeY[p])),
+                _mm256_add_ps(_mm256_mul_ps(cz, planeZ[p]), planeW[p]));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, absX[p]), _mm256_mul_ps(ey, absY[p])), _mm256_mul_ps(ez, absZ[p]));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+        }
+
+        // Видимые индексы переставляются в начало регистра и пишутся одной записью;
+        // хвост за count перезапишется следующей итерацией и не выходит за end - begin
+        int mask = _mm256_movemask_ps(inside);
+        __m256i indices = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), lanes);
+        __m256i permutation = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.permutation[mask]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pOutIndices + count), _mm256_permutevar8x32_epi32(indices, permutation));
+        count += table.popCount[mask];
+    }
+    return count + CullScalar(pOutIndices + count, i, end);
+}
+
+FrustumCuller::Path FrustumCuller::DetectBestPath() {
+#if defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx) {
+        // ОС должна сохранять регистры YMM при переключении контекста
+        if ((_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+    }
+
+    if (avx2)
+        return Path::AVX2;
+    return sse2 ? Path::SSE2 : Path::Scalar;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return Path::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return Path::SSE2;
+    return Path::Scalar;
+#endif
+}
+
+#else
+
+size_t FrustumCuller::CullSSE2(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    return CullScalar(pOutIndices, begin, end);
+}
+
+size_t FrustumCuller::CullAVX2(uint32_t* pOutIndices, size_t begin, size_t end) const {
+    return CullScalar(pOutIndices, begin, end);
+}
+
+FrustumCuller::Path FrustumCuller::DetectBestPath() {
+    return Path::Scalar;
+}
+
+#endif
+
+void FrustumCuller::SetPath(Path path) {
+    // Нельзя выбрать путь, который процессор не поддерживает
+    Path best = DetectBestPath();
+    if (static_cast<int>(path) > static_cast<int>(best))
+        path = best;
+    m_path = path;
+}
+
+const char* FrustumCuller::GetPathName(Path path) {
+    switch (path) {
+    case Path::AVX2:
+        return "AVX2";
+    case Path::SSE2:
+        return "SSE2";
+    default:
+        return "Scalar";
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef FRUSTUM_CULLER_H
+#define FRUSTUM_CULLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Пакетное отсечение AABB по шести плоскостям пирамиды видимости.
+// Центры и полуразмеры хранятся как структура массивов, чтобы SSE2/AVX2
+// проверяли 4 или 8 объектов за одну инструкцию. Не зависит от D3D11.
+class FrustumCuller
+{
+public:
+    enum class Path
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    FrustumCuller();
+
+    // Плоскости в виде (a, b, c, d), как после XMPlaneNormalize
+    void SetPlanes(const float planes[6][4]);
+
+    void Resize(size_t count);
+    void SetBox(size_t index, float centerX, float centerY, float centerZ, float extentX, float extentY, float extentZ);
+    size_t GetCount() const { return m_centerX.size(); }
+
+    // Записывает индексы видимых объектов подряд и возвращает их число.
+    // pOutIndices должен вмещать GetCount() элементов.
+    size_t Cull(uint32_t* pOutIndices, size_t begin, size_t end) const;
+    size_t Cull(uint32_t* pOutIndices) const { return Cull(pOutIndices, 0, GetCount()); }
+
+    size_t CullScalar(uint32_t* pOutIndices, size_t begin, size_t end) const;
+    size_t CullSSE2(uint32_t* pOutIndices, size_t begin, size_t end) const;
+    size_t CullAVX2(uint32_t* pOutIndices, size_t begin, size_t end) const;
+
+    // Расстояние от точки до ближайшего видимого AABB (0 - точка внутри); FLT_MAX - видимых нет
+    float GetNearestDistance(float x, float y, float z, size_t begin, size_t end) const;
+
+    Path GetPath() const { return m_path; }
+    void SetPath(Path path);
+    static Path DetectBestPath();
+    static const char* GetPathName(Path path);
+
+private:
+    float m_planeX[6];
+    float m_planeY[6];
+    float m_planeZ[6];
+    float m_planeW[6];
+    float m_planeAbsX[6];
+    float m_planeAbsY[6];
+    float m_planeAbsZ[6];
+
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_centerZ;
+    std::vector<float> m_extentX;
+    std::vector<float> m_extentY;
+    std::vector<float> m_extentZ;
+
+    Path m_path;
+};
+
+#endif
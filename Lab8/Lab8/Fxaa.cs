@@ -0,0 +1,137 @@
+// FXAA по мотивам 3.11 (качество 10): поиск края по яркости соседей, шаги вдоль него
+// до конца ступеньки и смешивание с соседом поперёк края
+cbuffer FxaaParams : register(b0)
+{
+    float2 rcpSize;
+    uint2 size;
+    float edgeThreshold;
+    float edgeThresholdMin;
+    float subpixel;
+    float padding;
+};
+
+Texture2D<float4> inputTexture : register(t0);
+SamplerState samLinear : register(s0);
+RWTexture2D<float4> outputTexture : register(u0);
+
+static const uint SearchSteps = 6;
+static const float StepSizes[SearchSteps] = { 1.0f, 1.5f, 2.0f, 2.0f, 4.0f, 12.0f };
+
+float Luma(float3 color)
+{
+    // Яркость после тональной компрессии: в HDR пороги иначе не работают
+    return sqrt(dot(saturate(color), float3(0.299f, 0.587f, 0.114f)));
+}
+
+float LumaAt(float2 uv)
+{
+    return Luma(inputTexture.SampleLevel(samLinear, uv, 0).rgb);
+}
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    float2 uv = (id.xy + 0.5f) * rcpSize;
+    float4 center = inputTexture[id.xy];
+    float lumaM = Luma(center.rgb);
+    float lumaN = LumaAt(uv + float2(0, -rcpSize.y));
+    float lumaS = LumaAt(uv + float2(0, rcpSize.y));
+    float lumaW = LumaAt(uv + float2(-rcpSize.x, 0));
+    float lumaE = LumaAt(uv + float2(rcpSize.x, 0));
+
+    float rangeMax = max(lumaM, max(max(lumaN, lumaS), max(lumaW, lumaE)));
+    float rangeMin = min(lumaM, min(min(lumaN, lumaS), min(lumaW, lumaE)));
+    float range = rangeMax - rangeMin;
+    if (range < max(edgeThresholdMin, rangeMax * edgeThreshold))
+    {
+        outputTexture[id.xy] = float4(center.rgb, 1.0f);
+        return;
+    }
+
+    float lumaNW = LumaAt(uv - rcpSize);
+    float lumaSE = LumaAt(uv + rcpSize);
+    float lumaNE = LumaAt(uv + float2(rcpSize.x, -rcpSize.y));
+    float lumaSW = LumaAt(uv + float2(-rcpSize.x, rcpSize.y));
+
+    // Подпиксельное смешивание: насколько центр выбивается из среднего по окрестности
+    float average = (2.0f * (lumaN + lumaS + lumaW + lumaE) + lumaNW + lumaNE + lumaSW + lumaSE) / 12.0f;
+    float subpixelBlend = saturate(abs(average - lumaM) / range);
+    subpixelBlend = smoothstep(0.0f, 1.0f, subpixelBlend);
+    subpixelBlend = subpixelBlend * subpixelBlend * subpixel;
+
+    float edgeH = abs(lumaNW + lumaNE - 2.0f * lumaN) + 2.0f * abs(lumaW + lumaE - 2.0f * lumaM) + abs(lumaSW + lumaSE - 2.0f * lumaS);
+    float edgeV = abs(lumaNW + lumaSW - 2.0f * lumaW) + 2.0f * abs(lumaN + lumaS - 2.0f * lumaM) + abs(lumaNE + lumaSE - 2.0f * lumaE);
+    bool horizontal = edgeH >= edgeV;
+
+    float luma1 = horizontal ? lumaN : lumaW;
+    float luma2 = horizontal ? lumaS : lumaE;
+    float gradient1 = abs(luma1 - lumaM);
+    float gradient2 = abs(luma2 - lumaM);
+    float stepLength = horizontal ? rcpSize.y : rcpSize.x;
+    float lumaLocal;
+    if (gradient1 >= gradient2)
+    {
+        stepLength = -stepLength;
+        lumaLocal = 0.5f * (luma1 + lumaM);
+    }
+    else
+    {
+        lumaLocal = 0.5f * (luma2 + lumaM);
+    }
+    float gradientScaled = 0.25f * max(gradient1, gradient2);
+
+    // Середина между центром и соседом поперёк края, дальше шаги вдоль края в обе стороны
+    float2 edgeUv = uv;
+    if (horizontal)
+        edgeUv.y += stepLength * 0.5f;
+    else
+        edgeUv.x += stepLength * 0.5f;
+    float2 edgeStep = horizontal ? float2(rcpSize.x, 0) : float2(0, rcpSize.y);
+
+    float2 uv1 = edgeUv - edgeStep;
+    float2 uv2 = edgeUv + edgeStep;
+    float lumaEnd1 = LumaAt(uv1) - lumaLocal;
+    float lumaEnd2 = LumaAt(uv2) - lumaLocal;
+    bool reached1 = abs(lumaEnd1) >= gradientScaled;
+    bool reached2 = abs(lumaEnd2) >= gradientScaled;
+
+    for (uint i = 0; i < SearchSteps; ++i)
+    {
+        if (reached1 && reached2)
+            break;
+        if (!reached1)
+        {
+            uv1 -= edgeStep * StepSizes[i];
+            lumaEnd1 = LumaAt(uv1) - lumaLocal;
+            reached1 = abs(lumaEnd1) >= gradientScaled;
+        }
+        if (!reached2)
+        {
+            uv2 += edgeStep * StepSizes[i];
+            lumaEnd2 = LumaAt(uv2) - lumaLocal;
+            reached2 = abs(lumaEnd2) >= gradientScaled;
+        }
+    }
+
+    float distance1 = horizontal ? uv.x - uv1.x : uv.y - uv1.y;
+    float distance2 = horizontal ? uv2.x - uv.x : uv2.y - uv.y;
+    bool nearest1 = distance1 < distance2;
+    float distanceMin = min(distance1, distance2);
+    float edgeLength = distance1 + distance2;
+
+    // Смещение осмысленно, только если ближний конец края меняет яркость в нужную сторону
+    bool centerSmaller = lumaM < lumaLocal;
+    bool correctVariation = ((nearest1 ? lumaEnd1 : lumaEnd2) < 0.0f) != centerSmaller;
+    float edgeOffset = correctVariation ? 0.5f - distanceMin / edgeLength : 0.0f;
+    float offset = max(edgeOffset, subpixelBlend);
+
+    float2 finalUv = uv;
+    if (horizontal)
+        finalUv.y += offset * stepLength;
+    else
+        finalUv.x += offset * stepLength;
+    outputTexture[id.xy] = float4(inputTexture.SampleLevel(samLinear, finalUv, 0).rgb, 1.0f);
+}
@@ -0,0 +1,225 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem() :
+    m_threadCount(1),
+    m_generation(0),
+    m_batchOpen(false),
+    m_stop(false),
+    m_pJob(nullptr),
+    m_count(0),
+    m_chunkSize(0),
+    m_pendingChunks(0),
+    m_activeWorkers(0),
+    m_stolenChunks(0)
+{
+}
+
+JobSystem::~JobSystem() {
+    Terminate();
+}
+
+bool JobSystem::Init(uint32_t threadCount) {
+    Terminate();
+
+    if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0)
+        threadCount = 1;
+
+    m_threadCount = threadCount;
+    m_queues.reset(new WorkQueue[threadCount]);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        m_queues[i].top.store(0, std::memory_order_relaxed);
+        m_queues[i].bottom.store(0, std::memory_order_relaxed);
+        m_queues[i].base = 0;
+    }
+
+    m_stop = false;
+    m_stolenChunks.store(0, std::memory_order_relaxed);
+
+    // Поток 0 - вызывающий, остальные создаются здесь
+    for (uint32_t i = 1; i < threadCount; ++i)
+        m_threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    return true;
+}
+
+void JobSystem::Terminate() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+    m_queues.reset();
+    m_threadCount = 1;
+}
+
+size_t JobSystem::GetChunkCount(size_t count, size_t chunkSize) {
+    if (chunkSize == 0)
+        chunkSize = 1;
+    return (count + chunkSize - 1) / chunkSize;
+}
+
+size_t JobSystem::AlignChunk(size_t chunkSize, size_t elementSize) {
+    if (elementSize == 0)
+        return chunkSize;
+
+    // Наименьшее число элементов, занимающее целое число кэш-линий
+    size_t a = elementSize;
+    size_t b = CacheLineSize;
+    while (b != 0) {
+        size_t r = a % b;
+        a = b;
+        b = r;
+    }
+    size_t step = CacheLineSize / a;
+
+    if (chunkSize < step)
+        return step;
+    return (chunkSize + step - 1) / step * step;
+}
+
+size_t JobSystem::ParallelFor(size_t count, size_t chunkSize, const RangeJob& job) {
+    if (count == 0)
+        return 0;
+    if (chunkSize == 0)
+        chunkSize = 1;
+
+    const size_t chunkCount = GetChunkCount(count, chunkSize);
+    if (m_threads.empty() || chunkCount == 1) {
+        for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+            size_t begin = chunk * chunkSize;
+            size_t end = begin + chunkSize < count ? begin + chunkSize : count;
+            job(begin, end, chunk);
+        }
+        return chunkCount;
+    }
+
+    // Каждый поток получает непрерывную полосу кусков - соседние данные остаются в одном кэше
+    for (uint32_t i = 0; i < m_threadCount; ++i) {
+        size_t first = chunkCount * i / m_threadCount;
+        size_t last = chunkCount * (i + 1) / m_threadCount;
+        m_queues[i].base = first;
+        m_queues[i].top.store(0, std::memory_order_relaxed);
+        m_queues[i].bottom.store(static_cast<int64_t>(last - first), std::memory_order_relaxed);
+    }
+
+    m_pJob = &job;
+    m_count = count;
+    m_chunkSize = chunkSize;
+    m_pendingChunks.store(chunkCount, std::memory_order_relaxed);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batchOpen = true;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    RunChunks(0);
+    while (m_pendingChunks.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+
+    // Новые потоки к пакету больше не присоединятся; дожидаемся тех, кто ещё проверяет очереди,
+    // чтобы следующий ParallelFor мог безопасно переписать их границы
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_batchOpen = false;
+    }
+    while (m_activeWorkers.load(std::memory_order_acquire) != 0)
+        std::this_thread::yield();
+
+    m_pJob = nullptr;
+    return chunkCount;
+}
+
+void JobSystem::WorkerLoop(uint32_t index) {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || (m_batchOpen && m_generation != seenGeneration); });
+            if (m_stop)
+                return;
+            seenGeneration = m_generation;
+            m_activeWorkers.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        RunChunks(index);
+        m_activeWorkers.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void JobSystem::RunChunks(uint32_t index) {
+    size_t chunk;
+    for (;;) {
+        if (PopChunk(index, &chunk)) {
+            RunChunk(chunk);
+            continue;
+        }
+        // Новые куски во время пакета не появляются: если красть нечего, работа потока окончена
+        if (!StealChunk(index, &chunk))
+            return;
+        m_stolenChunks.fetch_add(1, std::memory_order_relaxed);
+        RunChunk(chunk);
+    }
+}
+
+void JobSystem::RunChunk(size_t chunk) {
+    size_t begin = chunk * m_chunkSize;
+    size_t end = begin + m_chunkSize < m_count ? begin + m_chunkSize : m_count;
+    (*m_pJob)(begin, end, chunk);
+    m_pendingChunks.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+// Снятие с конца своей очереди (дек Чейза-Лева, массив кусков задан неявно через base)
+bool JobSystem::PopChunk(uint32_t index, size_t* pChunk) {
+    WorkQueue& queue = m_queues[index];
+    int64_t bottom = queue.bottom.load(std::memory_order_relaxed) - 1;
+    queue.bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = queue.top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (top == bottom) {
+        // Последний кусок - соревнуемся с ворами через top
+        bool won = queue.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        queue.bottom.store(bottom + 1, std::memory_order_relaxed);
+        if (!won)
+            return false;
+    }
+
+    *pChunk = queue.base + static_cast<size_t>(bottom);
+    return true;
+}
+
+// Кража с начала чужих очередей, начиная с соседа
+bool JobSystem::StealChunk(uint32_t index, size_t* pChunk) {
+    bool retry = true;
+    while (retry) {
+        retry = false;
+        for (uint32_t step = 1; step < m_threadCount; ++step) {
+            WorkQueue& victim = m_queues[(index + step) % m_threadCount];
+            int64_t top = victim.top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = victim.bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                continue;
+
+            if (victim.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                *pChunk = victim.base + static_cast<size_t>(top);
+                return true;
+            }
+            // Кусок увёл другой поток, но очередь может быть не пуста
+            retry = true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с кражей работы. ParallelFor режет диапазон на куски и раздаёт
+// их полосами по очередям потоков: владелец снимает куски с конца своей очереди,
+// а освободившийся поток без блокировок крадёт их с начала чужой.
+// Вызывающий поток работает наравне с остальными. Не зависит от D3D11.
+class JobSystem
+{
+public:
+    // begin/end - диапазон элементов, chunk - номер куска (куски идут по порядку элементов)
+    typedef std::function<void(size_t begin, size_t end, size_t chunk)> RangeJob;
+
+    JobSystem();
+    ~JobSystem();
+
+    // threadCount учитывает вызывающий поток; 0 - по числу логических ядер
+    bool Init(uint32_t threadCount);
+    void Terminate();
+
+    // Возвращает число кусков, когда все они выполнены
+    size_t ParallelFor(size_t count, size_t chunkSize, const RangeJob& job);
+
+    uint32_t GetThreadCount() const { return m_threadCount; }
+    uint64_t GetStolenChunks() const { return m_stolenChunks.load(std::memory_order_relaxed); }
+
+    static size_t GetChunkCount(size_t count, size_t chunkSize);
+    // Округляет размер куска так, чтобы границы кусков совпадали с границами кэш-линий
+    static size_t AlignChunk(size_t chunkSize, size_t elementSize);
+
+    static const size_t CacheLineSize = 64;
+
+private:
+    // top читают воры, bottom - владелец, поэтому они разнесены по разным кэш-линиям
+    struct WorkQueue
+    {
+        std::atomic<int64_t> top;
+        char topPadding[CacheLineSize];
+        std::atomic<int64_t> bottom;
+        size_t base;
+        char bottomPadding[CacheLineSize];
+    };
+
+    void WorkerLoop(uint32_t index);
+    void RunChunks(uint32_t index);
+    bool PopChunk(uint32_t index, size_t* pChunk);
+    bool StealChunk(uint32_t index, size_t* pChunk);
+    void RunChunk(size_t chunk);
+
+    std::vector<std::thread> m_threads;
+    std::unique_ptr<WorkQueue[]> m_queues;
+    uint32_t m_threadCount;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    uint64_t m_generation;
+    bool m_batchOpen;
+    bool m_stop;
+
+    const RangeJob* m_pJob;
+    size_t m_count;
+    size_t m_chunkSize;
+    std::atomic<size_t> m_pendingChunks;
+    std::atomic<uint32_t> m_activeWorkers;
+    std::atomic<uint64_t> m_stolenChunks;
+};
+
+#endif
@@ -1,182 +1,333 @@
-﻿#include "framework.h"
-#include "Lab8.h"
-#include "RenderClass.h"
-#include <dxgi.h>
-#include <d3d11.h>
-#include <string>
-
-#include "imgui.h"
-#include "imgui_impl_win32.h"
-#include "imgui_impl_dx11.h"
-
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "dxgi.lib")
-
-#define MAX_LOADSTRING 100
-
-// Глобальные переменные
-WCHAR szTitle[MAX_LOADSTRING] = L"Advanced Lab8 Kazakevich";
-WCHAR szWindowClass[MAX_LOADSTRING] = L"AdvancedLab8Class";
-extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
-
-RenderClass* g_Render = nullptr; 
-
-ATOM RegisterWindowClass(HINSTANCE hInstance);
-BOOL InitializeApplication(HINSTANCE hInstance, int nCmdShow);
-LRESULT CALLBACK WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
-void HandleWindowResize(HWND hWnd);
-
-int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
-    _In_opt_ HINSTANCE hPrevInstance,
-    _In_ LPWSTR lpCmdLine,
-    _In_ int nCmdShow)
-{
-    UNREFERENCED_PARAMETER(hPrevInstance);
-    UNREFERENCED_PARAMETER(lpCmdLine);
-
-    if (!RegisterWindowClass(hInstance))
-    {
-        OutputDebugString(_T("Не удалось зарегистрировать класс окна\n"));
-        return FALSE;
-    }
-
-    if (!InitializeApplication(hInstance, nCmdShow))
-    {
-        OutputDebugString(_T("Не удалось инициализировать приложение\n"));
-        return FALSE;
-    }
-
-    MSG msg = {};
-    while (msg.message != WM_QUIT)
-    {
-        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
-        {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-        }
-        else
-        {
-            if (g_Render)
-                g_Render->Render();
-        }
-    }
-
-    if (g_Render)
-    {
-        g_Render->Terminate();
-        delete g_Render;
-        g_Render = nullptr;
-    }
-
-    return (int)msg.wParam;
-}
-
-ATOM RegisterWindowClass(HINSTANCE hInstance)
-{
-    WNDCLASSEXW wcex = {};
-    wcex.cbSize = sizeof(WNDCLASSEX);
-    wcex.style = CS_HREDRAW | CS_VREDRAW;
-    wcex.lpfnWndProc = WindowProc;
-    wcex.hInstance = hInstance;
-    wcex.hCursor = LoadCursor(nullptr, IDC_ARROW);
-    wcex.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
-    wcex.lpszClassName = szWindowClass;
-    wcex.hIconSm = LoadIcon(hInstance, MAKEINTRESOURCE(IDI_SMALL));
-
-    return RegisterClassExW(&wcex);
-}
-
-BOOL InitializeApplication(HINSTANCE hInstance, int nCmdShow)
-{
-    HWND hWnd = CreateWindowW(szWindowClass, szTitle, WS_OVERLAPPEDWINDOW,
-        CW_USEDEFAULT, 0, CW_USEDEFAULT, 0,
-        nullptr, nullptr, hInstance, nullptr);
-    if (!hWnd)
-    {
-        OutputDebugString(_T("Не удалось создать окно\n"));
-        return FALSE;
-    }
-
-    g_Render = new RenderClass();
-    if (FAILED(g_Render->Init(hWnd, szTitle, szWindowClass)))
-    {
-        OutputDebugString(_T("Не удалось инициализировать рендерер\n"));
-        delete g_Render;
-        g_Render = nullptr;
-        return FALSE;
-    }
-
-    ShowWindow(hWnd, nCmdShow);
-    UpdateWindow(hWnd);
-
-    return TRUE;
-}
-
-LRESULT CALLBACK WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
-{
-    if (ImGui_ImplWin32_WndProcHandler(hWnd, message, wParam, lParam))
-        return true;
-    switch (message)
-    {
-    case WM_SIZE:
-        HandleWindowResize(hWnd);
-        break;
-
-    case WM_KEYDOWN:
-        if (g_Render)
-        {
-            switch (wParam)
-            {
-            case 'W': // Вращение вверх
-                g_Render->RotateCamera(0.0f, 0.01f);
-                break;
-            case 'S': // Вращение вниз
-                g_Render->RotateCamera(0.0f, -0.01f);
-                break;
-            case 'A': // Вращение влево
-                g_Render->RotateCamera(-0.01f, 0.0f);
-                break;
-            case 'D': // Вращение вправо
-                g_Render->RotateCamera(0.01f, 0.0f);
-                break;
-            case VK_UP:
-                g_Render->MoveCamera(0.0f, 1.0f, 0.0f);
-                break;
-            case VK_DOWN:
-                g_Render->MoveCamera(0.0f, -1.0f, 0.0f);
-                break;
-            case VK_LEFT:
-                g_Render->MoveCamera(-1.0f, 0.0f, 0.0f);
-                break;
-            case VK_RIGHT:
-                g_Render->MoveCamera(1.0f, 0.0f, 0.0f);
-                break;
-            case VK_ADD:
-            case 0xBB:
-                g_Render->MoveCamera(0.0f, 0.0f, 1.0f);
-                break;
-            case VK_SUBTRACT:
-            case 0xBD:
-                g_Render->MoveCamera(0.0f, 0.0f, -1.0f);
-                break;
-            }
-        }
-        break;
-
-    case WM_DESTROY:
-        PostQuitMessage(0);
-        break;
-
-    default:
-        return DefWindowProc(hWnd, message, wParam, lParam);
-    }
-    return 0;
-}
-
-void HandleWindowResize(HWND hWnd)
-{
-    if (g_Render)
-        g_Render->Resize(hWnd);
-}
-
-
+﻿#include "framework.h"
+#include "Lab8.h"
+#include "RenderClass.h"
+#include "CullingBenchmark.h"
+#include "ShaderBenchmark.h"
+#include "FrameBenchmark.h"
+#include "CommandLine.h"
+#include <dxgi.h>
+#include <d3d11.h>
+#include <string>
+
+#include "imgui.h"
+#include "imgui_impl_win32.h"
+#include "imgui_impl_dx11.h"
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "dxgi.lib")
+
+#define MAX_LOADSTRING 100
+
+// Глобальные переменные
+WCHAR szTitle[MAX_LOADSTRING] = L"Advanced Lab8 Kazakevich";
+WCHAR szWindowClass[MAX_LOADSTRING] = L"AdvancedLab8Class";
+extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam);
+
+RenderClass* g_Render = nullptr; 
+UINT g_InstanceCount = 23;
+
+ATOM RegisterWindowClass(HINSTANCE hInstance);
+BOOL InitializeApplication(HINSTANCE hInstance, int nCmdShow);
+LRESULT CALLBACK WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
+void HandleWindowResize(HWND hWnd);
+int RunCullingBenchmarkMode(const CommandLine& commandLine);
+int RunShaderBenchmarkMode();
+int RunFrameBenchmarkMode(const CommandLine& commandLine);
+
+// Режимы без окна и ключи приложения и замеров
+const CommandLineOption g_Options[] = {
+    { "benchcull", OptionValue::None, nullptr },
+    { "precompileshaders", OptionValue::None, nullptr },
+    { "benchshaders", OptionValue::None, nullptr },
+    { "benchframes", OptionValue::None, nullptr },
+    { "instances", OptionValue::Uint, nullptr },
+    { "frames", OptionValue::Uint, nullptr },
+    { "threads", OptionValue::Uint, nullptr },
+    { "path", OptionValue::Text, "static|orbit|flythrough" }
+};
+
+int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
+    _In_opt_ HINSTANCE hPrevInstance,
+    _In_ LPWSTR lpCmdLine,
+    _In_ int nCmdShow)
+{
+    UNREFERENCED_PARAMETER(hPrevInstance);
+
+    CommandLine commandLine;
+    if (!commandLine.Parse(lpCmdLine, g_Options, ARRAYSIZE(g_Options)))
+    {
+        if (!commandLine.HelpRequested())
+            OutputDebugStringA((commandLine.GetError() + "\n").c_str());
+        OutputDebugStringA(("Usage: Lab8.exe " + CommandLine::GetUsage(g_Options, ARRAYSIZE(g_Options)) + "\n").c_str());
+        return commandLine.HelpRequested() ? 0 : 1;
+    }
+
+    // Замер отсечения без окна: Lab8.exe benchcull [instances N]
+    if (commandLine.Has("benchcull"))
+        return RunCullingBenchmarkMode(commandLine);
+
+    // Офлайн-компиляция шейдеров в ShaderCache и замер запуска cold/warm/precompiled
+    if (commandLine.Has("precompileshaders"))
+        return PrecompileShaders(L"ShaderCache") ? 0 : 1;
+    if (commandLine.Has("benchshaders"))
+        return RunShaderBenchmarkMode();
+
+    // Кадр без окна и GPU по сценарию камеры: Lab8.exe benchframes [instances N] [frames N] [threads N] [path static|orbit|flythrough]
+    if (commandLine.Has("benchframes"))
+        return RunFrameBenchmarkMode(commandLine);
+
+    // Число кубов задаётся ключом "-instances N" или "--instances=N"
+    g_InstanceCount = commandLine.GetUint("instances", g_InstanceCount);
+
+    if (!RegisterWindowClass(hInstance))
+    {
+        OutputDebugString(_T("Не удалось зарегистрировать класс окна\n"));
+        return FALSE;
+    }
+
+    if (!InitializeApplication(hInstance, nCmdShow))
+    {
+        OutputDebugString(_T("Не удалось инициализировать приложение\n"));
+        return FALSE;
+    }
+
+    MSG msg = {};
+    while (msg.message != WM_QUIT)
+    {
+        if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE))
+        {
+            TranslateMessage(&msg);
+            DispatchMessage(&msg);
+        }
+        else
+        {
+            if (g_Render)
+                g_Render->Render();
+        }
+    }
+
+    if (g_Render)
+    {
+        g_Render->Terminate();
+        delete g_Render;
+        g_Render = nullptr;
+    }
+
+    return (int)msg.wParam;
+}
+
+ATOM RegisterWindowClass(HINSTANCE hInstance)
+{
+    WNDCLASSEXW wcex = {};
+    wcex.cbSize = sizeof(WNDCLASSEX);
+    wcex.style = CS_HREDRAW | CS_VREDRAW;
+    wcex.lpfnWndProc = WindowProc;
+    wcex.hInstance = hInstance;
+    wcex.hCursor = LoadCursor(nullptr, IDC_ARROW);
+    wcex.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
+    wcex.lpszClassName = szWindowClass;
+    wcex.hIconSm = LoadIcon(hInstance, MAKEINTRESOURCE(IDI_SMALL));
+
+    return RegisterClassExW(&wcex);
+}
+
+BOOL InitializeApplication(HINSTANCE hInstance, int nCmdShow)
+{
+    HWND hWnd = CreateWindowW(szWindowClass, szTitle, WS_OVERLAPPEDWINDOW,
+        CW_USEDEFAULT, 0, CW_USEDEFAULT, 0,
+        nullptr, nullptr, hInstance, nullptr);
+    if (!hWnd)
+    {
+        OutputDebugString(_T("Не удалось создать окно\n"));
+        return FALSE;
+    }
+
+    g_Render = new RenderClass();
+    g_Render->SetInstanceCount(g_InstanceCount);
+    if (FAILED(g_Render->Init(hWnd, szTitle, szWindowClass)))
+    {
+        OutputDebugString(_T("Не удалось инициализировать рендерер\n"));
+        delete g_Render;
+        g_Render = nullptr;
+        return FALSE;
+    }
+
+    ShowWindow(hWnd, nCmdShow);
+    UpdateWindow(hWnd);
+
+    return TRUE;
+}
+
+LRESULT CALLBACK WindowProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
+{
+    if (ImGui_ImplWin32_WndProcHandler(hWnd, message, wParam, lParam))
+        return true;
+    switch (message)
+    {
+    case WM_SIZE:
+        HandleWindowResize(hWnd);
+        break;
+
+    case WM_KEYDOWN:
+        if (g_Render)
+        {
+            switch (wParam)
+            {
+            case 'W': // Вращение вверх
+                g_Render->RotateCamera(0.0f, 0.01f);
+                break;
+            case 'S': // Вращение вниз
+                g_Render->RotateCamera(0.0f, -0.01f);
+                break;
+            case 'A': // Вращение влево
+                g_Render->RotateCamera(-0.01f, 0.0f);
+                break;
+            case 'D': // Вращение вправо
+                g_Render->RotateCamera(0.01f, 0.0f);
+                break;
+            case VK_UP:
+                g_Render->MoveCamera(0.0f, 1.0f, 0.0f);
+                break;
+            case VK_DOWN:
+                g_Render->MoveCamera(0.0f, -1.0f, 0.0f);
+                break;
+            case VK_LEFT:
+                g_Render->MoveCamera(-1.0f, 0.0f, 0.0f);
+                break;
+            case VK_RIGHT:
+                g_Render->MoveCamera(1.0f, 0.0f, 0.0f);
+                break;
+            case VK_ADD:
+            case 0xBB:
+                g_Render->MoveCamera(0.0f, 0.0f, 1.0f);
+                break;
+            case VK_SUBTRACT:
+            case 0xBD:
+                g_Render->MoveCamera(0.0f, 0.0f, -1.0f);
+                break;
+            }
+        }
+        break;
+
+    case WM_DESTROY:
+        PostQuitMessage(0);
+        break;
+
+    default:
+        return DefWindowProc(hWnd, message, wParam, lParam);
+    }
+    return 0;
+}
+
+void HandleWindowResize(HWND hWnd)
+{
+    if (g_Render)
+        g_Render->Resize(hWnd);
+}
+
+int RunCullingBenchmarkMode(const CommandLine& commandLine)
+{
+    UINT count = commandLine.GetUint("instances", 1000000);
+
+    std::vector<CullingBenchmarkResult> results;
+    std::vector<CullingPathResult> pathResults;
+    if (!RunCullingPathBenchmark(count, 20, pathResults) || !RunCullingBenchmark(count, 64, 20, results) ||
+        !WriteCullingBenchmarkCsv("cull_benchmark.csv", results))
+    {
+        OutputDebugString(_T("Не удалось выполнить замер отсечения\n"));
+        return 1;
+    }
+
+    for (const CullingPathResult& result : pathResults)
+    {
+        wchar_t line[128];
+        swprintf_s(line, L"%hs: %.3f ms, visible %zu%s\n", FrustumCuller::GetPathName(result.path), result.cullMs,
+            result.visibleCount, result.matchesScalar ? L"" : L" MISMATCH");
+        OutputDebugString(line);
+    }
+
+    for (const CullingBenchmarkResult& result : results)
+    {
+        wchar_t line[128];
+        swprintf_s(line, L"threads %u: %.3f ms (rebuild %.3f, cull %.3f)%s\n", result.threadCount, result.totalMs,
+            result.rebuildMs, result.cullMs, result.matchesSingleThread ? L"" : L" MISMATCH");
+        OutputDebugString(line);
+    }
+    return 0;
+}
+
+int RunShaderBenchmarkMode()
+{
+    std::vector<ShaderBenchmarkResult> results;
+    if (!RunShaderBenchmark(5, results) || !WriteShaderBenchmarkCsv("shader_benchmark.csv", results))
+    {
+        OutputDebugString(_T("Не удалось выполнить замер загрузки шейдеров\n"));
+        return 1;
+    }
+
+    for (const ShaderBenchmarkResult& result : results)
+    {
+        wchar_t line[128];
+        swprintf_s(line, L"%hs: %.3f ms for %u shaders (min %.3f, max %.3f)\n", result.mode, result.totalMs,
+            result.shaderCount, result.minMs, result.maxMs);
+        OutputDebugString(line);
+    }
+    return 0;
+}
+
+int RunFrameBenchmarkMode(const CommandLine& commandLine)
+{
+    // Без явного числа кубов и сценария - сетка из трёх размеров сцены по двум сценариям
+    std::vector<UINT> counts = { 10000, 100000, 1000000 };
+    if (commandLine.Has("instances"))
+        counts.assign(1, commandLine.GetUint("instances", 23));
+
+    std::vector<CameraPath> paths = { CameraPath::Orbit, CameraPath::FlyThrough };
+    const char* pathOption = commandLine.GetText("path");
+    if (pathOption)
+    {
+        CameraPath path;
+        if (!ParseCameraPath(pathOption, &path))
+        {
+            OutputDebugString(_T("Неизвестный сценарий камеры\n"));
+            return 1;
+        }
+        paths.assign(1, path);
+    }
+
+    FrameBenchmarkConfig config = {};
+    config.frameCount = commandLine.GetUint("frames", 600);
+    config.warmupFrames = 60;
+    config.threadCount = commandLine.GetUint("threads", 0);
+    config.aspect = 16.0f / 9.0f;
+
+    std::vector<FrameBenchmarkResult> results;
+    for (CameraPath path : paths)
+    {
+        for (UINT count : counts)
+        {
+            config.instanceCount = count;
+            config.path = path;
+
+            FrameBenchmarkResult result;
+            if (!RunFrameBenchmark(config, result))
+            {
+                OutputDebugString(_T("Не удалось выполнить замер кадра\n"));
+                return 1;
+            }
+            results.push_back(result);
+
+            wchar_t line[160];
+            swprintf_s(line, L"%hs, %u cubes: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, checksum %016llx\n",
+                GetCameraPathName(path), count, result.frame.p50Ms, result.frame.p95Ms, result.frame.p99Ms, result.checksum);
+            OutputDebugString(line);
+        }
+    }
+
+    if (!WriteFrameBenchmarkJson("frame_benchmark.json", results) || !WriteFrameBenchmarkCsv("frame_benchmark.csv", results))
+    {
+        OutputDebugString(_T("Не удалось записать результаты замера кадра\n"));
+        return 1;
+    }
+    return 0;
+}
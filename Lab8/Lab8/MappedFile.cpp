@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile() :
+    m_pData(nullptr),
+    m_size(0),
+#ifdef _WIN32
+    m_hFile(INVALID_HANDLE_VALUE),
+    m_hMapping(nullptr)
+#else
+    m_fd(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::wstring& path) {
+    Close();
+
+    m_hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_hFile == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(m_hFile, &size) || size.QuadPart == 0) {
+        Close();
+        return false;
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    m_hMapping = CreateFileMappingW(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_hMapping) {
+        Close();
+        return false;
+    }
+
+    m_pData = static_cast<const uint8_t*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!m_pData) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_pData) {
+        UnmapViewOfFile(m_pData);
+        m_pData = nullptr;
+    }
+    if (m_hMapping) {
+        CloseHandle(m_hMapping);
+        m_hMapping = nullptr;
+    }
+    if (m_hFile != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hFile);
+        m_hFile = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::wstring& path) {
+    Close();
+
+    std::string narrowPath(path.size() * 4 + 1, '\0');
+    size_t length = wcstombs(&narrowPath[0], path.c_str(), narrowPath.size());
+    if (length == static_cast<size_t>(-1))
+        return false;
+    narrowPath.resize(length);
+
+    m_fd = open(narrowPath.c_str(), O_RDONLY);
+    if (m_fd < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(m_fd, &info) != 0 || info.st_size == 0) {
+        Close();
+        return false;
+    }
+    m_size = static_cast<size_t>(info.st_size);
+
+    void* pData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (pData == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    m_pData = static_cast<const uint8_t*>(pData);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (m_pData) {
+        munmap(const_cast<uint8_t*>(m_pData), m_size);
+        m_pData = nullptr;
+    }
+    if (m_fd >= 0) {
+        close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+}
+
+#endif
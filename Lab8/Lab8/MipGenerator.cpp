@@ -0,0 +1,414 @@
+#include "MipGenerator.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MIP_GENERATOR_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define MIP_GENERATOR_SSE2_TARGET
+#else
+#define MIP_GENERATOR_SSE2_TARGET __attribute__((target("sse2")))
+#endif
+#endif
+
+namespace
+{
+    const float Pi = 3.14159265358979f;
+    // Радиус ядра Кайзера в выходных текселях и параметр окна
+    const float KaiserRadius = 3.0f;
+    const float KaiserAlpha = 4.0f;
+
+    float ToLinear(float value) {
+        return value <= 0.04045f ? value / 12.92f : powf((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    struct ConversionTables
+    {
+        float srgbToLinear[256];
+        float unormToFloat[256];
+        // Линейные значения посередине между соседними кодами sRGB
+        float srgbBounds[255];
+
+        ConversionTables() {
+            for (int i = 0; i < 256; ++i) {
+                srgbToLinear[i] = ToLinear(i / 255.0f);
+                unormToFloat[i] = i / 255.0f;
+            }
+            for (int i = 0; i < 255; ++i)
+                srgbBounds[i] = ToLinear((i + 0.5f) / 255.0f);
+        }
+    };
+
+    const ConversionTables& GetTables() {
+        static const ConversionTables tables;
+        return tables;
+    }
+
+    // Число границ меньше value - это ровно round(255 * sRGB(value))
+    uint8_t EncodeSrgb(const float* pBounds, float value) {
+        uint32_t code = 0;
+        for (uint32_t step = 128; step > 0; step >>= 1) {
+            if (code + step <= 255 && pBounds[code + step - 1] < value)
+                code += step;
+        }
+        return static_cast<uint8_t>(code);
+    }
+
+    uint8_t EncodeUnorm(float value) {
+        // Сравнения записаны так, чтобы NaN давал 0, как _mm_max_ps в SSE2-версии
+        value = value > 0.0f ? value : 0.0f;
+        value = value < 1.0f ? value : 1.0f;
+        return static_cast<uint8_t>(static_cast<int>(value * 255.0f + 0.5f));
+    }
+
+    float Sinc(float x) {
+        x *= Pi;
+        return fabsf(x) < 1e-6f ? 1.0f : sinf(x) / x;
+    }
+
+    double BesselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 64 && term > 1e-12 * sum; ++k) {
+            double half = x / (2.0 * k);
+            term *= half * half;
+            sum += term;
+        }
+        return sum;
+    }
+
+    float Kaiser(float t) {
+        if (fabsf(t) >= 1.0f)
+            return 0.0f;
+        return static_cast<float>(BesselI0(KaiserAlpha * sqrt(1.0 - t * t)) / BesselI0(KaiserAlpha));
+    }
+}
+
+MipGenerator::MipGenerator() :
+    m_path(DetectBestPath())
+{
+}
+
+uint32_t MipGenerator::CountMips(uint32_t width, uint32_t height) {
+    uint32_t count = 1;
+    while (width > 1 || height > 1) {
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+        ++count;
+    }
+    return count;
+}
+
+void MipGenerator::Clear() {
+    m_levels.clear();
+    m_pixels.clear();
+}
+
+bool MipGenerator::Generate(const uint8_t* pPixels, uint32_t width, uint32_t height, size_t rowPitch, bool srgb, Filter filter) {
+    Clear();
+    if (!pPixels || width == 0 || height == 0 || rowPitch < size_t(width) * 4)
+        return false;
+
+    const uint32_t levelCount = CountMips(width, height);
+    m_levels.resize(levelCount);
+    m_levels[0] = { width, height, rowPitch, pPixels };
+
+    size_t bytes = 0;
+    for (uint32_t mip = 1; mip < levelCount; ++mip) {
+        uint32_t w = (width >> mip) ? (width >> mip) : 1;
+        uint32_t h = (height >> mip) ? (height >> mip) : 1;
+        bytes += size_t(w) * h * 4;
+    }
+    m_pixels.resize(bytes);
+
+    // Каждый уровень строится из предыдущего во float, без потерь на промежуточном 8-битном округлении
+    std::vector<float> current(size_t(width) * height * 4);
+    std::vector<float> rows;
+    std::vector<float> next;
+    Decode(pPixels, width, height, rowPitch, srgb, current.data());
+
+    size_t offset = 0;
+    uint32_t w = width;
+    uint32_t h = height;
+    for (uint32_t mip = 1; mip < levelCount; ++mip) {
+        uint32_t nw = w > 1 ? w / 2 : 1;
+        uint32_t nh = h > 1 ? h / 2 : 1;
+        next.resize(size_t(nw) * nh * 4);
+        uint8_t* pLevel = m_pixels.data() + offset;
+        Resample(current.data(), w, h, nw, nh, filter, rows, next.data());
+        Encode(next.data(), size_t(nw) * nh, srgb, pLevel);
+
+        m_levels[mip] = { nw, nh, size_t(nw) * 4, pLevel };
+        offset += size_t(nw) * nh * 4;
+        current.swap(next);
+        w = nw;
+        h = nh;
+    }
+    return true;
+}
+
+bool MipGenerator::Resize(const uint8_t* pPixels, uint32_t width, uint32_t height, size_t rowPitch,
+    uint32_t newWidth, uint32_t newHeight, bool srgb, Filter filter, std::vector<uint8_t>& pixels) const {
+    if (!pPixels || width == 0 || height == 0 || newWidth == 0 || newHeight == 0 || rowPitch < size_t(width) * 4)
+        return false;
+
+    std::vector<float> source(size_t(width) * height * 4);
+    std::vector<float> rows;
+    std::vector<float> result(size_t(newWidth) * newHeight * 4);
+    Decode(pPixels, width, height, rowPitch, srgb, source.data());
+    Resample(source.data(), width, height, newWidth, newHeight, filter, rows, result.data());
+
+    pixels.resize(size_t(newWidth) * newHeight * 4);
+    Encode(result.data(), size_t(newWidth) * newHeight, srgb, pixels.data());
+    return true;
+}
+
+void MipGenerator::Resample(const float* pSrc, uint32_t width, uint32_t height, uint32_t newWidth, uint32_t newHeight, Filter filter,
+    std::vector<float>& rows, float* pDst) const {
+    Taps tapsX;
+    Taps tapsY;
+    BuildTaps(width, newWidth, filter, tapsX);
+    BuildTaps(height, newHeight, filter, tapsY);
+
+    rows.resize(size_t(newWidth) * height * 4);
+    if (m_path == Path::SSE2) {
+        ResampleRowsSSE2(pSrc, width, height, tapsX, rows.data(), newWidth);
+        ResampleColumnsSSE2(rows.data(), newWidth, tapsY, pDst, newHeight);
+    } else {
+        ResampleRowsScalar(pSrc, width, height, tapsX, rows.data(), newWidth);
+        ResampleColumnsScalar(rows.data(), newWidth, tapsY, pDst, newHeight);
+    }
+}
+
+void MipGenerator::Encode(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst) const {
+    if (m_path == Path::SSE2)
+        EncodeSSE2(pSrc, texels, srgb, pDst);
+    else
+        EncodeScalar(pSrc, texels, srgb, pDst);
+}
+
+void MipGenerator::BuildTaps(uint32_t srcSize, uint32_t dstSize, Filter filter, Taps& taps) {
+    const float scale = static_cast<float>(srcSize) / dstSize;
+    // При уменьшении ядро растягивается, чтобы не пропускать частоты выше новой Найквиста
+    const float support = scale > 1.0f ? scale : 1.0f;
+
+    std::vector<std::vector<float>> weights(dstSize);
+    taps.first.resize(dstSize);
+    taps.count.resize(dstSize);
+    taps.stride = 0;
+    for (uint32_t x = 0; x < dstSize; ++x) {
+        float lo = 0.0f;
+        float hi = 0.0f;
+        const float center = (x + 0.5f) * scale;
+        if (filter == Filter::Box) {
+            lo = x * scale;
+            hi = (x + 1) * scale;
+            // При увеличении площадь меньше текселя - берём ближайший
+            if (hi - lo < 1.0f) {
+                lo = floorf(center);
+                hi = lo + 1.0f;
+            }
+        } else {
+            lo = center - KaiserRadius * support;
+            hi = center + KaiserRadius * support;
+        }
+
+        int begin = static_cast<int>(floorf(lo));
+        int end = static_cast<int>(ceilf(hi));
+        int first = begin < 0 ? 0 : begin;
+        int last = end - 1 < static_cast<int>(srcSize) - 1 ? end - 1 : static_cast<int>(srcSize) - 1;
+        std::vector<float>& row = weights[x];
+        row.assign(last - first + 1, 0.0f);
+
+        float sum = 0.0f;
+        for (int i = begin; i < end; ++i) {
+            float weight = 0.0f;
+            if (filter == Filter::Box) {
+                float a = lo > i ? lo : static_cast<float>(i);
+                float b = hi < i + 1 ? hi : static_cast<float>(i + 1);
+                weight = b > a ? b - a : 0.0f;
+            } else {
+                float t = (i + 0.5f - center) / support;
+                weight = Sinc(t) * Kaiser(t / KaiserRadius);
+            }
+            // За краем повторяется крайний тексель
+            int clamped = i < first ? first : (i > last ? last : i);
+            row[clamped - first] += weight;
+            sum += weight;
+        }
+        if (sum != 0.0f) {
+            for (float& weight : row)
+                weight /= sum;
+        }
+
+        taps.first[x] = static_cast<uint32_t>(first);
+        taps.count[x] = static_cast<uint32_t>(row.size());
+        if (taps.count[x] > taps.stride)
+            taps.stride = taps.count[x];
+    }
+
+    taps.weights.assign(size_t(dstSize) * taps.stride, 0.0f);
+    for (uint32_t x = 0; x < dstSize; ++x)
+        memcpy(&taps.weights[size_t(x) * taps.stride], weights[x].data(), sizeof(float) * weights[x].size());
+}
+
+void MipGenerator::Decode(const uint8_t* pSrc, uint32_t width, uint32_t height, size_t rowPitch, bool srgb, float* pDst) {
+    const ConversionTables& tables = GetTables();
+    const float* pColor = srgb ? tables.srgbToLinear : tables.unormToFloat;
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* pRow = pSrc + y * rowPitch;
+        for (uint32_t x = 0; x < width; ++x, pRow += 4, pDst += 4) {
+            pDst[0] = pColor[pRow[0]];
+            pDst[1] = pColor[pRow[1]];
+            pDst[2] = pColor[pRow[2]];
+            pDst[3] = tables.unormToFloat[pRow[3]];
+        }
+    }
+}
+
+void MipGenerator::ResampleRowsScalar(const float* pSrc, uint32_t srcWidth, uint32_t rows, const Taps& taps, float* pDst, uint32_t dstWidth) {
+    for (uint32_t y = 0; y < rows; ++y) {
+        const float* pRow = pSrc + size_t(y) * srcWidth * 4;
+        float* pOut = pDst + size_t(y) * dstWidth * 4;
+        for (uint32_t x = 0; x < dstWidth; ++x, pOut += 4) {
+            const float* pWeights = &taps.weights[size_t(x) * taps.stride];
+            const float* pTexel = pRow + size_t(taps.first[x]) * 4;
+            float sum[4] = {};
+            for (uint32_t k = 0; k < taps.count[x]; ++k, pTexel += 4) {
+                for (int c = 0; c < 4; ++c)
+                    sum[c] = sum[c] + pWeights[k] * pTexel[c];
+            }
+            memcpy(pOut, sum, sizeof(sum));
+        }
+    }
+}
+
+void MipGenerator::ResampleColumnsScalar(const float* pSrc, uint32_t width, const Taps& taps, float* pDst, uint32_t dstHeight) {
+    const size_t rowFloats = size_t(width) * 4;
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        float* pOut = pDst + y * rowFloats;
+        memset(pOut, 0, sizeof(float) * rowFloats);
+        for (uint32_t k = 0; k < taps.count[y]; ++k) {
+            const float weight = taps.weights[size_t(y) * taps.stride + k];
+            const float* pRow = pSrc + (taps.first[y] + k) * rowFloats;
+            for (size_t i = 0; i < rowFloats; ++i)
+                pOut[i] = pOut[i] + weight * pRow[i];
+        }
+    }
+}
+
+void MipGenerator::EncodeScalar(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst) {
+    const float* pBounds = GetTables().srgbBounds;
+    for (size_t i = 0; i < texels; ++i, pSrc += 4, pDst += 4) {
+        for (int c = 0; c < 3; ++c)
+            pDst[c] = srgb ? EncodeSrgb(pBounds, pSrc[c]) : EncodeUnorm(pSrc[c]);
+        pDst[3] = EncodeUnorm(pSrc[3]);
+    }
+}
+
+#ifdef MIP_GENERATOR_X86
+
+MIP_GENERATOR_SSE2_TARGET
+void MipGenerator::ResampleRowsSSE2(const float* pSrc, uint32_t srcWidth, uint32_t rows, const Taps& taps, float* pDst, uint32_t dstWidth) {
+    for (uint32_t y = 0; y < rows; ++y) {
+        const float* pRow = pSrc + size_t(y) * srcWidth * 4;
+        float* pOut = pDst + size_t(y) * dstWidth * 4;
+        for (uint32_t x = 0; x < dstWidth; ++x, pOut += 4) {
+            const float* pWeights = &taps.weights[size_t(x) * taps.stride];
+            const float* pTexel = pRow + size_t(taps.first[x]) * 4;
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t k = 0; k < taps.count[x]; ++k, pTexel += 4)
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(pWeights[k]), _mm_loadu_ps(pTexel)));
+            _mm_storeu_ps(pOut, sum);
+        }
+    }
+}
+
+MIP_GENERATOR_SSE2_TARGET
+void MipGenerator::ResampleColumnsSSE2(const float* pSrc, uint32_t width, const Taps& taps, float* pDst, uint32_t dstHeight) {
+    const size_t rowFloats = size_t(width) * 4;
+    for (uint32_t y = 0; y < dstHeight; ++y) {
+        float* pOut = pDst + y * rowFloats;
+        memset(pOut, 0, sizeof(float) * rowFloats);
+        for (uint32_t k = 0; k < taps.count[y]; ++k) {
+            const __m128 weight = _mm_set1_ps(taps.weights[size_t(y) * taps.stride + k]);
+            const float* pRow = pSrc + (taps.first[y] + k) * rowFloats;
+            // Строка - целое число текселей, то есть кратна четырём float
+            for (size_t i = 0; i < rowFloats; i += 4)
+                _mm_storeu_ps(pOut + i, _mm_add_ps(_mm_loadu_ps(pOut + i), _mm_mul_ps(weight, _mm_loadu_ps(pRow + i))));
+        }
+    }
+}
+
+MIP_GENERATOR_SSE2_TARGET
+void MipGenerator::EncodeSSE2(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst) {
+    // Кодирование sRGB - поиск по таблице границ, он остаётся скалярным
+    if (srgb) {
+        EncodeScalar(pSrc, texels, srgb, pDst);
+        return;
+    }
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    size_t i = 0;
+    for (; i + 4 <= texels; i += 4, pSrc += 16, pDst += 16) {
+        __m128i values[4];
+        for (int k = 0; k < 4; ++k) {
+            __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pSrc + 4 * k), zero), one);
+            values[k] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half));
+        }
+        __m128i packed = _mm_packus_epi16(_mm_packs_epi32(values[0], values[1]), _mm_packs_epi32(values[2], values[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst), packed);
+    }
+    EncodeScalar(pSrc, texels - i, false, pDst);
+}
+
+MipGenerator::Path MipGenerator::DetectBestPath() {
+#if defined(_M_X64) || defined(__x86_64__)
+    // SSE2 входит в x64
+    return Path::SSE2;
+#elif defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) ? Path::SSE2 : Path::Scalar;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2") ? Path::SSE2 : Path::Scalar;
+#endif
+}
+
+#else
+
+void MipGenerator::ResampleRowsSSE2(const float* pSrc, uint32_t srcWidth, uint32_t rows, const Taps& taps, float* pDst, uint32_t dstWidth) {
+    ResampleRowsScalar(pSrc, srcWidth, rows, taps, pDst, dstWidth);
+}
+
+void MipGenerator::ResampleColumnsSSE2(const float* pSrc, uint32_t width, const Taps& taps, float* pDst, uint32_t dstHeight) {
+    ResampleColumnsScalar(pSrc, width, taps, pDst, dstHeight);
+}
+
+void MipGenerator::EncodeSSE2(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst) {
+    EncodeScalar(pSrc, texels, srgb, pDst);
+}
+
+MipGenerator::Path MipGenerator::DetectBestPath() {
+    return Path::Scalar;
+}
+
+#endif
+
+void MipGenerator::SetPath(Path path) {
+    // Нельзя выбрать путь, который процессор не поддерживает
+    Path best = DetectBestPath();
+    if (static_cast<int>(path) > static_cast<int>(best))
+        path = best;
+    m_path = path;
+}
+
+const char* MipGenerator::GetPathName(Path path) {
+    return path == Path::SSE2 ? "SSE2" : "Scalar";
+}
@@ -0,0 +1,94 @@
+#ifndef MIP_GENERATOR_H
+#define MIP_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Цепочка мипов на CPU для 8-битных картинок с четырьмя каналами (RGBA, BGRA).
+// Фильтр разделимый: сначала по строкам, затем по столбцам; тексель - четыре float,
+// то есть один регистр SSE2. Цвет в sRGB фильтруется в линейном пространстве, альфа -
+// как есть. Не зависит от D3D11.
+class MipGenerator
+{
+public:
+    enum class Filter
+    {
+        Box,        // среднее по покрываемой площади, для чётных размеров - 2x2
+        Kaiser      // sinc с окном Кайзера: резче и без муара на мелких деталях
+    };
+
+    enum class Path
+    {
+        Scalar,
+        SSE2
+    };
+
+    struct Level
+    {
+        uint32_t width;
+        uint32_t height;
+        size_t rowPitch;
+        const uint8_t* pPixels;
+    };
+
+    MipGenerator();
+    MipGenerator(MipGenerator&&) = default;
+    MipGenerator& operator=(MipGenerator&&) = default;
+
+    // Все мипы до 1x1. Уровень 0 - сама картинка: она не копируется и должна жить,
+    // пока нужны уровни
+    bool Generate(const uint8_t* pPixels, uint32_t width, uint32_t height, size_t rowPitch, bool srgb, Filter filter);
+    void Clear();
+
+    // Одна картинка в другой размер тем же фильтром; результат - плотные строки по width * 4
+    bool Resize(const uint8_t* pPixels, uint32_t width, uint32_t height, size_t rowPitch,
+        uint32_t newWidth, uint32_t newHeight, bool srgb, Filter filter, std::vector<uint8_t>& pixels) const;
+
+    uint32_t GetLevelCount() const { return static_cast<uint32_t>(m_levels.size()); }
+    const Level& GetLevel(uint32_t mip) const { return m_levels[mip]; }
+
+    Path GetPath() const { return m_path; }
+    void SetPath(Path path);
+    static Path DetectBestPath();
+    static const char* GetPathName(Path path);
+
+    static uint32_t CountMips(uint32_t width, uint32_t height);
+
+    // Веса одного прохода: для каждого выходного текселя - отрезок [first, first + count)
+    // входной строки или столбца; края уже свёрнуты в крайние тексели
+    struct Taps
+    {
+        uint32_t stride;
+        std::vector<uint32_t> first;
+        std::vector<uint32_t> count;
+        std::vector<float> weights;
+    };
+
+    static void BuildTaps(uint32_t srcSize, uint32_t dstSize, Filter filter, Taps& taps);
+
+    // Эталонная реализация; SSE2 повторяет тот же порядок операций, поэтому результаты совпадают побитно
+    static void ResampleRowsScalar(const float* pSrc, uint32_t srcWidth, uint32_t rows, const Taps& taps, float* pDst, uint32_t dstWidth);
+    static void ResampleColumnsScalar(const float* pSrc, uint32_t width, const Taps& taps, float* pDst, uint32_t dstHeight);
+    static void EncodeScalar(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst);
+    static void ResampleRowsSSE2(const float* pSrc, uint32_t srcWidth, uint32_t rows, const Taps& taps, float* pDst, uint32_t dstWidth);
+    static void ResampleColumnsSSE2(const float* pSrc, uint32_t width, const Taps& taps, float* pDst, uint32_t dstHeight);
+    static void EncodeSSE2(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst);
+
+    static void Decode(const uint8_t* pSrc, uint32_t width, uint32_t height, size_t rowPitch, bool srgb, float* pDst);
+
+private:
+    // Float-картинка в новый размер: сначала строки в rows, затем столбцы в pDst
+    void Resample(const float* pSrc, uint32_t width, uint32_t height, uint32_t newWidth, uint32_t newHeight, Filter filter,
+        std::vector<float>& rows, float* pDst) const;
+    void Encode(const float* pSrc, size_t texels, bool srgb, uint8_t* pDst) const;
+
+    MipGenerator(const MipGenerator&) = delete;
+    MipGenerator& operator=(const MipGenerator&) = delete;
+
+    std::vector<Level> m_levels;
+    std::vector<uint8_t> m_pixels;
+    Path m_path;
+};
+
+#endif
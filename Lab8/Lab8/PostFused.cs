@@ -0,0 +1,62 @@
+// Слитый проход постобработки: покомпонентные операции цепочки по порядку над одним пикселем.
+// Коды операций совпадают с PostOp в PostProcessChain.h
+#define OP_TONEMAP 0
+#define OP_COLOR_GRADING 1
+#define OP_NEGATIVE 2
+#define OP_BLOOM_COMPOSITE 3
+
+cbuffer PostParams : register(b0)
+{
+    uint2 size;
+    float exposure;
+    float bloomIntensity;
+    float lutScale;
+    float lutOffset;
+    uint opCount;
+    uint padding;
+    uint4 ops[2];
+};
+
+Texture2D<float4> inputTexture : register(t0);
+Texture3D<float4> gradingLut : register(t1);
+Texture2D<float4> bloomTexture : register(t2);
+SamplerState samLinear : register(s0);
+RWTexture2D<float4> outputTexture : register(u0);
+
+// Аппроксимация ACES (Narkowicz)
+float3 Tonemap(float3 color)
+{
+    color *= exposure;
+    return saturate((color * (2.51f * color + 0.03f)) / (color * (2.43f * color + 0.59f) + 0.14f));
+}
+
+[numthreads(8, 8, 1)]
+void main(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= size.x || id.y >= size.y)
+        return;
+
+    float4 color = inputTexture[id.xy];
+    for (uint i = 0; i < opCount; ++i)
+    {
+        uint op = ops[i / 4][i % 4];
+        if (op == OP_TONEMAP)
+        {
+            color.rgb = Tonemap(color.rgb);
+        }
+        else if (op == OP_COLOR_GRADING)
+        {
+            color.rgb = gradingLut.SampleLevel(samLinear, saturate(color.rgb) * lutScale + lutOffset, 0).rgb;
+        }
+        else if (op == OP_NEGATIVE)
+        {
+            color.rgb = 1.0f - saturate(color.rgb);
+        }
+        else if (op == OP_BLOOM_COMPOSITE)
+        {
+            float2 uv = (id.xy + 0.5f) / size;
+            color.rgb += bloomTexture.SampleLevel(samLinear, uv, 0).rgb * bloomIntensity;
+        }
+    }
+    outputTexture[id.xy] = float4(color.rgb, 1.0f);
+}
@@ -0,0 +1,178 @@
+#include "PostProcessChain.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // Слитые проходы с одной операцией называются по стадии, с несколькими - по номеру
+    const char* const FusedNames[] = { "Fused 1", "Fused 2", "Fused 3" };
+
+    float Saturate(float value) {
+        return value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    }
+
+    uint32_t OpStage(uint32_t op) {
+        switch (op) {
+        case PostOpTonemap: return static_cast<uint32_t>(PostStage::Tonemap);
+        case PostOpColorGrading: return static_cast<uint32_t>(PostStage::ColorGrading);
+        case PostOpNegative: return static_cast<uint32_t>(PostStage::Negative);
+        default: return static_cast<uint32_t>(PostStage::Bloom);
+        }
+    }
+}
+
+PostProcessChain::PostProcessChain() :
+    m_fusion(true),
+    m_revision(0)
+{
+    // Порядок по умолчанию: свечение считается в HDR, потом тональная компрессия,
+    // коррекция и сглаживание уже в LDR
+    const PostStage order[StageCount] = { PostStage::Bloom, PostStage::Tonemap, PostStage::ColorGrading, PostStage::Fxaa, PostStage::Negative };
+    for (uint32_t i = 0; i < StageCount; ++i) {
+        m_order[i] = order[i];
+        m_enabled[i] = false;
+    }
+}
+
+void PostProcessChain::SetEnabled(PostStage stage, bool enabled) {
+    bool& current = m_enabled[static_cast<uint32_t>(stage)];
+    if (current != enabled) {
+        current = enabled;
+        ++m_revision;
+    }
+}
+
+bool PostProcessChain::Move(uint32_t position, int delta) {
+    int64_t target = static_cast<int64_t>(position) + delta;
+    if (position >= StageCount || target < 0 || target >= StageCount)
+        return false;
+    std::swap(m_order[position], m_order[target]);
+    ++m_revision;
+    return true;
+}
+
+void PostProcessChain::SetFusion(bool fusion) {
+    if (m_fusion != fusion) {
+        m_fusion = fusion;
+        ++m_revision;
+    }
+}
+
+bool PostProcessChain::IsEmpty() const {
+    for (uint32_t i = 0; i < StageCount; ++i) {
+        if (m_enabled[i])
+            return false;
+    }
+    return true;
+}
+
+void PostProcessChain::BuildPlan(std::vector<PostDispatch>& plan) const {
+    plan.clear();
+
+    PostDispatch group = {};
+    uint32_t fusedCount = 0;
+    auto flush = [&]() {
+        if (group.opCount == 0)
+            return;
+        group.kind = PostDispatchKind::Fused;
+        group.fusedIndex = fusedCount++;
+        plan.push_back(group);
+        group = PostDispatch();
+    };
+    auto addOp = [&](uint32_t op) {
+        // Без слияния каждая стадия - свой проход, чтобы её время было видно отдельно
+        if (!m_fusion)
+            flush();
+        group.ops[group.opCount++] = op;
+        group.stageMask |= 1u << OpStage(op);
+    };
+
+    for (uint32_t i = 0; i < StageCount; ++i) {
+        PostStage stage = m_order[i];
+        if (!IsEnabled(stage))
+            continue;
+
+        switch (stage) {
+        case PostStage::Tonemap:
+            addOp(PostOpTonemap);
+            break;
+        case PostStage::ColorGrading:
+            addOp(PostOpColorGrading);
+            break;
+        case PostStage::Negative:
+            addOp(PostOpNegative);
+            break;
+        case PostStage::Fxaa:
+        case PostStage::Bloom: {
+            flush();
+            PostDispatch dispatch = {};
+            dispatch.kind = stage == PostStage::Fxaa ? PostDispatchKind::Fxaa : PostDispatchKind::Bloom;
+            dispatch.stageMask = 1u << static_cast<uint32_t>(stage);
+            plan.push_back(dispatch);
+            if (stage == PostStage::Bloom)
+                addOp(PostOpBloomComposite);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    flush();
+}
+
+const char* PostProcessChain::GetStageName(PostStage stage) {
+    switch (stage) {
+    case PostStage::Tonemap: return "Tonemap";
+    case PostStage::Fxaa: return "FXAA";
+    case PostStage::Bloom: return "Bloom";
+    case PostStage::ColorGrading: return "Color grading";
+    case PostStage::Negative: return "Negative";
+    default: return "";
+    }
+}
+
+bool PostProcessChain::IsPerPixel(PostStage stage) {
+    return stage == PostStage::Tonemap || stage == PostStage::ColorGrading || stage == PostStage::Negative;
+}
+
+const char* PostProcessChain::GetDispatchName(const PostDispatch& dispatch) {
+    switch (dispatch.kind) {
+    case PostDispatchKind::Fxaa:
+        return GetStageName(PostStage::Fxaa);
+    case PostDispatchKind::Bloom:
+        return GetStageName(PostStage::Bloom);
+    default:
+        break;
+    }
+
+    if (dispatch.opCount == 1)
+        return dispatch.ops[0] == PostOpBloomComposite ? "Bloom composite" : GetStageName(static_cast<PostStage>(OpStage(dispatch.ops[0])));
+    // Стадий 5, а FXAA и Bloom разрывают слияние: больше трёх слитых проходов не бывает
+    return FusedNames[dispatch.fusedIndex < 3 ? dispatch.fusedIndex : 2];
+}
+
+void PostProcessChain::BuildGradingLut(uint32_t size, std::vector<uint8_t>& rgba) {
+    rgba.resize(static_cast<size_t>(size) * size * size * 4);
+    float scale = size > 1 ? 1.0f / (size - 1) : 0.0f;
+
+    size_t offset = 0;
+    for (uint32_t b = 0; b < size; ++b) {
+        for (uint32_t g = 0; g < size; ++g) {
+            for (uint32_t r = 0; r < size; ++r) {
+                float color[3] = { r * scale, g * scale, b * scale };
+
+                float luma = 0.2126f * color[0] + 0.7152f * color[1] + 0.0722f * color[2];
+                const float warmth[3] = { 1.06f, 1.0f, 0.9f };
+                for (int c = 0; c < 3; ++c) {
+                    float value = luma + (color[c] - luma) * 1.15f;
+                    value = Saturate(value * warmth[c]);
+                    // Гладкая S-кривая: тени темнее, света ярче, концы на месте
+                    value = value * value * (3.0f - 2.0f * value) * 0.35f + value * 0.65f;
+                    rgba[offset + c] = static_cast<uint8_t>(std::lround(Saturate(value) * 255.0f));
+                }
+                rgba[offset + 3] = 255;
+                offset += 4;
+            }
+        }
+    }
+}
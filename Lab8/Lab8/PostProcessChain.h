@@ -0,0 +1,86 @@
+#ifndef POST_PROCESS_CHAIN_H
+#define POST_PROCESS_CHAIN_H
+
+#include <cstdint>
+#include <vector>
+
+// Стадии постобработки. Покомпонентные (без соседних пикселей) можно сливать в один проход.
+enum class PostStage : uint32_t
+{
+    Tonemap,
+    Fxaa,
+    Bloom,
+    ColorGrading,
+    Negative,
+    Count
+};
+
+// Операции слитого прохода; коды совпадают с PostFused.cs
+enum PostOp : uint32_t
+{
+    PostOpTonemap,
+    PostOpColorGrading,
+    PostOpNegative,
+    PostOpBloomComposite
+};
+
+enum class PostDispatchKind
+{
+    Fused,
+    Fxaa,
+    Bloom
+};
+
+// Один вызов Dispatch (для Bloom - цепочка уменьшения и увеличения).
+// Смешивание Bloom с картинкой - операция следующего слитого прохода.
+struct PostDispatch
+{
+    static const uint32_t MaxOps = static_cast<uint32_t>(PostStage::Count);
+
+    PostDispatchKind kind;
+    uint32_t opCount;
+    uint32_t ops[MaxOps];
+    uint32_t stageMask;     // стадии, которые покрывает проход: бит 1 << PostStage
+    uint32_t fusedIndex;    // номер слитого прохода в плане
+};
+
+// Порядок и включение стадий, план проходов по ним. Не зависит от D3D11.
+// План: подряд идущие покомпонентные стадии - один слитый проход, FXAA и Bloom
+// читают соседние пиксели и требуют готовый вход, поэтому разрывают слияние.
+class PostProcessChain
+{
+public:
+    static const uint32_t StageCount = static_cast<uint32_t>(PostStage::Count);
+    // Худший случай: каждая стадия отдельно и смешивание Bloom после всех
+    static const uint32_t MaxDispatches = StageCount + 1;
+
+    PostProcessChain();
+
+    PostStage GetStage(uint32_t position) const { return m_order[position]; }
+    bool IsEnabled(PostStage stage) const { return m_enabled[static_cast<uint32_t>(stage)]; }
+    void SetEnabled(PostStage stage, bool enabled);
+    // Сдвигает стадию на позиции position к соседу; false - если соседа нет
+    bool Move(uint32_t position, int delta);
+    bool GetFusion() const { return m_fusion; }
+    void SetFusion(bool fusion);
+    bool IsEmpty() const;
+    // Растёт при каждом изменении цепочки: по нему видно, что план надо пересобрать
+    uint32_t GetRevision() const { return m_revision; }
+
+    void BuildPlan(std::vector<PostDispatch>& plan) const;
+
+    static const char* GetStageName(PostStage stage);
+    static bool IsPerPixel(PostStage stage);
+    // Имя для профилировщика и графа: строка живёт всё время работы программы
+    static const char* GetDispatchName(const PostDispatch& dispatch);
+    // LUT цветокоррекции size^3 в RGBA8: тёплый оттенок, S-кривая контраста, насыщенность
+    static void BuildGradingLut(uint32_t size, std::vector<uint8_t>& rgba);
+
+private:
+    PostStage m_order[StageCount];
+    bool m_enabled[StageCount];
+    bool m_fusion;
+    uint32_t m_revision;
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "ReadbackRing.h"
+#include <cstring>
+
+bool ReadbackRing::Init(IReadbackDevice* pDevice, uint32_t slotCount, uint32_t byteWidth) {
+    Terminate();
+
+    if (!pDevice || slotCount == 0 || byteWidth == 0)
+        return false;
+
+    m_pDevice = pDevice;
+    m_byteWidth = byteWidth;
+    m_slots.assign(slotCount, Slot{ 0, false });
+
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        if (!m_pDevice->CreateSlot(i, byteWidth)) {
+            Terminate();
+            return false;
+        }
+    }
+    return true;
+}
+
+void ReadbackRing::Terminate() {
+    if (m_pDevice) {
+        for (uint32_t i = 0; i < m_slots.size(); ++i)
+            m_pDevice->DestroySlot(i);
+    }
+
+    m_pDevice = nullptr;
+    m_slots.clear();
+    m_byteWidth = 0;
+    m_writeIndex = 0;
+    m_lastEnqueuedFrame = 0;
+    m_lastReadFrame = 0;
+    m_droppedFrames = 0;
+}
+
+bool ReadbackRing::Enqueue(uint64_t frame, const ReadbackCopy* pCopies, uint32_t copyCount) {
+    if (!m_pDevice || m_slots.empty())
+        return false;
+
+    Slot& slot = m_slots[m_writeIndex];
+    if (slot.pending) {
+        // Старые данные ещё в пути — не ждём GPU, а пропускаем кадр
+        if (!m_pDevice->IsSlotReady(m_writeIndex)) {
+            ++m_droppedFrames;
+            return false;
+        }
+        slot.pending = false;
+    }
+
+    for (uint32_t i = 0; i < copyCount; ++i) {
+        const ReadbackCopy& copy = pCopies[i];
+        if (copy.dstOffset + copy.byteCount > m_byteWidth)
+            continue;
+        m_pDevice->CopyToSlot(m_writeIndex, copy.dstOffset, copy.pSource, copy.srcOffset, copy.byteCount);
+    }
+    m_pDevice->SignalSlot(m_writeIndex);
+
+    slot.frame = frame;
+    slot.pending = true;
+    m_lastEnqueuedFrame = frame;
+    m_writeIndex = (m_writeIndex + 1) % static_cast<uint32_t>(m_slots.size());
+    return true;
+}
+
+bool ReadbackRing::TryRead(void* pDst, uint32_t byteCount, uint64_t* pFrame) {
+    if (!m_pDevice || m_slots.empty())
+        return false;
+
+    const uint32_t count = static_cast<uint32_t>(m_slots.size());
+
+    // Идём от самого нового слота к самому старому и берём первый готовый
+    for (uint32_t step = 1; step <= count; ++step) {
+        uint32_t index = (m_writeIndex + count - step) % count;
+        Slot& slot = m_slots[index];
+        if (!slot.pending || !m_pDevice->IsSlotReady(index))
+            continue;
+
+        if (!m_pDevice->ReadSlot(index, pDst, byteCount < m_byteWidth ? byteCount : m_byteWidth))
+            return false;
+
+        m_lastReadFrame = slot.frame;
+        if (pFrame)
+            *pFrame = slot.frame;
+
+        // Всё, что старше прочитанного кадра, больше не нужно
+        for (Slot& other : m_slots) {
+            if (other.pending && other.frame <= slot.frame)
+                other.pending = false;
+        }
+        return true;
+    }
+    return false;
+}
+
+bool MockReadbackDevice::CreateSlot(uint32_t slot, uint32_t byteWidth) {
+    if (slot >= m_slots.size())
+        m_slots.resize(slot + 1);
+    m_slots[slot].data.assign(byteWidth, 0);
+    m_slots[slot].signalFrame = 0;
+    m_slots[slot].signaled = false;
+    return true;
+}
+
+void MockReadbackDevice::DestroySlot(uint32_t slot) {
+    if (slot < m_slots.size()) {
+        m_slots[slot].data.clear();
+        m_slots[slot].signaled = false;
+    }
+}
+
+void MockReadbackDevice::CopyToSlot(uint32_t slot, uint32_t dstOffset, void* pSource, uint32_t srcOffset, uint32_t byteCount) {
+    if (slot >= m_slots.size() || !pSource)
+        return;
+    std::vector<uint8_t>& data = m_slots[slot].data;
+    if (dstOffset + byteCount > data.size())
+        return;
+    memcpy(data.data() + dstOffset, static_cast<const uint8_t*>(pSource) + srcOffset, byteCount);
+    m_slots[slot].signaled = false;
+}
+
+void MockReadbackDevice::SignalSlot(uint32_t slot) {
+    if (slot >= m_slots.size())
+        return;
+    m_slots[slot].signalFrame = m_currentFrame;
+    m_slots[slot].signaled = true;
+}
+
+bool MockReadbackDevice::IsSlotReady(uint32_t slot) {
+    if (slot >= m_slots.size() || !m_slots[slot].signaled)
+        return false;
+    return m_currentFrame - m_slots[slot].signalFrame >= m_latencyFrames;
+}
+
+bool MockReadbackDevice::ReadSlot(uint32_t slot, void* pDst, uint32_t byteCount) {
+    if (!IsSlotReady(slot))
+        return false;
+    const std::vector<uint8_t>& data = m_slots[slot].data;
+    if (byteCount > data.size())
+        byteCount = static_cast<uint32_t>(data.size());
+    memcpy(pDst, data.data(), byteCount);
+    return true;
+}
@@ -0,0 +1,105 @@
+#ifndef READBACK_RING_H
+#define READBACK_RING_H
+
+#include <cstdint>
+#include <vector>
+
+// Абстракция устройства для чтения данных GPU -> CPU.
+// Слот = постоянный staging-буфер + fence, выставляемый после копирования.
+class IReadbackDevice
+{
+public:
+    virtual ~IReadbackDevice() = default;
+
+    virtual bool CreateSlot(uint32_t slot, uint32_t byteWidth) = 0;
+    virtual void DestroySlot(uint32_t slot) = 0;
+    virtual void CopyToSlot(uint32_t slot, uint32_t dstOffset, void* pSource, uint32_t srcOffset, uint32_t byteCount) = 0;
+    virtual void SignalSlot(uint32_t slot) = 0;
+    virtual bool IsSlotReady(uint32_t slot) = 0;
+    virtual bool ReadSlot(uint32_t slot, void* pDst, uint32_t byteCount) = 0;
+};
+
+struct ReadbackCopy
+{
+    void* pSource;
+    uint32_t srcOffset;
+    uint32_t dstOffset;
+    uint32_t byteCount;
+};
+
+// Кольцо из N staging-слотов. Enqueue и TryRead никогда не ждут GPU:
+// если свободного слота нет, кадр пропускается, если готовых данных нет, TryRead возвращает false.
+class ReadbackRing
+{
+public:
+    ReadbackRing() :
+        m_pDevice(nullptr),
+        m_byteWidth(0),
+        m_writeIndex(0),
+        m_lastEnqueuedFrame(0),
+        m_lastReadFrame(0),
+        m_droppedFrames(0)
+    {
+    }
+
+    bool Init(IReadbackDevice* pDevice, uint32_t slotCount, uint32_t byteWidth);
+    void Terminate();
+
+    bool Enqueue(uint64_t frame, const ReadbackCopy* pCopies, uint32_t copyCount);
+    bool TryRead(void* pDst, uint32_t byteCount, uint64_t* pFrame = nullptr);
+
+    uint64_t GetLatency() const { return m_lastEnqueuedFrame - m_lastReadFrame; }
+    uint64_t GetDroppedFrames() const { return m_droppedFrames; }
+    uint32_t GetSlotCount() const { return static_cast<uint32_t>(m_slots.size()); }
+    uint32_t GetByteWidth() const { return m_byteWidth; }
+
+private:
+    struct Slot
+    {
+        uint64_t frame;
+        bool pending;
+    };
+
+    IReadbackDevice* m_pDevice;
+    std::vector<Slot> m_slots;
+    uint32_t m_byteWidth;
+    uint32_t m_writeIndex;
+    uint64_t m_lastEnqueuedFrame;
+    uint64_t m_lastReadFrame;
+    uint64_t m_droppedFrames;
+};
+
+// CPU-реализация устройства: fence считается пройденным через latencyFrames вызовов Advance().
+class MockReadbackDevice : public IReadbackDevice
+{
+public:
+    explicit MockReadbackDevice(uint32_t latencyFrames = 2) :
+        m_latencyFrames(latencyFrames),
+        m_currentFrame(0)
+    {
+    }
+
+    void Advance() { ++m_currentFrame; }
+    void SetLatency(uint32_t latencyFrames) { m_latencyFrames = latencyFrames; }
+
+    bool CreateSlot(uint32_t slot, uint32_t byteWidth) override;
+    void DestroySlot(uint32_t slot) override;
+    void CopyToSlot(uint32_t slot, uint32_t dstOffset, void* pSource, uint32_t srcOffset, uint32_t byteCount) override;
+    void SignalSlot(uint32_t slot) override;
+    bool IsSlotReady(uint32_t slot) override;
+    bool ReadSlot(uint32_t slot, void* pDst, uint32_t byteCount) override;
+
+private:
+    struct Slot
+    {
+        std::vector<uint8_t> data;
+        uint64_t signalFrame;
+        bool signaled;
+    };
+
+    std::vector<Slot> m_slots;
+    uint32_t m_latencyFrames;
+    uint64_t m_currentFrame;
+};
+
+#endif
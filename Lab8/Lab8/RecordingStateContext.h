@@ -0,0 +1,119 @@
+#ifndef RECORDING_STATE_CONTEXT_H
+#define RECORDING_STATE_CONTEXT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "StateTracker.h"
+
+// Поддельный контекст для проверки StateTrackerT без D3D11: каждый дошедший вызов
+// записывается с именем и диапазоном слотов. Ресурсы - непрозрачные метки.
+struct RecordedResource
+{
+    int id;
+};
+
+struct RecordedViewport
+{
+    float topLeftX;
+    float topLeftY;
+    float width;
+    float height;
+    float minDepth;
+    float maxDepth;
+};
+
+struct RecordedCall
+{
+    std::string name;
+    uint32_t startSlot;
+    uint32_t count;
+};
+
+class RecordingStateContext
+{
+public:
+    void IASetInputLayout(RecordedResource*) { Record("IASetInputLayout"); }
+    void IASetPrimitiveTopology(uint32_t) { Record("IASetPrimitiveTopology"); }
+    void IASetVertexBuffers(uint32_t startSlot, uint32_t count, RecordedResource* const*, const uint32_t*, const uint32_t*) {
+        Record("IASetVertexBuffers", startSlot, count);
+    }
+    void IASetIndexBuffer(RecordedResource*, uint32_t, uint32_t) { Record("IASetIndexBuffer"); }
+
+    void VSSetShader(RecordedResource*, const void*, uint32_t) { Record("VSSetShader"); }
+    void PSSetShader(RecordedResource*, const void*, uint32_t) { Record("PSSetShader"); }
+    void CSSetShader(RecordedResource*, const void*, uint32_t) { Record("CSSetShader"); }
+
+    void VSSetConstantBuffers(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("VSSetConstantBuffers", startSlot, count); }
+    void PSSetConstantBuffers(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("PSSetConstantBuffers", startSlot, count); }
+    void CSSetConstantBuffers(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("CSSetConstantBuffers", startSlot, count); }
+    void VSSetConstantBuffers1(uint32_t startSlot, uint32_t count, RecordedResource* const*, const uint32_t*, const uint32_t*) {
+        Record("VSSetConstantBuffers1", startSlot, count);
+    }
+    void PSSetConstantBuffers1(uint32_t startSlot, uint32_t count, RecordedResource* const*, const uint32_t*, const uint32_t*) {
+        Record("PSSetConstantBuffers1", startSlot, count);
+    }
+    void CSSetConstantBuffers1(uint32_t startSlot, uint32_t count, RecordedResource* const*, const uint32_t*, const uint32_t*) {
+        Record("CSSetConstantBuffers1", startSlot, count);
+    }
+    void VSSetShaderResources(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("VSSetShaderResources", startSlot, count); }
+    void PSSetShaderResources(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("PSSetShaderResources", startSlot, count); }
+    void CSSetShaderResources(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("CSSetShaderResources", startSlot, count); }
+    void PSSetSamplers(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("PSSetSamplers", startSlot, count); }
+    void CSSetSamplers(uint32_t startSlot, uint32_t count, RecordedResource* const*) { Record("CSSetSamplers", startSlot, count); }
+    void CSSetUnorderedAccessViews(uint32_t startSlot, uint32_t count, RecordedResource* const*, const uint32_t*) {
+        Record("CSSetUnorderedAccessViews", startSlot, count);
+    }
+
+    void OMSetRenderTargets(uint32_t count, RecordedResource* const*, RecordedResource*) { Record("OMSetRenderTargets", 0, count); }
+    void OMSetDepthStencilState(RecordedResource*, uint32_t) { Record("OMSetDepthStencilState"); }
+    void OMSetBlendState(RecordedResource*, const float*, uint32_t) { Record("OMSetBlendState"); }
+    void RSSetState(RecordedResource*) { Record("RSSetState"); }
+    void RSSetViewports(uint32_t count, const RecordedViewport*) { Record("RSSetViewports", 0, count); }
+
+    const std::vector<RecordedCall>& GetCalls() const { return m_calls; }
+    void Clear() { m_calls.clear(); }
+
+    size_t CountCalls(const char* name) const {
+        size_t count = 0;
+        for (const RecordedCall& call : m_calls) {
+            if (call.name == name)
+                ++count;
+        }
+        return count;
+    }
+
+private:
+    void Record(const char* name, uint32_t startSlot = 0, uint32_t count = 1) {
+        RecordedCall call = { name, startSlot, count };
+        m_calls.push_back(call);
+    }
+
+    std::vector<RecordedCall> m_calls;
+};
+
+struct RecordingStateApi
+{
+    typedef RecordingStateContext Context;
+    typedef RecordingStateContext Context1;
+    typedef RecordedResource InputLayout;
+    typedef RecordedResource Buffer;
+    typedef RecordedResource VertexShader;
+    typedef RecordedResource PixelShader;
+    typedef RecordedResource ComputeShader;
+    typedef RecordedResource ShaderResourceView;
+    typedef RecordedResource UnorderedAccessView;
+    typedef RecordedResource SamplerState;
+    typedef RecordedResource RenderTargetView;
+    typedef RecordedResource DepthStencilView;
+    typedef RecordedResource DepthStencilState;
+    typedef RecordedResource BlendState;
+    typedef RecordedResource RasterizerState;
+    typedef RecordedViewport Viewport;
+    typedef uint32_t Format;
+    typedef uint32_t Topology;
+};
+
+typedef StateTrackerT<RecordingStateApi> RecordingStateTracker;
+
+#endif
@@ -1,1787 +1,2291 @@
-﻿#include "framework.h"
-#include "RenderClass.h"
-#include "WICTextureLoader.h"
-#include "DDSTextureLoader11.h"
-#include <filesystem>
-#include <wrl/client.h>
-#include <dxgi.h>
-#include <d3d11.h>
-#include <d3dcompiler.h>
-
-#include "imgui.h"
-#include "imgui_impl_dx11.h"
-#include "imgui_impl_win32.h"
-
-#pragma comment (lib, "d3dcompiler.lib")
-#pragma comment (lib, "d3d11.lib")
-#pragma comment (lib, "dxgi.lib")
-
-using namespace Microsoft::WRL;
-
-std::wstring Extension(const std::wstring& path) {
-    size_t dotPos = path.find_last_of(L".");
-    if (dotPos == std::wstring::npos || dotPos == 0) {
-        return L"";
-    }
-    return path.substr(dotPos + 1);
-}
-
-HRESULT RenderClass::Init(HWND hWnd, WCHAR szTitle[], WCHAR szWindowClass[]) {
-    m_szTitle = szTitle;
-    m_szWindowClass = szWindowClass;
-
-    HRESULT hr;
-
-    IDXGIFactory* pFactory = nullptr;
-    hr = CreateDXGIFactory(__uuidof(IDXGIFactory), (void**)&pFactory);
-
-    IDXGIAdapter* pSelectedAdapter = NULL;
-    if (SUCCEEDED(hr)) {
-        IDXGIAdapter* pAdapter = NULL;
-        UINT adapterIdx = 0;
-        while (SUCCEEDED(pFactory->EnumAdapters(adapterIdx, &pAdapter))) {
-            DXGI_ADAPTER_DESC desc;
-            pAdapter->GetDesc(&desc);
-
-            if (wcscmp(desc.Description, L"Microsoft Basic Render Driver") != 0) {
-                pSelectedAdapter = pAdapter;
-                break;
-            }
-
-            pAdapter->Release();
-            adapterIdx++;
-        }
-    }
-
-    D3D_FEATURE_LEVEL level;
-    D3D_FEATURE_LEVEL levels[] = { D3D_FEATURE_LEVEL_11_0 };
-    if (SUCCEEDED(hr)) {
-        UINT flags = 0;
-#ifdef _DEBUG
-        flags |= D3D11_CREATE_DEVICE_DEBUG;
-#endif
-        hr = D3D11CreateDevice(pSelectedAdapter, D3D_DRIVER_TYPE_UNKNOWN, NULL,
-            flags, levels, 1, D3D11_SDK_VERSION, &m_pDevice, &level, &m_pDeviceContext);
-    }
-
-    if (SUCCEEDED(hr)) {
-        DXGI_SWAP_CHAIN_DESC swapChainDesc = { 0 };
-        swapChainDesc.BufferCount = 2;
-        swapChainDesc.BufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-        swapChainDesc.BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT;
-        swapChainDesc.OutputWindow = hWnd;
-        swapChainDesc.SampleDesc.Count = 1;
-        swapChainDesc.SampleDesc.Quality = 0;
-        swapChainDesc.Windowed = true;
-        swapChainDesc.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
-        swapChainDesc.Flags = 0;
-
-        hr = pFactory->CreateSwapChain(m_pDevice, &swapChainDesc, &m_pSwapChain);
-    }
-
-    if (SUCCEEDED(hr)) {
-        RECT rc;
-        GetClientRect(hWnd, &rc);
-        UINT width = rc.right - rc.left;
-        UINT height = rc.bottom - rc.top;
-        hr = ConfigureBackBuffer(width, height);
-    }
-
-    if (SUCCEEDED(hr)) {
-        hr = InitBufferShader();
-    }
-
-    if (SUCCEEDED(hr))
-    {
-        hr = Init2DArray();
-    }
-
-    if (SUCCEEDED(hr))
-    {
-        InitImGui(hWnd);
-    }
-
-    if (SUCCEEDED(hr)) {
-        hr = InitSkybox();
-    }
-
-    if (SUCCEEDED(hr)) {
-        hr = InitParallelogram();
-    }
-
-    if (SUCCEEDED(hr))
-    {
-        hr = InitFullScreenTriangle();
-    }
-
-    if (SUCCEEDED(hr))
-    {
-        hr = InitComputeShader();
-    }
-
-    pSelectedAdapter->Release();
-    pFactory->Release();
-
-    if (FAILED(hr)) {
-        Terminate();
-    }
-
-    return hr;
-}
-
-HRESULT RenderClass::InitBufferShader() {
-    static const D3D11_INPUT_ELEMENT_DESC InputDesc[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(CubeVertex, xyz), D3D11_INPUT_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(CubeVertex, normal), D3D11_INPUT_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(CubeVertex, uv), D3D11_INPUT_PER_VERTEX_DATA, 0}
-    };
-
-    HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-    if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
-        OutputDebugString(L"COM initialization failed.\n");
-        return hr;
-    }
-
-    ID3DBlob* pVertexCode = nullptr;
-    if (SUCCEEDED(hr)) {
-        hr = CompileShader(L"ColorVertex.vs", &m_pVertexShader, nullptr, &pVertexCode);
-    }
-    if (SUCCEEDED(hr)) {
-        hr = CompileShader(L"ColorPixel.ps", nullptr, &m_pPixelShader);
-    }
-
-    if (SUCCEEDED(hr)) {
-        hr = m_pDevice->CreateInputLayout(InputDesc, 3, pVertexCode->GetBufferPointer(), pVertexCode->GetBufferSize(), &m_pLayout);
-    }
-
-    if (pVertexCode)
-        pVertexCode->Release();
-
-    if (SUCCEEDED(hr)) {
-        hr = CompileShader(L"LightPixel.ps", nullptr, &m_pLightPixelShader);
-    }
-
-    static const CubeVertex vertices[] =
-    {
-        { {-1.0f, -1.0f,  1.0f}, { 0.0f,  -1.0f,  0.0f}, {0.0f, 1.0f} },
-        { { 1.0f, -1.0f,  1.0f}, { 0.0f,  -1.0f,  0.0f}, {1.0f, 1.0f} },
-        { { 1.0f, -1.0f, -1.0f}, { 0.0f,  -1.0f,  0.0f}, {1.0f, 0.0f} },
-        { {-1.0f, -1.0f, -1.0f}, { 0.0f,  -1.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { {-1.0f,  1.0f, -1.0f}, { 0.0f,  1.0f, 0.0f}, {0.0f, 1.0f} },
-        { { 1.0f,  1.0f, -1.0f}, { 0.0f,  1.0f, 0.0f}, {1.0f, 1.0f} },
-        { { 1.0f,  1.0f,  1.0f}, { 0.0f,  1.0f, 0.0f}, {1.0f, 0.0f} },
-        { {-1.0f,  1.0f,  1.0f}, { 0.0f,  1.0f, 0.0f}, {0.0f, 0.0f} },
-
-        { { 1.0f, -1.0f, -1.0f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
-        { { 1.0f, -1.0f,  1.0f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
-        { { 1.0f,  1.0f,  1.0f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
-        { { 1.0f,  1.0f, -1.0f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { {-1.0f, -1.0f,  1.0f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
-        { {-1.0f, -1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
-        { {-1.0f,  1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
-        { {-1.0f,  1.0f,  1.0f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
-
-        { { 1.0f, -1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f} },
-        { {-1.0f, -1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f} },
-        { {-1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f} },
-        { { 1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f} },
-
-        { {-1.0f, -1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {0.0f, 1.0f} },
-        { { 1.0f, -1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {1.0f, 1.0f} },
-        { { 1.0f,  1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {1.0f, 0.0f} },
-        { {-1.0f,  1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {0.0f, 0.0f} },
-    };
-
-    WORD indices[] = {
-        0, 2, 1, 0, 3, 2, 4, 6, 5, 4, 7, 6, 8, 10, 9, 8, 11, 10,
-        12, 14, 13, 12, 15, 14, 16, 18, 17, 16, 19, 18, 20, 22, 21, 20, 23, 22
-    };
-
-    D3D11_BUFFER_DESC lightBufferDesc = {};
-    lightBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-    lightBufferDesc.ByteWidth = sizeof(PointLight) * 3;
-    lightBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    lightBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    hr = m_pDevice->CreateBuffer(&lightBufferDesc, nullptr, &m_pLightBuffer);
-    if (FAILED(hr)) return hr;
-
-    D3D11_BUFFER_DESC bd = {};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(CubeVertex) * ARRAYSIZE(vertices);
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    bd.CPUAccessFlags = 0;
-
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = vertices;
-    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pVertexBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(WORD) * ARRAYSIZE(indices);
-    bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    bd.CPUAccessFlags = 0;
-    initData.pSysMem = indices;
-    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pIndexBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(XMMATRIX);
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    bd.CPUAccessFlags = 0;
-    hr = m_pDevice->CreateBuffer(&bd, nullptr, &m_pModelBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(InstanceData) * MaxInst;
-    bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    bd.CPUAccessFlags = 0;
-    hr = m_pDevice->CreateBuffer(&bd, nullptr, &m_pModelBufferInst);
-    if (FAILED(hr))
-        return hr;
-
-    const int innerCount = 10;
-    const int outerCount = 12;
-    const float innerRadius = 4.0f;
-    const float outerRadius = 9.5f;
-
-    InstanceData modelBuf;
-    modelBuf.countInstance = MaxInst;
-    modelBuf.model = XMMatrixScaling(m_fixedScale, m_fixedScale, m_fixedScale);
-    modelBuf.texInd = 0;
-    m_modelInstances.push_back(modelBuf);
-
-    for (int i = 0; i < innerCount; i++)
-    {
-        float angle = XM_2PI * i / innerCount;
-        XMFLOAT3 position = { innerRadius * cosf(angle), 0.0f, innerRadius * sinf(angle) };
-
-        InstanceData modelBuf;
-        modelBuf.countInstance = MaxInst;
-        modelBuf.model = XMMatrixScaling(m_fixedScale, m_fixedScale, m_fixedScale) *
-            XMMatrixTranslation(position.x, position.y, position.z);
-        modelBuf.texInd = i % 2;
-        m_modelInstances.push_back(modelBuf);
-    }
-
-    for (int i = 0; i < outerCount; i++)
-    {
-        float angle = XM_2PI * i / outerCount;
-        XMFLOAT3 position = { outerRadius * cosf(angle), 0.0f, outerRadius * sinf(angle) };
-
-        InstanceData modelBuf;
-        modelBuf.countInstance = MaxInst;
-        modelBuf.model = XMMatrixScaling(m_fixedScale, m_fixedScale, m_fixedScale) *
-            XMMatrixTranslation(position.x, position.y, position.z);
-        modelBuf.texInd = i % 2;
-        m_modelInstances.push_back(modelBuf);
-    }
-
-    m_pDeviceContext->UpdateSubresource(m_pModelBufferInst, 0, nullptr, m_modelInstances.data(), 0, 0);
-
-
-    D3D11_BUFFER_DESC vpBufferDesc = {};
-    vpBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-    vpBufferDesc.ByteWidth = sizeof(CameraBuffer); 
-    vpBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    vpBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    hr = m_pDevice->CreateBuffer(&vpBufferDesc, nullptr, &m_pVPBuffer);
-    if (FAILED(hr))
-        return hr;
-
-   
-
-    hr = CreateDDSTextureFromFile(m_pDevice, L"cube_normal.dds", nullptr, &m_pNormalMapView);
-    if (FAILED(hr))
-        return hr;
-
-
-    D3D11_SAMPLER_DESC sampDesc = {};
-    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-    sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
-    sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
-    sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-    sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
-    sampDesc.MinLOD = 0;
-    sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
-    hr = m_pDevice->CreateSamplerState(&sampDesc, &m_pSamplerState);
-   
-    return hr;
-}
-
-HRESULT RenderClass::InitComputeShader()
-{
-    // Компиляция вычислительного шейдера
-    HRESULT hr = CompileComputeShader(L"ComputeShader.cs", &m_pComputeShader);
-    if (FAILED(hr))
-        return hr;
-
-    // Буфер фрустума
-    D3D11_BUFFER_DESC descFrustum = {};
-    descFrustum.ByteWidth = sizeof(XMVECTOR) * 6;
-    descFrustum.Usage = D3D11_USAGE_DYNAMIC;
-    descFrustum.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    descFrustum.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-
-    hr = m_pDevice->CreateBuffer(&descFrustum, nullptr, &m_pFrustumPlanesBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    // Буфер для индиректных аргументов
-    D3D11_BUFFER_DESC descArgs = {};
-    descArgs.ByteWidth = sizeof(UINT) * 5;
-    descArgs.Usage = D3D11_USAGE_DEFAULT;
-    descArgs.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
-    descArgs.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS | D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
-
-    hr = m_pDevice->CreateBuffer(&descArgs, nullptr, &m_pIndirectArgsBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_UNORDERED_ACCESS_VIEW_DESC uavArgs = {};
-    uavArgs.Format = DXGI_FORMAT_R32_TYPELESS;
-    uavArgs.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
-    uavArgs.Buffer.FirstElement = 0;
-    uavArgs.Buffer.NumElements = descArgs.ByteWidth / sizeof(UINT);
-    uavArgs.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
-
-    hr = m_pDevice->CreateUnorderedAccessView(m_pIndirectArgsBuffer, &uavArgs, &m_pIndirectArgsUAV);
-    if (FAILED(hr))
-        return hr;
-
-    // Буфер идентификаторов объектов
-    D3D11_BUFFER_DESC descIDs = {};
-    descIDs.ByteWidth = sizeof(UINT) * MaxInst;
-    descIDs.Usage = D3D11_USAGE_DEFAULT;
-    descIDs.BindFlags = D3D11_BIND_UNORDERED_ACCESS | D3D11_BIND_SHADER_RESOURCE;
-    descIDs.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-    descIDs.StructureByteStride = sizeof(UINT);
-
-    hr = m_pDevice->CreateBuffer(&descIDs, nullptr, &m_pObjectsIdsBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_UNORDERED_ACCESS_VIEW_DESC uavIDs = {};
-    uavIDs.Format = DXGI_FORMAT_UNKNOWN;
-    uavIDs.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
-    uavIDs.Buffer.FirstElement = 0;
-    uavIDs.Buffer.NumElements = MaxInst;
-
-    hr = m_pDevice->CreateUnorderedAccessView(m_pObjectsIdsBuffer, &uavIDs, &m_pObjectsIdsUAV);
-    if (FAILED(hr))
-        return hr;
-
-    // Буфер данных экземпляров
-    D3D11_BUFFER_DESC descInstances = {};
-    descInstances.ByteWidth = sizeof(InstanceData) * MaxInst;
-    descInstances.Usage = D3D11_USAGE_DEFAULT;
-    descInstances.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-    descInstances.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
-    descInstances.StructureByteStride = sizeof(InstanceData);
-
-    ID3D11Buffer* pTempInstanceBuffer = nullptr;
-    hr = m_pDevice->CreateBuffer(&descInstances, nullptr, &pTempInstanceBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvInstances = {};
-    srvInstances.Format = DXGI_FORMAT_UNKNOWN;
-    srvInstances.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
-    srvInstances.Buffer.FirstElement = 0;
-    srvInstances.Buffer.NumElements = MaxInst;
-
-    hr = m_pDevice->CreateShaderResourceView(pTempInstanceBuffer, &srvInstances, &m_pInstanceDataSRV);
-    if (FAILED(hr))
-    {
-        pTempInstanceBuffer->Release();
-        return hr;
-    }
-
-    // Обновление содержимого буфера
-    m_pDeviceContext->UpdateSubresource(pTempInstanceBuffer, 0, nullptr, m_modelInstances.data(), 0, 0);
-    pTempInstanceBuffer->Release();
-
-    return S_OK;
-}
-
-HRESULT RenderClass::CompileComputeShader(const std::wstring& path, ID3D11ComputeShader** ppComputeShader) {
-    std::wstring ext = Extension(path);
-    UINT flags = 0;
-#ifdef _DEBUG
-    flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-    ID3DBlob* pCode = nullptr;
-    ID3DBlob* pErr = nullptr;
-    HRESULT hr = D3DCompileFromFile(path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", "cs_5_0", flags, 0, &pCode, &pErr);
-    if (FAILED(hr) && pErr)
-        OutputDebugStringA(reinterpret_cast<const char*>(pErr->GetBufferPointer()));
-    if (pErr)
-        pErr->Release();
-    if (SUCCEEDED(hr))
-        hr = m_pDevice->CreateComputeShader(pCode->GetBufferPointer(), pCode->GetBufferSize(), nullptr, ppComputeShader);
-    if (pCode)
-        pCode->Release();
-    return hr;
-}
-
-
-void RenderClass::TerminateComputeShader()
-{
-    if (m_pComputeShader)
-    {
-        m_pComputeShader->Release();
-        m_pComputeShader = nullptr;
-    }
-
-    if (m_pFrustumPlanesBuffer)
-    {
-        m_pFrustumPlanesBuffer->Release();
-        m_pFrustumPlanesBuffer = nullptr;
-    }
-
-    if (m_pIndirectArgsBuffer)
-    {
-        m_pIndirectArgsBuffer->Release();
-        m_pIndirectArgsBuffer = nullptr;
-    }
-
-    if (m_pObjectsIdsBuffer)
-    {
-        m_pObjectsIdsBuffer->Release();
-        m_pObjectsIdsBuffer = nullptr;
-    }
-
-    if (m_pIndirectArgsUAV)
-    {
-        m_pIndirectArgsUAV->Release();
-        m_pIndirectArgsUAV = nullptr;
-    }
-
-    if (m_pObjectsIdsUAV)
-    {
-        m_pObjectsIdsUAV->Release();
-        m_pObjectsIdsUAV = nullptr;
-    }
-
-    if (m_pInstanceDataSRV)
-    {
-        m_pInstanceDataSRV->Release();
-        m_pInstanceDataSRV = nullptr;
-    }
-}
-
-std::vector<UINT> RenderClass::ReadUintBufferData(ID3D11DeviceContext* pContext, ID3D11Buffer* pBuffer, UINT count) {
-    std::vector<UINT> output(count);
-    D3D11_BUFFER_DESC origDesc = {};
-    pBuffer->GetDesc(&origDesc);
-    D3D11_BUFFER_DESC stagingDesc = origDesc;
-    stagingDesc.Usage = D3D11_USAGE_STAGING;
-    stagingDesc.BindFlags = 0;
-    stagingDesc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
-    stagingDesc.MiscFlags = 0;
-    ID3D11Buffer* pStaging = nullptr;
-    if (SUCCEEDED(m_pDevice->CreateBuffer(&stagingDesc, nullptr, &pStaging))) {
-        pContext->CopyResource(pStaging, pBuffer);
-        D3D11_MAPPED_SUBRESOURCE mapped = {};
-        if (SUCCEEDED(pContext->Map(pStaging, 0, D3D11_MAP_READ, 0, &mapped))) {
-            memcpy(output.data(), mapped.pData, count * sizeof(UINT));
-            pContext->Unmap(pStaging, 0);
-        }
-        pStaging->Release();
-    }
-    return output;
-}
-
-HRESULT RenderClass::Init2DArray()
-{
-    ID3D11Resource* pTextureResources[2] = { nullptr, nullptr };
-
-    HRESULT result = CreateWICTextureFromFileEx(m_pDevice, m_pDeviceContext, L"cat.png", 0, D3D11_USAGE_DEFAULT,
-        D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET, D3D11_CPU_ACCESS_FLAG(0), D3D11_RESOURCE_MISC_GENERATE_MIPS, WIC_LOADER_DEFAULT, &pTextureResources[0], &m_pTextureView);
-
-    if (FAILED(result))
-        return result;
-
-    m_pDeviceContext->GenerateMips(m_pTextureView);
-    m_pTextureView->Release();
-
-    result = CreateWICTextureFromFileEx(m_pDevice, m_pDeviceContext, L"textile.png", 0, D3D11_USAGE_DEFAULT,
-        D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_RENDER_TARGET, D3D11_CPU_ACCESS_FLAG(0), D3D11_RESOURCE_MISC_GENERATE_MIPS, WIC_LOADER_DEFAULT, &pTextureResources[1], &m_pTextureView);
-
-    if (FAILED(result))
-        return result;
-
-    m_pDeviceContext->GenerateMips(m_pTextureView);
-    m_pTextureView->Release();
-
-    ID3D11Texture2D* pTexture = nullptr;
-    pTextureResources[0]->QueryInterface(__uuidof(ID3D11Texture2D), (void**)&pTexture);
-
-
-    D3D11_TEXTURE2D_DESC texDesc;
-    pTexture->GetDesc(&texDesc);
-    pTexture->Release();
-
-    D3D11_TEXTURE2D_DESC arrayDesc = texDesc;
-    arrayDesc.ArraySize = 2;
-
-    ID3D11Texture2D* pTextureArray = nullptr;
-    result = m_pDevice->CreateTexture2D(&arrayDesc, nullptr, &pTextureArray);
-    if (FAILED(result))
-    {
-        pTextureResources[0]->Release();
-        pTextureResources[1]->Release();
-        return result;
-    }
-
-    for (UINT texIndex = 0; texIndex < 2; ++texIndex)
-    {
-        for (UINT mipLevel = 0; mipLevel < texDesc.MipLevels; ++mipLevel)
-        {
-            if (pTextureResources[texIndex])
-            {
-                m_pDeviceContext->CopySubresourceRegion(
-                    pTextureArray,
-                    D3D11CalcSubresource(mipLevel, texIndex, texDesc.MipLevels),
-                    0, 0, 0,
-                    pTextureResources[texIndex],
-                    mipLevel,
-                    nullptr
-                );
-            }
-            else {
-                OutputDebugString(L"Warning: Attempted to copy from a null texture resource.\n");
-            }
-        }
-    }
-
-    for (int i = 0; i < 2; ++i)
-    {
-        if (pTextureResources[i])
-            pTextureResources[i]->Release();
-    }
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = texDesc.Format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2DARRAY;
-    srvDesc.Texture2DArray.ArraySize = 2;
-    srvDesc.Texture2DArray.FirstArraySlice = 0;
-    srvDesc.Texture2DArray.MipLevels = texDesc.MipLevels;
-    srvDesc.Texture2DArray.MostDetailedMip = 0;
-
-    result = m_pDevice->CreateShaderResourceView(pTextureArray, &srvDesc, &m_pTextureView);
-    pTextureArray->Release();
-    return result;
-  
-}
-
-HRESULT RenderClass::InitFullScreenTriangle()
-{
-    // Определяем вершины полноэкранного треугольника
-    FullScreenVertex vertices[3] =
-    {
-        { -1.0f, -1.0f, 0, 1,  0.0f,  1.0f },
-        { -1.0f,  3.0f, 0, 1,  0.0f, -1.0f },
-        {  3.0f, -1.0f, 0, 1,  2.0f,  1.0f }
-    };
-
-    // Описание буфера вершин
-    D3D11_BUFFER_DESC bufferDesc = {};
-    bufferDesc.Usage = D3D11_USAGE_DEFAULT;
-    bufferDesc.ByteWidth = sizeof(vertices);
-    bufferDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-    // Данные для инициализации буфера
-    D3D11_SUBRESOURCE_DATA vertexData = {};
-    vertexData.pSysMem = vertices;
-
-    // Создаём буфер вершин
-    HRESULT hr = m_pDevice->CreateBuffer(&bufferDesc, &vertexData, &m_pFullScreenVB);
-    if (FAILED(hr))
-        return hr;
-
-    // Описание входного макета для вершинного шейдера
-    D3D11_INPUT_ELEMENT_DESC inputLayoutDesc[] =
-    {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0,  0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-        { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,       0, 16, D3D11_INPUT_PER_VERTEX_DATA, 0 }
-    };
-
-    ID3DBlob* pVSBlob = nullptr;
-
-    // Компиляция вершинного шейдера
-    hr = CompileShader(L"NegativeVertex.vs", &m_pPostProcessVS, nullptr, &pVSBlob);
-    if (FAILED(hr))
-        return hr;
-
-    // Создание входного макета на основе описания и скомпилированного шейдера
-    hr = m_pDevice->CreateInputLayout(
-        inputLayoutDesc,
-        ARRAYSIZE(inputLayoutDesc),
-        pVSBlob->GetBufferPointer(),
-        pVSBlob->GetBufferSize(),
-        &m_pFullScreenLayout
-    );
-
-    if (pVSBlob)
-        pVSBlob->Release();
-
-    if (FAILED(hr))
-        return hr;
-
-    // Компиляция пиксельного шейдера
-    hr = CompileShader(L"NegativePixel.ps", nullptr, &m_pPostProcessPS);
-    return hr;
-}
-
-
-
-HRESULT RenderClass::LoadCubemapFropCrossImage(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* filename, ID3D11ShaderResourceView** cubeSRV) {
-    ComPtr<ID3D11Resource> originalTexture;
-    ComPtr<ID3D11ShaderResourceView> originalSVR;
-    HRESULT hr = CreateWICTextureFromFile(device, filename, originalTexture.GetAddressOf(), originalSVR.GetAddressOf());
-    if (FAILED(hr)) {
-        return hr;
-    }
-
-    ComPtr<ID3D11Texture2D> texture2D;
-    originalTexture.As(&texture2D);
-    D3D11_TEXTURE2D_DESC srcDesc;
-    texture2D->GetDesc(&srcDesc);
-
-    int faceSize = srcDesc.Width / 4;
-
-    if (srcDesc.Height != faceSize * 3) {
-        return E_FAIL;
-    }
-
-    D3D11_TEXTURE2D_DESC cubeDesc = {};
-    cubeDesc.Width = faceSize;
-    cubeDesc.Height = faceSize;
-    cubeDesc.MipLevels = 1;
-    cubeDesc.ArraySize = 6;
-    cubeDesc.Format = srcDesc.Format;
-    cubeDesc.SampleDesc.Count = 1;
-    cubeDesc.Usage = D3D11_USAGE_DEFAULT;
-    cubeDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
-    cubeDesc.MiscFlags = D3D11_RESOURCE_MISC_TEXTURECUBE;
-
-    ComPtr<ID3D11Texture2D> cubeTexture;
-    hr = device->CreateTexture2D(&cubeDesc, nullptr, cubeTexture.GetAddressOf());
-    if (FAILED(hr)) return hr;
-
-    D3D11_BOX box;
-    for (int i = 0; i < 6; ++i) {
-        int x = 0, y = 0;
-        switch (i) {
-        case 0: x = 2 * faceSize; y = faceSize; break;
-        case 1: x = 0 * faceSize; y = faceSize; break;
-        case 2: x = 1 * faceSize; y = 0 * faceSize; break;
-        case 3: x = 1 * faceSize; y = 2 * faceSize; break;
-        case 4: x = 1 * faceSize; y = faceSize; break;
-        case 5: x = 3 * faceSize; y = faceSize; break;
-        }
-
-        box.left = x;
-        box.right = x + faceSize;
-        box.top = y;
-        box.bottom = y + faceSize;
-        box.front = 0;
-        box.back = 1;
-
-        context->CopySubresourceRegion(cubeTexture.Get(), D3D11CalcSubresource(0, i, 1),
-            0, 0, 0, texture2D.Get(), 0, &box);
-    }
-
-    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = cubeDesc.Format;
-    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURECUBE;
-    srvDesc.TextureCube.MostDetailedMip = 0;
-    srvDesc.TextureCube.MipLevels = 1;
-
-    hr = device->CreateShaderResourceView(cubeTexture.Get(), &srvDesc, cubeSRV);
-    return hr;
-}
-
-HRESULT RenderClass::InitSkybox() {
-    ID3DBlob* pVertexCode = nullptr;
-    HRESULT hr = CompileShader(L"SkyboxVertex.vs", &m_pSkyboxVS, nullptr, &pVertexCode);
-    if (SUCCEEDED(hr)) {
-        hr = CompileShader(L"SkyboxPixel.ps", nullptr, &m_pSkyboxPS);
-    }
-
-    D3D11_INPUT_ELEMENT_DESC skyboxLayout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
-    };
-
-    if (SUCCEEDED(hr)) {
-        hr = m_pDevice->CreateInputLayout(skyboxLayout, 1, pVertexCode->GetBufferPointer(), pVertexCode->GetBufferSize(), &m_pSkyboxLayout);
-    }
-
-    SkyboxVertex SkyboxVertices[] = {
-        { -1.0f, -1.0f, -1.0f },
-        { -1.0f,  1.0f, -1.0f },
-        {  1.0f,  1.0f, -1.0f },
-        { -1.0f, -1.0f, -1.0f },
-        {  1.0f,  1.0f, -1.0f },
-        {  1.0f, -1.0f, -1.0f },
-        {  1.0f, -1.0f,  1.0f },
-        {  1.0f,  1.0f,  1.0f },
-        { -1.0f,  1.0f,  1.0f },
-        {  1.0f, -1.0f,  1.0f },
-        { -1.0f,  1.0f,  1.0f },
-        { -1.0f, -1.0f,  1.0f },
-        { -1.0f, -1.0f,  1.0f },
-        { -1.0f,  1.0f,  1.0f },
-        { -1.0f,  1.0f, -1.0f },
-        { -1.0f, -1.0f,  1.0f },
-        { -1.0f,  1.0f, -1.0f },
-        { -1.0f, -1.0f, -1.0f },
-        { 1.0f, -1.0f, -1.0f },
-        { 1.0f,  1.0f, -1.0f },
-        { 1.0f,  1.0f,  1.0f },
-        { 1.0f, -1.0f, -1.0f },
-        { 1.0f,  1.0f,  1.0f },
-        { 1.0f, -1.0f,  1.0f },
-        { -1.0f, 1.0f, -1.0f },
-        { -1.0f, 1.0f,  1.0f },
-        { 1.0f, 1.0f,  1.0f },
-        { -1.0f, 1.0f, -1.0f },
-        { 1.0f, 1.0f,  1.0f },
-        { 1.0f, 1.0f, -1.0f },
-        { -1.0f, -1.0f,  1.0f },
-        { -1.0f, -1.0f, -1.0f },
-        { 1.0f, -1.0f, -1.0f },
-        { -1.0f, -1.0f,  1.0f },
-        { 1.0f, -1.0f, -1.0f },
-        { 1.0f, -1.0f,  1.0f },
-    };
-
-    D3D11_BUFFER_DESC bd = {};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(SkyboxVertex) * ARRAYSIZE(SkyboxVertices);
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = SkyboxVertices;
-    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pSkyboxVB);
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_BUFFER_DESC vpBufferDesc = {};
-    vpBufferDesc.Usage = D3D11_USAGE_DYNAMIC;
-    vpBufferDesc.ByteWidth = sizeof(CameraBuffer);
-    vpBufferDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    vpBufferDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    hr = m_pDevice->CreateBuffer(&vpBufferDesc, nullptr, &m_pSkyboxVPBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    hr = LoadCubemapFropCrossImage(m_pDevice, m_pDeviceContext, L"skybox.png", &m_pSkyboxSRV);
-    if (FAILED(hr))
-        return hr;
-
-    return S_OK;
-}
-
-void RenderClass::Terminate() {
-    TerminateBufferShader();
-    TerminateSkybox();
-    TerminateParallelogram();
-    TerminateComputeShader();
-
-    if (m_pDeviceContext) {
-        m_pDeviceContext->ClearState();
-        m_pDeviceContext->Release();
-        m_pDeviceContext = nullptr;
-    }
-
-    if (m_pRenderTargetView) {
-        m_pRenderTargetView->Release();
-        m_pRenderTargetView = nullptr;
-    }
-
-    if (m_pDepthView) {
-        m_pDepthView->Release();
-        m_pDepthView = nullptr;
-    }
-
-    if (m_pSwapChain) {
-        m_pSwapChain->Release();
-        m_pSwapChain = nullptr;
-    }
-
-    if (m_pDevice) {
-        m_pDevice->Release();
-        m_pDevice = nullptr;
-    }
-    
-    CoUninitialize();
-    ImGui_ImplDX11_Shutdown();
-    ImGui_ImplWin32_Shutdown();
-    ImGui::DestroyContext();
-}
-
-void RenderClass::TerminateBufferShader() {
-    if (m_pLayout)
-        m_pLayout->Release();
-
-    if (m_pPixelShader)
-        m_pPixelShader->Release();
-
-    if (m_pVertexShader)
-        m_pVertexShader->Release();
-
-    if (m_pIndexBuffer)
-        m_pIndexBuffer->Release();
-
-    if (m_pVertexBuffer)
-        m_pVertexBuffer->Release();
-
-    if (m_pModelBuffer)
-        m_pModelBuffer->Release();
-
-    if (m_pVPBuffer)
-        m_pVPBuffer->Release();
-
-    if (m_pTextureView)
-        m_pTextureView->Release();
-
-    if (m_pSamplerState)
-        m_pSamplerState->Release();
-
-    if (m_pLightBuffer)
-        m_pLightBuffer->Release();
-
-    if (m_pLightPixelShader)
-        m_pLightPixelShader->Release();
-
-    if (m_pNormalMapView)
-        m_pNormalMapView->Release();
-
-    if (m_pModelBufferInst)
-        m_pModelBufferInst->Release();
-
-    if (m_pPostProcessTexture)
-        m_pPostProcessTexture->Release();
-
-    if (m_pPostProcessRTV)
-        m_pPostProcessRTV->Release();
-
-    if (m_pPostProcessSRV)
-        m_pPostProcessSRV->Release();
-
-    if (m_pPostProcessVS)
-        m_pPostProcessVS->Release();
-
-    if (m_pPostProcessPS)
-        m_pPostProcessPS->Release();
-
-    if (m_pFullScreenVB)
-        m_pFullScreenVB->Release();
-
-    if (m_pFullScreenLayout)
-        m_pFullScreenLayout->Release();
-
-    m_modelInstances.clear();
-}
-
-void RenderClass::TerminateSkybox() {
-    if (m_pSkyboxVB) {
-        m_pSkyboxVB->Release();
-    }
-
-    if (m_pSkyboxSRV) {
-        m_pSkyboxSRV->Release();
-    }
-
-    if (m_pSkyboxVPBuffer) {
-        m_pSkyboxVPBuffer->Release();
-    }
-
-    if (m_pSkyboxLayout) {
-        m_pSkyboxLayout->Release();
-    }
-
-    if (m_pSkyboxVS) {
-        m_pSkyboxVS->Release();
-    }
-
-    if (m_pSkyboxPS) {
-        m_pSkyboxPS->Release();
-    }
-}
-
-
-
-HRESULT RenderClass::CompileShader(const std::wstring& path, ID3D11VertexShader** ppVertexShader, ID3D11PixelShader** ppPixelShader, ID3DBlob** pCodeShader) {
-    std::wstring extension = Extension(path);
-
-    std::string platform = "";
-
-    if (extension == L"vs") {
-        platform = "vs_5_0";
-    }
-    else if (extension == L"ps") {
-        platform = "ps_5_0";
-    }
-
-    UINT flags = 0;
-#ifdef _DEBUG
-    flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
-#endif
-
-    ID3DBlob* pCode = nullptr;
-    ID3DBlob* pErr = nullptr;
-
-    HRESULT hr = D3DCompileFromFile(path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", platform.c_str(), 0, 0, &pCode, &pErr);
-    if (!SUCCEEDED(hr) && pErr != nullptr) {
-        OutputDebugStringA((const char*)pErr->GetBufferPointer());
-    }
-    if (pErr)
-        pErr->Release();
-
-    if (SUCCEEDED(hr)) {
-        if (extension == L"vs" && ppVertexShader) {
-            hr = m_pDevice->CreateVertexShader(pCode->GetBufferPointer(), pCode->GetBufferSize(), nullptr, ppVertexShader);
-            if (FAILED(hr)) {
-                pCode->Release();
-                return hr;
-            }
-        }
-        else if (extension == L"ps" && ppPixelShader) {
-            hr = m_pDevice->CreatePixelShader(pCode->GetBufferPointer(), pCode->GetBufferSize(), nullptr, ppPixelShader);
-            if (FAILED(hr)) {
-                pCode->Release();
-                return hr;
-            }
-        }
-    }
-
-    if (pCodeShader) {
-        *pCodeShader = pCode;
-    }
-    else {
-        pCode->Release();
-    }
-    return hr;
-}
-
-void RenderClass::UpdateFrustum(const XMMATRIX& viewProjMatrix)
-{
-    // Преобразуем матрицу из SIMD в обычный формат для удобства работы
-    XMFLOAT4X4 matrix;
-    XMStoreFloat4x4(&matrix, viewProjMatrix);
-
-    // Плоскости усечённой пирамиды (лево, право, низ, верх, ближняя, дальняя)
-    m_frustumPlanes[0] = XMVectorSet(
-        matrix._14 + matrix._11,
-        matrix._24 + matrix._21,
-        matrix._34 + matrix._31,
-        matrix._44 + matrix._41
-    ); // Левая грань
-
-    m_frustumPlanes[1] = XMVectorSet(
-        matrix._14 - matrix._11,
-        matrix._24 - matrix._21,
-        matrix._34 - matrix._31,
-        matrix._44 - matrix._41
-    ); // Правая грань
-
-    m_frustumPlanes[2] = XMVectorSet(
-        matrix._14 + matrix._12,
-        matrix._24 + matrix._22,
-        matrix._34 + matrix._32,
-        matrix._44 + matrix._42
-    ); // Нижняя грань
-
-    m_frustumPlanes[3] = XMVectorSet(
-        matrix._14 - matrix._12,
-        matrix._24 - matrix._22,
-        matrix._34 - matrix._32,
-        matrix._44 - matrix._42
-    ); // Верхняя грань
-
-    m_frustumPlanes[4] = XMVectorSet(
-        matrix._13,
-        matrix._23,
-        matrix._33,
-        matrix._43
-    ); // Ближняя грань
-
-    m_frustumPlanes[5] = XMVectorSet(
-        matrix._14 - matrix._13,
-        matrix._24 - matrix._23,
-        matrix._34 - matrix._33,
-        matrix._44 - matrix._43
-    ); // Дальняя грань
-
-    // Нормализуем все плоскости
-    for (int i = 0; i < 6; ++i)
-    {
-        m_frustumPlanes[i] = XMPlaneNormalize(m_frustumPlanes[i]);
-    }
-}
-
-bool RenderClass::IsAABBInFrustum(const XMFLOAT3& center, float size) const
-{
-    // Проверка пересечения AABB с каждой плоскостью пирамиды
-    for (int i = 0; i < 6; ++i)
-    {
-        // Расстояние от центра AABB до плоскости
-        float distance = XMVectorGetX(XMPlaneDotCoord(m_frustumPlanes[i], XMLoadFloat3(&center)));
-
-        // Радиус AABB в направлении нормали плоскости
-        float radius = size * (
-            fabs(XMVectorGetX(m_frustumPlanes[i])) +
-            fabs(XMVectorGetY(m_frustumPlanes[i])) +
-            fabs(XMVectorGetZ(m_frustumPlanes[i]))
-            );
-
-        // Если полностью за плоскостью — не попадает в усечённую пирамиду
-        if (distance + radius < 0.0f)
-        {
-            return false;
-        }
-    }
-    return true;
-}
-
-
-void RenderClass::MoveCamera(float dx, float dy, float dz) {
-    m_CameraPosition.x += dx * m_CameraSpeed;
-    m_CameraPosition.y += dy * m_CameraSpeed;
-    m_CameraPosition.z += dz * m_CameraSpeed;
-}
-
-void RenderClass::RotateCamera(float lrAngle, float udAngle) {
-    m_LRAngle += lrAngle;
-    m_UDAngle -= udAngle;
-
-    m_LRAngle = fmodf(m_LRAngle, XM_2PI);
-    if (m_LRAngle > XM_PI) m_LRAngle -= XM_2PI;
-    if (m_LRAngle < -XM_PI) m_LRAngle += XM_2PI;
-
-    if (m_UDAngle > XM_PIDIV2) m_UDAngle = XM_PIDIV2;
-    if (m_UDAngle < -XM_PIDIV2) m_UDAngle = -XM_PIDIV2;
-}
-
-void RenderClass::Render() {
-    ID3D11ShaderResourceView* nullSRVs[1] = { nullptr };
-    m_pDeviceContext->PSSetShaderResources(0, 1, nullSRVs);
-    m_pDeviceContext->VSSetShaderResources(0, 1, nullSRVs);
-
-    float clearColor[4] = { 0.48f, 0.57f, 0.48f, 1.0f };
-    m_pDeviceContext->ClearRenderTargetView(m_pPostProcessRTV, clearColor);
-    m_pDeviceContext->ClearRenderTargetView(m_pRenderTargetView, clearColor);
-    m_pDeviceContext->ClearDepthStencilView(m_pDepthView, D3D11_CLEAR_DEPTH, 1.0f, 0);
-
-    m_pDeviceContext->OMSetRenderTargets(1, &m_pPostProcessRTV, m_pDepthView);
-
-    XMMATRIX rotLR = XMMatrixRotationY(m_LRAngle);
-    XMMATRIX rotUD = XMMatrixRotationX(m_UDAngle);
-    XMMATRIX totalRot;
-    if (m_CameraPosition.z <= 0)
-    {
-        totalRot = rotLR * rotUD;
-    }
-    else
-    {
-        totalRot = rotUD * rotLR;
-    }
-
-    
-    XMVECTOR eyePos = XMVectorSet(m_CameraPosition.x, m_CameraPosition.y, m_CameraPosition.z, 0.0f);
-    XMVECTOR focusPoint = XMVectorAdd(eyePos, XMVector3TransformNormal(XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f), totalRot));
-    XMMATRIX view = XMMatrixLookAtLH(eyePos, focusPoint, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
-
-    RECT rc;
-    GetClientRect(FindWindow(m_szWindowClass, m_szTitle), &rc);
-    float aspect = static_cast<float>(rc.right - rc.left) / (rc.bottom - rc.top);
-    XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4, aspect, 0.1f, 100.0f);
-
-    RenderSkybox(proj);
-
-    RenderCubes(view, proj);
-
-    RenderParallelogram();
-
-    m_pDeviceContext->PSSetShaderResources(0, 1, nullSRVs);
-    m_pDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, nullptr);
-
-    if (m_useNegative)
-    {
-        m_pDeviceContext->VSSetShader(m_pPostProcessVS, nullptr, 0);
-        m_pDeviceContext->PSSetShader(m_pPostProcessPS, nullptr, 0);
-        m_pDeviceContext->IASetInputLayout(m_pFullScreenLayout);
-
-        m_pDeviceContext->PSSetShaderResources(0, 1, &m_pPostProcessSRV);
-        m_pDeviceContext->PSSetSamplers(0, 1, &m_pSamplerState);
-
-        UINT stride = sizeof(FullScreenVertex);
-        UINT offset = 0;
-        m_pDeviceContext->IASetVertexBuffers(0, 1, &m_pFullScreenVB, &stride, &offset);
-        m_pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        m_pDeviceContext->Draw(3, 0);
-    }
-    else
-    {
-        ID3D11Resource* srcResource = nullptr;
-        ID3D11Resource* dstResource = nullptr;
-
-        m_pPostProcessSRV->GetResource(&srcResource);
-        m_pRenderTargetView->GetResource(&dstResource);
-
-        if (srcResource && dstResource)
-        {
-            m_pDeviceContext->CopyResource(dstResource, srcResource);
-        }
-
-        if (srcResource) srcResource->Release();
-        if (dstResource) dstResource->Release();
-    }
-
-    RenderImGui();
-
-    m_pSwapChain->Present(1, 0);
-    m_pDeviceContext->OMSetRenderTargets(0, nullptr, nullptr);
-    m_pDeviceContext->PSSetShaderResources(0, 1, nullSRVs);
-}
-
-void RenderClass::SetMVPBuffer() {
-    XMMATRIX rotLR = XMMatrixRotationY(m_LRAngle);
-    XMMATRIX rotUD = XMMatrixRotationX(m_UDAngle);
-    XMMATRIX totalRot = rotLR * rotUD;
-
-    XMVECTOR defaultForward = XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f);
-    XMVECTOR direction = XMVector3TransformNormal(defaultForward, totalRot);
-
-    XMVECTOR eyePos = XMVectorSet(m_CameraPosition.x, m_CameraPosition.y, m_CameraPosition.z, 0.0f);
-    XMVECTOR focusPoint = XMVectorAdd(eyePos, direction);
-    XMVECTOR upDir = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-    XMMATRIX view = XMMatrixLookAtLH(eyePos, focusPoint, upDir);
-
-    RECT rc;
-    GetClientRect(FindWindow(m_szWindowClass, m_szTitle), &rc);
-    float aspect = static_cast<float>(rc.right - rc.left) / (rc.bottom - rc.top);
-    XMMATRIX proj = XMMatrixPerspectiveFovLH(XM_PIDIV4, aspect, 0.1f, 100.0f);
-
-    XMMATRIX rotLRSky = XMMatrixRotationY(-m_LRAngle);
-    XMMATRIX rotUDSky = XMMatrixRotationX(-m_UDAngle);
-    XMMATRIX viewSkybox = rotLRSky * rotUDSky;
-    XMMATRIX vpSkybox = XMMatrixTranspose(viewSkybox * proj);
-
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    if (SUCCEEDED(m_pDeviceContext->Map(m_pSkyboxVPBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) {
-        memcpy(mapped.pData, &vpSkybox, sizeof(XMMATRIX));
-        m_pDeviceContext->Unmap(m_pSkyboxVPBuffer, 0);
-    }
-
-    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
-    dsDesc.DepthEnable = true;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
-    ID3D11DepthStencilState* pDSStateSkybox = nullptr;
-    m_pDevice->CreateDepthStencilState(&dsDesc, &pDSStateSkybox);
-    m_pDeviceContext->OMSetDepthStencilState(pDSStateSkybox, 0);
-
-    D3D11_RASTERIZER_DESC rsDesc = {};
-    rsDesc.FillMode = D3D11_FILL_SOLID;
-    rsDesc.CullMode = D3D11_CULL_FRONT;
-    rsDesc.FrontCounterClockwise = false;
-    ID3D11RasterizerState* pSkyboxRS = nullptr;
-    if (SUCCEEDED(m_pDevice->CreateRasterizerState(&rsDesc, &pSkyboxRS))) {
-        m_pDeviceContext->RSSetState(pSkyboxRS);
-    }
-
-    UINT stride = sizeof(SkyboxVertex);
-    UINT offset = 0;
-    m_pDeviceContext->IASetVertexBuffers(0, 1, &m_pSkyboxVB, &stride, &offset);
-    m_pDeviceContext->IASetInputLayout(m_pSkyboxLayout);
-    m_pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-    m_pDeviceContext->VSSetShader(m_pSkyboxVS, nullptr, 0);
-    m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pSkyboxVPBuffer);
-
-    m_pDeviceContext->PSSetShader(m_pSkyboxPS, nullptr, 0);
-    m_pDeviceContext->PSSetShaderResources(0, 1, &m_pSkyboxSRV);
-    m_pDeviceContext->PSSetSamplers(0, 1, &m_pSamplerState);
-
-    m_pDeviceContext->Draw(36, 0);
-
-    pDSStateSkybox->Release();
-    if (pSkyboxRS) {
-        pSkyboxRS->Release();
-        m_pDeviceContext->RSSetState(nullptr);
-    }
-
-    m_pDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, m_pDepthView);
-
-    m_CubeAngle += 0.01f;
-    if (m_CubeAngle > XM_2PI) m_CubeAngle -= XM_2PI;
-    XMMATRIX model = XMMatrixRotationY(m_CubeAngle);
-
-    XMMATRIX vp = view * proj;
-    XMMATRIX mT = XMMatrixTranspose(model);
-    XMMATRIX vpT = XMMatrixTranspose(vp);
-
-    m_pDeviceContext->UpdateSubresource(m_pModelBuffer, 0, nullptr, &mT, 0, 0);
-
-    D3D11_MAPPED_SUBRESOURCE mappedResource;
-    HRESULT hr = m_pDeviceContext->Map(m_pVPBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
-    if (SUCCEEDED(hr)) {
-        memcpy(mappedResource.pData, &vpT, sizeof(XMMATRIX));
-        m_pDeviceContext->Unmap(m_pVPBuffer, 0);
-    }
-    m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pModelBuffer);
-    m_pDeviceContext->VSSetConstantBuffers(1, 1, &m_pVPBuffer);
-}
-
-HRESULT RenderClass::ConfigureBackBuffer(UINT width, UINT height) {
-    if (m_pPostProcessTexture) m_pPostProcessTexture->Release();
-    if (m_pPostProcessRTV) m_pPostProcessRTV->Release();
-    if (m_pPostProcessSRV) m_pPostProcessSRV->Release();
-    if (m_pRenderTargetView) m_pRenderTargetView->Release();
-    if (m_pDepthView) m_pDepthView->Release();
-
-    m_pPostProcessTexture = nullptr;
-    m_pPostProcessRTV = nullptr;
-    m_pPostProcessSRV = nullptr;
-    m_pRenderTargetView = nullptr;
-    m_pDepthView = nullptr;
-
-    ID3D11Texture2D* pBackBuffer = nullptr;
-    HRESULT hr = m_pSwapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (LPVOID*)&pBackBuffer);
-    if (FAILED(hr))
-        return hr;
-
-    hr = m_pDevice->CreateRenderTargetView(pBackBuffer, nullptr, &m_pRenderTargetView);
-    pBackBuffer->Release();
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_TEXTURE2D_DESC descDepth = {};
-    descDepth.Width = width;
-    descDepth.Height = height;
-    descDepth.MipLevels = 1;
-    descDepth.ArraySize = 1;
-    descDepth.Format = DXGI_FORMAT_D24_UNORM_S8_UINT;
-    descDepth.SampleDesc.Count = 1;
-    descDepth.BindFlags = D3D11_BIND_DEPTH_STENCIL;
-    ID3D11Texture2D* pDepthStencil = nullptr;
-    hr = m_pDevice->CreateTexture2D(&descDepth, nullptr, &pDepthStencil);
-    if (FAILED(hr))
-        return hr;
-
-    hr = m_pDevice->CreateDepthStencilView(pDepthStencil, nullptr, &m_pDepthView);
-    pDepthStencil->Release();
-    if (FAILED(hr))
-        return hr;
-
-    D3D11_TEXTURE2D_DESC texDesc = {};
-    texDesc.Width = width;
-    texDesc.Height = height;
-    texDesc.MipLevels = 1;
-    texDesc.ArraySize = 1;
-    texDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    texDesc.SampleDesc.Count = 1;
-    texDesc.Usage = D3D11_USAGE_DEFAULT;
-    texDesc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-
-    hr = m_pDevice->CreateTexture2D(&texDesc, nullptr, &m_pPostProcessTexture);
-    if (FAILED(hr)) return hr;
-
-    hr = m_pDevice->CreateRenderTargetView(m_pPostProcessTexture, nullptr, &m_pPostProcessRTV);
-    if (FAILED(hr)) return hr;
-
-    hr = m_pDevice->CreateShaderResourceView(m_pPostProcessTexture, nullptr, &m_pPostProcessSRV);
-    if (FAILED(hr)) return hr;
-
-    D3D11_VIEWPORT vp;
-    vp.Width = (FLOAT)width;
-    vp.Height = (FLOAT)height;
-    vp.MinDepth = 0.0f;
-    vp.MaxDepth = 1.0f;
-    vp.TopLeftX = 0;
-    vp.TopLeftY = 0;
-    m_pDeviceContext->RSSetViewports(1, &vp);
-
-    return hr;
-}
-
-void RenderClass::Resize(HWND hWnd) {
-    if (m_pRenderTargetView) {
-        m_pRenderTargetView->Release();
-        m_pRenderTargetView = nullptr;
-    }
-
-    if (m_pDepthView) {
-        m_pDepthView->Release();
-        m_pDepthView = nullptr;
-    }
-
-    if (m_pSwapChain) {
-        HRESULT hr;
-
-        RECT rc;
-        GetClientRect(hWnd, &rc);
-        UINT width = rc.right - rc.left;
-        UINT height = rc.bottom - rc.top;
-
-        hr = m_pSwapChain->ResizeBuffers(1, width, height, DXGI_FORMAT_R8G8B8A8_UNORM, 0);
-        if (FAILED(hr)) {
-            MessageBox(nullptr, L"ResizeBuffers failed.", L"Error", MB_OK);
-            return;
-        }
-
-        HRESULT resultBack = ConfigureBackBuffer(width, height);
-        if (FAILED(resultBack)) {
-            MessageBox(nullptr, L"Configure back buffer failed.", L"Error", MB_OK);
-            return;
-        }
-
-        m_pDeviceContext->OMSetRenderTargets(1, &m_pRenderTargetView, m_pDepthView);
-
-        D3D11_VIEWPORT vp;
-        vp.Width = (FLOAT)width;
-        vp.Height = (FLOAT)height;
-        vp.MinDepth = 0.0f;
-        vp.MaxDepth = 1.0f;
-        vp.TopLeftX = 0;
-        vp.TopLeftY = 0;
-        m_pDeviceContext->RSSetViewports(1, &vp);
-    }
-}
-HRESULT RenderClass::InitParallelogram() {
-    ID3DBlob* pVertBlob = nullptr;
-    HRESULT hr = CompileShader(L"ParallelogramVertex.vs", &m_pParallelogramVS, nullptr, &pVertBlob);
-    if (SUCCEEDED(hr))
-        hr = CompileShader(L"ParallelogramPixel.ps", nullptr, &m_pParallelogramPS);
-    D3D11_INPUT_ELEMENT_DESC layout[] = {
-        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 }
-    };
-    if (SUCCEEDED(hr))
-        hr = m_pDevice->CreateInputLayout(layout, 1, pVertBlob->GetBufferPointer(), pVertBlob->GetBufferSize(), &m_pParallelogramLayout);
-    ParallelogramVertex verts[] = {
-        {-0.5f, -1.0f, 0.0f},
-        {-0.2f,  1.0f, 0.0f},
-        { 1.0f,  0.8f, 0.0f},
-        { 0.8f, -0.8f, 0.0f}
-    };
-    WORD indices[] = { 0, 1, 2, 0, 2, 3 };
-    D3D11_BUFFER_DESC bd = {};
-    bd.Usage = D3D11_USAGE_DEFAULT;
-    bd.ByteWidth = sizeof(verts);
-    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    D3D11_SUBRESOURCE_DATA initData = {};
-    initData.pSysMem = verts;
-    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pParallelogramVB);
-    if (FAILED(hr))
-        return hr;
-    bd.ByteWidth = sizeof(indices);
-    bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    initData.pSysMem = indices;
-    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pParallelogramIB);
-    if (FAILED(hr))
-        return hr;
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = sizeof(ColorBuffer);
-    cbDesc.Usage = D3D11_USAGE_DEFAULT;
-    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    hr = m_pDevice->CreateBuffer(&cbDesc, nullptr, &m_pColorBuffer);
-    if (FAILED(hr))
-        return hr;
-    D3D11_BLEND_DESC bsDesc = {};
-    bsDesc.RenderTarget[0].BlendEnable = true;
-    bsDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
-    bsDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
-    bsDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
-    bsDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
-    bsDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
-    bsDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
-    bsDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
-    hr = m_pDevice->CreateBlendState(&bsDesc, &m_pBlendState);
-    if (FAILED(hr))
-        return hr;
-    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
-    dsDesc.DepthEnable = true;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
-    hr = m_pDevice->CreateDepthStencilState(&dsDesc, &m_pDepthStateParallelogram);
-    if (FAILED(hr))
-        return hr;
-    return hr;
-}
-
-void RenderClass::TerminateParallelogram() {
-    if (m_pParallelogramVB) m_pParallelogramVB->Release();
-    if (m_pParallelogramIB) m_pParallelogramIB->Release();
-    if (m_pParallelogramPS) m_pParallelogramPS->Release();
-    if (m_pParallelogramVS) m_pParallelogramVS->Release();
-    if (m_pParallelogramLayout) m_pParallelogramLayout->Release();
-    if (m_pBlendState) m_pBlendState->Release();
-    if (m_pDepthStateParallelogram) m_pDepthStateParallelogram->Release();
-    if (m_pColorBuffer) m_pColorBuffer->Release();
-}
-
-void RenderClass::RenderParallelogram() {
-    D3D11_RASTERIZER_DESC rsDesc = {};
-    rsDesc.FillMode = D3D11_FILL_SOLID;
-    rsDesc.CullMode = D3D11_CULL_NONE;
-    rsDesc.FrontCounterClockwise = false;
-
-    ID3D11RasterizerState* pRS = nullptr;
-    m_pDevice->CreateRasterizerState(&rsDesc, &pRS);
-    m_pDeviceContext->RSSetState(pRS);
-    m_pDeviceContext->OMSetDepthStencilState(m_pDepthStateParallelogram, 0);
-    m_pDeviceContext->OMSetBlendState(m_pBlendState, nullptr, 0xffffffff);
-
-    UINT stride = sizeof(ParallelogramVertex), offset = 0;
-
-    m_pDeviceContext->IASetVertexBuffers(0, 1, &m_pParallelogramVB, &stride, &offset);
-    m_pDeviceContext->IASetIndexBuffer(m_pParallelogramIB, DXGI_FORMAT_R16_UINT, 0);
-    m_pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_pDeviceContext->IASetInputLayout(m_pParallelogramLayout);
-    m_pDeviceContext->VSSetShader(m_pParallelogramVS, nullptr, 0);
-    m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pModelBuffer);
-    m_pDeviceContext->VSSetConstantBuffers(1, 1, &m_pVPBuffer);
-    m_pDeviceContext->PSSetShader(m_pParallelogramPS, nullptr, 0);
-    m_pDeviceContext->PSSetConstantBuffers(0, 1, &m_pColorBuffer);
-
-    static float t = 0.0f;
-    t += 0.03f;
-
-    XMMATRIX model1 = XMMatrixTranslation(sinf(t) * 2.5f, 0.8f, -3.0f);
-    XMMATRIX m1T = XMMatrixTranspose(model1);
-    XMFLOAT4 color1 = XMFLOAT4(0.0f, 0.5f, 0.5f, 0.5f);
-
-    XMMATRIX model2 = XMMatrixTranslation(-cosf(t) * 2.5f, 0.8f, -2.0f);
-    XMMATRIX m2T = XMMatrixTranspose(model2);
-    XMFLOAT4 color2 = XMFLOAT4(0.5f, 0.0f, 0.5f, 0.5f);
-
-    XMFLOAT3 pos1, pos2;
-    XMStoreFloat3(&pos1, model1.r[3]);
-    XMStoreFloat3(&pos2, model2.r[3]);
-
-    XMVECTOR cam = XMLoadFloat3(&m_CameraPosition);
-
-    XMVECTOR v1 = XMLoadFloat3(&pos1);
-    XMVECTOR v2 = XMLoadFloat3(&pos2);
-
-    float d1 = XMVectorGetX(XMVector3Length(v1 - cam));
-    float d2 = XMVectorGetX(XMVector3Length(v2 - cam));
-
-    if (d1 >= d2) {
-        m_pDeviceContext->UpdateSubresource(m_pModelBuffer, 0, nullptr, &m1T, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pColorBuffer, 0, nullptr, &color1, 0, 0);
-        m_pDeviceContext->DrawIndexed(6, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pModelBuffer, 0, nullptr, &m2T, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pColorBuffer, 0, nullptr, &color2, 0, 0);
-        m_pDeviceContext->DrawIndexed(6, 0, 0);
-    }
-    else {
-        m_pDeviceContext->UpdateSubresource(m_pModelBuffer, 0, nullptr, &m2T, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pColorBuffer, 0, nullptr, &color2, 0, 0);
-        m_pDeviceContext->DrawIndexed(6, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pModelBuffer, 0, nullptr, &m1T, 0, 0);
-        m_pDeviceContext->UpdateSubresource(m_pColorBuffer, 0, nullptr, &color1, 0, 0);
-        m_pDeviceContext->DrawIndexed(6, 0, 0);
-    }
-    pRS->Release();
-}
-
-void RenderClass::RenderSkybox(XMMATRIX proj) {
-    XMMATRIX rY = XMMatrixRotationY(-m_LRAngle);
-    XMMATRIX rX = XMMatrixRotationX(-m_UDAngle);
-    XMMATRIX vMat = rY * rX;
-    XMMATRIX vpMat = XMMatrixTranspose(vMat * proj);
-    D3D11_MAPPED_SUBRESOURCE mapRes;
-
-    if (SUCCEEDED(m_pDeviceContext->Map(m_pSkyboxVPBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapRes))) {
-        memcpy(mapRes.pData, &vpMat, sizeof(XMMATRIX));
-        m_pDeviceContext->Unmap(m_pSkyboxVPBuffer, 0);
-    }
-
-    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
-    dsDesc.DepthEnable = true;
-    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
-    dsDesc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
-
-    ID3D11DepthStencilState* pDS = nullptr;
-    m_pDevice->CreateDepthStencilState(&dsDesc, &pDS);
-    m_pDeviceContext->OMSetDepthStencilState(pDS, 0);
-
-    D3D11_RASTERIZER_DESC rsDesc = {};
-    rsDesc.FillMode = D3D11_FILL_SOLID;
-    rsDesc.CullMode = D3D11_CULL_FRONT;
-    rsDesc.FrontCounterClockwise = false;
-
-    ID3D11RasterizerState* pRS = nullptr;
-    if (SUCCEEDED(m_pDevice->CreateRasterizerState(&rsDesc, &pRS)))
-        m_pDeviceContext->RSSetState(pRS);
-
-    UINT stride = sizeof(SkyboxVertex), offset = 0;
-
-    m_pDeviceContext->IASetVertexBuffers(0, 1, &m_pSkyboxVB, &stride, &offset);
-    m_pDeviceContext->IASetInputLayout(m_pSkyboxLayout);
-    m_pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_pDeviceContext->VSSetShader(m_pSkyboxVS, nullptr, 0);
-    m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pSkyboxVPBuffer);
-    m_pDeviceContext->PSSetShader(m_pSkyboxPS, nullptr, 0);
-    m_pDeviceContext->PSSetShaderResources(0, 1, &m_pSkyboxSRV);
-    m_pDeviceContext->PSSetSamplers(0, 1, &m_pSamplerState);
-    m_pDeviceContext->Draw(36, 0);
-
-    pDS->Release();
-    if (pRS) { pRS->Release(); m_pDeviceContext->RSSetState(nullptr); }
-}
-
-void RenderClass::RenderCubes(XMMATRIX view, XMMATRIX proj)
-{
-    m_pDeviceContext->OMSetRenderTargets(1, &m_pPostProcessRTV, m_pDepthView); m_pDeviceContext->OMSetDepthStencilState(nullptr, 0);
-    m_pDeviceContext->OMSetDepthStencilState(nullptr, 0);
-
-    CameraBuffer cameraBuffer;
-    cameraBuffer.vp = XMMatrixTranspose(view * proj);
-    cameraBuffer.cameraPos = m_CameraPosition;
-
-    D3D11_MAPPED_SUBRESOURCE mappedResource;
-    HRESULT hr = m_pDeviceContext->Map(m_pVPBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResource);
-    if (SUCCEEDED(hr))
-    {
-        memcpy(mappedResource.pData, &cameraBuffer, sizeof(CameraBuffer));
-        m_pDeviceContext->Unmap(m_pVPBuffer, 0);
-    }
-
-    UINT stride = sizeof(CubeVertex);
-    UINT offset = 0;
-    m_pDeviceContext->IASetVertexBuffers(0, 1, &m_pVertexBuffer, &stride, &offset);
-    m_pDeviceContext->IASetIndexBuffer(m_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
-    m_pDeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_pDeviceContext->IASetInputLayout(m_pLayout);
-
-    m_pDeviceContext->VSSetShader(m_pVertexShader, nullptr, 0);
-    m_pDeviceContext->PSSetShader(m_pPixelShader, nullptr, 0);
-    m_pDeviceContext->VSSetConstantBuffers(1, 1, &m_pVPBuffer);
-
-
-    m_pDeviceContext->PSSetShaderResources(0, 1, &m_pTextureView);
-    m_pDeviceContext->PSSetShaderResources(1, 1, &m_pNormalMapView);
-    m_pDeviceContext->PSSetSamplers(0, 1, &m_pSamplerState);
-
-    UpdateFrustum(view * proj);
-
-    m_CubeAngle += 0.01f;
-    if (m_CubeAngle > XM_2PI) m_CubeAngle -= XM_2PI;
-
-    if (m_pComputeShader)
-    {
-        for (int i = 0; i < m_modelInstances.size(); i++)
-        {
-            XMFLOAT3 position;
-            XMStoreFloat3(&position, m_modelInstances[i].model.r[3]);
-            m_modelInstances[i].model = XMMatrixScaling(m_fixedScale, m_fixedScale, m_fixedScale) *
-                XMMatrixRotationY(m_CubeAngle) *
-                XMMatrixTranslation(position.x, position.y, position.z);
-        }
-    
-        D3D11_MAPPED_SUBRESOURCE mapped;
-        if (SUCCEEDED(m_pDeviceContext->Map(m_pFrustumPlanesBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
-        {
-            memcpy(mapped.pData, m_frustumPlanes, sizeof(XMVECTOR) * 6);
-            m_pDeviceContext->Unmap(m_pFrustumPlanesBuffer, 0);
-        }
-
-        UINT initialArgs[5] = { 36, 0, 0, 0, 0 };
-        m_pDeviceContext->UpdateSubresource(m_pIndirectArgsBuffer, 0, nullptr, initialArgs, 0, 0);
-
-        m_pDeviceContext->CSSetShader(m_pComputeShader, nullptr, 0);
-        m_pDeviceContext->CSSetConstantBuffers(0, 1, &m_pFrustumPlanesBuffer);
-        m_pDeviceContext->CSSetUnorderedAccessViews(0, 1, &m_pIndirectArgsUAV, nullptr);
-        m_pDeviceContext->CSSetUnorderedAccessViews(1, 1, &m_pObjectsIdsUAV, nullptr);
-        m_pDeviceContext->CSSetShaderResources(0, 1, &m_pInstanceDataSRV);
-
-        m_pDeviceContext->Dispatch((MaxInst + 63) / 64, 1, 1);
-
-        auto args = ReadUintBufferData(m_pDeviceContext, m_pIndirectArgsBuffer, 2);
-        m_visibleCubes = args[1];
-
-        if (m_visibleCubes > 0)
-        {
-            auto visibleIds = ReadUintBufferData(m_pDeviceContext, m_pObjectsIdsBuffer, m_visibleCubes);
-
-            std::vector<InstanceData> visibleInstances(m_visibleCubes);
-            for (UINT i = 0; i < m_visibleCubes; i++)
-            {
-                UINT id = visibleIds[i];
-                visibleInstances[i].model = XMMatrixTranspose(m_modelInstances[id].model);
-                visibleInstances[i].texInd = m_modelInstances[id].texInd;
-            }
-
-            m_pDeviceContext->UpdateSubresource(
-                m_pModelBufferInst,
-                0,
-                nullptr,
-                visibleInstances.data(),
-                0,
-                sizeof(InstanceData) * m_visibleCubes
-            );
-        }
-    
-
-        m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pModelBufferInst);
-        m_pDeviceContext->DrawIndexedInstancedIndirect(m_pIndirectArgsBuffer, 0);
-
-        ID3D11UnorderedAccessView* nullUAVs[2] = { nullptr, nullptr };
-        m_pDeviceContext->CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
-        ID3D11ShaderResourceView* nullSRVs[1] = { nullptr };
-        m_pDeviceContext->CSSetShaderResources(0, 1, nullSRVs);
-        m_pDeviceContext->CSSetShader(nullptr, nullptr, 0);
-    }
-    else
-    {
-        std::vector<InstanceData> visibleInstances;
-        visibleInstances.reserve(m_modelInstances.size());
-        m_visibleCubes = 0;
-
-        for (int i = 0; i < m_modelInstances.size(); i++) {
-            XMFLOAT3 position;
-            XMStoreFloat3(&position, m_modelInstances[i].model.r[3]);
-
-            m_modelInstances[i].model = XMMatrixScaling(m_fixedScale, m_fixedScale, m_fixedScale) *
-                XMMatrixRotationY(m_CubeAngle) *
-                XMMatrixTranslation(position.x, position.y, position.z);
-
-            float size = m_fixedScale * 0.95f;
-            if (IsAABBInFrustum(position, size))
-            {
-                InstanceData data;
-                data.model = XMMatrixTranspose(m_modelInstances[i].model);
-                data.texInd = m_modelInstances[i].texInd;
-                visibleInstances.push_back(data);
-                m_visibleCubes++;
-            }
-        }
-        if (!visibleInstances.empty())
-        {
-            m_pDeviceContext->UpdateSubresource(
-                m_pModelBufferInst,
-                0,
-                nullptr,
-                visibleInstances.data(),
-                0,
-                sizeof(InstanceData) * m_visibleCubes
-            );
-
-            m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pModelBufferInst);
-            m_pDeviceContext->DrawIndexedInstanced(36, visibleInstances.size(), 0, 0, 0);
-        }
-    }
-
-
-    static float lightOrbit = 0;
-    lightOrbit += 0.01f;
-    if (lightOrbit > XM_2PI)
-        lightOrbit -= XM_2PI;
-
-  
-    PointLight lights[3];
-    float lightRadius = 2.0f;
-
-    lights[0].Position = XMFLOAT3(0.0f, lightRadius * cosf(lightOrbit), lightRadius * sin(-lightOrbit));
-    lights[0].Range = 3.0f;
-    lights[0].Color = XMFLOAT3(1.0f, 1.0f, 1.0f);
-    lights[0].Intensity = 1.0f;
-
-    lights[1].Position = XMFLOAT3(lightRadius * cosf(lightOrbit), 0.0f, lightRadius * sin(lightOrbit));
-    lights[1].Range = 3.0f;
-    lights[1].Color = XMFLOAT3(1.0f, 1.0f, 0.13f);
-    lights[1].Intensity = 1.0f;
-
-    lightRadius = 8.0f;
-    lights[2].Position = XMFLOAT3(lightRadius * cosf(lightOrbit), 0.0f, lightRadius * sinf(-lightOrbit));
-    lights[2].Range = 5.0f;
-    lights[2].Color = XMFLOAT3(1.0f, 1.0f, 1.0f);
-    lights[2].Intensity = 1.0f;
-
-    D3D11_MAPPED_SUBRESOURCE mappedResourceLight;
-    hr = m_pDeviceContext->Map(m_pLightBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedResourceLight);
-    if (SUCCEEDED(hr))
-    {
-        memcpy(mappedResourceLight.pData, lights, sizeof(PointLight) * 3);
-        m_pDeviceContext->Unmap(m_pLightBuffer, 0);
-    }
-
-    m_pDeviceContext->PSSetConstantBuffers(2, 1, &m_pLightBuffer);
-    m_pDeviceContext->PSSetShader(m_pLightPixelShader, nullptr, 0);
-
-    for (int i = 0; i < 3; i++)
-    {
-        XMMATRIX lightModel = XMMatrixScaling(0.1f, 0.1f, 0.1f) * XMMatrixTranslation(lights[i].Position.x, lights[i].Position.y, lights[i].Position.z);
-        XMMATRIX lightModelTransposed = XMMatrixTranspose(lightModel);
-        XMFLOAT4X4 lightModelTStored;
-        XMStoreFloat4x4(&lightModelTStored, lightModelTransposed);
-
-        m_pDeviceContext->UpdateSubresource(m_pModelBufferInst, 0, nullptr, &lightModelTStored, 0, 0);
-        m_pDeviceContext->VSSetConstantBuffers(0, 1, &m_pModelBufferInst);
-
-        XMFLOAT4 lightColor = XMFLOAT4(lights[i].Color.x, lights[i].Color.y, lights[i].Color.z, 1.0f);
-        m_pDeviceContext->UpdateSubresource(m_pColorBuffer, 0, nullptr, &lightColor, 0, 0);
-
-        m_pDeviceContext->DrawIndexed(36, 0, 0);
-    }
-}
-
-
-void RenderClass::InitImGui(HWND hWnd)
-{
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO();
-    io.Fonts->AddFontDefault();
-
-    ImGui::StyleColorsLight();
-    ImGuiStyle& style = ImGui::GetStyle();
-    style.WindowRounding = 6.0f;
-    style.FrameRounding = 4.0f;
-    style.ScrollbarRounding = 6.0f;
-
-    ImVec4* colors = style.Colors;
-    colors[ImGuiCol_WindowBg] = ImVec4(0.97f, 0.97f, 0.98f, 1.00f);
-    colors[ImGuiCol_Header] = ImVec4(0.20f, 0.50f, 0.90f, 0.45f);
-    colors[ImGuiCol_HeaderHovered] = ImVec4(0.20f, 0.50f, 0.90f, 0.80f);
-    colors[ImGuiCol_HeaderActive] = ImVec4(0.20f, 0.50f, 0.90f, 1.00f);
-    colors[ImGuiCol_Button] = ImVec4(0.26f, 0.54f, 0.85f, 0.40f);
-    colors[ImGuiCol_ButtonHovered] = ImVec4(0.26f, 0.54f, 0.85f, 1.00f);
-    colors[ImGuiCol_ButtonActive] = ImVec4(0.06f, 0.53f, 0.98f, 1.00f);
-
-    ImGui_ImplWin32_Init(hWnd);
-    ImGui_ImplDX11_Init(m_pDevice, m_pDeviceContext);
-}
-
-void RenderClass::RenderImGui()
-{
-    ImGui_ImplDX11_NewFrame();
-    ImGui_ImplWin32_NewFrame();
-    ImGui::NewFrame();
-
-    ImGui::SetNextWindowSize(ImVec2(600, 500), ImGuiCond_Once);
-    ImGui::Begin("PostProcess", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
-    ImGui::Checkbox("Negative", &m_useNegative);
-    ImGui::End();
-
-    ImGui::SetNextWindowSize(ImVec2(300, 140), ImGuiCond_Once);
-    ImGui::Begin("Clipping", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
-    ImGui::Text("All:     %d", MaxInst);
-    ImGui::Text("Visible:    %d", m_visibleCubes);
-    ImGui::Text("Cut off:  %d", MaxInst - m_visibleCubes);
-    ImGui::End();
-
-    ImGui::Render();
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
-}
-
+﻿#include "framework.h"
+#include "RenderClass.h"
+#include <filesystem>
+#include <utility>
+#include <wrl/client.h>
+#include <dxgi.h>
+#include <d3d11.h>
+#include <d3dcompiler.h>
+
+#include "imgui.h"
+#include "imgui_impl_dx11.h"
+#include "imgui_impl_win32.h"
+
+#pragma comment (lib, "d3dcompiler.lib")
+#pragma comment (lib, "d3d11.lib")
+#pragma comment (lib, "dxgi.lib")
+
+using namespace Microsoft::WRL;
+
+std::wstring Extension(const std::wstring& path) {
+    size_t dotPos = path.find_last_of(L".");
+    if (dotPos == std::wstring::npos || dotPos == 0) {
+        return L"";
+    }
+    return path.substr(dotPos + 1);
+}
+
+HRESULT RenderClass::Init(HWND hWnd, WCHAR szTitle[], WCHAR szWindowClass[]) {
+    m_szTitle = szTitle;
+    m_szWindowClass = szWindowClass;
+
+    // Отсюда считается время до первого кадра и до загрузки всех текстур
+    QueryPerformanceFrequency(&m_timerFrequency);
+    QueryPerformanceCounter(&m_initStartTime);
+
+    m_jobs.Init(0);
+    m_pendingThreadCount = static_cast<int>(m_jobs.GetThreadCount());
+
+    HRESULT hr;
+
+    IDXGIFactory* pFactory = nullptr;
+    hr = CreateDXGIFactory(__uuidof(IDXGIFactory), (void**)&pFactory);
+
+    IDXGIAdapter* pSelectedAdapter = NULL;
+    if (SUCCEEDED(hr)) {
+        IDXGIAdapter* pAdapter = NULL;
+        UINT adapterIdx = 0;
+        while (SUCCEEDED(pFactory->EnumAdapters(adapterIdx, &pAdapter))) {
+            DXGI_ADAPTER_DESC desc;
+            pAdapter->GetDesc(&desc);
+
+            if (wcscmp(desc.Description, L"Microsoft Basic Render Driver") != 0) {
+                pSelectedAdapter = pAdapter;
+                break;
+            }
+
+            pAdapter->Release();
+            adapterIdx++;
+        }
+    }
+
+    D3D_FEATURE_LEVEL level;
+    D3D_FEATURE_LEVEL levels[] = { D3D_FEATURE_LEVEL_11_0 };
+    if (SUCCEEDED(hr)) {
+        UINT flags = 0;
+#ifdef _DEBUG
+        flags |= D3D11_CREATE_DEVICE_DEBUG;
+#endif
+        hr = D3D11CreateDevice(pSelectedAdapter, D3D_DRIVER_TYPE_UNKNOWN, NULL,
+            flags, levels, 1, D3D11_SDK_VERSION, &m_pDevice, &level, &m_pDeviceContext);
+    }
+
+    if (SUCCEEDED(hr)) {
+        hr = m_swapChain.Init(m_pDevice, hWnd, SwapChainBuffers, MaxFrameLatency);
+        m_pendingBufferCount = static_cast<int>(m_swapChain.GetBufferCount());
+        m_maxFrameLatency = static_cast<int>(m_swapChain.GetMaximumFrameLatency());
+        m_framePacer.Init(&m_frameClock, &m_swapChain);
+    }
+
+    if (SUCCEEDED(hr)) {
+        m_stateCache.Init(m_pDevice);
+        m_graphResources.Init(m_pDevice);
+        // Отдельный пул: JobSystem занят отсечением каждый кадр и ждёт свои задачи
+        if (!m_textureLoader.Init(m_pDevice, 0))
+            hr = E_FAIL;
+    }
+
+    if (SUCCEEDED(hr)) {
+        // Чтение мипа - подкачка нескольких страниц, одного потока хватает
+        if (!m_textureStreamer.Init(m_pDevice, 1))
+            hr = E_FAIL;
+    }
+
+    if (SUCCEEDED(hr)) {
+        // Контекст D3D11.1 нужен для привязки участков кольца загрузки; без него работает запасной путь
+        if (FAILED(m_pDeviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&m_pDeviceContext1))))
+            m_pDeviceContext1 = nullptr;
+        m_stateTracker.Init(m_pDeviceContext, m_pDeviceContext1);
+        hr = m_uploadRing.Init(m_pDevice, m_pDeviceContext, m_pDeviceContext1 != nullptr);
+
+        // Без запросов времени профилировщик меряет только CPU
+        m_gpuTimer.Init(m_pDevice, m_pDeviceContext);
+        if (!m_profiler.Init(&m_gpuTimer, ProfilerLatency, ProfilerHistory))
+            m_profiler.Init(nullptr, 0, ProfilerHistory);
+
+        // Выход отсечения на GPU - по копии на кадр в пути
+        m_frameFences.Init(m_pDevice, m_pDeviceContext);
+        if (!m_cullingOutputs.Init(&m_frameFences, FramesInFlight))
+            hr = E_FAIL;
+
+        // Без отложенных контекстов проходы пишутся в немедленный контекст по очереди
+        if (FAILED(InitDeferredRecording()))
+            TerminateDeferredRecording();
+
+        m_timestep.Init(AnimationState::StepSeconds, MaxSimulationSteps);
+        m_animation.Reset();
+        m_prevAnimation = m_animation;
+        m_frameAnimation = m_animation;
+        m_clock.Reset();
+    }
+
+    if (SUCCEEDED(hr)) {
+        m_shaderCache.Init(L"ShaderCache");
+
+        RECT rc;
+        GetClientRect(hWnd, &rc);
+        ++m_win32Lookups;
+        UINT width = rc.right - rc.left;
+        UINT height = rc.bottom - rc.top;
+        m_camera.SetViewport(width, height);
+        hr = ConfigureBackBuffer(width, height);
+    }
+
+    if (SUCCEEDED(hr)) {
+        hr = InitBufferShader();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = Init2DArray();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        InitImGui(hWnd);
+    }
+
+    if (SUCCEEDED(hr)) {
+        hr = InitSkybox();
+    }
+
+    if (SUCCEEDED(hr)) {
+        hr = InitParallelogram();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = InitPostProcess();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = InitComputeShader();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        InitShaderHotReload();
+    }
+
+    pSelectedAdapter->Release();
+    pFactory->Release();
+
+    if (FAILED(hr)) {
+        Terminate();
+    }
+
+    return hr;
+}
+
+HRESULT RenderClass::InitBufferShader() {
+    static const D3D11_INPUT_ELEMENT_DESC InputDesc[] = {
+        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(CubeVertex, xyz), D3D11_INPUT_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(CubeVertex, normal), D3D11_INPUT_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, offsetof(CubeVertex, uv), D3D11_INPUT_PER_VERTEX_DATA, 0}
+    };
+
+    HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    if (FAILED(hr) && hr != RPC_E_CHANGED_MODE) {
+        OutputDebugString(L"COM initialization failed.\n");
+        return hr;
+    }
+
+    ID3DBlob* pVertexCode = nullptr;
+    if (SUCCEEDED(hr)) {
+        hr = CompileShader(L"ColorVertex.vs", &m_pVertexShader, nullptr, &pVertexCode);
+    }
+    if (SUCCEEDED(hr)) {
+        hr = CompileShader(L"ColorPixel.ps", nullptr, &m_pPixelShader);
+    }
+
+    if (SUCCEEDED(hr)) {
+        hr = m_pDevice->CreateInputLayout(InputDesc, 3, pVertexCode->GetBufferPointer(), pVertexCode->GetBufferSize(), &m_pLayout);
+    }
+
+    if (pVertexCode)
+        pVertexCode->Release();
+
+    if (SUCCEEDED(hr)) {
+        hr = CompileShader(L"LightPixel.ps", nullptr, &m_pLightPixelShader);
+    }
+
+    static const CubeVertex vertices[] =
+    {
+        { {-1.0f, -1.0f,  1.0f}, { 0.0f,  -1.0f,  0.0f}, {0.0f, 1.0f} },
+        { { 1.0f, -1.0f,  1.0f}, { 0.0f,  -1.0f,  0.0f}, {1.0f, 1.0f} },
+        { { 1.0f, -1.0f, -1.0f}, { 0.0f,  -1.0f,  0.0f}, {1.0f, 0.0f} },
+        { {-1.0f, -1.0f, -1.0f}, { 0.0f,  -1.0f,  0.0f}, {0.0f, 0.0f} },
+
+        { {-1.0f,  1.0f, -1.0f}, { 0.0f,  1.0f, 0.0f}, {0.0f, 1.0f} },
+        { { 1.0f,  1.0f, -1.0f}, { 0.0f,  1.0f, 0.0f}, {1.0f, 1.0f} },
+        { { 1.0f,  1.0f,  1.0f}, { 0.0f,  1.0f, 0.0f}, {1.0f, 0.0f} },
+        { {-1.0f,  1.0f,  1.0f}, { 0.0f,  1.0f, 0.0f}, {0.0f, 0.0f} },
+
+        { { 1.0f, -1.0f, -1.0f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
+        { { 1.0f, -1.0f,  1.0f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
+        { { 1.0f,  1.0f,  1.0f}, { 1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
+        { { 1.0f,  1.0f, -1.0f}, { 1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
+
+        { {-1.0f, -1.0f,  1.0f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 1.0f} },
+        { {-1.0f, -1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 1.0f} },
+        { {-1.0f,  1.0f, -1.0f}, {-1.0f,  0.0f,  0.0f}, {1.0f, 0.0f} },
+        { {-1.0f,  1.0f,  1.0f}, {-1.0f,  0.0f,  0.0f}, {0.0f, 0.0f} },
+
+        { { 1.0f, -1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 1.0f} },
+        { {-1.0f, -1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 1.0f} },
+        { {-1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {1.0f, 0.0f} },
+        { { 1.0f,  1.0f,  1.0f}, { 0.0f,  0.0f,  1.0f}, {0.0f, 0.0f} },
+
+        { {-1.0f, -1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {0.0f, 1.0f} },
+        { { 1.0f, -1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {1.0f, 1.0f} },
+        { { 1.0f,  1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {1.0f, 0.0f} },
+        { {-1.0f,  1.0f, -1.0f}, { 0.0f,  0.0f,  -1.0f}, {0.0f, 0.0f} },
+    };
+
+    WORD indices[] = {
+        0, 2, 1, 0, 3, 2, 4, 6, 5, 4, 7, 6, 8, 10, 9, 8, 11, 10,
+        12, 14, 13, 12, 15, 14, 16, 18, 17, 16, 19, 18, 20, 22, 21, 20, 23, 22
+    };
+
+    D3D11_BUFFER_DESC bd = {};
+    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.ByteWidth = sizeof(CubeVertex) * ARRAYSIZE(vertices);
+    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    bd.CPUAccessFlags = 0;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = vertices;
+    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pVertexBuffer);
+    if (FAILED(hr))
+        return hr;
+
+    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.ByteWidth = sizeof(WORD) * ARRAYSIZE(indices);
+    bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    bd.CPUAccessFlags = 0;
+    initData.pSysMem = indices;
+    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pIndexBuffer);
+    if (FAILED(hr))
+        return hr;
+
+    m_scene.Generate(m_instanceCount, static_cast<uint32_t>(m_materialFiles.size()));
+    hr = EnsureInstanceCapacity(m_instanceCount);
+    if (FAILED(hr))
+        return hr;
+    ResetVisibleIds();
+
+
+   
+
+    // Хвост мипов создаётся сразу; DDS, который нельзя подгружать по мипам, грузится целиком
+    hr = m_textureStreamer.Add(L"cube_normal.dds", StreamingTailSize, &m_pNormalMapView, &m_normalMapStream);
+    if (FAILED(hr)) {
+        m_normalMapStream = UINT32_MAX;
+        // Заглушка - плоская нормаль (0, 0, 1)
+        hr = m_textureLoader.LoadDDS(L"cube_normal.dds", 0xFFFF8080, &m_pNormalMapView);
+    }
+    if (FAILED(hr))
+        return hr;
+
+
+    D3D11_SAMPLER_DESC sampDesc = {};
+    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+    sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+    sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+    sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    sampDesc.MinLOD = 0;
+    sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
+    hr = m_stateCache.GetSamplerState(sampDesc, &m_pSamplerState);
+   
+    return hr;
+}
+
+HRESULT RenderClass::InitComputeShader()
+{
+    // Компиляция вычислительного шейдера
+    HRESULT hr = CompileComputeShader(L"ComputeShader.cs", &m_pComputeShader);
+    if (FAILED(hr))
+        return hr;
+
+    // Буфер для индиректных аргументов
+    D3D11_BUFFER_DESC descArgs = {};
+    descArgs.ByteWidth = sizeof(UINT) * 5;
+    descArgs.Usage = D3D11_USAGE_DEFAULT;
+    descArgs.BindFlags = D3D11_BIND_UNORDERED_ACCESS;
+    descArgs.MiscFlags = D3D11_RESOURCE_MISC_DRAWINDIRECT_ARGS | D3D11_RESOURCE_MISC_BUFFER_ALLOW_RAW_VIEWS;
+
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavArgs = {};
+    uavArgs.Format = DXGI_FORMAT_R32_TYPELESS;
+    uavArgs.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavArgs.Buffer.FirstElement = 0;
+    uavArgs.Buffer.NumElements = descArgs.ByteWidth / sizeof(UINT);
+    uavArgs.Buffer.Flags = D3D11_BUFFER_UAV_FLAG_RAW;
+
+    for (UINT i = 0; i < m_cullingOutputs.GetCount(); i++)
+    {
+        CullingOutput& output = m_cullingOutputs.Get(i);
+        hr = m_pDevice->CreateBuffer(&descArgs, nullptr, &output.pArgsBuffer);
+        if (FAILED(hr))
+            return hr;
+
+        hr = m_pDevice->CreateUnorderedAccessView(output.pArgsBuffer, &uavArgs, &output.pArgsUAV);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    return S_OK;
+}
+
+void RenderClass::InitShaderHotReload() {
+    m_shaderReload.Watch(L"ColorVertex.vs", &m_pVertexShader);
+    m_shaderReload.Watch(L"ColorPixel.ps", &m_pPixelShader);
+    m_shaderReload.Watch(L"LightPixel.ps", &m_pLightPixelShader);
+    m_shaderReload.Watch(L"SkyboxVertex.vs", &m_pSkyboxVS);
+    m_shaderReload.Watch(L"SkyboxPixel.ps", &m_pSkyboxPS);
+    m_shaderReload.Watch(L"ParallelogramVertex.vs", &m_pParallelogramVS);
+    m_shaderReload.Watch(L"ParallelogramPixel.ps", &m_pParallelogramPS);
+    m_shaderReload.Watch(L"ComputeShader.cs", &m_pComputeShader);
+    m_shaderReload.Watch(L"PostFused.cs", &m_pPostFusedCS);
+    m_shaderReload.Watch(L"Fxaa.cs", &m_pFxaaCS);
+    m_shaderReload.Watch(L"BloomDownsample.cs", &m_pBloomDownsampleCS);
+    m_shaderReload.Watch(L"BloomUpsample.cs", &m_pBloomUpsampleCS);
+
+    // Без перезагрузки приложение продолжает работать как раньше
+    if (FAILED(m_shaderReload.Start(m_pDevice, L".", L"ShaderCache")))
+        OutputDebugString(L"Shader hot reload is unavailable.\n");
+}
+
+HRESULT RenderClass::CompileComputeShader(const std::wstring& path, ID3D11ComputeShader** ppComputeShader) {
+    ShaderBytecode bytecode;
+    HRESULT hr = m_shaderCache.Load(path, "main", "cs_5_0", ShaderCache::GetDefaultFlags(), nullptr, bytecode);
+    if (SUCCEEDED(hr))
+        hr = m_pDevice->CreateComputeShader(bytecode.GetData(), bytecode.GetSize(), nullptr, ppComputeShader);
+    return hr;
+}
+
+HRESULT RenderClass::CreateStructuredBuffer(UINT stride, UINT count, D3D11_USAGE usage, UINT bindFlags, const void* pInitData,
+    ID3D11Buffer** ppBuffer, ID3D11ShaderResourceView** ppSRV)
+{
+    D3D11_BUFFER_DESC desc = {};
+    desc.ByteWidth = stride * count;
+    desc.Usage = usage;
+    desc.BindFlags = bindFlags | D3D11_BIND_SHADER_RESOURCE;
+    desc.CPUAccessFlags = usage == D3D11_USAGE_DYNAMIC ? D3D11_CPU_ACCESS_WRITE : 0;
+    desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    desc.StructureByteStride = stride;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = pInitData;
+
+    HRESULT hr = m_pDevice->CreateBuffer(&desc, pInitData ? &initData : nullptr, ppBuffer);
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.FirstElement = 0;
+    srvDesc.Buffer.NumElements = count;
+
+    return m_pDevice->CreateShaderResourceView(*ppBuffer, &srvDesc, ppSRV);
+}
+
+HRESULT RenderClass::EnsureInstanceCapacity(UINT count)
+{
+    if (count <= m_instanceCapacity)
+        return S_OK;
+
+    // Ёмкость растёт вдвое, чтобы при увеличении сцены буферы пересоздавались редко
+    UINT capacity = m_instanceCapacity ? m_instanceCapacity : 64;
+    while (capacity < count)
+        capacity *= 2;
+
+    InstanceBuffers buffers = {};
+    HRESULT hr = CreateInstanceBuffers(capacity, buffers);
+    if (FAILED(hr))
+    {
+        ReleaseInstanceBuffers(buffers);
+        return hr;
+    }
+
+    // Новый набор готов целиком - только теперь он заменяет старый
+    SwapInstanceBuffers(buffers);
+    ReleaseInstanceBuffers(buffers);
+    m_instanceCapacity = capacity;
+
+    // Кольцо чтения результатов отсечения: [число видимых][идентификаторы].
+    // Без него буферы всё равно целы, просто чтению нечего отдать
+    m_readbackDevice.Init(m_pDevice, m_pDeviceContext);
+    if (!m_cullReadback.Init(&m_readbackDevice, ReadbackSlots, sizeof(UINT) * (capacity + 1)))
+        return E_FAIL;
+    return S_OK;
+}
+
+HRESULT RenderClass::CreateInstanceBuffers(UINT capacity, InstanceBuffers& buffers)
+{
+    // Хранилище экземпляров: обновляется каждый кадр, читается шейдером отсечения и вершинным шейдером
+    HRESULT hr = CreateStructuredBuffer(sizeof(SceneInstance), capacity, D3D11_USAGE_DYNAMIC, 0, nullptr, &buffers.pInstanceBuffer, &buffers.pInstanceDataSRV);
+    if (FAILED(hr))
+        return hr;
+
+    // Экземпляры, собранные на CPU (отсечение без GPU, чтение с GPU), и маркеры источников света в хвосте;
+    // переписывается целиком одним Map(WRITE_DISCARD) за кадр
+    hr = CreateStructuredBuffer(sizeof(SceneInstance), capacity + LightCount, D3D11_USAGE_DYNAMIC, 0, nullptr, &buffers.pModelBuffer, &buffers.pModelSRV);
+    if (FAILED(hr))
+        return hr;
+
+    std::vector<UINT> identityIds(capacity + LightCount);
+    for (UINT i = 0; i < capacity + LightCount; i++)
+        identityIds[i] = i;
+    hr = CreateStructuredBuffer(sizeof(UINT), capacity + LightCount, D3D11_USAGE_DEFAULT, 0, identityIds.data(), &buffers.pIdentityIdsBuffer, &buffers.pIdentityIdsSRV);
+    if (FAILED(hr))
+        return hr;
+
+    // SV_InstanceID не учитывает StartInstanceLocation, поэтому каждому источнику - вид с одним своим индексом
+    for (UINT i = 0; i < LightCount; i++)
+    {
+        D3D11_SHADER_RESOURCE_VIEW_DESC lightDesc = {};
+        lightDesc.Format = DXGI_FORMAT_UNKNOWN;
+        lightDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+        lightDesc.Buffer.FirstElement = capacity + i;
+        lightDesc.Buffer.NumElements = 1;
+
+        hr = m_pDevice->CreateShaderResourceView(buffers.pIdentityIdsBuffer, &lightDesc, &buffers.lightIdsSRV[i]);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    // Буфер идентификаторов объектов
+    D3D11_UNORDERED_ACCESS_VIEW_DESC uavIDs = {};
+    uavIDs.Format = DXGI_FORMAT_UNKNOWN;
+    uavIDs.ViewDimension = D3D11_UAV_DIMENSION_BUFFER;
+    uavIDs.Buffer.FirstElement = 0;
+    uavIDs.Buffer.NumElements = capacity;
+
+    for (UINT i = 0; i < m_cullingOutputs.GetCount(); i++)
+    {
+        hr = CreateStructuredBuffer(sizeof(UINT), capacity, D3D11_USAGE_DEFAULT, D3D11_BIND_UNORDERED_ACCESS, nullptr, &buffers.pIdsBuffer[i], &buffers.pIdsSRV[i]);
+        if (FAILED(hr))
+            return hr;
+
+        hr = m_pDevice->CreateUnorderedAccessView(buffers.pIdsBuffer[i], &uavIDs, &buffers.pIdsUAV[i]);
+        if (FAILED(hr))
+            return hr;
+    }
+    return S_OK;
+}
+
+void RenderClass::SwapInstanceBuffers(InstanceBuffers& buffers)
+{
+    std::swap(m_pInstanceBuffer, buffers.pInstanceBuffer);
+    std::swap(m_pInstanceDataSRV, buffers.pInstanceDataSRV);
+    std::swap(m_pModelBufferInst, buffers.pModelBuffer);
+    std::swap(m_pModelBufferInstSRV, buffers.pModelSRV);
+    std::swap(m_pIdentityIdsBuffer, buffers.pIdentityIdsBuffer);
+    std::swap(m_pIdentityIdsSRV, buffers.pIdentityIdsSRV);
+    for (UINT i = 0; i < LightCount; i++)
+        std::swap(m_lightIdsSRV[i], buffers.lightIdsSRV[i]);
+
+    for (UINT i = 0; i < m_cullingOutputs.GetCount(); i++)
+    {
+        CullingOutput& output = m_cullingOutputs.Get(i);
+        std::swap(output.pIdsBuffer, buffers.pIdsBuffer[i]);
+        std::swap(output.pIdsUAV, buffers.pIdsUAV[i]);
+        std::swap(output.pIdsSRV, buffers.pIdsSRV[i]);
+    }
+}
+
+void RenderClass::ReleaseInstanceBuffers(InstanceBuffers& buffers)
+{
+    // Виды освобождаются раньше своих буферов
+    if (buffers.pInstanceDataSRV) buffers.pInstanceDataSRV->Release();
+    if (buffers.pInstanceBuffer) buffers.pInstanceBuffer->Release();
+    if (buffers.pModelSRV) buffers.pModelSRV->Release();
+    if (buffers.pModelBuffer) buffers.pModelBuffer->Release();
+    for (UINT i = 0; i < LightCount; i++)
+    {
+        if (buffers.lightIdsSRV[i]) buffers.lightIdsSRV[i]->Release();
+    }
+    if (buffers.pIdentityIdsSRV) buffers.pIdentityIdsSRV->Release();
+    if (buffers.pIdentityIdsBuffer) buffers.pIdentityIdsBuffer->Release();
+    for (UINT i = 0; i < FramesInFlight; i++)
+    {
+        if (buffers.pIdsUAV[i]) buffers.pIdsUAV[i]->Release();
+        if (buffers.pIdsSRV[i]) buffers.pIdsSRV[i]->Release();
+        if (buffers.pIdsBuffer[i]) buffers.pIdsBuffer[i]->Release();
+    }
+    buffers = InstanceBuffers();
+}
+
+void RenderClass::ReleaseInstanceBuffers()
+{
+    m_cullReadback.Terminate();
+
+    InstanceBuffers buffers = {};
+    SwapInstanceBuffers(buffers);
+    ReleaseInstanceBuffers(buffers);
+    m_instanceCapacity = 0;
+}
+
+void RenderClass::ResetVisibleIds()
+{
+    // Пока первый результат чтения не пришёл, рисуем все объекты
+    m_visibleIds.resize(m_instanceCount);
+    for (UINT i = 0; i < m_instanceCount; i++)
+        m_visibleIds[i] = i;
+}
+
+void RenderClass::SetInstanceCount(UINT count)
+{
+    if (count == 0)
+        count = 1;
+    if (count > MaxInstances)
+        count = MaxInstances;
+
+    if (!m_pDevice)
+    {
+        m_instanceCount = count;
+        m_pendingInstanceCount = static_cast<int>(count);
+        return;
+    }
+
+    // Сцена и счётчик меняются только после того, как буферы вместили новое число кубов;
+    // иначе остаётся прежняя сцена, а поле Instances возвращается к её размеру
+    if (FAILED(EnsureInstanceCapacity(count)))
+    {
+        OutputDebugString(L"Не удалось увеличить буферы экземпляров, остаётся прежнее число кубов.\n");
+        m_pendingInstanceCount = static_cast<int>(m_instanceCount);
+        return;
+    }
+
+    m_instanceCount = count;
+    m_pendingInstanceCount = static_cast<int>(count);
+    m_scene.Generate(count, static_cast<uint32_t>(m_materialFiles.size()));
+
+    // Результаты чтения от старой сцены больше не годятся
+    m_cullReadback.Init(&m_readbackDevice, ReadbackSlots, sizeof(UINT) * (m_instanceCapacity + 1));
+    ResetVisibleIds();
+}
+
+void RenderClass::TerminateComputeShader()
+{
+    if (m_pComputeShader)
+    {
+        m_pComputeShader->Release();
+        m_pComputeShader = nullptr;
+    }
+
+
+    for (UINT i = 0; i < m_cullingOutputs.GetCount(); i++)
+    {
+        CullingOutput& output = m_cullingOutputs.Get(i);
+        if (output.pArgsBuffer)
+        {
+            output.pArgsBuffer->Release();
+            output.pArgsBuffer = nullptr;
+        }
+
+        if (output.pArgsUAV)
+        {
+            output.pArgsUAV->Release();
+            output.pArgsUAV = nullptr;
+        }
+    }
+}
+
+HRESULT RenderClass::Init2DArray()
+{
+    // Пока картинки декодируются, кубы рисуются серыми
+    return m_textureLoader.LoadArray(m_materialFiles, MaterialTextureSize, MaterialTextureSize, true, 0xFF808080, &m_pTextureView);
+}
+
+HRESULT RenderClass::InitPostProcess()
+{
+    HRESULT hr = CompileComputeShader(L"PostFused.cs", &m_pPostFusedCS);
+    if (SUCCEEDED(hr))
+        hr = CompileComputeShader(L"Fxaa.cs", &m_pFxaaCS);
+    if (SUCCEEDED(hr))
+        hr = CompileComputeShader(L"BloomDownsample.cs", &m_pBloomDownsampleCS);
+    if (SUCCEEDED(hr))
+        hr = CompileComputeShader(L"BloomUpsample.cs", &m_pBloomUpsampleCS);
+    if (FAILED(hr))
+        return hr;
+
+    // LUT цветокоррекции считается при запуске, а не грузится из файла
+    std::vector<uint8_t> lut;
+    PostProcessChain::BuildGradingLut(GradingLutSize, lut);
+
+    D3D11_TEXTURE3D_DESC lutDesc = {};
+    lutDesc.Width = GradingLutSize;
+    lutDesc.Height = GradingLutSize;
+    lutDesc.Depth = GradingLutSize;
+    lutDesc.MipLevels = 1;
+    lutDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    lutDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    lutDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    D3D11_SUBRESOURCE_DATA lutData = {};
+    lutData.pSysMem = lut.data();
+    lutData.SysMemPitch = GradingLutSize * 4;
+    lutData.SysMemSlicePitch = GradingLutSize * GradingLutSize * 4;
+
+    ID3D11Texture3D* pLut = nullptr;
+    hr = m_pDevice->CreateTexture3D(&lutDesc, &lutData, &pLut);
+    if (FAILED(hr))
+        return hr;
+    hr = m_pDevice->CreateShaderResourceView(pLut, nullptr, &m_pGradingLutSRV);
+    pLut->Release();
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_SAMPLER_DESC sampDesc = {};
+    sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+    sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
+    sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+    sampDesc.MinLOD = 0;
+    sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
+    return m_stateCache.GetSamplerState(sampDesc, &m_pLinearClampSampler);
+}
+
+void RenderClass::TerminatePostProcess()
+{
+    if (m_pPostFusedCS) {
+        m_pPostFusedCS->Release();
+        m_pPostFusedCS = nullptr;
+    }
+    if (m_pFxaaCS) {
+        m_pFxaaCS->Release();
+        m_pFxaaCS = nullptr;
+    }
+    if (m_pBloomDownsampleCS) {
+        m_pBloomDownsampleCS->Release();
+        m_pBloomDownsampleCS = nullptr;
+    }
+    if (m_pBloomUpsampleCS) {
+        m_pBloomUpsampleCS->Release();
+        m_pBloomUpsampleCS = nullptr;
+    }
+    if (m_pGradingLutSRV) {
+        m_pGradingLutSRV->Release();
+        m_pGradingLutSRV = nullptr;
+    }
+    // Сэмплер принадлежит кэшу состояний
+    m_pLinearClampSampler = nullptr;
+}
+
+HRESULT RenderClass::InitSkybox() {
+    ID3DBlob* pVertexCode = nullptr;
+    HRESULT hr = CompileShader(L"SkyboxVertex.vs", &m_pSkyboxVS, nullptr, &pVertexCode);
+    if (SUCCEEDED(hr)) {
+        hr = CompileShader(L"SkyboxPixel.ps", nullptr, &m_pSkyboxPS);
+    }
+
+    D3D11_INPUT_ELEMENT_DESC skyboxLayout[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    };
+
+    if (SUCCEEDED(hr)) {
+        hr = m_pDevice->CreateInputLayout(skyboxLayout, 1, pVertexCode->GetBufferPointer(), pVertexCode->GetBufferSize(), &m_pSkyboxLayout);
+    }
+
+    SkyboxVertex SkyboxVertices[] = {
+        { -1.0f, -1.0f, -1.0f },
+        { -1.0f,  1.0f, -1.0f },
+        {  1.0f,  1.0f, -1.0f },
+        { -1.0f, -1.0f, -1.0f },
+        {  1.0f,  1.0f, -1.0f },
+        {  1.0f, -1.0f, -1.0f },
+        {  1.0f, -1.0f,  1.0f },
+        {  1.0f,  1.0f,  1.0f },
+        { -1.0f,  1.0f,  1.0f },
+        {  1.0f, -1.0f,  1.0f },
+        { -1.0f,  1.0f,  1.0f },
+        { -1.0f, -1.0f,  1.0f },
+        { -1.0f, -1.0f,  1.0f },
+        { -1.0f,  1.0f,  1.0f },
+        { -1.0f,  1.0f, -1.0f },
+        { -1.0f, -1.0f,  1.0f },
+        { -1.0f,  1.0f, -1.0f },
+        { -1.0f, -1.0f, -1.0f },
+        { 1.0f, -1.0f, -1.0f },
+        { 1.0f,  1.0f, -1.0f },
+        { 1.0f,  1.0f,  1.0f },
+        { 1.0f, -1.0f, -1.0f },
+        { 1.0f,  1.0f,  1.0f },
+        { 1.0f, -1.0f,  1.0f },
+        { -1.0f, 1.0f, -1.0f },
+        { -1.0f, 1.0f,  1.0f },
+        { 1.0f, 1.0f,  1.0f },
+        { -1.0f, 1.0f, -1.0f },
+        { 1.0f, 1.0f,  1.0f },
+        { 1.0f, 1.0f, -1.0f },
+        { -1.0f, -1.0f,  1.0f },
+        { -1.0f, -1.0f, -1.0f },
+        { 1.0f, -1.0f, -1.0f },
+        { -1.0f, -1.0f,  1.0f },
+        { 1.0f, -1.0f, -1.0f },
+        { 1.0f, -1.0f,  1.0f },
+    };
+
+    D3D11_BUFFER_DESC bd = {};
+    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.ByteWidth = sizeof(SkyboxVertex) * ARRAYSIZE(SkyboxVertices);
+    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = SkyboxVertices;
+    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pSkyboxVB);
+    if (FAILED(hr))
+        return hr;
+
+    hr = m_textureLoader.LoadCubeCross(L"skybox.png", 0xFFC0A080, &m_pSkyboxSRV);
+    if (FAILED(hr))
+        return hr;
+
+    return S_OK;
+}
+
+void RenderClass::Terminate() {
+    m_shaderReload.Terminate();
+    m_jobs.Terminate();
+    m_textureLoader.Terminate();
+    m_textureStreamer.Terminate();
+    TerminateBufferShader();
+    TerminateSkybox();
+    TerminateParallelogram();
+    TerminateComputeShader();
+    // Копии вывода отсечения освобождают TerminateBufferShader и TerminateComputeShader
+    m_cullingOutputs.Terminate();
+    m_frameFences.Terminate();
+    TerminatePostProcess();
+    m_stateCache.Terminate();
+    m_uploadRing.Terminate();
+    m_profiler.Terminate();
+    m_gpuTimer.Terminate();
+
+    TerminateDeferredRecording();
+    m_graphResources.Terminate();
+    m_frameGraph.Reset();
+    m_stateTracker.Terminate();
+    if (m_pDeviceContext1) {
+        m_pDeviceContext1->Release();
+        m_pDeviceContext1 = nullptr;
+    }
+    if (m_pDeviceContext) {
+        m_pDeviceContext->ClearState();
+        m_pDeviceContext->Release();
+        m_pDeviceContext = nullptr;
+    }
+
+    if (m_pBackBufferUAV) {
+        m_pBackBufferUAV->Release();
+        m_pBackBufferUAV = nullptr;
+    }
+    if (m_pRenderTargetView) {
+        m_pRenderTargetView->Release();
+        m_pRenderTargetView = nullptr;
+    }
+
+    m_swapChain.Terminate();
+
+    if (m_pDevice) {
+        m_pDevice->Release();
+        m_pDevice = nullptr;
+    }
+    
+    CoUninitialize();
+    ImGui_ImplDX11_Shutdown();
+    ImGui_ImplWin32_Shutdown();
+    ImGui::DestroyContext();
+}
+
+void RenderClass::TerminateBufferShader() {
+    if (m_pLayout)
+        m_pLayout->Release();
+
+    if (m_pPixelShader)
+        m_pPixelShader->Release();
+
+    if (m_pVertexShader)
+        m_pVertexShader->Release();
+
+    if (m_pIndexBuffer)
+        m_pIndexBuffer->Release();
+
+    if (m_pVertexBuffer)
+        m_pVertexBuffer->Release();
+
+    if (m_pTextureView)
+        m_pTextureView->Release();
+
+    // Сэмплер принадлежит кэшу состояний
+    m_pSamplerState = nullptr;
+
+    if (m_pLightPixelShader)
+        m_pLightPixelShader->Release();
+
+    if (m_pNormalMapView)
+        m_pNormalMapView->Release();
+
+    ReleaseInstanceBuffers();
+    m_readbackDevice.Terminate();
+    m_visibleIds.clear();
+
+    m_scene.Clear();
+}
+
+void RenderClass::TerminateSkybox() {
+    if (m_pSkyboxVB) {
+        m_pSkyboxVB->Release();
+    }
+
+    if (m_pSkyboxSRV) {
+        m_pSkyboxSRV->Release();
+    }
+
+    if (m_pSkyboxLayout) {
+        m_pSkyboxLayout->Release();
+    }
+
+    if (m_pSkyboxVS) {
+        m_pSkyboxVS->Release();
+    }
+
+    if (m_pSkyboxPS) {
+        m_pSkyboxPS->Release();
+    }
+}
+
+
+
+HRESULT RenderClass::CompileShader(const std::wstring& path, ID3D11VertexShader** ppVertexShader, ID3D11PixelShader** ppPixelShader, ID3DBlob** pCodeShader) {
+    std::wstring extension = Extension(path);
+    const char* platform = ShaderCache::GetTargetForPath(path);
+    if (!platform)
+        return E_INVALIDARG;
+
+    // Байт-код берётся из дискового кэша; компиляция - только при промахе
+    ShaderBytecode bytecode;
+    HRESULT hr = m_shaderCache.Load(path, "main", platform, ShaderCache::GetDefaultFlags(), nullptr, bytecode);
+    if (FAILED(hr))
+        return hr;
+
+    if (extension == L"vs" && ppVertexShader) {
+        hr = m_pDevice->CreateVertexShader(bytecode.GetData(), bytecode.GetSize(), nullptr, ppVertexShader);
+    }
+    else if (extension == L"ps" && ppPixelShader) {
+        hr = m_pDevice->CreatePixelShader(bytecode.GetData(), bytecode.GetSize(), nullptr, ppPixelShader);
+    }
+
+    if (SUCCEEDED(hr) && pCodeShader) {
+        hr = bytecode.CopyToBlob(pCodeShader);
+    }
+    return hr;
+}
+
+void RenderClass::MoveCamera(float dx, float dy, float dz) {
+    m_camera.Move(dx * m_CameraSpeed, dy * m_CameraSpeed, dz * m_CameraSpeed);
+}
+
+void RenderClass::RotateCamera(float lrAngle, float udAngle) {
+    m_camera.Rotate(lrAngle, -udAngle);
+}
+
+void RenderClass::Render() {
+    // Ждём, пока цепочка обмена примет кадр, - до чтения ввода и любой работы CPU
+    m_framePacer.BeginFrame();
+    if (m_pendingBufferCount != static_cast<int>(m_swapChain.GetBufferCount()))
+    {
+        m_swapChain.SetBufferCount(static_cast<UINT>(m_pendingBufferCount));
+        ResizeBackBuffer(m_camera.GetWidth(), m_camera.GetHeight());
+    }
+
+    m_frameIndex++;
+    m_cullingOutputs.Acquire(m_frameIndex);
+    m_lastFrameCopyBytes = m_frameCopyBytes;
+    m_frameCopyBytes = 0;
+    m_lastFrameWin32Lookups = m_win32Lookups - m_frameStartWin32Lookups;
+    m_frameStartWin32Lookups = m_win32Lookups;
+    m_profiler.BeginFrame();
+    m_stateCache.BeginFrame();
+    m_stateTracker.BeginFrame();
+    m_uploadRing.BeginFrame();
+    // Граница кадра: подставляем перекомпилированные шейдеры, если фоновый поток их уже создал
+    if (m_shaderReload.Apply() > 0)
+        m_stateTracker.Invalidate();
+    // Готовые текстуры подменяют заглушки; новый вид может занять адрес освобождённого
+    if (m_textureLoader.Update(MaxTextureCreatesPerFrame) > 0)
+        m_stateTracker.Invalidate();
+    UpdateStreaming();
+    UpdateCullingStats();
+    UpdateAnimation();
+
+    ID3D11ShaderResourceView* nullSRVs[1] = { nullptr };
+    m_stateTracker.PSSetShaderResources(0, 1, nullSRVs);
+    m_stateTracker.VSSetShaderResources(0, 1, nullSRVs);
+
+    // Граф пересобирается, только если цепочка эффектов изменилась
+    if (m_postChain.GetRevision() != m_frameGraphRevision)
+        BuildFrameGraph();
+
+    m_passData.viewport.Width = static_cast<FLOAT>(m_camera.GetWidth());
+    m_passData.viewport.Height = static_cast<FLOAT>(m_camera.GetHeight());
+    m_passData.viewport.MinDepth = 0.0f;
+    m_passData.viewport.MaxDepth = 1.0f;
+
+    {
+        ProfileScope scope(m_profiler, "Prepare");
+        PrepareSkybox();
+        PrepareCubes();
+        PrepareParallelogram();
+        PreparePostProcess();
+    }
+
+    {
+        ProfileScope scope(m_profiler, "Record", false);
+        RecordPasses(m_useDeferredRecording && m_deferredSupported);
+    }
+
+    {
+        ProfileScope scope(m_profiler, "ImGui");
+        RenderImGui();
+    }
+    // ImGui привязывает своё состояние напрямую через контекст
+    m_stateTracker.Invalidate();
+
+    // Ожидание вертикальной синхронизации видно только на CPU
+    {
+        ProfileScope scope(m_profiler, "Present", false);
+        m_swapChain.Present(m_framePacer.GetSyncInterval(), m_framePacer.AllowTearing());
+    }
+    m_stateTracker.OMSetRenderTargets(0, nullptr, nullptr);
+    m_stateTracker.PSSetShaderResources(0, 1, nullSRVs);
+    m_cullingOutputs.Signal();
+    m_profiler.EndFrame();
+    UpdateLoadTimes();
+}
+
+void RenderClass::UpdateLoadTimes() {
+    if (m_firstFrameMs > 0.0f && m_assetsReadyMs > 0.0f)
+        return;
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    float sinceInit = 1000.0f * (now.QuadPart - m_initStartTime.QuadPart) / m_timerFrequency.QuadPart;
+    if (m_firstFrameMs == 0.0f)
+        m_firstFrameMs = sinceInit;
+    if (m_assetsReadyMs == 0.0f && m_textureLoader.GetPending() == 0)
+        m_assetsReadyMs = sinceInit;
+}
+
+void RenderClass::UpdateStreaming() {
+    if (m_normalMapStream != UINT32_MAX && m_streamingFrame++ % StreamingInterval == 0) {
+        // Все кубы делят одну карту нормалей, поэтому нужный мип задаёт ближайший видимый
+        FrustumCuller& culler = m_scene.GetCuller();
+        culler.SetPlanes(reinterpret_cast<const float(*)[4]>(m_camera.GetFrustumPlanes()));
+        const XMFLOAT3& eye = m_camera.GetPosition();
+        const size_t chunkSize = JobSystem::AlignChunk(SceneFrame::InstanceChunkSize, sizeof(float));
+        m_chunkNearest.resize(JobSystem::GetChunkCount(culler.GetCount(), chunkSize));
+        m_jobs.ParallelFor(culler.GetCount(), chunkSize, [&](size_t begin, size_t end, size_t chunk)
+        {
+            m_chunkNearest[chunk] = culler.GetNearestDistance(eye.x, eye.y, eye.z, begin, end);
+        });
+        float nearest = FLT_MAX;
+        for (float distance : m_chunkNearest)
+            nearest = distance < nearest ? distance : nearest;
+
+        // Грань куба в пикселях экрана; если никого не видно, хватает хвоста
+        float screenPixels = 0.0f;
+        if (nearest < FLT_MAX) {
+            float focal = m_camera.GetHeight() / (2.0f * tanf(0.5f * m_camera.GetFovY()));
+            screenPixels = 2.0f * m_scene.GetScale() * focal / (nearest > 0.01f ? nearest : 0.01f);
+        }
+        m_textureStreamer.SetScreenSize(m_normalMapStream, screenPixels);
+    }
+
+    // Пересозданная текстура - новый вид
+    m_textureStreamer.SetBudget(static_cast<uint64_t>(m_streamingBudgetKb) * 1024);
+    if (m_textureStreamer.Update(m_pDeviceContext, MaxStreamingFetches) > 0)
+        m_stateTracker.Invalidate();
+}
+
+void RenderClass::UpdateAnimation() {
+    // Сцена движется фиксированными шагами по реальному времени, кадр рисует
+    // промежуточное состояние между двумя последними шагами
+    m_frameSteps = m_timestep.Advance(m_clock.Tick());
+    for (uint32_t i = 0; i < m_frameSteps; ++i)
+    {
+        m_prevAnimation = m_animation;
+        m_animation.Step();
+    }
+    m_frameAnimation = AnimationState::Interpolate(m_prevAnimation, m_animation, m_timestep.GetAlpha());
+}
+
+void RenderClass::UpdateCullingStats() {
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    if (m_timerFrequency.QuadPart == 0)
+        QueryPerformanceFrequency(&m_timerFrequency);
+
+    if (m_lastFrameTime.QuadPart != 0)
+    {
+        float frameMs = 1000.0f * (now.QuadPart - m_lastFrameTime.QuadPart) / m_timerFrequency.QuadPart;
+        float& average = m_cullingStats[m_frameCullingMode].frameMs;
+        average = average == 0.0f ? frameMs : average * 0.95f + frameMs * 0.05f;
+    }
+    m_lastFrameTime = now;
+
+    // В режиме сравнения пути переключаются по кругу каждые 120 кадров
+    if (m_compareCulling && ++m_compareFrames >= 120)
+    {
+        m_compareFrames = 0;
+        m_cullingMode = (m_cullingMode + 1) % CullingModeCount;
+    }
+}
+
+void RenderClass::BindVSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation) {
+    if (allocation.numConstants)
+        tracker.VSSetConstantBuffers1(slot, 1, &allocation.pBuffer, &allocation.firstConstant, &allocation.numConstants);
+    else
+        tracker.VSSetConstantBuffers(slot, 1, &allocation.pBuffer);
+}
+
+void RenderClass::BindPSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation) {
+    if (allocation.numConstants)
+        tracker.PSSetConstantBuffers1(slot, 1, &allocation.pBuffer, &allocation.firstConstant, &allocation.numConstants);
+    else
+        tracker.PSSetConstantBuffers(slot, 1, &allocation.pBuffer);
+}
+
+void RenderClass::BindCSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation) {
+    if (allocation.numConstants)
+        tracker.CSSetConstantBuffers1(slot, 1, &allocation.pBuffer, &allocation.firstConstant, &allocation.numConstants);
+    else
+        tracker.CSSetConstantBuffers(slot, 1, &allocation.pBuffer);
+}
+
+bool RenderClass::UploadCSConstants(UINT slot, const void* pData, UINT size) {
+    UploadAllocation allocation = {};
+    if (!m_uploadRing.Upload(pData, size, &allocation))
+        return false;
+    BindCSConstants(m_stateTracker, slot, allocation);
+    return true;
+}
+
+HRESULT RenderClass::ConfigureBackBuffer(UINT width, UINT height) {
+    if (m_pRenderTargetView) m_pRenderTargetView->Release();
+    m_pRenderTargetView = nullptr;
+    if (m_pBackBufferUAV) m_pBackBufferUAV->Release();
+    m_pBackBufferUAV = nullptr;
+
+    ID3D11Texture2D* pBackBuffer = nullptr;
+    HRESULT hr = m_swapChain.GetBackBuffer(&pBackBuffer);
+    if (FAILED(hr))
+        return hr;
+
+    hr = m_pDevice->CreateRenderTargetView(pBackBuffer, nullptr, &m_pRenderTargetView);
+    // Без UAV на буфере обмена последний проход постобработки копирует результат
+    if (SUCCEEDED(hr) && FAILED(m_pDevice->CreateUnorderedAccessView(pBackBuffer, nullptr, &m_pBackBufferUAV)))
+        m_pBackBufferUAV = nullptr;
+    pBackBuffer->Release();
+    if (FAILED(hr))
+        return hr;
+
+    // Промежуточный цвет и глубину создаёт граф кадра под новый размер
+    hr = BuildFrameGraph();
+    if (FAILED(hr))
+        return hr;
+
+    D3D11_VIEWPORT vp;
+    vp.Width = (FLOAT)width;
+    vp.Height = (FLOAT)height;
+    vp.MinDepth = 0.0f;
+    vp.MaxDepth = 1.0f;
+    vp.TopLeftX = 0;
+    vp.TopLeftY = 0;
+    m_stateTracker.RSSetViewports(1, &vp);
+
+    return hr;
+}
+
+void RenderClass::Resize(HWND hWnd) {
+    if (!m_swapChain.IsCreated())
+        return;
+
+    RECT rc;
+    GetClientRect(hWnd, &rc);
+    ++m_win32Lookups;
+    UINT width = rc.right - rc.left;
+    UINT height = rc.bottom - rc.top;
+    // Свёрнутое окно: буферы нулевого размера не создаём
+    if (width == 0 || height == 0)
+        return;
+    m_camera.SetViewport(width, height);
+    ResizeBackBuffer(width, height);
+}
+
+void RenderClass::ResizeBackBuffer(UINT width, UINT height) {
+    if (m_pRenderTargetView) {
+        m_pRenderTargetView->Release();
+        m_pRenderTargetView = nullptr;
+    }
+    if (m_pBackBufferUAV) {
+        m_pBackBufferUAV->Release();
+        m_pBackBufferUAV = nullptr;
+    }
+
+    // Flip-модель не даёт изменить буферы, пока они привязаны к конвейеру
+    m_stateTracker.OMSetRenderTargets(0, nullptr, nullptr);
+    m_pDeviceContext->Flush();
+
+    HRESULT hr = m_swapChain.Resize(width, height);
+    if (FAILED(hr)) {
+        MessageBox(nullptr, L"ResizeBuffers failed.", L"Error", MB_OK);
+        return;
+    }
+
+    HRESULT resultBack = ConfigureBackBuffer(width, height);
+    if (FAILED(resultBack)) {
+        MessageBox(nullptr, L"Configure back buffer failed.", L"Error", MB_OK);
+        return;
+    }
+
+    m_stateTracker.OMSetRenderTargets(1, &m_pRenderTargetView, nullptr);
+
+    D3D11_VIEWPORT vp;
+    vp.Width = (FLOAT)width;
+    vp.Height = (FLOAT)height;
+    vp.MinDepth = 0.0f;
+    vp.MaxDepth = 1.0f;
+    vp.TopLeftX = 0;
+    vp.TopLeftY = 0;
+    m_stateTracker.RSSetViewports(1, &vp);
+}
+HRESULT RenderClass::InitParallelogram() {
+    ID3DBlob* pVertBlob = nullptr;
+    HRESULT hr = CompileShader(L"ParallelogramVertex.vs", &m_pParallelogramVS, nullptr, &pVertBlob);
+    if (SUCCEEDED(hr))
+        hr = CompileShader(L"ParallelogramPixel.ps", nullptr, &m_pParallelogramPS);
+    D3D11_INPUT_ELEMENT_DESC layout[] = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+    };
+    if (SUCCEEDED(hr))
+        hr = m_pDevice->CreateInputLayout(layout, 1, pVertBlob->GetBufferPointer(), pVertBlob->GetBufferSize(), &m_pParallelogramLayout);
+    ParallelogramVertex verts[] = {
+        {-0.5f, -1.0f, 0.0f},
+        {-0.2f,  1.0f, 0.0f},
+        { 1.0f,  0.8f, 0.0f},
+        { 0.8f, -0.8f, 0.0f}
+    };
+    WORD indices[] = { 0, 1, 2, 0, 2, 3 };
+    D3D11_BUFFER_DESC bd = {};
+    bd.Usage = D3D11_USAGE_DEFAULT;
+    bd.ByteWidth = sizeof(verts);
+    bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    D3D11_SUBRESOURCE_DATA initData = {};
+    initData.pSysMem = verts;
+    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pParallelogramVB);
+    if (FAILED(hr))
+        return hr;
+    bd.ByteWidth = sizeof(indices);
+    bd.BindFlags = D3D11_BIND_INDEX_BUFFER;
+    initData.pSysMem = indices;
+    hr = m_pDevice->CreateBuffer(&bd, &initData, &m_pParallelogramIB);
+    if (FAILED(hr))
+        return hr;
+    D3D11_BLEND_DESC bsDesc = {};
+    bsDesc.RenderTarget[0].BlendEnable = true;
+    bsDesc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
+    bsDesc.RenderTarget[0].DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+    bsDesc.RenderTarget[0].BlendOp = D3D11_BLEND_OP_ADD;
+    bsDesc.RenderTarget[0].SrcBlendAlpha = D3D11_BLEND_ONE;
+    bsDesc.RenderTarget[0].DestBlendAlpha = D3D11_BLEND_ZERO;
+    bsDesc.RenderTarget[0].BlendOpAlpha = D3D11_BLEND_OP_ADD;
+    bsDesc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+    hr = m_stateCache.GetBlendState(bsDesc, &m_pBlendState);
+    if (FAILED(hr))
+        return hr;
+    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+    dsDesc.DepthFunc = D3D11_COMPARISON_LESS;
+    hr = m_stateCache.GetDepthStencilState(dsDesc, &m_pDepthStateParallelogram);
+    if (FAILED(hr))
+        return hr;
+    return hr;
+}
+
+void RenderClass::TerminateParallelogram() {
+    if (m_pParallelogramVB) m_pParallelogramVB->Release();
+    if (m_pParallelogramIB) m_pParallelogramIB->Release();
+    if (m_pParallelogramPS) m_pParallelogramPS->Release();
+    if (m_pParallelogramVS) m_pParallelogramVS->Release();
+    if (m_pParallelogramLayout) m_pParallelogramLayout->Release();
+    m_pBlendState = nullptr;
+    m_pDepthStateParallelogram = nullptr;
+}
+
+void RenderClass::PrepareParallelogram() {
+    D3D11_RASTERIZER_DESC rsDesc = {};
+    rsDesc.FillMode = D3D11_FILL_SOLID;
+    rsDesc.CullMode = D3D11_CULL_NONE;
+    rsDesc.FrontCounterClockwise = false;
+
+    m_passData.pNoCullRasterizerState = nullptr;
+    m_stateCache.GetRasterizerState(rsDesc, &m_passData.pNoCullRasterizerState);
+
+    // Дальний рисуется первым; каждому вызову - свой участок кольца, без переименований буфера
+    const XMFLOAT3& eye = m_camera.GetPosition();
+    SceneParallelogram parallelograms[SceneFrame::ParallelogramCount];
+    SceneFrame::BuildParallelograms(m_frameAnimation.parallelogramTime, &eye.x, parallelograms);
+    for (UINT i = 0; i < SceneFrame::ParallelogramCount; i++) {
+        m_uploadRing.Upload(parallelograms[i].model, sizeof(parallelograms[i].model), &m_passData.parallelogramModels[i]);
+        m_uploadRing.Upload(parallelograms[i].color, sizeof(parallelograms[i].color), &m_passData.parallelogramColors[i]);
+    }
+}
+
+void RenderClass::RecordParallelogram(StateTracker& tracker, ID3D11DeviceContext* pContext) {
+    if (!m_cameraConstants.pBuffer)
+        return;
+
+    tracker.OMSetRenderTargets(1, &m_passData.pSceneRTV, m_passData.pDepthView);
+    tracker.RSSetViewports(1, &m_passData.viewport);
+    tracker.RSSetState(m_passData.pNoCullRasterizerState);
+    tracker.OMSetDepthStencilState(m_pDepthStateParallelogram, 0);
+    tracker.OMSetBlendState(m_pBlendState, nullptr, 0xffffffff);
+
+    UINT stride = sizeof(ParallelogramVertex), offset = 0;
+
+    tracker.IASetVertexBuffers(0, 1, &m_pParallelogramVB, &stride, &offset);
+    tracker.IASetIndexBuffer(m_pParallelogramIB, DXGI_FORMAT_R16_UINT, 0);
+    tracker.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    tracker.IASetInputLayout(m_pParallelogramLayout);
+    tracker.VSSetShader(m_pParallelogramVS);
+    BindVSConstants(tracker, 1, m_cameraConstants);
+    tracker.PSSetShader(m_pParallelogramPS);
+
+    // Константы, не попавшие в кольцо, пропускают свой вызов
+    for (UINT i = 0; i < SceneFrame::ParallelogramCount; i++) {
+        if (!m_passData.parallelogramModels[i].pBuffer || !m_passData.parallelogramColors[i].pBuffer)
+            continue;
+        BindVSConstants(tracker, 0, m_passData.parallelogramModels[i]);
+        BindPSConstants(tracker, 0, m_passData.parallelogramColors[i]);
+        pContext->DrawIndexed(6, 0, 0);
+    }
+}
+
+void RenderClass::PrepareSkybox() {
+    XMMATRIX vpMat = XMMatrixTranspose(m_camera.GetSkyboxViewProj());
+    m_uploadRing.Upload(&vpMat, sizeof(XMMATRIX), &m_passData.skyboxConstants);
+
+    D3D11_DEPTH_STENCIL_DESC dsDesc = {};
+    dsDesc.DepthEnable = true;
+    dsDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+    dsDesc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
+
+    m_passData.pSkyboxDepthState = nullptr;
+    m_stateCache.GetDepthStencilState(dsDesc, &m_passData.pSkyboxDepthState);
+
+    D3D11_RASTERIZER_DESC rsDesc = {};
+    rsDesc.FillMode = D3D11_FILL_SOLID;
+    rsDesc.CullMode = D3D11_CULL_FRONT;
+    rsDesc.FrontCounterClockwise = false;
+
+    m_passData.pSkyboxRasterizerState = nullptr;
+    m_stateCache.GetRasterizerState(rsDesc, &m_passData.pSkyboxRasterizerState);
+}
+
+void RenderClass::RecordSkybox(StateTracker& tracker, ID3D11DeviceContext* pContext) {
+    // Небо - первый писатель цвета и глубины сцены в графе, очистка идёт вместе с ним
+    float clearColor[4] = { 0.48f, 0.57f, 0.48f, 1.0f };
+    pContext->ClearRenderTargetView(m_passData.pSceneRTV, clearColor);
+    pContext->ClearDepthStencilView(m_passData.pDepthView, D3D11_CLEAR_DEPTH, 1.0f, 0);
+    if (!m_passData.skyboxConstants.pBuffer)
+        return;
+
+    tracker.OMSetRenderTargets(1, &m_passData.pSceneRTV, m_passData.pDepthView);
+    tracker.RSSetViewports(1, &m_passData.viewport);
+    tracker.OMSetDepthStencilState(m_passData.pSkyboxDepthState, 0);
+    tracker.OMSetBlendState(nullptr, nullptr, 0xffffffff);
+    if (m_passData.pSkyboxRasterizerState)
+        tracker.RSSetState(m_passData.pSkyboxRasterizerState);
+
+    UINT stride = sizeof(SkyboxVertex), offset = 0;
+
+    tracker.IASetVertexBuffers(0, 1, &m_pSkyboxVB, &stride, &offset);
+    tracker.IASetInputLayout(m_pSkyboxLayout);
+    tracker.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    tracker.VSSetShader(m_pSkyboxVS);
+    BindVSConstants(tracker, 0, m_passData.skyboxConstants);
+    tracker.PSSetShader(m_pSkyboxPS);
+    tracker.PSSetShaderResources(0, 1, &m_pSkyboxSRV);
+    tracker.PSSetSamplers(0, 1, &m_pSamplerState);
+    pContext->Draw(36, 0);
+
+    if (m_passData.pSkyboxRasterizerState)
+        tracker.RSSetState(nullptr);
+}
+
+void RenderClass::PrepareCubes()
+{
+    CameraBuffer cameraBuffer;
+    cameraBuffer.vp = XMMatrixTranspose(m_camera.GetViewProj());
+    cameraBuffer.cameraPos = m_camera.GetPosition();
+    m_uploadRing.Upload(&cameraBuffer, sizeof(CameraBuffer), &m_cameraConstants);
+
+    ScenePointLight lights[LightCount];
+    SceneFrame::BuildLights(m_frameAnimation.lightOrbit, lights);
+
+    // Свет этого кадра - до отрисовки кубов, в том числе косвенной
+    m_uploadRing.Upload(lights, sizeof(ScenePointLight) * LightCount, &m_passData.lightConstants);
+    for (UINT i = 0; i < LightCount; i++)
+    {
+        XMFLOAT4 lightColor = XMFLOAT4(lights[i].color[0], lights[i].color[1], lights[i].color[2], 1.0f);
+        m_uploadRing.Upload(&lightColor, sizeof(XMFLOAT4), &m_passData.lightColorConstants[i]);
+    }
+
+    const XMFLOAT4* frustumPlanes = m_camera.GetFrustumPlanes();
+
+    LARGE_INTEGER cullStart;
+    QueryPerformanceCounter(&cullStart);
+    m_frameCullingMode = m_pComputeShader ? m_cullingMode : CullingCpu;
+
+    // Матрицы пишутся сразу в отображённый динамический буфер, уже транспонированными
+    D3D11_MAPPED_SUBRESOURCE mappedInstances;
+    SceneInstance* pGpuInstances = nullptr;
+    if (m_frameCullingMode != CullingCpu &&
+        SUCCEEDED(m_pDeviceContext->Map(m_pInstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedInstances)))
+        pGpuInstances = static_cast<SceneInstance*>(mappedInstances.pData);
+
+    bool cullOnCpu = m_frameCullingMode == CullingCpu;
+    if (cullOnCpu)
+        m_scene.GetCuller().SetPlanes(reinterpret_cast<const float(*)[4]>(frustumPlanes));
+
+    // Пересборка матриц и отсечение на CPU - кусками по всем ядрам, см. SceneFrame::Update
+    m_scene.Update(m_jobs, m_frameAnimation.cubeAngle, pGpuInstances, cullOnCpu, m_visibleIds);
+    if (pGpuInstances)
+    {
+        m_pDeviceContext->Unmap(m_pInstanceBuffer, 0);
+        m_uploadRing.GetAllocator().RecordExternalUpload(sizeof(SceneInstance) * m_scene.GetCount(), true);
+    }
+
+    if (!cullOnCpu)
+    {
+        const CullingOutput& output = m_cullingOutputs.GetCurrent();
+        CullingBuffer culling = {};
+        memcpy(culling.planes, frustumPlanes, sizeof(XMFLOAT4) * 6);
+        culling.instanceCount = m_instanceCount;
+
+        UINT initialArgs[5] = { 36, 0, 0, 0, 0 };
+        m_pDeviceContext->UpdateSubresource(output.pArgsBuffer, 0, nullptr, initialArgs, 0, 0);
+        m_uploadRing.GetAllocator().RecordExternalUpload(sizeof(initialArgs), false);
+
+        // Без констант отсечения проход пропускается: в аргументах остаётся ноль экземпляров
+        m_stateTracker.CSSetShader(m_pComputeShader);
+        if (UploadCSConstants(0, &culling, sizeof(CullingBuffer)))
+        {
+            m_stateTracker.CSSetUnorderedAccessViews(0, 1, &output.pArgsUAV, nullptr);
+            m_stateTracker.CSSetUnorderedAccessViews(1, 1, &output.pIdsUAV, nullptr);
+            m_stateTracker.CSSetShaderResources(0, 1, &m_pInstanceDataSRV);
+
+            m_pDeviceContext->Dispatch((m_instanceCount + 63) / 64, 1, 1);
+        }
+
+        ID3D11UnorderedAccessView* nullUAVs[2] = { nullptr, nullptr };
+        m_stateTracker.CSSetUnorderedAccessViews(0, 2, nullUAVs, nullptr);
+        ID3D11ShaderResourceView* nullSRVs[1] = { nullptr };
+        m_stateTracker.CSSetShaderResources(0, 1, nullSRVs);
+        m_stateTracker.CSSetShader(nullptr);
+
+        if (m_frameCullingMode == CullingReadback)
+        {
+            // Копия уходит в кольцо без ожидания, читаем самый свежий готовый кадр
+            ReadbackCopy copies[2] = {
+                { output.pArgsBuffer, sizeof(UINT), 0, sizeof(UINT) },
+                { output.pIdsBuffer, 0, sizeof(UINT), sizeof(UINT) * m_instanceCount }
+            };
+            if (m_cullReadback.Enqueue(m_frameIndex, copies, 2))
+                m_frameCopyBytes += copies[0].byteCount + copies[1].byteCount;
+
+            m_readbackData.resize(m_instanceCount + 1);
+            if (m_cullReadback.TryRead(m_readbackData.data(), sizeof(UINT) * (m_instanceCount + 1)))
+            {
+                UINT count = m_readbackData[0] < m_instanceCount ? m_readbackData[0] : m_instanceCount;
+                m_visibleIds.assign(m_readbackData.begin() + 1, m_readbackData.begin() + 1 + count);
+            }
+        }
+    }
+
+
+    // Видимые экземпляры и матрицы источников света - одно переименование буфера за кадр
+    m_visibleCubes = m_frameCullingMode != CullingGpuDriven ? static_cast<int>(m_visibleIds.size()) : 0;
+    m_passData.cubesGpuDriven = m_frameCullingMode == CullingGpuDriven;
+    D3D11_MAPPED_SUBRESOURCE mappedModels;
+    m_passData.cubesMapped = SUCCEEDED(m_pDeviceContext->Map(m_pModelBufferInst, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedModels));
+    if (m_passData.cubesMapped)
+    {
+        SceneInstance* pModels = static_cast<SceneInstance*>(mappedModels.pData);
+        m_scene.Gather(m_visibleIds.data(), m_visibleCubes, pModels);
+        for (UINT i = 0; i < LightCount; i++)
+            SceneFrame::BuildLightModel(lights[i], pModels[m_instanceCapacity + i]);
+        m_pDeviceContext->Unmap(m_pModelBufferInst, 0);
+        m_uploadRing.GetAllocator().RecordExternalUpload(sizeof(SceneInstance) * (m_visibleCubes + LightCount), true);
+    }
+
+    LARGE_INTEGER cullEnd;
+    QueryPerformanceCounter(&cullEnd);
+    if (m_timerFrequency.QuadPart != 0)
+    {
+        float cpuMs = 1000.0f * (cullEnd.QuadPart - cullStart.QuadPart) / m_timerFrequency.QuadPart;
+        float& average = m_cullingStats[m_frameCullingMode].cpuMs;
+        average = average == 0.0f ? cpuMs : average * 0.95f + cpuMs * 0.05f;
+    }
+}
+
+void RenderClass::RecordCubes(StateTracker& tracker, ID3D11DeviceContext* pContext)
+{
+    // Без камеры и света этого кадра кубы не рисуются
+    if (!m_cameraConstants.pBuffer || !m_passData.lightConstants.pBuffer)
+        return;
+
+    tracker.OMSetRenderTargets(1, &m_passData.pSceneRTV, m_passData.pDepthView);
+    tracker.RSSetViewports(1, &m_passData.viewport);
+    tracker.OMSetDepthStencilState(nullptr, 0);
+    tracker.OMSetBlendState(nullptr, nullptr, 0xffffffff);
+
+    UINT stride = sizeof(CubeVertex);
+    UINT offset = 0;
+    tracker.IASetVertexBuffers(0, 1, &m_pVertexBuffer, &stride, &offset);
+    tracker.IASetIndexBuffer(m_pIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
+    tracker.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    tracker.IASetInputLayout(m_pLayout);
+
+    tracker.VSSetShader(m_pVertexShader);
+    tracker.PSSetShader(m_pPixelShader);
+    BindVSConstants(tracker, 1, m_cameraConstants);
+    BindPSConstants(tracker, 2, m_passData.lightConstants);
+
+    tracker.PSSetShaderResources(0, 1, &m_pTextureView);
+    tracker.PSSetShaderResources(1, 1, &m_pNormalMapView);
+    tracker.PSSetSamplers(0, 1, &m_pSamplerState);
+
+    if (m_passData.cubesGpuDriven)
+    {
+        // Отсечение, сжатие и отрисовка остаются на GPU: вершинный шейдер
+        // берёт экземпляр по индексу из списка, записанного вычислительным шейдером
+        const CullingOutput& output = m_cullingOutputs.GetCurrent();
+        ID3D11ShaderResourceView* instanceSRVs[2] = { m_pInstanceDataSRV, output.pIdsSRV };
+        tracker.VSSetShaderResources(0, 2, instanceSRVs);
+        pContext->DrawIndexedInstancedIndirect(output.pArgsBuffer, 0);
+    }
+
+    if (!m_passData.cubesMapped)
+        return;
+
+    if (m_visibleCubes > 0)
+    {
+        ID3D11ShaderResourceView* instanceSRVs[2] = { m_pModelBufferInstSRV, m_pIdentityIdsSRV };
+        tracker.VSSetShaderResources(0, 2, instanceSRVs);
+        pContext->DrawIndexedInstanced(36, m_visibleCubes, 0, 0, 0);
+    }
+
+    tracker.PSSetShader(m_pLightPixelShader);
+
+    for (UINT i = 0; i < LightCount; i++)
+    {
+        if (!m_passData.lightColorConstants[i].pBuffer)
+            continue;
+        ID3D11ShaderResourceView* lightSRVs[2] = { m_pModelBufferInstSRV, m_lightIdsSRV[i] };
+        tracker.VSSetShaderResources(0, 2, lightSRVs);
+        BindPSConstants(tracker, 0, m_passData.lightColorConstants[i]);
+        pContext->DrawIndexed(36, 0, 0);
+    }
+}
+
+void RenderClass::PreparePostProcess() {
+    // Константы всех вызовов плана кладутся в кольцо здесь, на основном потоке
+    UINT width = m_camera.GetWidth();
+    UINT height = m_camera.GetHeight();
+    for (size_t i = 0; i < m_postPlan.size(); i++)
+    {
+        PostPass& pass = m_passData.postPasses[i];
+        switch (pass.dispatch.kind)
+        {
+        case PostDispatchKind::Fused: {
+            PostFusedConstants constants = {};
+            constants.width = width;
+            constants.height = height;
+            constants.exposure = m_exposure;
+            constants.bloomIntensity = m_bloomIntensity;
+            // Центры крайних текселей LUT: входной цвет 0 и 1 попадает точно в них
+            constants.lutScale = (GradingLutSize - 1.0f) / GradingLutSize;
+            constants.lutOffset = 0.5f / GradingLutSize;
+            constants.opCount = pass.dispatch.opCount;
+            for (UINT op = 0; op < pass.dispatch.opCount; op++)
+                constants.ops[op] = pass.dispatch.ops[op];
+            m_uploadRing.Upload(&constants, sizeof(constants), &pass.constants);
+            break;
+        }
+        case PostDispatchKind::Fxaa: {
+            FxaaConstants constants = {};
+            constants.rcpSize = XMFLOAT2(1.0f / width, 1.0f / height);
+            constants.width = width;
+            constants.height = height;
+            constants.edgeThreshold = 0.166f;
+            constants.edgeThresholdMin = 0.0833f;
+            constants.subpixel = m_fxaaSubpixel;
+            m_uploadRing.Upload(&constants, sizeof(constants), &pass.constants);
+            break;
+        }
+        case PostDispatchKind::Bloom: {
+            BloomChain& bloom = m_passData.bloom;
+            BloomConstants constants = {};
+            constants.threshold = m_bloomThreshold;
+            constants.knee = m_bloomThreshold * 0.5f;
+            UINT srcWidth = width;
+            UINT srcHeight = height;
+            for (UINT level = 0; level < BloomLevels; level++)
+            {
+                constants.srcTexelSize = XMFLOAT2(1.0f / srcWidth, 1.0f / srcHeight);
+                constants.width = bloom.width[level];
+                constants.height = bloom.height[level];
+                constants.firstLevel = level == 0;
+                m_uploadRing.Upload(&constants, sizeof(constants), &bloom.downConstants[level]);
+                srcWidth = bloom.width[level];
+                srcHeight = bloom.height[level];
+            }
+            // knee у увеличения - радиус шатра в текселях нижнего уровня
+            constants.knee = 1.0f;
+            constants.firstLevel = 0;
+            for (UINT level = 0; level + 1 < BloomLevels; level++)
+            {
+                constants.srcTexelSize = XMFLOAT2(1.0f / bloom.width[level + 1], 1.0f / bloom.height[level + 1]);
+                constants.width = bloom.width[level];
+                constants.height = bloom.height[level];
+                m_uploadRing.Upload(&constants, sizeof(constants), &bloom.upConstants[level]);
+            }
+            break;
+        }
+        }
+
+        if (pass.pCopySource)
+            m_frameCopyBytes += static_cast<UINT64>(width) * height * 4;
+    }
+}
+
+void RenderClass::DispatchPost(StateTracker& tracker, ID3D11DeviceContext* pContext, ID3D11ComputeShader* pShader,
+    ID3D11ShaderResourceView* const* ppInputs, ID3D11UnorderedAccessView* pOutput, const UploadAllocation& constants,
+    UINT width, UINT height)
+{
+    if (!constants.pBuffer)
+        return;
+
+    // Выход прошлого вызова - вход этого: UAV снимается до привязки SRV, иначе рантайм обнулит SRV
+    ID3D11UnorderedAccessView* nullUAVs[1] = { nullptr };
+    tracker.CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+    tracker.CSSetShader(pShader);
+    tracker.CSSetShaderResources(0, 3, ppInputs);
+    tracker.CSSetUnorderedAccessViews(0, 1, &pOutput, nullptr);
+    BindCSConstants(tracker, 0, constants);
+    pContext->Dispatch((width + 7) / 8, (height + 7) / 8, 1);
+}
+
+void RenderClass::RecordBloom(const PostPass& pass, StateTracker& tracker, ID3D11DeviceContext* pContext)
+{
+    const BloomChain& bloom = m_passData.bloom;
+    for (UINT level = 0; level < BloomLevels; level++)
+    {
+        ID3D11ShaderResourceView* inputs[3] = { level == 0 ? pass.pInput : bloom.pDownSRV[level - 1], nullptr, nullptr };
+        DispatchPost(tracker, pContext, m_pBloomDownsampleCS, inputs, bloom.pDownUAV[level], bloom.downConstants[level],
+            bloom.width[level], bloom.height[level]);
+    }
+    for (UINT level = BloomLevels - 1; level-- > 0;)
+    {
+        ID3D11ShaderResourceView* lower = level + 2 == BloomLevels ? bloom.pDownSRV[level + 1] : bloom.pUpSRV[level + 1];
+        ID3D11ShaderResourceView* inputs[3] = { lower, bloom.pDownSRV[level], nullptr };
+        DispatchPost(tracker, pContext, m_pBloomUpsampleCS, inputs, bloom.pUpUAV[level], bloom.upConstants[level],
+            bloom.width[level], bloom.height[level]);
+    }
+}
+
+void RenderClass::RecordPostPass(UINT index, StateTracker& tracker, ID3D11DeviceContext* pContext)
+{
+    const PostPass& pass = m_passData.postPasses[index];
+
+    // Цвет сцены ещё привязан как цель, а читать его будет шейдер
+    tracker.OMSetRenderTargets(0, nullptr, nullptr);
+    tracker.CSSetSamplers(0, 1, &m_pLinearClampSampler);
+
+    UINT width = m_camera.GetWidth();
+    UINT height = m_camera.GetHeight();
+    switch (pass.dispatch.kind)
+    {
+    case PostDispatchKind::Fused: {
+        ID3D11ShaderResourceView* inputs[3] = { pass.pInput, m_pGradingLutSRV, pass.pBloom };
+        DispatchPost(tracker, pContext, m_pPostFusedCS, inputs, pass.pOutput, pass.constants, width, height);
+        break;
+    }
+    case PostDispatchKind::Fxaa: {
+        ID3D11ShaderResourceView* inputs[3] = { pass.pInput, nullptr, nullptr };
+        DispatchPost(tracker, pContext, m_pFxaaCS, inputs, pass.pOutput, pass.constants, width, height);
+        break;
+    }
+    case PostDispatchKind::Bloom:
+        RecordBloom(pass, tracker, pContext);
+        break;
+    }
+
+    // Выход следующему проходу нужен как SRV, а буфер обмена - как цель ImGui
+    ID3D11ShaderResourceView* nullSRVs[3] = { nullptr, nullptr, nullptr };
+    ID3D11UnorderedAccessView* nullUAVs[1] = { nullptr };
+    tracker.CSSetShaderResources(0, 3, nullSRVs);
+    tracker.CSSetUnorderedAccessViews(0, 1, nullUAVs, nullptr);
+
+    if (pass.pCopySource)
+    {
+        ID3D11Resource* pBackBuffer = nullptr;
+        m_pRenderTargetView->GetResource(&pBackBuffer);
+        pContext->CopyResource(pBackBuffer, pass.pCopySource);
+        pBackBuffer->Release();
+    }
+}
+
+HRESULT RenderClass::BuildFrameGraph() {
+    static const char* bloomDownNames[BloomLevels] = { "BloomDown1", "BloomDown2", "BloomDown3", "BloomDown4" };
+    static const char* bloomUpNames[BloomLevels - 1] = { "BloomUp1", "BloomUp2", "BloomUp3" };
+
+    UINT width = m_camera.GetWidth();
+    UINT height = m_camera.GetHeight();
+    m_postChain.BuildPlan(m_postPlan);
+    m_frameGraphRevision = m_postChain.GetRevision();
+    bool postProcess = !m_postPlan.empty();
+
+    // С постобработкой сцена рисуется в HDR; у её цвета и промежуточных целей одно описание
+    RenderGraphTextureDesc hdrDesc = { width, height, DXGI_FORMAT_R16G16B16A16_FLOAT,
+        D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS, 8 };
+    RenderGraphTextureDesc depthDesc = { width, height, DXGI_FORMAT_D24_UNORM_S8_UINT,
+        D3D11_BIND_DEPTH_STENCIL, 4 };
+    RenderGraphTextureDesc outputDesc = { width, height, DXGI_FORMAT_R8G8B8A8_UNORM, D3D11_BIND_UNORDERED_ACCESS, 4 };
+
+    m_frameGraph.Reset();
+    RenderGraph::Handle backBuffer = m_frameGraph.ImportTexture("BackBuffer");
+    uint32_t backBufferResource = m_frameGraph.GetResource(backBuffer);
+    // Без эффектов сцене промежуточная цель не нужна
+    RenderGraph::Handle color = postProcess ? m_frameGraph.CreateTexture("SceneColor", hdrDesc) : backBuffer;
+    RenderGraph::Handle depth = m_frameGraph.CreateTexture("SceneDepth", depthDesc);
+    uint32_t sceneColor = m_frameGraph.GetResource(color);
+    uint32_t sceneDepth = m_frameGraph.GetResource(depth);
+
+    // Небо очищает цвет и глубину, предыдущие версии ему не нужны
+    uint32_t pass = m_frameGraph.AddPass("Skybox");
+    color = m_frameGraph.Write(pass, color);
+    depth = m_frameGraph.Write(pass, depth);
+
+    pass = m_frameGraph.AddPass("Cubes");
+    m_frameGraph.Read(pass, color);
+    color = m_frameGraph.Write(pass, color);
+    m_frameGraph.Read(pass, depth);
+    depth = m_frameGraph.Write(pass, depth);
+
+    pass = m_frameGraph.AddPass("Parallelogram");
+    m_frameGraph.Read(pass, color);
+    color = m_frameGraph.Write(pass, color);
+    m_frameGraph.Read(pass, depth);
+
+    // Каждый вызов плана читает выход предыдущего и пишет новую цель; последний - буфер обмена.
+    // Bloom картинку не меняет: он пишет свои уровни, Up1 читает смешивание в следующем слитом проходе
+    const uint32_t bloomBit = 1u << static_cast<uint32_t>(PostStage::Bloom);
+    uint32_t postInputs[MaxPostPasses] = {};
+    uint32_t postOutputs[MaxPostPasses] = {};
+    UINT bloomWidth[BloomLevels] = {};
+    UINT bloomHeight[BloomLevels] = {};
+    uint32_t bloomDown[BloomLevels] = {};
+    uint32_t bloomUp[BloomLevels - 1] = {};
+    RenderGraph::Handle bloomResult = RenderGraph::InvalidIndex;
+    uint32_t outputResource = RenderGraph::InvalidIndex;
+    for (size_t i = 0; i < m_postPlan.size(); i++)
+    {
+        const PostDispatch& dispatch = m_postPlan[i];
+        pass = m_frameGraph.AddPass(PostProcessChain::GetDispatchName(dispatch));
+        m_frameGraph.Read(pass, color);
+        postInputs[i] = m_frameGraph.GetResource(color);
+
+        if (dispatch.kind == PostDispatchKind::Bloom)
+        {
+            UINT levelWidth = width;
+            UINT levelHeight = height;
+            for (UINT level = 0; level < BloomLevels; level++)
+            {
+                levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+                levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+                bloomWidth[level] = levelWidth;
+                bloomHeight[level] = levelHeight;
+                RenderGraphTextureDesc levelDesc = { levelWidth, levelHeight, DXGI_FORMAT_R16G16B16A16_FLOAT,
+                    D3D11_BIND_SHADER_RESOURCE | D3D11_BIND_UNORDERED_ACCESS, 8 };
+                bloomDown[level] = m_frameGraph.GetResource(m_frameGraph.Write(pass, m_frameGraph.CreateTexture(bloomDownNames[level], levelDesc)));
+                if (level + 1 < BloomLevels)
+                {
+                    RenderGraph::Handle up = m_frameGraph.Write(pass, m_frameGraph.CreateTexture(bloomUpNames[level], levelDesc));
+                    bloomUp[level] = m_frameGraph.GetResource(up);
+                    if (level == 0)
+                        bloomResult = up;
+                }
+            }
+            postOutputs[i] = RenderGraph::InvalidIndex;
+            continue;
+        }
+
+        if (dispatch.kind == PostDispatchKind::Fused && (dispatch.stageMask & bloomBit))
+            m_frameGraph.Read(pass, bloomResult);
+
+        if (i + 1 < m_postPlan.size())
+        {
+            color = m_frameGraph.Write(pass, m_frameGraph.CreateTexture("PostColor", hdrDesc));
+        }
+        else
+        {
+            if (!m_pBackBufferUAV)
+                outputResource = m_frameGraph.GetResource(m_frameGraph.Write(pass, m_frameGraph.CreateTexture("PostOutput", outputDesc)));
+            color = m_frameGraph.Write(pass, backBuffer);
+        }
+        postOutputs[i] = m_frameGraph.GetResource(color);
+    }
+    m_frameGraph.MarkOutput(color);
+
+    // Цель и глубина могут смениться: старые виды не должны остаться привязанными
+    m_stateTracker.OMSetRenderTargets(0, nullptr, nullptr);
+    ID3D11ShaderResourceView* nullSRVs[1] = { nullptr };
+    m_stateTracker.PSSetShaderResources(0, 1, nullSRVs);
+
+    PassFrameData& data = m_passData;
+    data.pSceneRTV = nullptr;
+    data.pDepthView = nullptr;
+    memset(data.postPasses, 0, sizeof(data.postPasses));
+    memset(&data.bloom, 0, sizeof(data.bloom));
+
+    HRESULT hr = m_frameGraph.Compile() ? m_graphResources.Realize(m_frameGraph) : E_FAIL;
+    if (FAILED(hr)) {
+        // Пустой граф: проходы не записываются, пока граф не соберётся снова
+        m_frameGraph.Reset();
+        return hr;
+    }
+
+    data.pSceneRTV = sceneColor == backBufferResource ? m_pRenderTargetView : m_graphResources.GetRTV(m_frameGraph, sceneColor);
+    data.pDepthView = m_graphResources.GetDSV(m_frameGraph, sceneDepth);
+    for (size_t i = 0; i < m_postPlan.size(); i++)
+    {
+        PostPass& post = data.postPasses[i];
+        post.dispatch = m_postPlan[i];
+        post.pInput = m_graphResources.GetSRV(m_frameGraph, postInputs[i]);
+        if (post.dispatch.kind == PostDispatchKind::Fused && (post.dispatch.stageMask & bloomBit))
+            post.pBloom = m_graphResources.GetSRV(m_frameGraph, bloomUp[0]);
+        if (postOutputs[i] != backBufferResource)
+        {
+            post.pOutput = postOutputs[i] == RenderGraph::InvalidIndex ? nullptr : m_graphResources.GetUAV(m_frameGraph, postOutputs[i]);
+        }
+        else if (m_pBackBufferUAV)
+        {
+            post.pOutput = m_pBackBufferUAV;
+        }
+        else
+        {
+            post.pOutput = m_graphResources.GetUAV(m_frameGraph, outputResource);
+            post.pCopySource = m_graphResources.GetTexture(m_frameGraph, outputResource);
+        }
+    }
+    for (UINT level = 0; level < BloomLevels && bloomResult != RenderGraph::InvalidIndex; level++)
+    {
+        data.bloom.width[level] = bloomWidth[level];
+        data.bloom.height[level] = bloomHeight[level];
+        data.bloom.pDownSRV[level] = m_graphResources.GetSRV(m_frameGraph, bloomDown[level]);
+        data.bloom.pDownUAV[level] = m_graphResources.GetUAV(m_frameGraph, bloomDown[level]);
+        if (level + 1 < BloomLevels)
+        {
+            data.bloom.pUpSRV[level] = m_graphResources.GetSRV(m_frameGraph, bloomUp[level]);
+            data.bloom.pUpUAV[level] = m_graphResources.GetUAV(m_frameGraph, bloomUp[level]);
+        }
+    }
+    return S_OK;
+}
+
+HRESULT RenderClass::InitDeferredRecording() {
+    D3D11_FEATURE_DATA_THREADING threading = {};
+    if (SUCCEEDED(m_pDevice->CheckFeatureSupport(D3D11_FEATURE_THREADING, &threading, sizeof(threading))))
+        m_driverCommandLists = threading.DriverCommandLists != FALSE;
+
+    // Участки кольца привязываются через D3D11.1; без него каждый контекст получил бы свой запасной буфер
+    bool offsetsSupported = true;
+    for (UINT i = 0; i < RecordPassCount; i++)
+    {
+        HRESULT hr = m_pDevice->CreateDeferredContext(0, &m_pDeferredContexts[i]);
+        if (FAILED(hr))
+            return hr;
+        if (FAILED(m_pDeferredContexts[i]->QueryInterface(__uuidof(ID3D11DeviceContext1), reinterpret_cast<void**>(&m_pDeferredContexts1[i]))))
+        {
+            m_pDeferredContexts1[i] = nullptr;
+            offsetsSupported = false;
+        }
+        m_deferredTrackers[i].Init(m_pDeferredContexts[i], m_pDeferredContexts1[i]);
+    }
+
+    m_deferredSupported = offsetsSupported || !m_uploadRing.UsesOffsets();
+    return S_OK;
+}
+
+void RenderClass::TerminateDeferredRecording() {
+    for (UINT i = 0; i < RecordPassCount; i++)
+    {
+        if (m_pCommandLists[i]) {
+            m_pCommandLists[i]->Release();
+            m_pCommandLists[i] = nullptr;
+        }
+        m_deferredTrackers[i].Terminate();
+        if (m_pDeferredContexts1[i]) {
+            m_pDeferredContexts1[i]->Release();
+            m_pDeferredContexts1[i] = nullptr;
+        }
+        if (m_pDeferredContexts[i]) {
+            m_pDeferredContexts[i]->Release();
+            m_pDeferredContexts[i] = nullptr;
+        }
+    }
+    m_deferredSupported = false;
+    m_driverCommandLists = false;
+}
+
+void RenderClass::RecordPass(UINT pass, StateTracker& tracker, ID3D11DeviceContext* pContext) {
+    switch (pass)
+    {
+    case RecordPassSkybox:
+        RecordSkybox(tracker, pContext);
+        break;
+    case RecordPassCubes:
+        RecordCubes(tracker, pContext);
+        break;
+    case RecordPassParallelogram:
+        RecordParallelogram(tracker, pContext);
+        break;
+    default:
+        RecordPostPass(pass - RecordPassPostProcess, tracker, pContext);
+        break;
+    }
+}
+
+void RenderClass::RecordPasses(bool deferred) {
+    // Пишутся только оставшиеся после компиляции графа проходы, в его порядке
+    const std::vector<uint32_t>& order = m_frameGraph.GetOrder();
+    for (UINT i = 0; i < RecordPassCount; i++)
+        m_passTimings[i].cpuMs = 0.0f;
+
+    LARGE_INTEGER recordStart;
+    QueryPerformanceCounter(&recordStart);
+
+    if (deferred)
+    {
+        // Каждый проход пишет свой список команд в своём контексте, начиная с чистого состояния
+        m_jobs.ParallelFor(order.size(), 1, [&](size_t begin, size_t, size_t)
+        {
+            UINT pass = order[begin];
+            LARGE_INTEGER start, end;
+            QueryPerformanceCounter(&start);
+
+            StateTracker& tracker = m_deferredTrackers[pass];
+            tracker.BeginFrame();
+            tracker.Invalidate();
+            RecordPass(pass, tracker, m_pDeferredContexts[pass]);
+            if (FAILED(m_pDeferredContexts[pass]->FinishCommandList(FALSE, &m_pCommandLists[pass])))
+                m_pCommandLists[pass] = nullptr;
+
+            QueryPerformanceCounter(&end);
+            m_passTimings[pass].cpuMs = 1000.0f * (end.QuadPart - start.QuadPart) / m_timerFrequency.QuadPart;
+            m_passTimings[pass].thread = std::this_thread::get_id();
+        });
+
+        // Списки исполняются строго в порядке проходов; GPU-время по-прежнему видно по участкам
+        for (uint32_t pass : order)
+        {
+            ProfileScope scope(m_profiler, m_frameGraph.GetPassName(pass));
+            if (m_pCommandLists[pass])
+            {
+                m_pDeviceContext->ExecuteCommandList(m_pCommandLists[pass], FALSE);
+                m_pCommandLists[pass]->Release();
+                m_pCommandLists[pass] = nullptr;
+            }
+        }
+        // FALSE сбрасывает немедленный контекст в состояние по умолчанию
+        m_stateTracker.Invalidate();
+    }
+    else
+    {
+        for (uint32_t pass : order)
+        {
+            ProfileScope scope(m_profiler, m_frameGraph.GetPassName(pass));
+            LARGE_INTEGER start, end;
+            QueryPerformanceCounter(&start);
+            RecordPass(pass, m_stateTracker, m_pDeviceContext);
+            QueryPerformanceCounter(&end);
+            m_passTimings[pass].cpuMs = 1000.0f * (end.QuadPart - start.QuadPart) / m_timerFrequency.QuadPart;
+            m_passTimings[pass].thread = std::this_thread::get_id();
+        }
+    }
+    // ImGui рисует в уже привязанную цель, а постобработка пишет буфер обмена через UAV
+    m_stateTracker.OMSetRenderTargets(1, &m_pRenderTargetView, nullptr);
+    m_stateTracker.RSSetViewports(1, &m_passData.viewport);
+
+    LARGE_INTEGER recordEnd;
+    QueryPerformanceCounter(&recordEnd);
+    m_recordWallMs = 1000.0f * (recordEnd.QuadPart - recordStart.QuadPart) / m_timerFrequency.QuadPart;
+    m_lastFrameDeferred = deferred;
+}
+
+
+void RenderClass::InitImGui(HWND hWnd)
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.Fonts->AddFontDefault();
+
+    ImGui::StyleColorsLight();
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.WindowRounding = 6.0f;
+    style.FrameRounding = 4.0f;
+    style.ScrollbarRounding = 6.0f;
+
+    ImVec4* colors = style.Colors;
+    colors[ImGuiCol_WindowBg] = ImVec4(0.97f, 0.97f, 0.98f, 1.00f);
+    colors[ImGuiCol_Header] = ImVec4(0.20f, 0.50f, 0.90f, 0.45f);
+    colors[ImGuiCol_HeaderHovered] = ImVec4(0.20f, 0.50f, 0.90f, 0.80f);
+    colors[ImGuiCol_HeaderActive] = ImVec4(0.20f, 0.50f, 0.90f, 1.00f);
+    colors[ImGuiCol_Button] = ImVec4(0.26f, 0.54f, 0.85f, 0.40f);
+    colors[ImGuiCol_ButtonHovered] = ImVec4(0.26f, 0.54f, 0.85f, 1.00f);
+    colors[ImGuiCol_ButtonActive] = ImVec4(0.06f, 0.53f, 0.98f, 1.00f);
+
+    ImGui_ImplWin32_Init(hWnd);
+    ImGui_ImplDX11_Init(m_pDevice, m_pDeviceContext);
+}
+
+void RenderClass::RenderImGui()
+{
+    ImGui_ImplDX11_NewFrame();
+    ImGui_ImplWin32_NewFrame();
+    ImGui::NewFrame();
+
+    ImGui::SetNextWindowSize(ImVec2(600, 500), ImGuiCond_Once);
+    ImGui::Begin("PostProcess", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    // Стадии в порядке исполнения; перестановка применяется после списка, чтобы не сбить его отрисовку
+    int moveFrom = -1;
+    int moveDelta = 0;
+    for (UINT i = 0; i < PostProcessChain::StageCount; i++)
+    {
+        PostStage stage = m_postChain.GetStage(i);
+        bool enabled = m_postChain.IsEnabled(stage);
+        ImGui::PushID(static_cast<int>(i));
+        if (ImGui::ArrowButton("up", ImGuiDir_Up)) {
+            moveFrom = static_cast<int>(i);
+            moveDelta = -1;
+        }
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("down", ImGuiDir_Down)) {
+            moveFrom = static_cast<int>(i);
+            moveDelta = 1;
+        }
+        ImGui::SameLine();
+        if (ImGui::Checkbox(PostProcessChain::GetStageName(stage), &enabled))
+            m_postChain.SetEnabled(stage, enabled);
+        ImGui::PopID();
+    }
+    if (moveFrom >= 0)
+        m_postChain.Move(static_cast<uint32_t>(moveFrom), moveDelta);
+
+    bool fusion = m_postChain.GetFusion();
+    if (ImGui::Checkbox("Fuse per-pixel stages", &fusion))
+        m_postChain.SetFusion(fusion);
+    ImGui::SliderFloat("Exposure", &m_exposure, 0.1f, 4.0f);
+    ImGui::SliderFloat("Bloom threshold", &m_bloomThreshold, 0.0f, 2.0f);
+    ImGui::SliderFloat("Bloom intensity", &m_bloomIntensity, 0.0f, 2.0f);
+    ImGui::SliderFloat("FXAA subpixel", &m_fxaaSubpixel, 0.0f, 1.0f);
+
+    ImGui::Separator();
+    if (m_postPlan.empty())
+        ImGui::Text("Chain: empty, scene renders to back buffer");
+    else
+        ImGui::Text("Chain: %zu dispatches, last writes back buffer %s", m_postPlan.size(), m_pBackBufferUAV ? "through UAV" : "through copy");
+
+    // GPU-время вызова - участок профилировщика с тем же именем, что и проход графа
+    const FrameProfiler::FrameRecord* pRecord = m_profiler.GetLatest(true);
+    for (const PostDispatch& dispatch : m_postPlan)
+    {
+        const char* name = PostProcessChain::GetDispatchName(dispatch);
+        float gpuMs = 0.0f;
+        for (UINT scope = 0; pRecord && scope < m_profiler.GetScopeCount(); scope++)
+        {
+            if (strcmp(m_profiler.GetScopeName(scope), name) == 0 && pRecord->scopes[scope].active)
+                gpuMs = pRecord->scopes[scope].gpuMs;
+        }
+        ImGui::Text("  %-16s %u op(s)  GPU %.3f ms", name, dispatch.opCount, gpuMs);
+    }
+    ImGui::Text("GPU copies: %llu bytes / frame", m_lastFrameCopyBytes);
+    ImGui::End();
+
+    ImGui::Begin("States", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Cached:   %zu", m_stateCache.GetStateCount());
+    ImGui::Text("Hits:       %llu", m_stateCache.GetHits());
+    ImGui::Text("Misses:   %llu", m_stateCache.GetMisses());
+    ImGui::Text("Created this frame: %u", m_stateCache.GetFrameCreations());
+    ImGui::Text("Created last frame: %u", m_stateCache.GetLastFrameCreations());
+    ImGui::Separator();
+    ImGui::Text("Set* issued:   %u / frame", m_stateTracker.GetLastFrameIssued());
+    ImGui::Text("Set* dropped: %u / frame", m_stateTracker.GetLastFrameDropped());
+    ImGui::Text("Total: %llu issued, %llu dropped", m_stateTracker.GetIssuedCalls(), m_stateTracker.GetDroppedCalls());
+    ImGui::End();
+
+    const UploadRingAllocator::FrameStats& uploadStats = m_uploadRing.GetAllocator().GetLastFrameStats();
+    ImGui::Begin("Uploads", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Constants: %s", m_uploadRing.UsesOffsets() ? "ring, bound by offset" : "DISCARD per update");
+    ImGui::Text("Ring: %llu bytes, %u allocations / frame", uploadStats.bytes, uploadStats.allocations);
+    ImGui::Text("Other: %llu bytes / frame", uploadStats.externalBytes);
+    ImGui::Text("Renames: %u / frame", uploadStats.discards + uploadStats.externalRenames);
+    ImGui::Text("Total: %llu bytes, %llu ring wraps", m_uploadRing.GetAllocator().GetTotalBytes(), m_uploadRing.GetAllocator().GetTotalDiscards());
+    ImGui::End();
+
+    const ShaderCache::Stats& shaderStats = m_shaderCache.GetStats();
+    ImGui::Begin("Shaders", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Cache hits:  %u (%.2f ms)", shaderStats.hits, shaderStats.loadMs);
+    ImGui::Text("Compiled:    %u (%.2f ms)", shaderStats.misses, shaderStats.compileMs);
+    ImGui::Text("Precompiled: %u", shaderStats.precompiled);
+    ImGui::Text("Failures:    %u", shaderStats.failures);
+    ImGui::Separator();
+    bool hotReload = m_shaderReload.IsEnabled();
+    if (ImGui::Checkbox("Hot reload", &hotReload))
+        m_shaderReload.SetEnabled(hotReload);
+    ImGui::Text("Reloaded: %u%s", m_shaderReload.GetReloadCount(), m_shaderReload.GetPendingCompiles() > 0 ? " (compiling...)" : "");
+    for (const ShaderHotReload::Status& status : m_shaderReload.GetStatus())
+    {
+        if (status.error.empty())
+            continue;
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%ls:", status.path.c_str());
+        ImGui::TextWrapped("%s", status.error.c_str());
+    }
+    ImGui::End();
+
+    ImGui::Begin("Assets", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Textures: %u loaded, %u loading, %u failed", m_textureLoader.GetLoaded(), m_textureLoader.GetPending(), m_textureLoader.GetFailed());
+    ImGui::Text("First frame: %.1f ms", m_firstFrameMs);
+    if (m_assetsReadyMs > 0.0f)
+        ImGui::Text("All loaded:  %.1f ms", m_assetsReadyMs);
+    else
+        ImGui::Text("All loaded:  ...");
+    if (m_normalMapStream != UINT32_MAX) {
+        const TextureStreamer& streamer = m_textureStreamer.GetStreamer();
+        const TextureStreamer::TextureState& normalMap = streamer.GetTexture(m_normalMapStream);
+        ImGui::Separator();
+        ImGui::Text("Normal map mips: wanted %u, resident %u, tail %u", normalMap.wantedMip, normalMap.residentMip, normalMap.tailMip);
+        ImGui::Text("VRAM: %.1f KB, streamed %.1f KB", streamer.GetAllocatedBytes() / 1024.0f, m_textureStreamer.GetUploadedBytes() / 1024.0f);
+        ImGui::Text("Reallocations: %u", m_textureStreamer.GetReallocations());
+        ImGui::SliderInt("Budget", &m_streamingBudgetKb, 16, 4096, "%d KB");
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowSize(ImVec2(300, 140), ImGuiCond_Once);
+    ImGui::Begin("Clipping", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("All:     %u", m_instanceCount);
+    ImGui::Text("Capacity: %u", m_instanceCapacity);
+    ImGui::InputInt("Instances", &m_pendingInstanceCount, 1000, 100000);
+    ImGui::SameLine();
+    if (ImGui::Button("Apply") && m_pendingInstanceCount > 0)
+        SetInstanceCount(static_cast<UINT>(m_pendingInstanceCount));
+    if (m_frameCullingMode == CullingGpuDriven)
+    {
+        ImGui::Text("Visible:    GPU");
+    }
+    else
+    {
+        ImGui::Text("Visible:    %d", m_visibleCubes);
+        ImGui::Text("Cut off:  %d", static_cast<int>(m_instanceCount) - m_visibleCubes);
+    }
+
+    ImGui::Separator();
+    int path = static_cast<int>(m_scene.GetCuller().GetPath());
+    const char* pathNames[] = { "Scalar", "SSE2", "AVX2" };
+    if (ImGui::Combo("CPU path", &path, pathNames, static_cast<int>(FrustumCuller::DetectBestPath()) + 1))
+        m_scene.GetCuller().SetPath(static_cast<FrustumCuller::Path>(path));
+    ImGui::InputInt("Threads", &m_pendingThreadCount, 1, 4);
+    ImGui::SameLine();
+    if (ImGui::Button("Set") && m_pendingThreadCount > 0 && m_pendingThreadCount <= 64)
+        m_jobs.Init(static_cast<uint32_t>(m_pendingThreadCount));
+    ImGui::Text("Job threads: %u, stolen chunks: %llu", m_jobs.GetThreadCount(), m_jobs.GetStolenChunks());
+    ImGui::Text("GPU output copies: %u, CPU stalls: %llu", m_cullingOutputs.GetCount(), m_cullingOutputs.GetStalls());
+    if (m_pComputeShader)
+    {
+        ImGui::RadioButton("CPU", &m_cullingMode, CullingCpu);
+        ImGui::SameLine();
+        ImGui::RadioButton("Readback", &m_cullingMode, CullingReadback);
+        ImGui::SameLine();
+        ImGui::RadioButton("GPU-driven", &m_cullingMode, CullingGpuDriven);
+        if (ImGui::Checkbox("Compare", &m_compareCulling))
+            m_compareFrames = 0;
+
+        ImGui::Text("CPU %s: %.2f ms frame, %.3f ms CPU", FrustumCuller::GetPathName(m_scene.GetCuller().GetPath()),
+            m_cullingStats[CullingCpu].frameMs, m_cullingStats[CullingCpu].cpuMs);
+        ImGui::Text("Readback: %.2f ms frame, %.3f ms CPU", m_cullingStats[CullingReadback].frameMs, m_cullingStats[CullingReadback].cpuMs);
+        ImGui::Text("GPU-driven: %.2f ms frame, %.3f ms CPU", m_cullingStats[CullingGpuDriven].frameMs, m_cullingStats[CullingGpuDriven].cpuMs);
+        if (m_frameCullingMode == CullingReadback)
+        {
+            ImGui::Text("Readback latency: %llu frames", m_cullReadback.GetLatency());
+            ImGui::Text("Readback dropped: %llu", m_cullReadback.GetDroppedFrames());
+        }
+    }
+    ImGui::End();
+
+    const Camera::Stats& cameraStats = m_camera.GetStats();
+    ImGui::Begin("Camera", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Viewport: %u x %u", m_camera.GetWidth(), m_camera.GetHeight());
+    ImGui::Text("Win32 lookups: %llu last frame, %llu total", m_lastFrameWin32Lookups, m_win32Lookups);
+    ImGui::Text("Rebuilt: view %llu, proj %llu, frustum %llu", cameraStats.viewUpdates, cameraStats.projUpdates, cameraStats.frustumUpdates);
+    ImGui::End();
+
+    ImGui::Begin("Timing", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    int presentMode = static_cast<int>(m_framePacer.GetMode());
+    ImGui::RadioButton("VSync", &presentMode, static_cast<int>(PresentMode::VSync));
+    ImGui::SameLine();
+    ImGui::RadioButton("Unlocked", &presentMode, static_cast<int>(PresentMode::Unlocked));
+    ImGui::SameLine();
+    ImGui::RadioButton("Capped", &presentMode, static_cast<int>(PresentMode::Capped));
+    m_framePacer.SetMode(static_cast<PresentMode>(presentMode));
+    int frameCap = static_cast<int>(m_framePacer.GetFrameCap());
+    if (ImGui::SliderInt("Frame cap", &frameCap, 10, 480, "%d fps"))
+        m_framePacer.SetFrameCap(static_cast<uint32_t>(frameCap));
+    ImGui::SliderInt("Buffers", &m_pendingBufferCount, D3D11SwapChain::MinBufferCount, D3D11SwapChain::MaxBufferCount);
+    if (ImGui::SliderInt("Max latency", &m_maxFrameLatency, 1, 3))
+        m_swapChain.SetMaximumFrameLatency(static_cast<UINT>(m_maxFrameLatency));
+    ImGui::Text("Swap chain: %s%s%s", m_swapChain.IsFlipModel() ? "flip" : "discard (legacy)",
+        m_swapChain.HasWaitableObject() ? ", waitable" : "", m_swapChain.IsTearingSupported() ? ", tearing" : "");
+    const FramePacer::Stats& pacerStats = m_framePacer.GetStats();
+    ImGui::Text("Frame: %.2f ms, waited %.2f ms", pacerStats.lastIntervalMs, pacerStats.lastWaitMs);
+    ImGui::Text("Missed deadlines: %llu, wait timeouts: %llu", pacerStats.missedDeadlines, pacerStats.waitTimeouts);
+    ImGui::Separator();
+    ImGui::Text("Step: %.2f ms, %u steps this frame, alpha %.2f", m_timestep.GetStep() * 1000.0, m_frameSteps, m_timestep.GetAlpha());
+    ImGui::Text("Total steps: %llu, dropped: %.2f s", m_timestep.GetTotalSteps(), m_timestep.GetDroppedSeconds());
+    ImGui::End();
+
+    ImGui::Begin("Recording", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    if (m_deferredSupported)
+        ImGui::Checkbox("Deferred contexts", &m_useDeferredRecording);
+    else
+        ImGui::Text("Deferred contexts: unavailable");
+    ImGui::Text("Driver command lists: %s", m_driverCommandLists ? "yes" : "no (emulated by runtime)");
+    ImGui::Text("Record: %.3f ms wall, %s", m_recordWallMs, m_lastFrameDeferred ? "deferred" : "immediate");
+    std::thread::id mainThread = std::this_thread::get_id();
+    float mainMs = 0.0f;
+    float workerMs = 0.0f;
+    for (uint32_t pass : m_frameGraph.GetOrder())
+    {
+        bool onMain = m_passTimings[pass].thread == mainThread;
+        (onMain ? mainMs : workerMs) += m_passTimings[pass].cpuMs;
+        ImGui::Text("%-14s %.3f ms, %s", m_frameGraph.GetPassName(pass), m_passTimings[pass].cpuMs, onMain ? "main thread" : "worker");
+    }
+    ImGui::Text("Main thread: %.3f ms, workers: %.3f ms", mainMs, workerMs);
+    ImGui::End();
+
+    const RenderGraph::Stats& graphStats = m_frameGraph.GetStats();
+    ImGui::Begin("Render graph", nullptr, ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("Passes: %u, culled: %u", graphStats.passes, graphStats.culledPasses);
+    for (uint32_t pass = 0; pass < m_frameGraph.GetPassCount(); pass++)
+        ImGui::Text("  %-14s %s", m_frameGraph.GetPassName(pass), m_frameGraph.IsCulled(pass) ? "culled" : "");
+    ImGui::Text("Transient textures: %u in %u physical", graphStats.transientTextures, graphStats.physicalTextures);
+    for (uint32_t resource = 0; resource < m_frameGraph.GetResourceCount(); resource++)
+    {
+        if (m_frameGraph.GetPhysical(resource) == RenderGraph::InvalidIndex)
+            continue;
+        ImGui::Text("  %-12s slot %u, passes %u..%u", m_frameGraph.GetResourceName(resource), m_frameGraph.GetPhysical(resource),
+            m_frameGraph.GetFirstUse(resource), m_frameGraph.GetLastUse(resource));
+    }
+    ImGui::Text("Memory: %.2f MB requested, %.2f MB allocated", graphStats.requestedBytes / (1024.0 * 1024.0),
+        graphStats.allocatedBytes / (1024.0 * 1024.0));
+    ImGui::Text("Textures created: %u", m_graphResources.GetCreatedTextures());
+    ImGui::End();
+
+    RenderProfilerWindow();
+
+    ImGui::Render();
+    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+}
+
+void RenderClass::RenderProfilerWindow()
+{
+    ImGui::SetNextWindowSize(ImVec2(460, 520), ImGuiCond_Once);
+    ImGui::Begin("Profiler", nullptr, ImGuiWindowFlags_NoCollapse);
+
+    float frameCpu = m_profiler.GetHistory(FrameProfiler::MaxScopes, false, m_profileValues);
+    float frameGpu = m_profiler.GetHistory(FrameProfiler::MaxScopes, true, m_profileValues);
+    ImGui::Text("Frame: CPU %.2f ms, GPU %.2f ms", frameCpu, frameGpu);
+    if (!m_profiler.HasGpu())
+        ImGui::Text("GPU timestamps are unavailable");
+    else
+        ImGui::Text("GPU frames skipped: %llu", m_profiler.GetDroppedGpuFrames());
+
+    // Последний кадр с результатами GPU: полосы по началу и длительности, вложенные участки ниже
+    const FrameProfiler::FrameRecord* pRecord = m_profiler.GetLatest(m_profiler.HasGpu());
+    const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    for (int gpu = 0; gpu < 2 && pRecord; gpu++)
+    {
+        if (gpu && !pRecord->gpuResolved)
+            break;
+
+        float frameMs = gpu ? pRecord->gpuMs : pRecord->cpuMs;
+        ImGui::Text("%s, frame %llu: %.3f ms", gpu ? "GPU" : "CPU", pRecord->frame, frameMs);
+
+        ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        float width = ImGui::GetContentRegionAvail().x;
+        float scale = frameMs > 0.0f ? width / frameMs : 0.0f;
+        UINT rows = 1;
+        for (UINT scope = 0; scope < m_profiler.GetScopeCount(); scope++)
+        {
+            const FrameProfiler::ScopeTiming& timing = pRecord->scopes[scope];
+            if (!timing.active || (gpu && !timing.gpu))
+                continue;
+
+            float start = gpu ? timing.gpuStartMs : timing.cpuStartMs;
+            float duration = gpu ? timing.gpuMs : timing.cpuMs;
+            ImVec2 min(origin.x + start * scale, origin.y + timing.depth * rowHeight);
+            ImVec2 max(min.x + (duration * scale > 1.0f ? duration * scale : 1.0f), min.y + rowHeight - 1.0f);
+            pDrawList->AddRectFilled(min, max, ImColor::HSV(scope / 7.0f, 0.5f, 0.9f));
+            if (ImGui::CalcTextSize(m_profiler.GetScopeName(scope)).x < max.x - min.x)
+                pDrawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32(0, 0, 0, 255), m_profiler.GetScopeName(scope));
+            if (timing.depth + 1 > rows)
+                rows = timing.depth + 1;
+        }
+        ImGui::Dummy(ImVec2(width, rows * rowHeight));
+    }
+
+    ImGui::Separator();
+    for (UINT scope = 0; scope < m_profiler.GetScopeCount(); scope++)
+    {
+        ImGui::PushID(scope);
+        float cpuMs = m_profiler.GetHistory(scope, false, m_profileValues);
+        ImGui::PlotHistogram("##cpu", m_profileValues.data(), static_cast<int>(m_profileValues.size()), 0, nullptr, 0.0f, FLT_MAX, ImVec2(180, 32));
+        ImGui::SameLine();
+        float gpuMs = m_profiler.GetHistory(scope, true, m_profileValues);
+        ImGui::PlotHistogram("##gpu", m_profileValues.data(), static_cast<int>(m_profileValues.size()), 0, nullptr, 0.0f, FLT_MAX, ImVec2(180, 32));
+        ImGui::SameLine();
+        ImGui::Text("%s\nCPU %.3f\nGPU %.3f", m_profiler.GetScopeName(scope), cpuMs, gpuMs);
+        ImGui::PopID();
+    }
+
+    ImGui::Separator();
+    if (ImGui::Button("Save CSV"))
+        m_profileMessage = m_profiler.WriteCsv("profile.csv") ? "Saved profile.csv" : "Failed to write profile.csv";
+    ImGui::SameLine();
+    if (ImGui::Button("Save JSON"))
+        m_profileMessage = m_profiler.WriteJson("profile.json") ? "Saved profile.json" : "Failed to write profile.json";
+    if (!m_profileMessage.empty())
+        ImGui::Text("%s", m_profileMessage.c_str());
+    ImGui::End();
+}
+
@@ -1,241 +1,515 @@
-#ifndef RENDER_CLASS_H
-#define RENDER_CLASS_H
-
-#include <dxgi.h>
-#include <d3d11.h>
-#include <DirectXMath.h>
-#include <vector>
-
-using namespace DirectX;
-
-class RenderClass
-{
-public:
-    RenderClass() :
-        m_pDevice(nullptr),
-        m_pDeviceContext(nullptr),
-        m_pSwapChain(nullptr),
-        m_pRenderTargetView(nullptr),
-        m_pVertexBuffer(nullptr),
-        m_pIndexBuffer(nullptr),
-        m_pPixelShader(nullptr),
-        m_pVertexShader(nullptr),
-        m_pLayout(nullptr),
-        m_pModelBuffer(nullptr),
-        m_pVPBuffer(nullptr),
-        m_szTitle(nullptr),
-        m_szWindowClass(nullptr),
-        m_pTextureView(nullptr),
-        m_pSamplerState(nullptr),
-        m_pSkyboxSRV(nullptr),
-        m_pSkyboxVB(nullptr),
-        m_pSkyboxVPBuffer(nullptr),
-        m_pSkyboxVS(nullptr),
-        m_pSkyboxPS(nullptr),
-        m_pSkyboxLayout(nullptr),
-        m_pDepthView(nullptr),
-        m_pParallelogramVB(nullptr),
-        m_pParallelogramIB(nullptr),
-        m_pParallelogramPS(nullptr),
-        m_pParallelogramVS(nullptr),
-        m_pParallelogramLayout(nullptr),
-        m_pBlendState(nullptr),
-        m_pDepthStateParallelogram(nullptr),
-        m_pLightBuffer(nullptr),
-        m_pLightPixelShader(nullptr),
-        m_pNormalMapView(nullptr),
-        m_pPostProcessTexture(nullptr),
-        m_pPostProcessRTV(nullptr),
-        m_pPostProcessSRV(nullptr),
-        m_pPostProcessVS(nullptr),
-        m_pPostProcessPS(nullptr),
-        m_pFullScreenVB(nullptr),
-        m_pFullScreenLayout(nullptr),
-        m_pModelBufferInst(nullptr),
-        m_pComputeShader(nullptr),
-        m_pFrustumPlanesBuffer(nullptr),
-        m_pIndirectArgsBuffer(nullptr),
-        m_pObjectsIdsBuffer(nullptr),
-        m_pIndirectArgsUAV(nullptr),
-        m_pObjectsIdsUAV(nullptr),
-        m_pInstanceDataSRV(nullptr),
-        m_CameraPosition(0.0f, 1.5f, -10.0f),
-        m_CameraSpeed(0.1f),
-        m_LRAngle(0.0f),
-        m_UDAngle(0.0f),
-        m_frustumPlanes{}
-    {
-    }
-
-    HRESULT Init(HWND hWnd, WCHAR szTitle[], WCHAR szWindowClass[]);
-    void Terminate();
-
-    HRESULT Init2DArray();
-    HRESULT InitFullScreenTriangle();
-    void UpdateFrustum(const XMMATRIX& viewProjMatrix);
-    bool IsAABBInFrustum(const XMFLOAT3& center, float size) const;
-    void InitImGui(HWND hWnd);
-    void RenderImGui();
-
-    HRESULT InitBufferShader();
-    void TerminateBufferShader();
-
-    HRESULT InitSkybox();
-    void TerminateSkybox();
-
-    HRESULT InitComputeShader();
-    void TerminateComputeShader();
-
-    HRESULT CompileShader(const std::wstring& path, ID3D11VertexShader** ppVertexShader, ID3D11PixelShader** ppPixelShader, ID3DBlob** pCodeShader = nullptr);
-    HRESULT CompileComputeShader(const std::wstring& path, ID3D11ComputeShader** ppComputeShader);
-
-    void Render();
-    void Resize(HWND hWnd);
-    void MoveCamera(float dx, float dy, float dz);
-    void RotateCamera(float yaw, float pitch);
-
-    HRESULT InitParallelogram();
-    void TerminateParallelogram();
-    void RenderParallelogram();
-    void RenderSkybox(XMMATRIX proj);
-    void RenderCubes(XMMATRIX view, XMMATRIX proj);
-
-    std::vector<UINT> ReadUintBufferData(ID3D11DeviceContext* pContext, ID3D11Buffer* pBuffer, UINT count);
-
-
-private:
-
-    struct CubeVertex {
-        XMFLOAT3 xyz;
-        XMFLOAT3 normal;
-        XMFLOAT2 uv;
-    };
-
-    struct SkyboxVertex {
-        float x, y, z;
-    };
-
-    struct MatrixBuffer {
-        XMMATRIX m;
-    };
-
-    struct CameraBuffer {
-        XMMATRIX vp;
-        XMFLOAT3 cameraPos;
-        float padding;
-    };
-
-    struct PointLight {
-        XMFLOAT3 Position;
-        float Range;
-        XMFLOAT3 Color;
-        float Intensity;
-    };
-
-    struct ColorBuffer
-    {
-        XMFLOAT4 color;
-    };
-
-    struct ParallelogramVertex
-    {
-        float x, y, z;
-    };
-
-    struct FullScreenVertex
-    {
-        float x, y, z, w;
-        float u, v;
-    };
-
-    struct InstanceData
-    {
-        XMMATRIX model;
-        UINT texInd;
-        UINT countInstance;
-        XMFLOAT2 padding;
-    };
-
-    HRESULT ConfigureBackBuffer(UINT width, UINT height);
-    void SetMVPBuffer();
-
-    HRESULT LoadCubemapFropCrossImage(ID3D11Device* device, ID3D11DeviceContext* context, const wchar_t* filename, ID3D11ShaderResourceView** cubeSVR);
-
-    ID3D11Device* m_pDevice;
-    ID3D11DeviceContext* m_pDeviceContext;
-
-    IDXGISwapChain* m_pSwapChain;
-    ID3D11RenderTargetView* m_pRenderTargetView;
-
-    ID3D11Buffer* m_pModelBuffer;
-    ID3D11Buffer* m_pVPBuffer;
-
-    ID3D11Buffer* m_pVertexBuffer;
-    ID3D11Buffer* m_pIndexBuffer;
-
-    ID3D11PixelShader* m_pPixelShader;
-    ID3D11VertexShader* m_pVertexShader;
-    ID3D11InputLayout* m_pLayout;
-
-    ID3D11ShaderResourceView* m_pTextureView;
-    ID3D11SamplerState* m_pSamplerState;
-
-    ID3D11ShaderResourceView* m_pSkyboxSRV;
-    ID3D11Buffer* m_pSkyboxVB;
-    ID3D11Buffer* m_pSkyboxVPBuffer;
-    ID3D11VertexShader* m_pSkyboxVS;
-    ID3D11PixelShader* m_pSkyboxPS;
-    ID3D11InputLayout* m_pSkyboxLayout;
-    ID3D11DepthStencilView* m_pDepthView;
-    
-    ID3D11Buffer* m_pColorBuffer;
-    ID3D11Buffer* m_pParallelogramVB;
-    ID3D11Buffer* m_pParallelogramIB;
-    ID3D11PixelShader* m_pParallelogramPS;
-    ID3D11VertexShader* m_pParallelogramVS;
-    ID3D11InputLayout* m_pParallelogramLayout;
-    ID3D11BlendState* m_pBlendState;
-    ID3D11DepthStencilState* m_pDepthStateParallelogram;
-
-    ID3D11Buffer* m_pLightBuffer;
-    ID3D11PixelShader* m_pLightPixelShader;
-    ID3D11ShaderResourceView* m_pNormalMapView;
-
-    ID3D11Texture2D* m_pPostProcessTexture;
-    ID3D11RenderTargetView* m_pPostProcessRTV;
-    ID3D11ShaderResourceView* m_pPostProcessSRV;
-    ID3D11VertexShader* m_pPostProcessVS;
-    ID3D11PixelShader* m_pPostProcessPS;
-    ID3D11Buffer* m_pFullScreenVB;
-    ID3D11InputLayout* m_pFullScreenLayout;
-
-    ID3D11ComputeShader* m_pComputeShader;
-    ID3D11Buffer* m_pFrustumPlanesBuffer;
-    ID3D11Buffer* m_pIndirectArgsBuffer;
-    ID3D11Buffer* m_pObjectsIdsBuffer;
-    ID3D11UnorderedAccessView* m_pIndirectArgsUAV;
-    ID3D11UnorderedAccessView* m_pObjectsIdsUAV;
-    ID3D11ShaderResourceView* m_pInstanceDataSRV;
-
-    bool m_useNegative = false;
-
-    const float m_fixedScale = 0.5f;
-    ID3D11Buffer* m_pModelBufferInst;
-    static const int MaxInst = 23;
-    std::vector<InstanceData> m_modelInstances = {};
-
-    XMVECTOR m_frustumPlanes[6];
-
-    float m_CubeAngle = 0.0f;
-    WCHAR* m_szTitle;
-    WCHAR* m_szWindowClass;
-
-    XMFLOAT3 m_CameraPosition;
-    float m_CameraSpeed;
-    float m_LRAngle;  
-    float m_UDAngle;  
-
-    int m_visibleCubes = 0;
-
-};
+#ifndef RENDER_CLASS_H
+#define RENDER_CLASS_H
+
+#include <dxgi.h>
+#include <d3d11.h>
+#include <DirectXMath.h>
+#include <thread>
+#include <vector>
+#include "D3D11Readback.h"
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include "SceneFrame.h"
+#include "StateCache.h"
+#include "D3D11StateTracker.h"
+#include "ShaderCache.h"
+#include "ShaderHotReload.h"
+#include "D3D11UploadRing.h"
+#include "D3D11GpuTimer.h"
+#include "Simulation.h"
+#include "Camera.h"
+#include "D3D11SwapChain.h"
+#include "FramePacer.h"
+#include "D3D11FrameFence.h"
+#include "D3D11RenderGraph.h"
+#include "PostProcessChain.h"
+#include "D3D11TextureLoader.h"
+#include "D3D11TextureStreamer.h"
+
+using namespace DirectX;
+
+class RenderClass
+{
+public:
+    RenderClass() :
+        m_pDevice(nullptr),
+        m_pDeviceContext(nullptr),
+        m_pDeviceContext1(nullptr),
+        m_pRenderTargetView(nullptr),
+        m_pVertexBuffer(nullptr),
+        m_pIndexBuffer(nullptr),
+        m_pPixelShader(nullptr),
+        m_pVertexShader(nullptr),
+        m_pLayout(nullptr),
+        m_szTitle(nullptr),
+        m_szWindowClass(nullptr),
+        m_pTextureView(nullptr),
+        m_pSamplerState(nullptr),
+        m_pSkyboxSRV(nullptr),
+        m_pSkyboxVB(nullptr),
+        m_pSkyboxVS(nullptr),
+        m_pSkyboxPS(nullptr),
+        m_pSkyboxLayout(nullptr),
+        m_pParallelogramVB(nullptr),
+        m_pParallelogramIB(nullptr),
+        m_pParallelogramPS(nullptr),
+        m_pParallelogramVS(nullptr),
+        m_pParallelogramLayout(nullptr),
+        m_pBlendState(nullptr),
+        m_pDepthStateParallelogram(nullptr),
+        m_pLightPixelShader(nullptr),
+        m_pNormalMapView(nullptr),
+        m_pPostFusedCS(nullptr),
+        m_pFxaaCS(nullptr),
+        m_pBloomDownsampleCS(nullptr),
+        m_pBloomUpsampleCS(nullptr),
+        m_pGradingLutSRV(nullptr),
+        m_pLinearClampSampler(nullptr),
+        m_pBackBufferUAV(nullptr),
+        m_pModelBufferInst(nullptr),
+        m_pComputeShader(nullptr),
+        m_pInstanceDataSRV(nullptr),
+        m_pInstanceBuffer(nullptr),
+        m_pModelBufferInstSRV(nullptr),
+        m_pIdentityIdsBuffer(nullptr),
+        m_pIdentityIdsSRV(nullptr),
+        m_CameraSpeed(0.1f)
+    {
+        m_camera.SetPosition(XMFLOAT3(0.0f, 1.5f, -10.0f));
+    }
+
+    HRESULT Init(HWND hWnd, WCHAR szTitle[], WCHAR szWindowClass[]);
+    void Terminate();
+
+    HRESULT Init2DArray();
+    HRESULT InitPostProcess();
+    void TerminatePostProcess();
+    void InitImGui(HWND hWnd);
+    void RenderImGui();
+    void RenderProfilerWindow();
+
+    HRESULT InitBufferShader();
+    void TerminateBufferShader();
+
+    HRESULT InitSkybox();
+    void TerminateSkybox();
+
+    HRESULT InitComputeShader();
+    void TerminateComputeShader();
+
+    HRESULT CompileShader(const std::wstring& path, ID3D11VertexShader** ppVertexShader, ID3D11PixelShader** ppPixelShader, ID3DBlob** pCodeShader = nullptr);
+    HRESULT CompileComputeShader(const std::wstring& path, ID3D11ComputeShader** ppComputeShader);
+    void InitShaderHotReload();
+
+    void Render();
+    void Resize(HWND hWnd);
+    void MoveCamera(float dx, float dy, float dz);
+    void RotateCamera(float yaw, float pitch);
+
+    HRESULT InitParallelogram();
+    void TerminateParallelogram();
+    void PrepareParallelogram();
+    void PrepareSkybox();
+    void PrepareCubes();
+
+    void SetInstanceCount(UINT count);
+    UINT GetInstanceCount() const { return m_instanceCount; }
+
+    static const UINT MaxInstances = 1 << 20;
+
+
+private:
+
+    struct CubeVertex {
+        XMFLOAT3 xyz;
+        XMFLOAT3 normal;
+        XMFLOAT2 uv;
+    };
+
+    struct SkyboxVertex {
+        float x, y, z;
+    };
+
+    struct MatrixBuffer {
+        XMMATRIX m;
+    };
+
+    struct CameraBuffer {
+        XMMATRIX vp;
+        XMFLOAT3 cameraPos;
+        float padding;
+    };
+
+    struct ColorBuffer
+    {
+        XMFLOAT4 color;
+    };
+
+    struct ParallelogramVertex
+    {
+        float x, y, z;
+    };
+
+    struct CullingBuffer
+    {
+        XMVECTOR planes[6];
+        UINT instanceCount;
+        UINT padding[3];
+    };
+
+    struct CullingStats
+    {
+        float frameMs;
+        float cpuMs;
+    };
+
+    HRESULT ConfigureBackBuffer(UINT width, UINT height);
+    void ResizeBackBuffer(UINT width, UINT height);
+    HRESULT CreateStructuredBuffer(UINT stride, UINT count, D3D11_USAGE usage, UINT bindFlags, const void* pInitData,
+        ID3D11Buffer** ppBuffer, ID3D11ShaderResourceView** ppSRV);
+    HRESULT EnsureInstanceCapacity(UINT count);
+    void ReleaseInstanceBuffers();
+    void ResetVisibleIds();
+    void UpdateCullingStats();
+    void UpdateAnimation();
+    bool UploadCSConstants(UINT slot, const void* pData, UINT size);
+    void PreparePostProcess();
+    void UpdateLoadTimes();
+    void UpdateStreaming();
+
+    ID3D11Device* m_pDevice;
+    ID3D11DeviceContext* m_pDeviceContext;
+    ID3D11DeviceContext1* m_pDeviceContext1;
+    StateCache m_stateCache;
+    StateTracker m_stateTracker;
+    ShaderCache m_shaderCache;
+    ShaderHotReload m_shaderReload;
+    D3D11UploadRing m_uploadRing;
+
+    // Текстуры грузятся в фоне, до готовности вместо них заглушки 1x1
+    static const UINT MaxTextureCreatesPerFrame = 4;
+    D3D11TextureLoader m_textureLoader;
+    LARGE_INTEGER m_initStartTime = {};
+    float m_firstFrameMs = 0.0f;
+    float m_assetsReadyMs = 0.0f;
+
+    // Карта нормалей: сразу только хвост мипов, детальные подгружаются по размеру
+    // ближайшего видимого куба на экране, который пересчитывается раз в StreamingInterval кадров
+    static const UINT StreamingTailSize = 64;
+    static const UINT MaxStreamingFetches = 2;
+    static const UINT StreamingInterval = 8;
+    D3D11TextureStreamer m_textureStreamer;
+    uint32_t m_normalMapStream = UINT32_MAX;
+    int m_streamingBudgetKb = 4096;
+    UINT m_streamingFrame = 0;
+    std::vector<float> m_chunkNearest = {};
+
+    // Кадров в пути у GPU-таймера и длина истории профилировщика
+    static const UINT ProfilerLatency = 4;
+    static const UINT ProfilerHistory = 240;
+    D3D11GpuTimerDevice m_gpuTimer;
+    FrameProfiler m_profiler;
+    std::vector<float> m_profileValues = {};
+    std::string m_profileMessage = {};
+
+    // Flip-модель: буферы и задержка кадров настраиваются в окне Timing
+    static const UINT SwapChainBuffers = 3;
+    static const UINT MaxFrameLatency = 1;
+    D3D11SwapChain m_swapChain;
+    SteadyFrameClock m_frameClock;
+    FramePacer m_framePacer;
+    int m_pendingBufferCount = SwapChainBuffers;
+    int m_maxFrameLatency = MaxFrameLatency;
+    ID3D11RenderTargetView* m_pRenderTargetView;
+
+    ID3D11Buffer* m_pVertexBuffer;
+    ID3D11Buffer* m_pIndexBuffer;
+
+    ID3D11PixelShader* m_pPixelShader;
+    ID3D11VertexShader* m_pVertexShader;
+    ID3D11InputLayout* m_pLayout;
+
+    // Материалы кубов - слои одного массива текстур, texInd выбирает слой без лишних вызовов отрисовки.
+    // Картинки любого размера приводятся к MaterialTextureSize
+    static const UINT MaterialTextureSize = 512;
+    std::vector<std::wstring> m_materialFiles = { L"cat.png", L"textile.png" };
+    ID3D11ShaderResourceView* m_pTextureView;
+    ID3D11SamplerState* m_pSamplerState;
+
+    ID3D11ShaderResourceView* m_pSkyboxSRV;
+    ID3D11Buffer* m_pSkyboxVB;
+    ID3D11VertexShader* m_pSkyboxVS;
+    ID3D11PixelShader* m_pSkyboxPS;
+    ID3D11InputLayout* m_pSkyboxLayout;
+    
+    ID3D11Buffer* m_pParallelogramVB;
+    ID3D11Buffer* m_pParallelogramIB;
+    ID3D11PixelShader* m_pParallelogramPS;
+    ID3D11VertexShader* m_pParallelogramVS;
+    ID3D11InputLayout* m_pParallelogramLayout;
+    ID3D11BlendState* m_pBlendState;
+    ID3D11DepthStencilState* m_pDepthStateParallelogram;
+
+    ID3D11PixelShader* m_pLightPixelShader;
+    ID3D11ShaderResourceView* m_pNormalMapView;
+
+    ID3D11ComputeShader* m_pPostFusedCS;
+    ID3D11ComputeShader* m_pFxaaCS;
+    ID3D11ComputeShader* m_pBloomDownsampleCS;
+    ID3D11ComputeShader* m_pBloomUpsampleCS;
+    ID3D11ShaderResourceView* m_pGradingLutSRV;
+    ID3D11SamplerState* m_pLinearClampSampler;
+    // nullptr, если буфер обмена не допускает UAV: тогда последний проход пишет в свою цель и копирует
+    ID3D11UnorderedAccessView* m_pBackBufferUAV;
+
+    ID3D11ComputeShader* m_pComputeShader;
+    ID3D11ShaderResourceView* m_pInstanceDataSRV;
+    ID3D11Buffer* m_pInstanceBuffer;
+
+    // Что пишет шейдер отсечения: аргументы косвенной отрисовки и список видимых.
+    // Копия на каждый кадр в пути, чтобы запись кадра N + 1 не ждала, пока GPU дочитает кадр N
+    struct CullingOutput
+    {
+        ID3D11Buffer* pArgsBuffer;
+        ID3D11UnorderedAccessView* pArgsUAV;
+        ID3D11Buffer* pIdsBuffer;
+        ID3D11UnorderedAccessView* pIdsUAV;
+        ID3D11ShaderResourceView* pIdsSRV;
+    };
+    static const UINT FramesInFlight = 3;
+    D3D11FrameFenceDevice m_frameFences;
+    FrameResources<CullingOutput> m_cullingOutputs;
+
+    static const UINT ReadbackSlots = 3;
+    D3D11ReadbackDevice m_readbackDevice;
+    ReadbackRing m_cullReadback;
+    std::vector<UINT> m_visibleIds = {};
+    UINT64 m_frameIndex = 0;
+
+    // Цепочка постобработки на вычислительных шейдерах: пустая - сцена рисуется прямо
+    // в буфер цепочки обмена, иначе в HDR-цель, а проходы плана идут по очереди через
+    // промежуточные цели; последний пишет в буфер обмена
+    static const UINT MaxPostPasses = PostProcessChain::MaxDispatches;
+    static const UINT BloomLevels = 4;
+    static const UINT GradingLutSize = 16;
+
+    struct PostFusedConstants
+    {
+        UINT width, height;
+        float exposure;
+        float bloomIntensity;
+        float lutScale;
+        float lutOffset;
+        UINT opCount;
+        UINT padding;
+        UINT ops[8];
+    };
+
+    struct FxaaConstants
+    {
+        XMFLOAT2 rcpSize;
+        UINT width, height;
+        float edgeThreshold;
+        float edgeThresholdMin;
+        float subpixel;
+        float padding;
+    };
+
+    struct BloomConstants
+    {
+        XMFLOAT2 srcTexelSize;
+        UINT width, height;
+        float threshold;
+        float knee;
+        UINT firstLevel;
+        float padding;
+    };
+
+    PostProcessChain m_postChain;
+    std::vector<PostDispatch> m_postPlan = {};
+    float m_exposure = 1.0f;
+    float m_bloomThreshold = 0.8f;
+    float m_bloomIntensity = 0.6f;
+    float m_fxaaSubpixel = 0.75f;
+    // Байты, скопированные на GPU за кадр: чтение отсечения и прочие Copy*
+    UINT64 m_frameCopyBytes = 0;
+    UINT64 m_lastFrameCopyBytes = 0;
+
+    ID3D11Buffer* m_pModelBufferInst;
+    ID3D11ShaderResourceView* m_pModelBufferInstSRV;
+    ID3D11Buffer* m_pIdentityIdsBuffer;
+    ID3D11ShaderResourceView* m_pIdentityIdsSRV;
+    // Матрицы источников света лежат после экземпляров, в [capacity, capacity + LightCount);
+    // отдельный вид на список индексов отдаёт вершинному шейдеру нужный элемент по SV_InstanceID = 0
+    static const UINT LightCount = SceneFrame::LightCount;
+    ID3D11ShaderResourceView* m_lightIdsSRV[LightCount] = {};
+    // Всё, что пересоздаётся при росте ёмкости. Новый набор собирается целиком рядом со старым
+    // и только потом подменяет его, так что при нехватке памяти остаются старые буферы
+    struct InstanceBuffers
+    {
+        ID3D11Buffer* pInstanceBuffer;
+        ID3D11ShaderResourceView* pInstanceDataSRV;
+        ID3D11Buffer* pModelBuffer;
+        ID3D11ShaderResourceView* pModelSRV;
+        ID3D11Buffer* pIdentityIdsBuffer;
+        ID3D11ShaderResourceView* pIdentityIdsSRV;
+        ID3D11ShaderResourceView* lightIdsSRV[LightCount];
+        ID3D11Buffer* pIdsBuffer[FramesInFlight];
+        ID3D11UnorderedAccessView* pIdsUAV[FramesInFlight];
+        ID3D11ShaderResourceView* pIdsSRV[FramesInFlight];
+    };
+    HRESULT CreateInstanceBuffers(UINT capacity, InstanceBuffers& buffers);
+    void SwapInstanceBuffers(InstanceBuffers& buffers);
+    static void ReleaseInstanceBuffers(InstanceBuffers& buffers);
+
+    // Камера кадра: её же читает параллелограмм через b1
+    UploadAllocation m_cameraConstants = {};
+    UINT m_instanceCount = 23;
+    UINT m_instanceCapacity = 0;
+    int m_pendingInstanceCount = 23;
+    // Кубы сцены и CPU-стадии кадра над ними; их же гоняет замер кадра без окна
+    SceneFrame m_scene;
+    std::vector<UINT> m_readbackData = {};
+
+    // Анимация на фиксированном шаге: два последних состояния и интерполированное для кадра
+    static const uint32_t MaxSimulationSteps = 8;
+    SimulationClock m_clock;
+    FixedTimestep m_timestep;
+    AnimationState m_animation = {};
+    AnimationState m_prevAnimation = {};
+    AnimationState m_frameAnimation = {};
+    uint32_t m_frameSteps = 0;
+    WCHAR* m_szTitle;
+    WCHAR* m_szWindowClass;
+
+    // Размер окна приходит только из Init и Resize; счётчик обращений к Win32 за размером
+    // в установившемся режиме не растёт
+    Camera m_camera;
+    float m_CameraSpeed;
+    UINT64 m_win32Lookups = 0;
+    UINT64 m_frameStartWin32Lookups = 0;
+    UINT64 m_lastFrameWin32Lookups = 0;
+
+    int m_visibleCubes = 0;
+
+    // Сравнение путей отсечения: SIMD на CPU, вычислительный шейдер с чтением на CPU, полностью на GPU
+    enum CullingMode
+    {
+        CullingCpu,
+        CullingReadback,
+        CullingGpuDriven,
+        CullingModeCount
+    };
+
+    JobSystem m_jobs;
+    int m_pendingThreadCount = 0;
+    int m_cullingMode = CullingGpuDriven;
+    int m_frameCullingMode = CullingGpuDriven;
+    bool m_compareCulling = false;
+    UINT m_compareFrames = 0;
+    CullingStats m_cullingStats[CullingModeCount] = {};
+    LARGE_INTEGER m_timerFrequency = {};
+    LARGE_INTEGER m_lastFrameTime = {};
+
+    // Проходы кадра. Всё, что трогает общие объекты (кольцо загрузки, Map, кэш состояний,
+    // отсечение), делается заранее на основном потоке; запись проходов читает только
+    // PassFrameData и поэтому может идти в отложенных контекстах параллельно.
+    // ImGui пишется в немедленный контекст: его бэкенд привязан к нему при инициализации.
+    enum RecordPass
+    {
+        RecordPassSkybox,
+        RecordPassCubes,
+        RecordPassParallelogram,
+        // По проходу на каждый вызов плана постобработки, подряд
+        RecordPassPostProcess,
+        RecordPassCount = RecordPassPostProcess + MaxPostPasses
+    };
+
+    struct PostPass
+    {
+        PostDispatch dispatch;
+        ID3D11ShaderResourceView* pInput;
+        ID3D11ShaderResourceView* pBloom;
+        ID3D11UnorderedAccessView* pOutput;
+        // Не nullptr - выход копируется в буфер обмена
+        ID3D11Texture2D* pCopySource;
+        UploadAllocation constants;
+    };
+
+    // Уровни свечения: Down[0] - половина экрана; Up[i] = Down[i] + размытый Up[i + 1] (или Down[3])
+    struct BloomChain
+    {
+        UINT width[BloomLevels];
+        UINT height[BloomLevels];
+        ID3D11ShaderResourceView* pDownSRV[BloomLevels];
+        ID3D11UnorderedAccessView* pDownUAV[BloomLevels];
+        ID3D11ShaderResourceView* pUpSRV[BloomLevels - 1];
+        ID3D11UnorderedAccessView* pUpUAV[BloomLevels - 1];
+        UploadAllocation downConstants[BloomLevels];
+        UploadAllocation upConstants[BloomLevels - 1];
+    };
+
+    struct PassFrameData
+    {
+        D3D11_VIEWPORT viewport;
+        ID3D11RenderTargetView* pSceneRTV;
+        ID3D11DepthStencilView* pDepthView;
+        PostPass postPasses[MaxPostPasses];
+        BloomChain bloom;
+        UploadAllocation skyboxConstants;
+        ID3D11DepthStencilState* pSkyboxDepthState;
+        ID3D11RasterizerState* pSkyboxRasterizerState;
+        UploadAllocation lightConstants;
+        UploadAllocation lightColorConstants[LightCount];
+        bool cubesMapped;
+        bool cubesGpuDriven;
+        ID3D11RasterizerState* pNoCullRasterizerState;
+        UploadAllocation parallelogramModels[SceneFrame::ParallelogramCount];
+        UploadAllocation parallelogramColors[SceneFrame::ParallelogramCount];
+    };
+
+    struct PassTiming
+    {
+        float cpuMs;
+        std::thread::id thread;
+    };
+
+    HRESULT InitDeferredRecording();
+    void TerminateDeferredRecording();
+    void RecordPasses(bool deferred);
+    void RecordPass(UINT pass, StateTracker& tracker, ID3D11DeviceContext* pContext);
+    void RecordSkybox(StateTracker& tracker, ID3D11DeviceContext* pContext);
+    void RecordCubes(StateTracker& tracker, ID3D11DeviceContext* pContext);
+    void RecordParallelogram(StateTracker& tracker, ID3D11DeviceContext* pContext);
+    void RecordPostPass(UINT index, StateTracker& tracker, ID3D11DeviceContext* pContext);
+    void RecordBloom(const PostPass& pass, StateTracker& tracker, ID3D11DeviceContext* pContext);
+    static void DispatchPost(StateTracker& tracker, ID3D11DeviceContext* pContext, ID3D11ComputeShader* pShader,
+        ID3D11ShaderResourceView* const* ppInputs, ID3D11UnorderedAccessView* pOutput, const UploadAllocation& constants,
+        UINT width, UINT height);
+    static void BindVSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation);
+    static void BindPSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation);
+    static void BindCSConstants(StateTracker& tracker, UINT slot, const UploadAllocation& allocation);
+
+    PassFrameData m_passData = {};
+    ID3D11DeviceContext* m_pDeferredContexts[RecordPassCount] = {};
+    ID3D11DeviceContext1* m_pDeferredContexts1[RecordPassCount] = {};
+    ID3D11CommandList* m_pCommandLists[RecordPassCount] = {};
+    StateTracker m_deferredTrackers[RecordPassCount];
+    PassTiming m_passTimings[RecordPassCount] = {};
+    bool m_deferredSupported = false;
+    bool m_driverCommandLists = false;
+    bool m_useDeferredRecording = false;
+    bool m_lastFrameDeferred = false;
+    float m_recordWallMs = 0.0f;
+
+    // Граф кадра: проходы объявляются в порядке RecordPass, так что номер прохода графа
+    // совпадает с RecordPass. Пересобирается при смене размера и цепочки постобработки.
+    // Цвет сцены и промежуточные цели постобработки одного описания граф сводит в две
+    // текстуры, между которыми цепочка ходит по очереди
+    HRESULT BuildFrameGraph();
+
+    RenderGraph m_frameGraph;
+    D3D11RenderGraphResources m_graphResources;
+    uint32_t m_frameGraphRevision = 0;
+};
 #endif
\ No newline at end of file
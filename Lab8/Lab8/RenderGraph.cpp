@@ -0,0 +1,244 @@
+#include "RenderGraph.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+void RenderGraph::Reset() {
+    m_passes.clear();
+    m_resources.clear();
+    m_versions.clear();
+    m_outputs.clear();
+    m_order.clear();
+    m_physical.clear();
+    m_invalid = false;
+    m_stats = Stats();
+}
+
+uint32_t RenderGraph::AddPass(const char* name) {
+    Pass pass;
+    pass.name = name;
+    pass.alive = false;
+    m_passes.push_back(pass);
+    return static_cast<uint32_t>(m_passes.size() - 1);
+}
+
+RenderGraph::Handle RenderGraph::CreateTexture(const char* name, const RenderGraphTextureDesc& desc) {
+    Resource resource;
+    resource.name = name;
+    resource.desc = desc;
+    resource.imported = false;
+    resource.latest = static_cast<Handle>(m_versions.size());
+    resource.physical = InvalidIndex;
+    resource.firstUse = InvalidIndex;
+    resource.lastUse = InvalidIndex;
+    m_resources.push_back(resource);
+
+    Version version = { static_cast<uint32_t>(m_resources.size() - 1), InvalidIndex, InvalidIndex };
+    m_versions.push_back(version);
+    return resource.latest;
+}
+
+RenderGraph::Handle RenderGraph::ImportTexture(const char* name) {
+    RenderGraphTextureDesc desc = {};
+    Handle handle = CreateTexture(name, desc);
+    m_resources.back().imported = true;
+    return handle;
+}
+
+void RenderGraph::Read(uint32_t pass, Handle handle) {
+    if (!IsValidPass(pass) || !IsValidHandle(handle)) {
+        m_invalid = true;
+        return;
+    }
+    m_passes[pass].reads.push_back(handle);
+}
+
+RenderGraph::Handle RenderGraph::Write(uint32_t pass, Handle handle) {
+    if (!IsValidPass(pass) || !IsValidHandle(handle) || m_resources[m_versions[handle].resource].latest != handle) {
+        m_invalid = true;
+        return InvalidIndex;
+    }
+
+    Version version = { m_versions[handle].resource, pass, handle };
+    m_versions.push_back(version);
+    Handle written = static_cast<Handle>(m_versions.size() - 1);
+    m_resources[version.resource].latest = written;
+    m_passes[pass].writes.push_back(written);
+    return written;
+}
+
+void RenderGraph::MarkOutput(Handle handle) {
+    if (!IsValidHandle(handle)) {
+        m_invalid = true;
+        return;
+    }
+    m_outputs.push_back(handle);
+}
+
+bool RenderGraph::Compile() {
+    m_order.clear();
+    m_physical.clear();
+    for (Pass& pass : m_passes)
+        pass.alive = false;
+    for (Resource& resource : m_resources) {
+        resource.physical = InvalidIndex;
+        resource.firstUse = InvalidIndex;
+        resource.lastUse = InvalidIndex;
+    }
+    m_stats = Stats();
+    m_stats.passes = static_cast<uint32_t>(m_passes.size());
+
+    if (m_invalid)
+        return false;
+
+    CullPasses();
+    if (!SortPasses()) {
+        m_order.clear();
+        return false;
+    }
+    ComputeLifetimes();
+    AssignPhysical();
+
+    for (const Pass& pass : m_passes) {
+        if (!pass.alive)
+            ++m_stats.culledPasses;
+    }
+    return true;
+}
+
+void RenderGraph::CullPasses() {
+    // Обход назад от выходов: проход нужен, если нужна записанная им версия.
+    // Перезаписанная без чтения предыдущая версия нужной не становится
+    std::vector<Handle> pending = m_outputs;
+    while (!pending.empty()) {
+        Handle handle = pending.back();
+        pending.pop_back();
+
+        uint32_t producer = m_versions[handle].producer;
+        if (producer == InvalidIndex || m_passes[producer].alive)
+            continue;
+        m_passes[producer].alive = true;
+        pending.insert(pending.end(), m_passes[producer].reads.begin(), m_passes[producer].reads.end());
+    }
+}
+
+bool RenderGraph::SortPasses() {
+    std::vector<std::vector<uint32_t>> readers(m_versions.size());
+    for (uint32_t i = 0; i < m_passes.size(); i++) {
+        if (!m_passes[i].alive)
+            continue;
+        for (Handle handle : m_passes[i].reads)
+            readers[handle].push_back(i);
+    }
+
+    // Рёбра: запись -> чтение той же версии, запись -> следующая запись,
+    // чтение -> запись следующей версии
+    std::vector<std::vector<uint32_t>> edges(m_passes.size());
+    std::vector<uint32_t> inDegree(m_passes.size(), 0);
+    uint32_t aliveCount = 0;
+    for (uint32_t i = 0; i < m_passes.size(); i++) {
+        const Pass& pass = m_passes[i];
+        if (!pass.alive)
+            continue;
+        ++aliveCount;
+
+        for (Handle handle : pass.reads) {
+            uint32_t producer = m_versions[handle].producer;
+            if (producer != InvalidIndex && producer != i) {
+                edges[producer].push_back(i);
+                ++inDegree[i];
+            }
+        }
+
+        for (Handle handle : pass.writes) {
+            Handle previous = m_versions[handle].previous;
+            uint32_t producer = m_versions[previous].producer;
+            if (producer != InvalidIndex && producer != i && m_passes[producer].alive) {
+                edges[producer].push_back(i);
+                ++inDegree[i];
+            }
+            for (uint32_t reader : readers[previous]) {
+                if (reader != i) {
+                    edges[reader].push_back(i);
+                    ++inDegree[i];
+                }
+            }
+        }
+    }
+
+    // Из готовых проходов первым идёт объявленный раньше: без зависимостей порядок не меняется
+    std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> ready;
+    for (uint32_t i = 0; i < m_passes.size(); i++) {
+        if (m_passes[i].alive && inDegree[i] == 0)
+            ready.push(i);
+    }
+
+    while (!ready.empty()) {
+        uint32_t pass = ready.top();
+        ready.pop();
+        m_order.push_back(pass);
+        for (uint32_t next : edges[pass]) {
+            if (--inDegree[next] == 0)
+                ready.push(next);
+        }
+    }
+    return m_order.size() == aliveCount;
+}
+
+void RenderGraph::ComputeLifetimes() {
+    for (uint32_t position = 0; position < m_order.size(); position++) {
+        const Pass& pass = m_passes[m_order[position]];
+        for (int access = 0; access < 2; access++) {
+            for (Handle handle : access == 0 ? pass.reads : pass.writes) {
+                Resource& resource = m_resources[m_versions[handle].resource];
+                if (resource.firstUse == InvalidIndex)
+                    resource.firstUse = position;
+                resource.lastUse = position;
+            }
+        }
+    }
+}
+
+void RenderGraph::AssignPhysical() {
+    std::vector<uint32_t> transients;
+    for (uint32_t i = 0; i < m_resources.size(); i++) {
+        if (!m_resources[i].imported && m_resources[i].firstUse != InvalidIndex)
+            transients.push_back(i);
+    }
+    std::stable_sort(transients.begin(), transients.end(), [this](uint32_t a, uint32_t b) {
+        return m_resources[a].firstUse < m_resources[b].firstUse;
+    });
+
+    // Жадно по началу жизни: слот свободен, если его последний пользователь исполнился раньше
+    for (uint32_t index : transients) {
+        Resource& resource = m_resources[index];
+        uint32_t slot = InvalidIndex;
+        for (uint32_t i = 0; i < m_physical.size(); i++) {
+            if (m_physical[i].lastUse < resource.firstUse && SameDesc(m_physical[i].desc, resource.desc)) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot == InvalidIndex) {
+            Physical physical = { resource.desc, resource.lastUse };
+            m_physical.push_back(physical);
+            slot = static_cast<uint32_t>(m_physical.size() - 1);
+            m_stats.allocatedBytes += GetTextureBytes(resource.desc);
+        }
+        m_physical[slot].lastUse = resource.lastUse;
+        resource.physical = slot;
+        m_stats.requestedBytes += GetTextureBytes(resource.desc);
+    }
+
+    m_stats.transientTextures = static_cast<uint32_t>(transients.size());
+    m_stats.physicalTextures = static_cast<uint32_t>(m_physical.size());
+}
+
+uint64_t RenderGraph::GetTextureBytes(const RenderGraphTextureDesc& desc) {
+    return static_cast<uint64_t>(desc.width) * desc.height * desc.bytesPerPixel;
+}
+
+bool RenderGraph::SameDesc(const RenderGraphTextureDesc& a, const RenderGraphTextureDesc& b) {
+    return a.width == b.width && a.height == b.height && a.format == b.format &&
+        a.bindFlags == b.bindFlags && a.bytesPerPixel == b.bytesPerPixel;
+}
@@ -0,0 +1,130 @@
+#ifndef RENDER_GRAPH_H
+#define RENDER_GRAPH_H
+
+#include <cstdint>
+#include <vector>
+
+// Описание временной текстуры графа. format и bindFlags - значения DXGI_FORMAT и D3D11_BIND_*,
+// граф их только сравнивает. Не зависит от D3D11.
+struct RenderGraphTextureDesc
+{
+    uint32_t width;
+    uint32_t height;
+    uint32_t format;
+    uint32_t bindFlags;
+    uint32_t bytesPerPixel;
+};
+
+// Граф кадра: проходы объявляют, какие версии ресурсов читают и пишут.
+// Write возвращает новую версию ресурса; запись без чтения перезаписывает его целиком.
+// Compile сортирует проходы топологически, отбрасывает проходы, чьи версии не нужны
+// выходам графа, и по времени жизни раздаёт временным текстурам физические слоты:
+// текстуры с одинаковым описанием и непересекающимся временем жизни делят один слот.
+class RenderGraph
+{
+public:
+    typedef uint32_t Handle;
+    static const uint32_t InvalidIndex = ~0u;
+
+    struct Stats
+    {
+        uint32_t passes;
+        uint32_t culledPasses;
+        uint32_t transientTextures;
+        uint32_t physicalTextures;
+        uint64_t requestedBytes;
+        uint64_t allocatedBytes;
+    };
+
+    RenderGraph() :
+        m_invalid(false),
+        m_stats()
+    {
+    }
+
+    void Reset();
+
+    uint32_t AddPass(const char* name);
+    Handle CreateTexture(const char* name, const RenderGraphTextureDesc& desc);
+    // Внешний ресурс (цепочка обмена): время жизни и память графу не принадлежат
+    Handle ImportTexture(const char* name);
+    void Read(uint32_t pass, Handle handle);
+    // Писать можно только в последнюю версию ресурса
+    Handle Write(uint32_t pass, Handle handle);
+    void MarkOutput(Handle handle);
+
+    // false - ошибка объявления или цикл; порядок исполнения тогда пуст
+    bool Compile();
+
+    const std::vector<uint32_t>& GetOrder() const { return m_order; }
+    uint32_t GetPassCount() const { return static_cast<uint32_t>(m_passes.size()); }
+    const char* GetPassName(uint32_t pass) const { return m_passes[pass].name; }
+    bool IsCulled(uint32_t pass) const { return !m_passes[pass].alive; }
+
+    uint32_t GetResourceCount() const { return static_cast<uint32_t>(m_resources.size()); }
+    uint32_t GetResource(Handle handle) const { return m_versions[handle].resource; }
+    const char* GetResourceName(uint32_t resource) const { return m_resources[resource].name; }
+    // InvalidIndex - внешний ресурс или текстура, которой не пользуется ни один проход
+    uint32_t GetPhysical(uint32_t resource) const { return m_resources[resource].physical; }
+    // Позиции первого и последнего прохода в порядке исполнения
+    uint32_t GetFirstUse(uint32_t resource) const { return m_resources[resource].firstUse; }
+    uint32_t GetLastUse(uint32_t resource) const { return m_resources[resource].lastUse; }
+
+    uint32_t GetPhysicalCount() const { return static_cast<uint32_t>(m_physical.size()); }
+    const RenderGraphTextureDesc& GetPhysicalDesc(uint32_t physical) const { return m_physical[physical].desc; }
+
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Pass
+    {
+        const char* name;
+        std::vector<Handle> reads;
+        std::vector<Handle> writes;
+        bool alive;
+    };
+
+    struct Resource
+    {
+        const char* name;
+        RenderGraphTextureDesc desc;
+        bool imported;
+        Handle latest;
+        uint32_t physical;
+        uint32_t firstUse;
+        uint32_t lastUse;
+    };
+
+    struct Version
+    {
+        uint32_t resource;
+        uint32_t producer;
+        Handle previous;
+    };
+
+    struct Physical
+    {
+        RenderGraphTextureDesc desc;
+        uint32_t lastUse;
+    };
+
+    bool IsValidPass(uint32_t pass) const { return pass < m_passes.size(); }
+    bool IsValidHandle(Handle handle) const { return handle < m_versions.size(); }
+    void CullPasses();
+    bool SortPasses();
+    void ComputeLifetimes();
+    void AssignPhysical();
+    static uint64_t GetTextureBytes(const RenderGraphTextureDesc& desc);
+    static bool SameDesc(const RenderGraphTextureDesc& a, const RenderGraphTextureDesc& b);
+
+    std::vector<Pass> m_passes;
+    std::vector<Resource> m_resources;
+    std::vector<Version> m_versions;
+    std::vector<Handle> m_outputs;
+    std::vector<uint32_t> m_order;
+    std::vector<Physical> m_physical;
+    bool m_invalid;
+    Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,197 @@
+#include "SceneFrame.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const float Pi2 = 6.283185307f;
+}
+
+SceneFrame::SceneFrame() :
+    m_scale(0.5f),
+    m_radius(0.0f)
+{
+}
+
+void SceneFrame::Generate(uint32_t count, uint32_t materialCount) {
+    // Первые два кольца совпадают с исходной сценой, дальше радиус растёт с тем же шагом,
+    // а число кубов пропорционально длине окружности
+    const int innerCount = 10;
+    const int outerCount = 12;
+    const float innerRadius = 4.0f;
+    const float outerRadius = 9.5f;
+    const float ringStep = outerRadius - innerRadius;
+    const float ringSpacing = 2.0f;
+    if (materialCount == 0)
+        materialCount = 1;
+
+    SceneInstance instance = {};
+    instance.countInstance = count;
+    instance.model[0] = instance.model[5] = instance.model[10] = m_scale;
+    instance.model[15] = 1.0f;
+
+    m_instances.clear();
+    m_instances.reserve(count);
+    m_radius = 0.0f;
+    if (count > 0)
+        m_instances.push_back(instance);
+
+    for (int ring = 0; m_instances.size() < count; ++ring) {
+        float radius = innerRadius + ringStep * ring;
+        int ringCount = outerCount;
+        if (ring == 0)
+            ringCount = innerCount;
+        else if (ring > 1 && Pi2 * radius / ringSpacing > outerCount)
+            ringCount = static_cast<int>(Pi2 * radius / ringSpacing);
+
+        for (int i = 0; i < ringCount && m_instances.size() < count; ++i) {
+            float angle = Pi2 * i / ringCount;
+            instance.model[12] = radius * cosf(angle);
+            instance.model[14] = radius * sinf(angle);
+            instance.texInd = i % materialCount;
+            m_instances.push_back(instance);
+        }
+        m_radius = radius;
+    }
+
+    // Кубы только вращаются на месте, поэтому их AABB для отсечения задаются один раз
+    const float extent = m_scale * 0.95f;
+    m_culler.Resize(m_instances.size());
+    for (size_t i = 0; i < m_instances.size(); ++i)
+        m_culler.SetBox(i, m_instances[i].model[12], m_instances[i].model[13], m_instances[i].model[14], extent, extent, extent);
+}
+
+void SceneFrame::Clear() {
+    m_instances.clear();
+    m_chunkVisible.clear();
+    m_culler.Resize(0);
+    m_radius = 0.0f;
+}
+
+size_t SceneFrame::Update(JobSystem& jobs, float cubeAngle, SceneInstance* pGpuInstances, bool cull, std::vector<uint32_t>& visibleIds) {
+    // Поворот у всех кубов общий, отличается только перенос
+    const float c = cosf(cubeAngle);
+    const float s = sinf(cubeAngle);
+    const float scaleRotation[12] = {
+        m_scale * c, 0.0f, -m_scale * s, 0.0f,
+        0.0f, m_scale, 0.0f, 0.0f,
+        m_scale * s, 0.0f, m_scale * c, 0.0f
+    };
+
+    if (cull)
+        visibleIds.resize(m_instances.size());
+
+    // Пересборка матриц и отсечение идут кусками по всем ядрам; каждый кусок пишет
+    // видимые индексы в свой участок visibleIds, начиная с первого своего элемента
+    const uint32_t count = static_cast<uint32_t>(m_instances.size());
+    const size_t chunkSize = JobSystem::AlignChunk(JobSystem::AlignChunk(InstanceChunkSize, sizeof(float)), sizeof(SceneInstance));
+    m_chunkVisible.resize(JobSystem::GetChunkCount(m_instances.size(), chunkSize));
+    jobs.ParallelFor(m_instances.size(), chunkSize, [&](size_t begin, size_t end, size_t chunk) {
+        for (size_t i = begin; i < end; ++i) {
+            float* model = m_instances[i].model;
+            memcpy(model, scaleRotation, sizeof(scaleRotation));
+
+            if (pGpuInstances) {
+                Transpose(model, pGpuInstances[i].model);
+                pGpuInstances[i].texInd = m_instances[i].texInd;
+                pGpuInstances[i].countInstance = count;
+            }
+        }
+
+        if (cull)
+            m_chunkVisible[chunk] = m_culler.Cull(visibleIds.data() + begin, begin, end);
+    });
+
+    if (!cull)
+        return 0;
+
+    // Склейка в порядке кусков: список совпадает с однопоточным при любом числе потоков
+    size_t visible = 0;
+    for (size_t chunk = 0; chunk < m_chunkVisible.size(); ++chunk) {
+        size_t begin = chunk * chunkSize;
+        if (visible != begin && m_chunkVisible[chunk] > 0)
+            memmove(visibleIds.data() + visible, visibleIds.data() + begin, sizeof(uint32_t) * m_chunkVisible[chunk]);
+        visible += m_chunkVisible[chunk];
+    }
+    visibleIds.resize(visible);
+    return visible;
+}
+
+void SceneFrame::Gather(const uint32_t* pIds, size_t count, SceneInstance* pModels) const {
+    for (size_t i = 0; i < count; ++i) {
+        const SceneInstance& instance = m_instances[pIds[i]];
+        Transpose(instance.model, pModels[i].model);
+        pModels[i].texInd = instance.texInd;
+    }
+}
+
+void SceneFrame::BuildLights(float lightOrbit, ScenePointLight lights[LightCount]) {
+    const ScenePointLight source[LightCount] = {
+        { { 0.0f, 2.0f * cosf(lightOrbit), 2.0f * sinf(-lightOrbit) }, 3.0f, { 1.0f, 1.0f, 1.0f }, 1.0f },
+        { { 2.0f * cosf(lightOrbit), 0.0f, 2.0f * sinf(lightOrbit) }, 3.0f, { 1.0f, 1.0f, 0.13f }, 1.0f },
+        { { 8.0f * cosf(lightOrbit), 0.0f, 8.0f * sinf(-lightOrbit) }, 5.0f, { 1.0f, 1.0f, 1.0f }, 1.0f }
+    };
+    memcpy(lights, source, sizeof(source));
+}
+
+void SceneFrame::BuildLightModel(const ScenePointLight& light, SceneInstance& model) {
+    memset(&model, 0, sizeof(model));
+    model.model[0] = model.model[5] = model.model[10] = 0.1f;
+    model.model[3] = light.position[0];
+    model.model[7] = light.position[1];
+    model.model[11] = light.position[2];
+    model.model[15] = 1.0f;
+}
+
+void SceneFrame::BuildParallelograms(float time, const float eye[3], SceneParallelogram parallelograms[ParallelogramCount]) {
+    const float positions[ParallelogramCount][3] = {
+        { sinf(time) * 2.5f, 0.8f, -3.0f },
+        { -cosf(time) * 2.5f, 0.8f, -2.0f }
+    };
+    const float colors[ParallelogramCount][4] = { { 0.0f, 0.5f, 0.5f, 0.5f }, { 0.5f, 0.0f, 0.5f, 0.5f } };
+
+    float distances[ParallelogramCount];
+    for (uint32_t i = 0; i < ParallelogramCount; ++i) {
+        float dx = positions[i][0] - eye[0];
+        float dy = positions[i][1] - eye[1];
+        float dz = positions[i][2] - eye[2];
+        distances[i] = sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Прозрачные - от дальнего к ближнему; при равенстве первый остаётся первым
+    const uint32_t order = distances[0] >= distances[1] ? 0 : 1;
+    for (uint32_t i = 0; i < ParallelogramCount; ++i) {
+        const uint32_t index = i == 0 ? order : 1 - order;
+        SceneParallelogram& target = parallelograms[i];
+        memset(target.model, 0, sizeof(target.model));
+        target.model[0] = target.model[5] = target.model[10] = target.model[15] = 1.0f;
+        target.model[3] = positions[index][0];
+        target.model[7] = positions[index][1];
+        target.model[11] = positions[index][2];
+        memcpy(target.color, colors[index], sizeof(target.color));
+    }
+}
+
+void SceneFrame::ExtractFrustumPlanes(const float m[16], float planes[6][4]) {
+    for (int i = 0; i < 4; ++i) {
+        float column3 = m[i * 4 + 3];
+        planes[0][i] = column3 + m[i * 4 + 0];
+        planes[1][i] = column3 - m[i * 4 + 0];
+        planes[2][i] = column3 + m[i * 4 + 1];
+        planes[3][i] = column3 - m[i * 4 + 1];
+        planes[4][i] = m[i * 4 + 2];
+        planes[5][i] = column3 - m[i * 4 + 2];
+    }
+    for (int p = 0; p < 6; ++p) {
+        float length = sqrtf(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1] + planes[p][2] * planes[p][2]);
+        for (int i = 0; i < 4 && length > 0.0f; ++i)
+            planes[p][i] /= length;
+    }
+}
+
+void SceneFrame::Transpose(const float in[16], float out[16]) {
+    for (int r = 0; r < 4; ++r) {
+        for (int c = 0; c < 4; ++c)
+            out[c * 4 + r] = in[r * 4 + c];
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef SCENE_FRAME_H
+#define SCENE_FRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+
+// Раскладка экземпляра в структурированных буферах: матрица по строкам, на GPU уходит транспонированной
+struct SceneInstance
+{
+    float model[16];
+    uint32_t texInd;
+    uint32_t countInstance;
+    float padding[2];
+};
+
+// Раскладка точечного источника в константном буфере света
+struct ScenePointLight
+{
+    float position[3];
+    float range;
+    float color[3];
+    float intensity;
+};
+
+// Прозрачный параллелограмм, готовый к загрузке: матрица уже транспонирована
+struct SceneParallelogram
+{
+    float model[16];
+    float color[4];
+};
+
+// CPU-часть кадра над сценой из кубов: генерация колец, пересборка матриц с отсечением,
+// сборка видимых экземпляров, свет и сортировка прозрачных параллелограммов.
+// Общая для RenderClass и замера кадра без окна, поэтому не зависит от Win32, D3D11 и DirectXMath.
+class SceneFrame
+{
+public:
+    static const uint32_t LightCount = 3;
+    static const uint32_t ParallelogramCount = 2;
+    static const size_t InstanceChunkSize = 4096;
+
+    SceneFrame();
+
+    // Центральный куб и кольца вокруг него; материалы чередуются по кругу
+    void Generate(uint32_t count, uint32_t materialCount);
+    void Clear();
+
+    // Поворачивает все кубы на угол и, если pGpuInstances != nullptr, сразу пишет их туда
+    // транспонированными. При cull отсекает по плоскостям GetCuller() и оставляет в visibleIds
+    // видимые индексы в порядке возрастания; возвращает их число
+    size_t Update(JobSystem& jobs, float cubeAngle, SceneInstance* pGpuInstances, bool cull, std::vector<uint32_t>& visibleIds);
+
+    // Видимые экземпляры подряд, транспонированными
+    void Gather(const uint32_t* pIds, size_t count, SceneInstance* pModels) const;
+
+    static void BuildLights(float lightOrbit, ScenePointLight lights[LightCount]);
+    // Маркер источника: маленький куб в его позиции, транспонированный
+    static void BuildLightModel(const ScenePointLight& light, SceneInstance& model);
+    // От дальнего к ближнему, как их нужно рисовать
+    static void BuildParallelograms(float time, const float eye[3], SceneParallelogram parallelograms[ParallelogramCount]);
+
+    // Нормализованные плоскости матрицы вида-проекции (по строкам): лево, право, низ, верх, ближняя, дальняя
+    static void ExtractFrustumPlanes(const float viewProj[16], float planes[6][4]);
+    static void Transpose(const float in[16], float out[16]);
+
+    uint32_t GetCount() const { return static_cast<uint32_t>(m_instances.size()); }
+    const SceneInstance& GetInstance(size_t index) const { return m_instances[index]; }
+    float GetScale() const { return m_scale; }
+    float GetRadius() const { return m_radius; }
+    FrustumCuller& GetCuller() { return m_culler; }
+    const FrustumCuller& GetCuller() const { return m_culler; }
+
+private:
+    std::vector<SceneInstance> m_instances;
+    std::vector<size_t> m_chunkVisible;
+    FrustumCuller m_culler;
+    float m_scale;
+    float m_radius;
+};
+
+#endif
@@ -0,0 +1,160 @@
+#include "framework.h"
+#include "ShaderBenchmark.h"
+#include "ShaderCache.h"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+    // Все шейдеры, которые создаёт RenderClass при запуске
+    const wchar_t* const ShaderFiles[] =
+    {
+        L"ColorVertex.vs",
+        L"ColorPixel.ps",
+        L"LightPixel.ps",
+        L"ComputeShader.cs",
+        L"PostFused.cs",
+        L"Fxaa.cs",
+        L"BloomDownsample.cs",
+        L"BloomUpsample.cs",
+        L"SkyboxVertex.vs",
+        L"SkyboxPixel.ps",
+        L"ParallelogramVertex.vs",
+        L"ParallelogramPixel.ps"
+    };
+
+    const uint32_t ShaderFileCount = sizeof(ShaderFiles) / sizeof(ShaderFiles[0]);
+
+    enum class LoadMode
+    {
+        Cache,
+        Precompiled
+    };
+
+    HRESULT CreateShader(ID3D11Device* pDevice, const char* target, const ShaderBytecode& bytecode) {
+        HRESULT hr = E_INVALIDARG;
+        if (target[0] == 'v') {
+            ID3D11VertexShader* pShader = nullptr;
+            hr = pDevice->CreateVertexShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+            if (pShader)
+                pShader->Release();
+        }
+        else if (target[0] == 'p') {
+            ID3D11PixelShader* pShader = nullptr;
+            hr = pDevice->CreatePixelShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+            if (pShader)
+                pShader->Release();
+        }
+        else if (target[0] == 'c') {
+            ID3D11ComputeShader* pShader = nullptr;
+            hr = pDevice->CreateComputeShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+            if (pShader)
+                pShader->Release();
+        }
+        return hr;
+    }
+
+    // Один "запуск": новый экземпляр кэша, как при старте приложения
+    HRESULT LoadAll(ID3D11Device* pDevice, const std::wstring& directory, LoadMode mode) {
+        ShaderCache cache;
+        cache.Init(directory);
+        for (uint32_t i = 0; i < ShaderFileCount; ++i) {
+            const char* target = ShaderCache::GetTargetForPath(ShaderFiles[i]);
+            ShaderBytecode bytecode;
+            HRESULT hr = mode == LoadMode::Precompiled ?
+                cache.LoadPrecompiled(ShaderFiles[i], "main", target, bytecode) :
+                cache.Load(ShaderFiles[i], "main", target, ShaderCache::GetDefaultFlags(), nullptr, bytecode);
+            if (SUCCEEDED(hr))
+                hr = CreateShader(pDevice, target, bytecode);
+            if (FAILED(hr))
+                return hr;
+        }
+        return S_OK;
+    }
+
+    void ClearDirectory(const std::wstring& directory) {
+        WIN32_FIND_DATAW data;
+        HANDLE hFind = FindFirstFileW((directory + L"\\*.cso").c_str(), &data);
+        if (hFind == INVALID_HANDLE_VALUE)
+            return;
+        do {
+            DeleteFileW((directory + L"\\" + data.cFileName).c_str());
+        } while (FindNextFileW(hFind, &data));
+        FindClose(hFind);
+    }
+
+    bool Measure(ID3D11Device* pDevice, const std::wstring& directory, LoadMode mode, bool clearFirst, uint32_t iterations,
+        const char* name, std::vector<ShaderBenchmarkResult>& results)
+    {
+        ShaderBenchmarkResult result = {};
+        result.mode = name;
+        result.shaderCount = ShaderFileCount;
+        result.minMs = 1e30;
+        for (uint32_t i = 0; i < iterations; ++i) {
+            if (clearFirst)
+                ClearDirectory(directory);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            HRESULT hr = LoadAll(pDevice, directory, mode);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            if (FAILED(hr))
+                return false;
+
+            result.totalMs += ms;
+            result.minMs = ms < result.minMs ? ms : result.minMs;
+            result.maxMs = ms > result.maxMs ? ms : result.maxMs;
+        }
+        result.totalMs /= iterations;
+        results.push_back(result);
+        return true;
+    }
+}
+
+bool PrecompileShaders(const std::wstring& cacheDirectory) {
+    ShaderCache cache;
+    cache.Init(cacheDirectory);
+    for (uint32_t i = 0; i < ShaderFileCount; ++i) {
+        ShaderBytecode bytecode;
+        std::string errors;
+        HRESULT hr = cache.Compile(ShaderFiles[i], "main", ShaderCache::GetTargetForPath(ShaderFiles[i]),
+            ShaderCache::GetDefaultFlags(), nullptr, bytecode, &errors);
+        if (FAILED(hr))
+            return false;
+    }
+    return true;
+}
+
+bool RunShaderBenchmark(uint32_t iterations, std::vector<ShaderBenchmarkResult>& results) {
+    results.clear();
+    if (iterations == 0)
+        return false;
+
+    ID3D11Device* pDevice = nullptr;
+    D3D_FEATURE_LEVEL level = D3D_FEATURE_LEVEL_11_0;
+    HRESULT hr = D3D11CreateDevice(nullptr, D3D_DRIVER_TYPE_HARDWARE, nullptr, 0, &level, 1, D3D11_SDK_VERSION,
+        &pDevice, nullptr, nullptr);
+    if (FAILED(hr))
+        return false;
+
+    const std::wstring directory = L"ShaderCacheBench";
+    bool ok = Measure(pDevice, directory, LoadMode::Cache, true, iterations, "cold", results);
+    // Последний холодный проход оставил заполненный кэш и готовые .cso
+    ok = ok && Measure(pDevice, directory, LoadMode::Cache, false, iterations, "warm", results);
+    ok = ok && Measure(pDevice, directory, LoadMode::Precompiled, false, iterations, "precompiled", results);
+
+    pDevice->Release();
+    return ok;
+}
+
+bool WriteShaderBenchmarkCsv(const char* path, const std::vector<ShaderBenchmarkResult>& results) {
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "mode,shaders,avg_ms,min_ms,max_ms\n";
+    file << std::fixed << std::setprecision(4);
+    for (const ShaderBenchmarkResult& result : results)
+        file << result.mode << ',' << result.shaderCount << ',' << result.totalMs << ',' << result.minMs << ',' << result.maxMs << '\n';
+    return static_cast<bool>(file);
+}
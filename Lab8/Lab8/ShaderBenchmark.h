@@ -0,0 +1,25 @@
+#ifndef SHADER_BENCHMARK_H
+#define SHADER_BENCHMARK_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Замер запуска: создание всех шейдеров приложения на устройстве без окна
+// с пустым кэшем (cold), с заполненным кэшем (warm) и только из готовых .cso (precompiled).
+struct ShaderBenchmarkResult
+{
+    const char* mode;
+    uint32_t shaderCount;
+    double totalMs;
+    double minMs;
+    double maxMs;
+};
+
+// Офлайн-компиляция всех шейдеров в каталог кэша: Lab8.exe precompileshaders
+bool PrecompileShaders(const std::wstring& cacheDirectory);
+
+bool RunShaderBenchmark(uint32_t iterations, std::vector<ShaderBenchmarkResult>& results);
+bool WriteShaderBenchmarkCsv(const char* path, const std::vector<ShaderBenchmarkResult>& results);
+
+#endif
@@ -0,0 +1,449 @@
+#include "framework.h"
+#include "ShaderCache.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    const uint32_t CacheMagic = 0x3143534C; // "LSC1"
+    const uint32_t CacheFormatVersion = 1;
+
+    // Заголовок записи кэша; за ним идут записи включаемых файлов и байт-код
+    struct CacheHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t key;
+        uint32_t includeCount;
+        uint32_t bytecodeOffset;
+        uint32_t bytecodeSize;
+        uint32_t reserved;
+    };
+
+    struct IncludeHeader
+    {
+        uint64_t hash;
+        uint32_t pathLength;
+        uint32_t reserved;
+    };
+
+    bool ReadFileBytes(const std::wstring& path, std::vector<uint8_t>& data) {
+        std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        std::streamoff size = file.tellg();
+        if (size < 0)
+            return false;
+        data.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        if (size > 0)
+            file.read(reinterpret_cast<char*>(data.data()), size);
+        return static_cast<bool>(file);
+    }
+
+    std::wstring Directory(const std::wstring& path) {
+        size_t pos = path.find_last_of(L"\\/");
+        return pos == std::wstring::npos ? std::wstring() : path.substr(0, pos + 1);
+    }
+
+    std::wstring FileName(const std::wstring& path) {
+        size_t pos = path.find_last_of(L"\\/");
+        return pos == std::wstring::npos ? path : path.substr(pos + 1);
+    }
+
+    std::wstring Widen(const char* text) {
+        std::wstring result;
+        for (; text && *text; ++text)
+            result += static_cast<wchar_t>(static_cast<unsigned char>(*text));
+        return result;
+    }
+
+    std::string Narrow(const std::wstring& text) {
+        int length = WideCharToMultiByte(CP_UTF8, 0, text.c_str(), -1, nullptr, 0, nullptr, nullptr);
+        if (length <= 1)
+            return std::string();
+        std::string result(static_cast<size_t>(length), '\0');
+        WideCharToMultiByte(CP_UTF8, 0, text.c_str(), -1, &result[0], length, nullptr, nullptr);
+        result.resize(static_cast<size_t>(length - 1));
+        return result;
+    }
+
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Запись во временный файл и атомарная замена, чтобы параллельный запуск не увидел половину файла
+    bool WriteFileAtomic(const std::wstring& path, const std::vector<uint8_t>& data) {
+        std::wstring tempPath = path + L".tmp";
+        {
+            std::ofstream file(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file)
+                return false;
+        }
+        if (!MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+            DeleteFileW(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void Append(std::vector<uint8_t>& data, const T& value) {
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&value);
+        data.insert(data.end(), pBytes, pBytes + sizeof(T));
+    }
+
+    // #include относительно каталога шейдера; каждый открытый файл запоминается вместе с хешем
+    class RecordingInclude : public ID3DInclude
+    {
+    public:
+        explicit RecordingInclude(const std::wstring& directory) :
+            m_directory(directory)
+        {
+        }
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR pFileName, LPCVOID, LPCVOID* ppData, UINT* pBytes) override {
+            std::wstring path = m_directory + Widen(pFileName);
+            std::vector<uint8_t>* pData = new std::vector<uint8_t>();
+            if (!ReadFileBytes(path, *pData)) {
+                delete pData;
+                return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+            }
+
+            Record record = { path, ShaderCache::HashBytes(pData->data(), pData->size()) };
+            m_records.push_back(record);
+            m_open.push_back(pData);
+
+            *ppData = pData->data();
+            *pBytes = static_cast<UINT>(pData->size());
+            return S_OK;
+        }
+
+        HRESULT __stdcall Close(LPCVOID pData) override {
+            for (size_t i = 0; i < m_open.size(); ++i) {
+                if (m_open[i]->data() == pData) {
+                    delete m_open[i];
+                    m_open.erase(m_open.begin() + i);
+                    break;
+                }
+            }
+            return S_OK;
+        }
+
+        ~RecordingInclude() {
+            for (std::vector<uint8_t>* pData : m_open)
+                delete pData;
+        }
+
+        struct Record
+        {
+            std::wstring path;
+            uint64_t hash;
+        };
+
+        const std::vector<Record>& GetRecords() const { return m_records; }
+
+    private:
+        std::wstring m_directory;
+        std::vector<Record> m_records;
+        std::vector<std::vector<uint8_t>*> m_open;
+    };
+}
+
+const void* ShaderBytecode::GetData() const {
+    if (m_pBlob)
+        return m_pBlob->GetBufferPointer();
+    if (m_file.IsOpen())
+        return m_file.GetData() + m_offset;
+    return nullptr;
+}
+
+HRESULT ShaderBytecode::CopyToBlob(ID3DBlob** ppBlob) const {
+    if (!ppBlob)
+        return E_INVALIDARG;
+    *ppBlob = nullptr;
+    if (IsEmpty())
+        return E_FAIL;
+
+    if (m_pBlob) {
+        m_pBlob->AddRef();
+        *ppBlob = m_pBlob;
+        return S_OK;
+    }
+
+    HRESULT hr = D3DCreateBlob(m_size, ppBlob);
+    if (SUCCEEDED(hr))
+        memcpy((*ppBlob)->GetBufferPointer(), GetData(), m_size);
+    return hr;
+}
+
+void ShaderBytecode::Reset() {
+    if (m_pBlob) {
+        m_pBlob->Release();
+        m_pBlob = nullptr;
+    }
+    m_file.Close();
+    m_offset = 0;
+    m_size = 0;
+}
+
+ShaderCache::ShaderCache() {
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+void ShaderCache::Init(const std::wstring& cacheDirectory) {
+    m_directory = cacheDirectory;
+    if (!m_directory.empty() && m_directory.back() != L'\\' && m_directory.back() != L'/')
+        m_directory += L'\\';
+    CreateDirectoryW(m_directory.c_str(), nullptr);
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+uint64_t ShaderCache::HashBytes(const void* pData, size_t size, uint64_t hash) {
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= pBytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const char* ShaderCache::GetTargetForPath(const std::wstring& path) {
+    size_t pos = path.find_last_of(L'.');
+    std::wstring extension = pos == std::wstring::npos ? std::wstring() : path.substr(pos + 1);
+    if (extension == L"vs")
+        return "vs_5_0";
+    if (extension == L"ps")
+        return "ps_5_0";
+    if (extension == L"cs")
+        return "cs_5_0";
+    return nullptr;
+}
+
+UINT ShaderCache::GetDefaultFlags() {
+    UINT flags = 0;
+#ifdef _DEBUG
+    flags |= D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
+#endif
+    return flags;
+}
+
+uint64_t ShaderCache::ComputeKey(const std::vector<uint8_t>& source, const char* entry, const char* target, UINT flags,
+    const D3D_SHADER_MACRO* pDefines) const
+{
+    const uint32_t version[2] = { CacheFormatVersion, D3D_COMPILER_VERSION };
+    uint64_t hash = HashBytes(version, sizeof(version));
+    hash = HashBytes(source.data(), source.size(), hash);
+    // Нулевой байт после каждой строки разделяет поля: "ab"+"c" != "a"+"bc"
+    hash = HashBytes(entry, strlen(entry) + 1, hash);
+    hash = HashBytes(target, strlen(target) + 1, hash);
+    hash = HashBytes(&flags, sizeof(flags), hash);
+    for (const D3D_SHADER_MACRO* pMacro = pDefines; pMacro && pMacro->Name; ++pMacro) {
+        hash = HashBytes(pMacro->Name, strlen(pMacro->Name) + 1, hash);
+        const char* definition = pMacro->Definition ? pMacro->Definition : "";
+        hash = HashBytes(definition, strlen(definition) + 1, hash);
+    }
+    return hash;
+}
+
+std::wstring ShaderCache::GetEntryPath(uint64_t key) const {
+    wchar_t name[32];
+    swprintf_s(name, L"%016llx.cso", static_cast<unsigned long long>(key));
+    return m_directory + name;
+}
+
+std::wstring ShaderCache::GetPrecompiledPath(const std::wstring& path, const char* entry, const char* target) const {
+    return m_directory + FileName(path) + L"." + Widen(entry) + L"." + Widen(target) + L".cso";
+}
+
+bool ShaderCache::TryLoadEntry(uint64_t key, ShaderBytecode& bytecode) {
+    bytecode.Reset();
+    if (!bytecode.m_file.Open(GetEntryPath(key)))
+        return false;
+
+    const uint8_t* pData = bytecode.m_file.GetData();
+    size_t size = bytecode.m_file.GetSize();
+    CacheHeader header;
+    if (size < sizeof(header)) {
+        bytecode.Reset();
+        return false;
+    }
+    memcpy(&header, pData, sizeof(header));
+    if (header.magic != CacheMagic || header.version != CacheFormatVersion || header.key != key ||
+        header.bytecodeSize == 0 || static_cast<size_t>(header.bytecodeOffset) + header.bytecodeSize > size) {
+        bytecode.Reset();
+        return false;
+    }
+
+    // Ключ покрывает только сам исходник - включаемые файлы сверяем по сохранённым хешам
+    size_t offset = sizeof(header);
+    std::vector<uint8_t> includeData;
+    for (uint32_t i = 0; i < header.includeCount; ++i) {
+        IncludeHeader include;
+        if (offset + sizeof(include) > header.bytecodeOffset) {
+            bytecode.Reset();
+            return false;
+        }
+        memcpy(&include, pData + offset, sizeof(include));
+        offset += sizeof(include);
+
+        size_t pathBytes = include.pathLength * sizeof(wchar_t);
+        if (offset + pathBytes > header.bytecodeOffset) {
+            bytecode.Reset();
+            return false;
+        }
+        std::wstring includePath(include.pathLength, L'\0');
+        memcpy(&includePath[0], pData + offset, pathBytes);
+        offset += pathBytes;
+
+        if (!ReadFileBytes(includePath, includeData) || HashBytes(includeData.data(), includeData.size()) != include.hash) {
+            bytecode.Reset();
+            return false;
+        }
+    }
+
+    bytecode.m_offset = header.bytecodeOffset;
+    bytecode.m_size = header.bytecodeSize;
+    return true;
+}
+
+void ShaderCache::WriteEntry(uint64_t key, const std::vector<IncludeRecord>& includes, const void* pBytecode, size_t size,
+    const std::wstring& precompiledPath) const
+{
+    std::vector<uint8_t> data;
+    data.resize(sizeof(CacheHeader));
+    for (const IncludeRecord& record : includes) {
+        IncludeHeader include = {};
+        include.hash = record.hash;
+        include.pathLength = static_cast<uint32_t>(record.path.size());
+        Append(data, include);
+        const uint8_t* pPath = reinterpret_cast<const uint8_t*>(record.path.data());
+        data.insert(data.end(), pPath, pPath + record.path.size() * sizeof(wchar_t));
+    }
+    // Байт-код выравниваем на 16 байт от начала отображения
+    data.resize((data.size() + 15) & ~static_cast<size_t>(15));
+
+    CacheHeader header = {};
+    header.magic = CacheMagic;
+    header.version = CacheFormatVersion;
+    header.key = key;
+    header.includeCount = static_cast<uint32_t>(includes.size());
+    header.bytecodeOffset = static_cast<uint32_t>(data.size());
+    header.bytecodeSize = static_cast<uint32_t>(size);
+    memcpy(data.data(), &header, sizeof(header));
+
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pBytecode);
+    data.insert(data.end(), pBytes, pBytes + size);
+    WriteFileAtomic(GetEntryPath(key), data);
+
+    std::vector<uint8_t> raw(pBytes, pBytes + size);
+    WriteFileAtomic(precompiledPath, raw);
+}
+
+HRESULT ShaderCache::CompileSource(const std::wstring& path, const std::vector<uint8_t>& source, uint64_t key, const char* entry,
+    const char* target, UINT flags, const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    RecordingInclude include(Directory(path));
+    std::string sourceName = Narrow(path);
+    ID3DBlob* pCode = nullptr;
+    ID3DBlob* pErr = nullptr;
+    HRESULT hr = D3DCompile(source.data(), source.size(), sourceName.c_str(), pDefines, &include, entry, target, flags, 0, &pCode, &pErr);
+    if (pErr) {
+        if (pErrors)
+            pErrors->assign(static_cast<const char*>(pErr->GetBufferPointer()), pErr->GetBufferSize());
+        if (FAILED(hr))
+            OutputDebugStringA(static_cast<const char*>(pErr->GetBufferPointer()));
+        pErr->Release();
+    }
+    if (FAILED(hr)) {
+        if (pCode)
+            pCode->Release();
+        ++m_stats.failures;
+        return hr;
+    }
+
+    std::vector<IncludeRecord> includes;
+    for (const RecordingInclude::Record& record : include.GetRecords()) {
+        IncludeRecord entryRecord = { record.path, record.hash };
+        includes.push_back(entryRecord);
+    }
+    WriteEntry(key, includes, pCode->GetBufferPointer(), pCode->GetBufferSize(), GetPrecompiledPath(path, entry, target));
+
+    bytecode.Reset();
+    bytecode.m_pBlob = pCode;
+    bytecode.m_size = pCode->GetBufferSize();
+
+    ++m_stats.misses;
+    m_stats.compileMs += ElapsedMs(start);
+    return S_OK;
+}
+
+HRESULT ShaderCache::Load(const std::wstring& path, const char* entry, const char* target, UINT flags,
+    const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors, Source* pSource)
+{
+    if (pSource)
+        *pSource = Source::None;
+    if (pErrors)
+        pErrors->clear();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Исходника нет - поставка только с готовым байт-кодом
+    std::vector<uint8_t> source;
+    if (!ReadFileBytes(path, source)) {
+        HRESULT hr = LoadPrecompiled(path, entry, target, bytecode);
+        if (SUCCEEDED(hr) && pSource)
+            *pSource = Source::Precompiled;
+        return hr;
+    }
+
+    uint64_t key = ComputeKey(source, entry, target, flags, pDefines);
+    if (TryLoadEntry(key, bytecode)) {
+        ++m_stats.hits;
+        m_stats.loadMs += ElapsedMs(start);
+        if (pSource)
+            *pSource = Source::Cache;
+        return S_OK;
+    }
+
+    HRESULT hr = CompileSource(path, source, key, entry, target, flags, pDefines, bytecode, pErrors);
+    if (SUCCEEDED(hr) && pSource)
+        *pSource = Source::Compiled;
+    return hr;
+}
+
+HRESULT ShaderCache::LoadPrecompiled(const std::wstring& path, const char* entry, const char* target, ShaderBytecode& bytecode) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    bytecode.Reset();
+    if (!bytecode.m_file.Open(GetPrecompiledPath(path, entry, target))) {
+        ++m_stats.failures;
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    bytecode.m_size = bytecode.m_file.GetSize();
+
+    ++m_stats.precompiled;
+    m_stats.loadMs += ElapsedMs(start);
+    return S_OK;
+}
+
+HRESULT ShaderCache::Compile(const std::wstring& path, const char* entry, const char* target, UINT flags,
+    const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors)
+{
+    if (pErrors)
+        pErrors->clear();
+
+    std::vector<uint8_t> source;
+    if (!ReadFileBytes(path, source)) {
+        ++m_stats.failures;
+        return HRESULT_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    return CompileSource(path, source, ComputeKey(source, entry, target, flags, pDefines), entry, target, flags, pDefines, bytecode, pErrors);
+}
@@ -0,0 +1,113 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <d3d11.h>
+#include <d3dcompiler.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// Байт-код шейдера: либо участок отображённого в память файла кэша, либо блоб компилятора.
+class ShaderBytecode
+{
+public:
+    ShaderBytecode() :
+        m_offset(0),
+        m_size(0),
+        m_pBlob(nullptr)
+    {
+    }
+    ~ShaderBytecode() { Reset(); }
+
+    const void* GetData() const;
+    size_t GetSize() const { return m_size; }
+    bool IsEmpty() const { return m_size == 0; }
+
+    // Копия в ID3DBlob для кода, которому нужен блоб (например, CreateInputLayout)
+    HRESULT CopyToBlob(ID3DBlob** ppBlob) const;
+    void Reset();
+
+private:
+    friend class ShaderCache;
+
+    ShaderBytecode(const ShaderBytecode&);
+    ShaderBytecode& operator=(const ShaderBytecode&);
+
+    MappedFile m_file;
+    size_t m_offset;
+    size_t m_size;
+    ID3DBlob* m_pBlob;
+};
+
+// Кэш скомпилированных шейдеров на диске.
+// Ключ - хеш исходника, макросов, точки входа, профиля, флагов и версии компилятора;
+// включаемые файлы записываются в запись кэша вместе с их хешами и проверяются при загрузке.
+// Дополнительно рядом кладётся <файл>.<вход>.<профиль>.cso - его грузят, когда исходника нет.
+class ShaderCache
+{
+public:
+    enum class Source
+    {
+        None,
+        Cache,
+        Compiled,
+        Precompiled
+    };
+
+    struct Stats
+    {
+        uint32_t hits;
+        uint32_t misses;
+        uint32_t precompiled;
+        uint32_t failures;
+        double loadMs;
+        double compileMs;
+    };
+
+    ShaderCache();
+
+    void Init(const std::wstring& cacheDirectory);
+    void Terminate() {}
+
+    HRESULT Load(const std::wstring& path, const char* entry, const char* target, UINT flags,
+        const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors = nullptr, Source* pSource = nullptr);
+
+    // Только готовый байт-код по имени файла, без исходника
+    HRESULT LoadPrecompiled(const std::wstring& path, const char* entry, const char* target, ShaderBytecode& bytecode);
+
+    // Компилирует и сохраняет в кэш, даже если запись уже есть
+    HRESULT Compile(const std::wstring& path, const char* entry, const char* target, UINT flags,
+        const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors = nullptr);
+
+    const Stats& GetStats() const { return m_stats; }
+    const std::wstring& GetDirectory() const { return m_directory; }
+
+    static uint64_t HashBytes(const void* pData, size_t size, uint64_t hash = 14695981039346656037ull);
+    // Профиль по расширению файла: .vs/.ps/.cs
+    static const char* GetTargetForPath(const std::wstring& path);
+    static UINT GetDefaultFlags();
+
+private:
+    struct IncludeRecord
+    {
+        std::wstring path;
+        uint64_t hash;
+    };
+
+    uint64_t ComputeKey(const std::vector<uint8_t>& source, const char* entry, const char* target, UINT flags,
+        const D3D_SHADER_MACRO* pDefines) const;
+    std::wstring GetEntryPath(uint64_t key) const;
+    std::wstring GetPrecompiledPath(const std::wstring& path, const char* entry, const char* target) const;
+
+    bool TryLoadEntry(uint64_t key, ShaderBytecode& bytecode);
+    HRESULT CompileSource(const std::wstring& path, const std::vector<uint8_t>& source, uint64_t key, const char* entry,
+        const char* target, UINT flags, const D3D_SHADER_MACRO* pDefines, ShaderBytecode& bytecode, std::string* pErrors);
+    void WriteEntry(uint64_t key, const std::vector<IncludeRecord>& includes, const void* pBytecode, size_t size,
+        const std::wstring& precompiledPath) const;
+
+    std::wstring m_directory;
+    Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,203 @@
+#include "framework.h"
+#include "ShaderHotReload.h"
+
+namespace
+{
+    // Редакторы пишут файл в несколько приёмов - даём записи завершиться
+    const DWORD SettleDelayMs = 100;
+}
+
+ShaderHotReload::ShaderHotReload() :
+    m_hStop(nullptr),
+    m_pDevice(nullptr),
+    m_enabled(true),
+    m_compiling(0),
+    m_reloadCount(0)
+{
+}
+
+void ShaderHotReload::Add(const std::wstring& path, Kind kind, void** ppSlot) {
+    Entry entry = { path, ShaderCache::GetTargetForPath(path), kind, ppSlot, 0, false };
+    m_entries.push_back(entry);
+
+    Status status = { path, std::string(), 0 };
+    m_status.push_back(status);
+}
+
+void ShaderHotReload::Watch(const std::wstring& path, ID3D11VertexShader** ppShader) {
+    Add(path, Kind::Vertex, reinterpret_cast<void**>(ppShader));
+}
+
+void ShaderHotReload::Watch(const std::wstring& path, ID3D11PixelShader** ppShader) {
+    Add(path, Kind::Pixel, reinterpret_cast<void**>(ppShader));
+}
+
+void ShaderHotReload::Watch(const std::wstring& path, ID3D11ComputeShader** ppShader) {
+    Add(path, Kind::Compute, reinterpret_cast<void**>(ppShader));
+}
+
+HRESULT ShaderHotReload::Start(ID3D11Device* pDevice, const std::wstring& directory, const std::wstring& cacheDirectory) {
+    if (!pDevice || m_thread.joinable())
+        return E_INVALIDARG;
+
+    m_hStop = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!m_hStop)
+        return HRESULT_FROM_WIN32(GetLastError());
+
+    m_pDevice = pDevice;
+    m_pDevice->AddRef();
+    m_directory = directory;
+    m_cache.Init(cacheDirectory);
+    m_thread = std::thread(&ShaderHotReload::ThreadProc, this);
+    return S_OK;
+}
+
+void ShaderHotReload::Terminate() {
+    if (m_thread.joinable()) {
+        SetEvent(m_hStop);
+        m_thread.join();
+    }
+    if (m_hStop) {
+        CloseHandle(m_hStop);
+        m_hStop = nullptr;
+    }
+
+    for (Result& result : m_pending) {
+        if (result.pShader)
+            result.pShader->Release();
+    }
+    m_pending.clear();
+    m_entries.clear();
+    m_status.clear();
+
+    if (m_pDevice) {
+        m_pDevice->Release();
+        m_pDevice = nullptr;
+    }
+}
+
+uint32_t ShaderHotReload::Apply() {
+    // Поток держит мьютекс только на время добавления результата, но и этого не ждём
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || m_pending.empty())
+        return 0;
+
+    std::vector<Result> results;
+    results.swap(m_pending);
+    lock.unlock();
+
+    uint32_t swapped = 0;
+    for (Result& result : results) {
+        Status& status = m_status[result.index];
+        status.error = result.error;
+        if (!result.pShader)
+            continue;
+
+        // Контекст держит свою ссылку на привязанный шейдер, поэтому старый можно отпускать сразу
+        ID3D11DeviceChild** ppSlot = reinterpret_cast<ID3D11DeviceChild**>(m_entries[result.index].ppSlot);
+        if (*ppSlot)
+            (*ppSlot)->Release();
+        *ppSlot = result.pShader;
+
+        ++status.reloads;
+        ++swapped;
+    }
+    m_reloadCount += swapped;
+    return swapped;
+}
+
+HRESULT ShaderHotReload::CreateShader(const Entry& entry, const ShaderBytecode& bytecode, ID3D11DeviceChild** ppShader) const {
+    *ppShader = nullptr;
+    HRESULT hr = E_INVALIDARG;
+    switch (entry.kind) {
+    case Kind::Vertex: {
+        ID3D11VertexShader* pShader = nullptr;
+        hr = m_pDevice->CreateVertexShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+        *ppShader = pShader;
+        break;
+    }
+    case Kind::Pixel: {
+        ID3D11PixelShader* pShader = nullptr;
+        hr = m_pDevice->CreatePixelShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+        *ppShader = pShader;
+        break;
+    }
+    case Kind::Compute: {
+        ID3D11ComputeShader* pShader = nullptr;
+        hr = m_pDevice->CreateComputeShader(bytecode.GetData(), bytecode.GetSize(), nullptr, &pShader);
+        *ppShader = pShader;
+        break;
+    }
+    }
+    return hr;
+}
+
+void ShaderHotReload::CheckAll(bool baseline) {
+    // Изменение включаемого файла не трогает дату корневого шейдера - поэтому проверяем все:
+    // кэш сам сверит хеши исходников и include, а сравнение байт-кода отсеет неизменившиеся
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        Entry& entry = m_entries[i];
+        ShaderBytecode bytecode;
+        std::string errors;
+        ++m_compiling;
+        HRESULT hr = m_cache.Load(entry.path, "main", entry.target, ShaderCache::GetDefaultFlags(), nullptr, bytecode, &errors);
+        --m_compiling;
+
+        Result result = { i, nullptr, std::string() };
+        if (FAILED(hr)) {
+            if (baseline)
+                continue;
+            result.error = errors.empty() ? "Failed to load shader source" : errors;
+            entry.failed = true;
+        }
+        else {
+            uint64_t hash = ShaderCache::HashBytes(bytecode.GetData(), bytecode.GetSize());
+            if (hash == entry.bytecodeHash) {
+                // Исправили обратно к работающей версии - только снимаем ошибку
+                if (!entry.failed)
+                    continue;
+                entry.failed = false;
+            }
+            else if (!baseline) {
+                hr = CreateShader(entry, bytecode, &result.pShader);
+                entry.failed = FAILED(hr);
+                if (FAILED(hr))
+                    result.error = "Failed to create shader object";
+                else
+                    entry.bytecodeHash = hash;
+            }
+            else {
+                entry.bytecodeHash = hash;
+                continue;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.push_back(result);
+    }
+}
+
+void ShaderHotReload::ThreadProc() {
+    // Запоминаем текущий байт-код, чтобы первая проверка не подменяла всё подряд
+    CheckAll(true);
+
+    HANDLE hChange = FindFirstChangeNotificationW(m_directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+    if (hChange == INVALID_HANDLE_VALUE)
+        return;
+
+    HANDLE handles[2] = { m_hStop, hChange };
+    for (;;) {
+        DWORD wait = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+        if (wait != WAIT_OBJECT_0 + 1)
+            break;
+        if (WaitForSingleObject(m_hStop, SettleDelayMs) == WAIT_OBJECT_0)
+            break;
+
+        // Повторная подписка до проверки, чтобы не пропустить запись во время компиляции
+        FindNextChangeNotification(hChange);
+        if (m_enabled)
+            CheckAll(false);
+    }
+    FindCloseChangeNotification(hChange);
+}
@@ -0,0 +1,97 @@
+#ifndef SHADER_HOT_RELOAD_H
+#define SHADER_HOT_RELOAD_H
+
+#include <d3d11.h>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ShaderCache.h"
+
+// Горячая перезагрузка шейдеров.
+// Фоновый поток ждёт изменений в каталоге шейдеров, перекомпилирует через собственный ShaderCache
+// и создаёт новые объекты шейдеров (ID3D11Device свободно-поточный). Подмена указателей в RenderClass
+// происходит только в Apply() на границе кадра; при ошибке компиляции старый шейдер остаётся.
+class ShaderHotReload
+{
+public:
+    struct Status
+    {
+        std::wstring path;
+        std::string error;
+        uint32_t reloads;
+    };
+
+    ShaderHotReload();
+    ~ShaderHotReload() { Terminate(); }
+
+    // Регистрация до Start: указатель на поле, куда подставляется новый шейдер
+    void Watch(const std::wstring& path, ID3D11VertexShader** ppShader);
+    void Watch(const std::wstring& path, ID3D11PixelShader** ppShader);
+    void Watch(const std::wstring& path, ID3D11ComputeShader** ppShader);
+
+    HRESULT Start(ID3D11Device* pDevice, const std::wstring& directory, const std::wstring& cacheDirectory);
+    void Terminate();
+
+    // Подменяет готовые шейдеры; не ждёт компиляцию. Возвращает число замен.
+    uint32_t Apply();
+
+    void SetEnabled(bool enabled) { m_enabled = enabled; }
+    bool IsEnabled() const { return m_enabled; }
+
+    const std::vector<Status>& GetStatus() const { return m_status; }
+    uint32_t GetReloadCount() const { return m_reloadCount; }
+    uint32_t GetPendingCompiles() const { return m_compiling; }
+
+private:
+    enum class Kind
+    {
+        Vertex,
+        Pixel,
+        Compute
+    };
+
+    struct Entry
+    {
+        std::wstring path;
+        const char* target;
+        Kind kind;
+        void** ppSlot;
+        uint64_t bytecodeHash;
+        bool failed;
+    };
+
+    struct Result
+    {
+        size_t index;
+        ID3D11DeviceChild* pShader;
+        std::string error;
+    };
+
+    ShaderHotReload(const ShaderHotReload&);
+    ShaderHotReload& operator=(const ShaderHotReload&);
+
+    void Add(const std::wstring& path, Kind kind, void** ppSlot);
+    void ThreadProc();
+    void CheckAll(bool baseline);
+    HRESULT CreateShader(const Entry& entry, const ShaderBytecode& bytecode, ID3D11DeviceChild** ppShader) const;
+
+    std::vector<Entry> m_entries;
+    std::vector<Status> m_status;
+
+    std::mutex m_mutex;
+    std::vector<Result> m_pending;
+
+    std::thread m_thread;
+    void* m_hStop;
+    std::wstring m_directory;
+    ShaderCache m_cache;
+    ID3D11Device* m_pDevice;
+    std::atomic<bool> m_enabled;
+    std::atomic<uint32_t> m_compiling;
+    uint32_t m_reloadCount;
+};
+
+#endif
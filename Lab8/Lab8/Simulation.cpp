@@ -0,0 +1,92 @@
+#include "Simulation.h"
+#include <cmath>
+
+namespace
+{
+    const float Pi = 3.141592654f;
+    const float Pi2 = 6.283185307f;
+
+    float Wrap(float angle) {
+        return angle > Pi2 ? angle - Pi2 : angle;
+    }
+
+    float LerpAngle(float previous, float current, float alpha) {
+        float delta = current - previous;
+        if (delta < -Pi)
+            delta += Pi2;
+        else if (delta > Pi)
+            delta -= Pi2;
+        return Wrap(previous + delta * alpha);
+    }
+}
+
+double SimulationClock::Tick() {
+    Clock::time_point now = Clock::now();
+    double elapsed = std::chrono::duration<double>(now - m_last).count();
+    m_last = now;
+    return elapsed;
+}
+
+double SimulationClock::Peek() const {
+    return std::chrono::duration<double>(Clock::now() - m_last).count();
+}
+
+bool FixedTimestep::Init(double stepSeconds, uint32_t maxStepsPerFrame) {
+    if (stepSeconds <= 0.0 || maxStepsPerFrame == 0)
+        return false;
+
+    m_step = stepSeconds;
+    m_maxSteps = maxStepsPerFrame;
+    Reset();
+    return true;
+}
+
+void FixedTimestep::Reset() {
+    m_accumulator = 0.0;
+    m_totalSteps = 0;
+    m_droppedSeconds = 0.0;
+}
+
+uint32_t FixedTimestep::Advance(double elapsedSeconds) {
+    if (elapsedSeconds > 0.0)
+        m_accumulator += elapsedSeconds;
+
+    uint32_t steps = 0;
+    while (m_accumulator >= m_step && steps < m_maxSteps) {
+        m_accumulator -= m_step;
+        ++steps;
+    }
+
+    // Не успели догнать - лишнее время выбрасываем, иначе каждый следующий кадр будет ещё длиннее
+    if (m_accumulator >= m_step) {
+        double remainder = fmod(m_accumulator, m_step);
+        m_droppedSeconds += m_accumulator - remainder;
+        m_accumulator = remainder;
+    }
+
+    m_totalSteps += steps;
+    return steps;
+}
+
+const double AnimationState::StepSeconds = 1.0 / 60.0;
+
+void AnimationState::Reset() {
+    cubeAngle = 0.0f;
+    lightOrbit = 0.0f;
+    parallelogramTime = 0.0f;
+}
+
+void AnimationState::Step() {
+    cubeAngle = Wrap(cubeAngle + 0.01f);
+    lightOrbit = Wrap(lightOrbit + 0.01f);
+    // В параллелограммах время идёт только в sin/cos, поэтому его тоже можно держать в [0, 2pi)
+    parallelogramTime = Wrap(parallelogramTime + 0.03f);
+}
+
+AnimationState AnimationState::Interpolate(const AnimationState& previous, const AnimationState& current, float alpha) {
+    AnimationState state;
+    state.cubeAngle = LerpAngle(previous.cubeAngle, current.cubeAngle, alpha);
+    state.lightOrbit = LerpAngle(previous.lightOrbit, current.lightOrbit, alpha);
+    state.parallelogramTime = LerpAngle(previous.parallelogramTime, current.parallelogramTime, alpha);
+    return state;
+}
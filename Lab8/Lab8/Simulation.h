@@ -0,0 +1,78 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <chrono>
+#include <cstdint>
+
+// Монотонные часы высокого разрешения: время между соседними Tick в секундах
+class SimulationClock
+{
+public:
+    SimulationClock() :
+        m_last(Clock::now())
+    {
+    }
+
+    void Reset() { m_last = Clock::now(); }
+    double Tick();
+    // Время с последнего Tick без сброса
+    double Peek() const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point m_last;
+};
+
+// Накопитель фиксированного шага: реальное время кадра превращается в целое число шагов
+// симуляции, остаток даёт коэффициент интерполяции между двумя последними состояниями.
+class FixedTimestep
+{
+public:
+    FixedTimestep() :
+        m_step(1.0 / 60.0),
+        m_maxSteps(8),
+        m_accumulator(0.0),
+        m_totalSteps(0),
+        m_droppedSeconds(0.0)
+    {
+    }
+
+    // maxStepsPerFrame ограничивает догонялки после долгого кадра (отладчик, перетаскивание окна)
+    bool Init(double stepSeconds, uint32_t maxStepsPerFrame);
+    void Reset();
+
+    // Возвращает, сколько шагов выполнить в этом кадре
+    uint32_t Advance(double elapsedSeconds);
+    // Доля шага, прошедшая после последнего выполненного: [0, 1)
+    float GetAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+
+    double GetStep() const { return m_step; }
+    uint64_t GetTotalSteps() const { return m_totalSteps; }
+    double GetDroppedSeconds() const { return m_droppedSeconds; }
+
+private:
+    double m_step;
+    uint32_t m_maxSteps;
+    double m_accumulator;
+    uint64_t m_totalSteps;
+    double m_droppedSeconds;
+};
+
+// Анимируемое состояние сцены. Шаг равен прежнему приращению за кадр при 60 Гц,
+// поэтому при вертикальной синхронизации 60 Гц движение не изменилось.
+struct AnimationState
+{
+    float cubeAngle;
+    float lightOrbit;
+    float parallelogramTime;
+
+    static const double StepSeconds;
+
+    void Reset();
+    void Step();
+    // Углы интерполируются по кратчайшей дуге, поэтому переход через 2pi не даёт рывка
+    static AnimationState Interpolate(const AnimationState& previous, const AnimationState& current, float alpha);
+};
+
+#endif
@@ -0,0 +1,164 @@
+#include "StateCache.h"
+
+void StateCache::Init(ID3D11Device* pDevice) {
+    Terminate();
+    m_pDevice = pDevice;
+}
+
+void StateCache::Terminate() {
+    ReleaseTable(m_depthStencilStates);
+    ReleaseTable(m_rasterizerStates);
+    ReleaseTable(m_blendStates);
+    ReleaseTable(m_samplerStates);
+
+    m_pDevice = nullptr;
+    m_hits = 0;
+    m_misses = 0;
+    m_frameCreations = 0;
+    m_lastFrameCreations = 0;
+}
+
+void StateCache::BeginFrame() {
+    m_lastFrameCreations = m_frameCreations;
+    m_frameCreations = 0;
+}
+
+size_t StateCache::GetStateCount() const {
+    return m_depthStencilStates.size() + m_rasterizerStates.size() + m_blendStates.size() + m_samplerStates.size();
+}
+
+template <typename Desc, typename State>
+bool StateCache::Find(Table<Desc, State>& table, const Key<Desc>& key, State** ppState) {
+    typename Table<Desc, State>::iterator it = table.find(key);
+    if (it == table.end()) {
+        ++m_misses;
+        return false;
+    }
+
+    ++m_hits;
+    *ppState = it->second;
+    return true;
+}
+
+template <typename Desc, typename State>
+void StateCache::ReleaseTable(Table<Desc, State>& table) {
+    for (auto& entry : table) {
+        if (entry.second)
+            entry.second->Release();
+    }
+    table.clear();
+}
+
+HRESULT StateCache::GetDepthStencilState(const D3D11_DEPTH_STENCIL_DESC& desc, ID3D11DepthStencilState** ppState) {
+    if (!ppState)
+        return E_INVALIDARG;
+    *ppState = nullptr;
+
+    // После StencilWriteMask идут байты выравнивания - переносим поля по одному
+    Key<D3D11_DEPTH_STENCIL_DESC> key;
+    memset(&key, 0, sizeof(key));
+    key.desc.DepthEnable = desc.DepthEnable;
+    key.desc.DepthWriteMask = desc.DepthWriteMask;
+    key.desc.DepthFunc = desc.DepthFunc;
+    key.desc.StencilEnable = desc.StencilEnable;
+    key.desc.StencilReadMask = desc.StencilReadMask;
+    key.desc.StencilWriteMask = desc.StencilWriteMask;
+    key.desc.FrontFace = desc.FrontFace;
+    key.desc.BackFace = desc.BackFace;
+
+    if (Find(m_depthStencilStates, key, ppState))
+        return S_OK;
+    if (!m_pDevice)
+        return E_FAIL;
+
+    HRESULT hr = m_pDevice->CreateDepthStencilState(&key.desc, ppState);
+    if (FAILED(hr))
+        return hr;
+
+    ++m_frameCreations;
+    m_depthStencilStates[key] = *ppState;
+    return S_OK;
+}
+
+HRESULT StateCache::GetRasterizerState(const D3D11_RASTERIZER_DESC& desc, ID3D11RasterizerState** ppState) {
+    if (!ppState)
+        return E_INVALIDARG;
+    *ppState = nullptr;
+
+    Key<D3D11_RASTERIZER_DESC> key;
+    memset(&key, 0, sizeof(key));
+    key.desc = desc;
+
+    if (Find(m_rasterizerStates, key, ppState))
+        return S_OK;
+    if (!m_pDevice)
+        return E_FAIL;
+
+    HRESULT hr = m_pDevice->CreateRasterizerState(&key.desc, ppState);
+    if (FAILED(hr))
+        return hr;
+
+    ++m_frameCreations;
+    m_rasterizerStates[key] = *ppState;
+    return S_OK;
+}
+
+HRESULT StateCache::GetBlendState(const D3D11_BLEND_DESC& desc, ID3D11BlendState** ppState) {
+    if (!ppState)
+        return E_INVALIDARG;
+    *ppState = nullptr;
+
+    // У каждой цели после RenderTargetWriteMask есть выравнивание
+    Key<D3D11_BLEND_DESC> key;
+    memset(&key, 0, sizeof(key));
+    key.desc.AlphaToCoverageEnable = desc.AlphaToCoverageEnable;
+    key.desc.IndependentBlendEnable = desc.IndependentBlendEnable;
+    for (int i = 0; i < D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+        const D3D11_RENDER_TARGET_BLEND_DESC& src = desc.RenderTarget[i];
+        D3D11_RENDER_TARGET_BLEND_DESC& dst = key.desc.RenderTarget[i];
+        dst.BlendEnable = src.BlendEnable;
+        dst.SrcBlend = src.SrcBlend;
+        dst.DestBlend = src.DestBlend;
+        dst.BlendOp = src.BlendOp;
+        dst.SrcBlendAlpha = src.SrcBlendAlpha;
+        dst.DestBlendAlpha = src.DestBlendAlpha;
+        dst.BlendOpAlpha = src.BlendOpAlpha;
+        dst.RenderTargetWriteMask = src.RenderTargetWriteMask;
+    }
+
+    if (Find(m_blendStates, key, ppState))
+        return S_OK;
+    if (!m_pDevice)
+        return E_FAIL;
+
+    HRESULT hr = m_pDevice->CreateBlendState(&key.desc, ppState);
+    if (FAILED(hr))
+        return hr;
+
+    ++m_frameCreations;
+    m_blendStates[key] = *ppState;
+    return S_OK;
+}
+
+HRESULT StateCache::GetSamplerState(const D3D11_SAMPLER_DESC& desc, ID3D11SamplerState** ppState) {
+    if (!ppState)
+        return E_INVALIDARG;
+    *ppState = nullptr;
+
+    Key<D3D11_SAMPLER_DESC> key;
+    memset(&key, 0, sizeof(key));
+    key.desc = desc;
+
+    if (Find(m_samplerStates, key, ppState))
+        return S_OK;
+    if (!m_pDevice)
+        return E_FAIL;
+
+    HRESULT hr = m_pDevice->CreateSamplerState(&key.desc, ppState);
+    if (FAILED(hr))
+        return hr;
+
+    ++m_frameCreations;
+    m_samplerStates[key] = *ppState;
+    return S_OK;
+}
@@ -0,0 +1,90 @@
+#ifndef STATE_CACHE_H
+#define STATE_CACHE_H
+
+#include <d3d11.h>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+
+// Кэш объектов состояний D3D11 по их описаниям.
+// Каждое уникальное описание создаётся один раз; возвращаемые указатели принадлежат кэшу
+// и действительны до Terminate, поэтому вызывающий код их не освобождает.
+class StateCache
+{
+public:
+    StateCache() :
+        m_pDevice(nullptr),
+        m_hits(0),
+        m_misses(0),
+        m_frameCreations(0),
+        m_lastFrameCreations(0)
+    {
+    }
+
+    void Init(ID3D11Device* pDevice);
+    void Terminate();
+
+    HRESULT GetDepthStencilState(const D3D11_DEPTH_STENCIL_DESC& desc, ID3D11DepthStencilState** ppState);
+    HRESULT GetRasterizerState(const D3D11_RASTERIZER_DESC& desc, ID3D11RasterizerState** ppState);
+    HRESULT GetBlendState(const D3D11_BLEND_DESC& desc, ID3D11BlendState** ppState);
+    HRESULT GetSamplerState(const D3D11_SAMPLER_DESC& desc, ID3D11SamplerState** ppState);
+
+    // Сбрасывает счётчик созданий за кадр
+    void BeginFrame();
+
+    uint64_t GetHits() const { return m_hits; }
+    uint64_t GetMisses() const { return m_misses; }
+    uint32_t GetFrameCreations() const { return m_frameCreations; }
+    uint32_t GetLastFrameCreations() const { return m_lastFrameCreations; }
+    size_t GetStateCount() const;
+
+private:
+    // Описание с обнулёнными байтами выравнивания, чтобы его можно было хешировать и сравнивать побайтно
+    template <typename Desc>
+    struct Key
+    {
+        Desc desc;
+
+        bool operator==(const Key& other) const {
+            return memcmp(&desc, &other.desc, sizeof(Desc)) == 0;
+        }
+    };
+
+    // FNV-1a по байтам описания
+    template <typename Desc>
+    struct KeyHash
+    {
+        size_t operator()(const Key<Desc>& key) const {
+            const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&key.desc);
+            uint64_t hash = 14695981039346656037ull;
+            for (size_t i = 0; i < sizeof(Desc); ++i) {
+                hash ^= pBytes[i];
+                hash *= 1099511628211ull;
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    template <typename Desc, typename State>
+    using Table = std::unordered_map<Key<Desc>, State*, KeyHash<Desc>>;
+
+    template <typename Desc, typename State>
+    bool Find(Table<Desc, State>& table, const Key<Desc>& key, State** ppState);
+
+    template <typename Desc, typename State>
+    void ReleaseTable(Table<Desc, State>& table);
+
+    ID3D11Device* m_pDevice;
+
+    Table<D3D11_DEPTH_STENCIL_DESC, ID3D11DepthStencilState> m_depthStencilStates;
+    Table<D3D11_RASTERIZER_DESC, ID3D11RasterizerState> m_rasterizerStates;
+    Table<D3D11_BLEND_DESC, ID3D11BlendState> m_blendStates;
+    Table<D3D11_SAMPLER_DESC, ID3D11SamplerState> m_samplerStates;
+
+    uint64_t m_hits;
+    uint64_t m_misses;
+    uint32_t m_frameCreations;
+    uint32_t m_lastFrameCreations;
+};
+
+#endif
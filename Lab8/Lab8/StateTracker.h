@@ -0,0 +1,551 @@
+#ifndef STATE_TRACKER_H
+#define STATE_TRACKER_H
+
+#include <cstdint>
+#include <cstring>
+
+// Фильтр повторных привязок перед контекстом устройства.
+// Хранит копию того, что сейчас привязано, и пропускает вызовы *Set*, которые ничего не меняют.
+// Api задаёт типы контекста и ресурсов: D3D11StateApi в приложении или RecordingStateApi в тестах,
+// поэтому сам трекер от D3D11 не зависит.
+//
+// Контекст сам отвязывает ресурс от SRV, когда тот становится render target или UAV,
+// поэтому при смене целей и UAV копия SRV-слотов сбрасывается. После вызовов в обход
+// трекера (ClearState, Present, сторонний код) нужно вызвать Invalidate().
+// *SetConstantBuffers1 (участок буфера, D3D11.1) идут через Context1 и доступны, если он передан в Init.
+template <typename Api>
+class StateTrackerT
+{
+public:
+    typedef typename Api::Context Context;
+    typedef typename Api::Context1 Context1;
+    typedef typename Api::InputLayout InputLayout;
+    typedef typename Api::Buffer Buffer;
+    typedef typename Api::VertexShader VertexShader;
+    typedef typename Api::PixelShader PixelShader;
+    typedef typename Api::ComputeShader ComputeShader;
+    typedef typename Api::ShaderResourceView ShaderResourceView;
+    typedef typename Api::UnorderedAccessView UnorderedAccessView;
+    typedef typename Api::SamplerState SamplerState;
+    typedef typename Api::RenderTargetView RenderTargetView;
+    typedef typename Api::DepthStencilView DepthStencilView;
+    typedef typename Api::DepthStencilState DepthStencilState;
+    typedef typename Api::BlendState BlendState;
+    typedef typename Api::RasterizerState RasterizerState;
+    typedef typename Api::Viewport Viewport;
+    typedef typename Api::Format Format;
+    typedef typename Api::Topology Topology;
+
+    static const uint32_t VertexBufferSlots = 16;
+    static const uint32_t ConstantBufferSlots = 14;
+    static const uint32_t ResourceSlots = 16;
+    static const uint32_t SamplerSlots = 16;
+    static const uint32_t UavSlots = 8;
+    static const uint32_t RenderTargetSlots = 8;
+    static const uint32_t ViewportSlots = 16;
+
+    StateTrackerT() :
+        m_pContext(nullptr),
+        m_pContext1(nullptr),
+        m_issuedCalls(0),
+        m_droppedCalls(0),
+        m_frameIssued(0),
+        m_frameDropped(0),
+        m_lastFrameIssued(0),
+        m_lastFrameDropped(0)
+    {
+        Invalidate();
+    }
+
+    void Init(Context* pContext, Context1* pContext1 = nullptr) {
+        m_pContext = pContext;
+        m_pContext1 = pContext1;
+        Invalidate();
+        m_issuedCalls = 0;
+        m_droppedCalls = 0;
+        m_frameIssued = 0;
+        m_frameDropped = 0;
+        m_lastFrameIssued = 0;
+        m_lastFrameDropped = 0;
+    }
+
+    void Terminate() {
+        m_pContext = nullptr;
+        m_pContext1 = nullptr;
+        Invalidate();
+    }
+
+    Context* GetContext() const { return m_pContext; }
+    Context1* GetContext1() const { return m_pContext1; }
+
+    // Забывает всё привязанное: следующий вызов каждого *Set* дойдёт до контекста
+    void Invalidate() {
+        m_inputLayout.Reset();
+        m_topology.Reset();
+        m_indexBuffer.Reset();
+        m_vertexShader.Reset();
+        m_pixelShader.Reset();
+        m_computeShader.Reset();
+        m_depthStencilState.Reset();
+        m_blendState.Reset();
+        m_rasterizerState.Reset();
+        m_renderTargets.Reset();
+        m_viewports.Reset();
+        for (uint32_t i = 0; i < VertexBufferSlots; ++i)
+            m_vertexBuffers[i].Reset();
+        m_vsConstantBuffers.Reset();
+        m_psConstantBuffers.Reset();
+        m_csConstantBuffers.Reset();
+        m_psSamplers.Reset();
+        m_csSamplers.Reset();
+        m_csUavs.Reset();
+        InvalidateResources();
+    }
+
+    void BeginFrame() {
+        m_lastFrameIssued = m_frameIssued;
+        m_lastFrameDropped = m_frameDropped;
+        m_frameIssued = 0;
+        m_frameDropped = 0;
+    }
+
+    uint64_t GetIssuedCalls() const { return m_issuedCalls; }
+    uint64_t GetDroppedCalls() const { return m_droppedCalls; }
+    uint32_t GetFrameIssued() const { return m_frameIssued; }
+    uint32_t GetFrameDropped() const { return m_frameDropped; }
+    uint32_t GetLastFrameIssued() const { return m_lastFrameIssued; }
+    uint32_t GetLastFrameDropped() const { return m_lastFrameDropped; }
+
+    void IASetInputLayout(InputLayout* pLayout) {
+        if (Drop(m_inputLayout.Set(pLayout)))
+            return;
+        m_pContext->IASetInputLayout(pLayout);
+    }
+
+    void IASetPrimitiveTopology(Topology topology) {
+        if (Drop(m_topology.Set(topology)))
+            return;
+        m_pContext->IASetPrimitiveTopology(topology);
+    }
+
+    void IASetVertexBuffers(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers, const uint32_t* pStrides, const uint32_t* pOffsets) {
+        bool changed = startSlot + count > VertexBufferSlots;
+        for (uint32_t i = 0; i < count && startSlot + i < VertexBufferSlots; ++i) {
+            VertexBinding binding;
+            memset(&binding, 0, sizeof(binding));
+            binding.pBuffer = ppBuffers[i];
+            binding.stride = pStrides[i];
+            binding.offset = pOffsets[i];
+            if (!m_vertexBuffers[startSlot + i].Set(binding))
+                changed = true;
+        }
+        if (Drop(!changed))
+            return;
+
+        m_pContext->IASetVertexBuffers(startSlot, count, ppBuffers, pStrides, pOffsets);
+    }
+
+    void IASetIndexBuffer(Buffer* pBuffer, Format format, uint32_t offset) {
+        IndexBinding binding;
+        memset(&binding, 0, sizeof(binding));
+        binding.pBuffer = pBuffer;
+        binding.format = format;
+        binding.offset = offset;
+        if (Drop(m_indexBuffer.Set(binding)))
+            return;
+        m_pContext->IASetIndexBuffer(pBuffer, format, offset);
+    }
+
+    void VSSetShader(VertexShader* pShader) {
+        if (Drop(m_vertexShader.Set(pShader)))
+            return;
+        m_pContext->VSSetShader(pShader, nullptr, 0);
+    }
+
+    void PSSetShader(PixelShader* pShader) {
+        if (Drop(m_pixelShader.Set(pShader)))
+            return;
+        m_pContext->PSSetShader(pShader, nullptr, 0);
+    }
+
+    void CSSetShader(ComputeShader* pShader) {
+        if (Drop(m_computeShader.Set(pShader)))
+            return;
+        m_pContext->CSSetShader(pShader, nullptr, 0);
+    }
+
+    void VSSetConstantBuffers(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers) {
+        uint32_t first, last;
+        if (Drop(!m_vsConstantBuffers.Update(startSlot, count, ppBuffers, nullptr, nullptr, &first, &last)))
+            return;
+        m_pContext->VSSetConstantBuffers(first, last - first, ppBuffers + (first - startSlot));
+    }
+
+    void PSSetConstantBuffers(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers) {
+        uint32_t first, last;
+        if (Drop(!m_psConstantBuffers.Update(startSlot, count, ppBuffers, nullptr, nullptr, &first, &last)))
+            return;
+        m_pContext->PSSetConstantBuffers(first, last - first, ppBuffers + (first - startSlot));
+    }
+
+    void CSSetConstantBuffers(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers) {
+        uint32_t first, last;
+        if (Drop(!m_csConstantBuffers.Update(startSlot, count, ppBuffers, nullptr, nullptr, &first, &last)))
+            return;
+        m_pContext->CSSetConstantBuffers(first, last - first, ppBuffers + (first - startSlot));
+    }
+
+    void VSSetConstantBuffers1(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers,
+        const uint32_t* pFirstConstant, const uint32_t* pNumConstants)
+    {
+        uint32_t first, last;
+        if (Drop(!m_vsConstantBuffers.Update(startSlot, count, ppBuffers, pFirstConstant, pNumConstants, &first, &last)))
+            return;
+        uint32_t skip = first - startSlot;
+        m_pContext1->VSSetConstantBuffers1(first, last - first, ppBuffers + skip, pFirstConstant + skip, pNumConstants + skip);
+    }
+
+    void PSSetConstantBuffers1(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers,
+        const uint32_t* pFirstConstant, const uint32_t* pNumConstants)
+    {
+        uint32_t first, last;
+        if (Drop(!m_psConstantBuffers.Update(startSlot, count, ppBuffers, pFirstConstant, pNumConstants, &first, &last)))
+            return;
+        uint32_t skip = first - startSlot;
+        m_pContext1->PSSetConstantBuffers1(first, last - first, ppBuffers + skip, pFirstConstant + skip, pNumConstants + skip);
+    }
+
+    void CSSetConstantBuffers1(uint32_t startSlot, uint32_t count, Buffer* const* ppBuffers,
+        const uint32_t* pFirstConstant, const uint32_t* pNumConstants)
+    {
+        uint32_t first, last;
+        if (Drop(!m_csConstantBuffers.Update(startSlot, count, ppBuffers, pFirstConstant, pNumConstants, &first, &last)))
+            return;
+        uint32_t skip = first - startSlot;
+        m_pContext1->CSSetConstantBuffers1(first, last - first, ppBuffers + skip, pFirstConstant + skip, pNumConstants + skip);
+    }
+
+    void VSSetShaderResources(uint32_t startSlot, uint32_t count, ShaderResourceView* const* ppViews) {
+        uint32_t first, last;
+        if (Drop(!m_vsResources.Update(startSlot, count, ppViews, &first, &last)))
+            return;
+        m_pContext->VSSetShaderResources(first, last - first, ppViews + (first - startSlot));
+    }
+
+    void PSSetShaderResources(uint32_t startSlot, uint32_t count, ShaderResourceView* const* ppViews) {
+        uint32_t first, last;
+        if (Drop(!m_psResources.Update(startSlot, count, ppViews, &first, &last)))
+            return;
+        m_pContext->PSSetShaderResources(first, last - first, ppViews + (first - startSlot));
+    }
+
+    void CSSetShaderResources(uint32_t startSlot, uint32_t count, ShaderResourceView* const* ppViews) {
+        uint32_t first, last;
+        if (Drop(!m_csResources.Update(startSlot, count, ppViews, &first, &last)))
+            return;
+        m_pContext->CSSetShaderResources(first, last - first, ppViews + (first - startSlot));
+    }
+
+    void PSSetSamplers(uint32_t startSlot, uint32_t count, SamplerState* const* ppSamplers) {
+        uint32_t first, last;
+        if (Drop(!m_psSamplers.Update(startSlot, count, ppSamplers, &first, &last)))
+            return;
+        m_pContext->PSSetSamplers(first, last - first, ppSamplers + (first - startSlot));
+    }
+
+    void CSSetSamplers(uint32_t startSlot, uint32_t count, SamplerState* const* ppSamplers) {
+        uint32_t first, last;
+        if (Drop(!m_csSamplers.Update(startSlot, count, ppSamplers, &first, &last)))
+            return;
+        m_pContext->CSSetSamplers(first, last - first, ppSamplers + (first - startSlot));
+    }
+
+    // Начальные значения счётчиков применяются при каждом вызове, поэтому с ними вызов не отбрасывается
+    void CSSetUnorderedAccessViews(uint32_t startSlot, uint32_t count, UnorderedAccessView* const* ppViews, const uint32_t* pInitialCounts) {
+        uint32_t first, last;
+        bool changed = m_csUavs.Update(startSlot, count, ppViews, &first, &last);
+        if (Drop(!changed && !pInitialCounts))
+            return;
+
+        InvalidateResources();
+        if (pInitialCounts)
+            m_pContext->CSSetUnorderedAccessViews(startSlot, count, ppViews, pInitialCounts);
+        else
+            m_pContext->CSSetUnorderedAccessViews(first, last - first, ppViews + (first - startSlot), nullptr);
+    }
+
+    void OMSetRenderTargets(uint32_t count, RenderTargetView* const* ppViews, DepthStencilView* pDepthView) {
+        RenderTargetBinding binding;
+        memset(&binding, 0, sizeof(binding));
+        binding.count = count < RenderTargetSlots ? count : RenderTargetSlots;
+        for (uint32_t i = 0; i < binding.count; ++i)
+            binding.views[i] = ppViews ? ppViews[i] : nullptr;
+        binding.pDepthView = pDepthView;
+
+        if (Drop(count <= RenderTargetSlots && m_renderTargets.Set(binding)))
+            return;
+        if (count > RenderTargetSlots)
+            m_renderTargets.Reset();
+
+        InvalidateResources();
+        m_pContext->OMSetRenderTargets(count, ppViews, pDepthView);
+    }
+
+    void OMSetDepthStencilState(DepthStencilState* pState, uint32_t stencilRef) {
+        DepthStencilBinding binding;
+        memset(&binding, 0, sizeof(binding));
+        binding.pState = pState;
+        binding.stencilRef = stencilRef;
+        if (Drop(m_depthStencilState.Set(binding)))
+            return;
+        m_pContext->OMSetDepthStencilState(pState, stencilRef);
+    }
+
+    void OMSetBlendState(BlendState* pState, const float blendFactor[4], uint32_t sampleMask) {
+        // nullptr вместо коэффициентов означает { 1, 1, 1, 1 }
+        BlendBinding binding;
+        memset(&binding, 0, sizeof(binding));
+        binding.pState = pState;
+        for (int i = 0; i < 4; ++i)
+            binding.factor[i] = blendFactor ? blendFactor[i] : 1.0f;
+        binding.sampleMask = sampleMask;
+        if (Drop(m_blendState.Set(binding)))
+            return;
+        m_pContext->OMSetBlendState(pState, blendFactor, sampleMask);
+    }
+
+    void RSSetState(RasterizerState* pState) {
+        if (Drop(m_rasterizerState.Set(pState)))
+            return;
+        m_pContext->RSSetState(pState);
+    }
+
+    void RSSetViewports(uint32_t count, const Viewport* pViewports) {
+        ViewportBinding binding;
+        memset(&binding, 0, sizeof(binding));
+        binding.count = count < ViewportSlots ? count : ViewportSlots;
+        memcpy(binding.viewports, pViewports, sizeof(Viewport) * binding.count);
+
+        if (Drop(count <= ViewportSlots && m_viewports.Set(binding)))
+            return;
+        if (count > ViewportSlots)
+            m_viewports.Reset();
+        m_pContext->RSSetViewports(count, pViewports);
+    }
+
+private:
+    // Одно значение состояния; known = false, пока его не задали через трекер.
+    // Сравнение побайтное, поэтому составные значения перед заполнением обнуляются целиком
+    template <typename T>
+    struct Shadow
+    {
+        T value;
+        bool known;
+
+        void Reset() { known = false; }
+        bool Equals(const T& other) const { return known && memcmp(&value, &other, sizeof(T)) == 0; }
+
+        // true, если значение не изменилось и вызов можно отбросить
+        bool Set(const T& other) {
+            if (Equals(other))
+                return true;
+            memcpy(&value, &other, sizeof(T));
+            known = true;
+            return false;
+        }
+    };
+
+    // Набор слотов одной стадии. Update обновляет копию и возвращает границы
+    // диапазона [first, last), который действительно изменился
+    template <typename T, uint32_t N>
+    struct Slots
+    {
+        T* items[N];
+        bool known[N];
+
+        void Reset() {
+            for (uint32_t i = 0; i < N; ++i) {
+                items[i] = nullptr;
+                known[i] = false;
+            }
+        }
+
+        bool Update(uint32_t startSlot, uint32_t count, T* const* ppItems, uint32_t* pFirst, uint32_t* pLast) {
+            *pFirst = startSlot;
+            *pLast = startSlot + count;
+            if (startSlot + count > N) {
+                // Слоты за пределами копии не отслеживаются - вызов передаётся целиком
+                for (uint32_t i = startSlot; i < N; ++i)
+                    known[i] = false;
+                return true;
+            }
+
+            uint32_t first = startSlot + count;
+            uint32_t last = startSlot;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t slot = startSlot + i;
+                if (known[slot] && items[slot] == ppItems[i])
+                    continue;
+                items[slot] = ppItems[i];
+                known[slot] = true;
+                if (slot < first)
+                    first = slot;
+                last = slot + 1;
+            }
+            if (first >= last)
+                return false;
+
+            *pFirst = first;
+            *pLast = last;
+            return true;
+        }
+    };
+
+    // Слоты константных буферов: кроме самого буфера помнят привязанный участок.
+    // Обычная привязка хранится как участок 0/0, поэтому не совпадает ни с одним участком *1
+    template <uint32_t N>
+    struct ConstantBufferSlotsT
+    {
+        Buffer* items[N];
+        uint32_t firstConstant[N];
+        uint32_t numConstants[N];
+        bool known[N];
+
+        void Reset() {
+            for (uint32_t i = 0; i < N; ++i) {
+                items[i] = nullptr;
+                firstConstant[i] = 0;
+                numConstants[i] = 0;
+                known[i] = false;
+            }
+        }
+
+        bool Update(uint32_t startSlot, uint32_t count, Buffer* const* ppItems, const uint32_t* pFirstConstant,
+            const uint32_t* pNumConstants, uint32_t* pFirst, uint32_t* pLast)
+        {
+            *pFirst = startSlot;
+            *pLast = startSlot + count;
+            if (startSlot + count > N) {
+                for (uint32_t i = startSlot; i < N; ++i)
+                    known[i] = false;
+                return true;
+            }
+
+            uint32_t first = startSlot + count;
+            uint32_t last = startSlot;
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t slot = startSlot + i;
+                uint32_t firstConst = pFirstConstant ? pFirstConstant[i] : 0;
+                uint32_t numConst = pNumConstants ? pNumConstants[i] : 0;
+                if (known[slot] && items[slot] == ppItems[i] && firstConstant[slot] == firstConst && numConstants[slot] == numConst)
+                    continue;
+                items[slot] = ppItems[i];
+                firstConstant[slot] = firstConst;
+                numConstants[slot] = numConst;
+                known[slot] = true;
+                if (slot < first)
+                    first = slot;
+                last = slot + 1;
+            }
+            if (first >= last)
+                return false;
+
+            *pFirst = first;
+            *pLast = last;
+            return true;
+        }
+    };
+
+    struct VertexBinding
+    {
+        Buffer* pBuffer;
+        uint32_t stride;
+        uint32_t offset;
+    };
+
+    struct IndexBinding
+    {
+        Buffer* pBuffer;
+        Format format;
+        uint32_t offset;
+    };
+
+    struct DepthStencilBinding
+    {
+        DepthStencilState* pState;
+        uint32_t stencilRef;
+    };
+
+    struct BlendBinding
+    {
+        BlendState* pState;
+        float factor[4];
+        uint32_t sampleMask;
+    };
+
+    struct RenderTargetBinding
+    {
+        uint32_t count;
+        RenderTargetView* views[RenderTargetSlots];
+        DepthStencilView* pDepthView;
+    };
+
+    struct ViewportBinding
+    {
+        uint32_t count;
+        Viewport viewports[ViewportSlots];
+    };
+
+    bool Drop(bool redundant) {
+        if (redundant) {
+            ++m_droppedCalls;
+            ++m_frameDropped;
+        }
+        else {
+            ++m_issuedCalls;
+            ++m_frameIssued;
+        }
+        return redundant;
+    }
+
+    void InvalidateResources() {
+        m_vsResources.Reset();
+        m_psResources.Reset();
+        m_csResources.Reset();
+    }
+
+    Context* m_pContext;
+    Context1* m_pContext1;
+
+    Shadow<InputLayout*> m_inputLayout;
+    Shadow<Topology> m_topology;
+    Shadow<VertexBinding> m_vertexBuffers[VertexBufferSlots];
+    Shadow<IndexBinding> m_indexBuffer;
+    Shadow<VertexShader*> m_vertexShader;
+    Shadow<PixelShader*> m_pixelShader;
+    Shadow<ComputeShader*> m_computeShader;
+    Shadow<DepthStencilBinding> m_depthStencilState;
+    Shadow<BlendBinding> m_blendState;
+    Shadow<RasterizerState*> m_rasterizerState;
+    Shadow<RenderTargetBinding> m_renderTargets;
+    Shadow<ViewportBinding> m_viewports;
+
+    ConstantBufferSlotsT<ConstantBufferSlots> m_vsConstantBuffers;
+    ConstantBufferSlotsT<ConstantBufferSlots> m_psConstantBuffers;
+    ConstantBufferSlotsT<ConstantBufferSlots> m_csConstantBuffers;
+    Slots<ShaderResourceView, ResourceSlots> m_vsResources;
+    Slots<ShaderResourceView, ResourceSlots> m_psResources;
+    Slots<ShaderResourceView, ResourceSlots> m_csResources;
+    Slots<SamplerState, SamplerSlots> m_psSamplers;
+    Slots<SamplerState, SamplerSlots> m_csSamplers;
+    Slots<UnorderedAccessView, UavSlots> m_csUavs;
+
+    uint64_t m_issuedCalls;
+    uint64_t m_droppedCalls;
+    uint32_t m_frameIssued;
+    uint32_t m_frameDropped;
+    uint32_t m_lastFrameIssued;
+    uint32_t m_lastFrameDropped;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#include "../CommandLine.h"
+#include "TestCheck.h"
+#include <cstring>
+
+// Разбор ключей: формы записи, неизвестные ключи, числа и строка wWinMain
+namespace
+{
+    const CommandLineOption Options[] = {
+        { "benchframes", OptionValue::None, nullptr },
+        { "instances", OptionValue::Uint, nullptr },
+        { "frames", OptionValue::Uint, nullptr },
+        { "path", OptionValue::Text, "static|orbit|flythrough" }
+    };
+    const size_t OptionCount = sizeof(Options) / sizeof(Options[0]);
+
+    bool ParseArgs(CommandLine& commandLine, std::vector<const char*> args) {
+        args.insert(args.begin(), "framebench");
+        return commandLine.Parse(static_cast<int>(args.size()), const_cast<char**>(args.data()), Options, OptionCount);
+    }
+
+    void TestForms() {
+        CommandLine commandLine;
+        CHECK(ParseArgs(commandLine, {}));
+        CHECK(!commandLine.Has("instances"));
+        CHECK(commandLine.GetUint("instances", 23) == 23);
+        CHECK(commandLine.GetText("path") == nullptr);
+
+        CHECK(ParseArgs(commandLine, { "instances", "100" }));
+        CHECK(commandLine.GetUint("instances", 23) == 100);
+        CHECK(ParseArgs(commandLine, { "-instances", "200" }));
+        CHECK(commandLine.GetUint("instances", 23) == 200);
+        CHECK(ParseArgs(commandLine, { "--instances=300", "--path", "orbit" }));
+        CHECK(commandLine.GetUint("instances", 23) == 300);
+        CHECK(strcmp(commandLine.GetText("path"), "orbit") == 0);
+
+        // Повтор - последнее значение; 0 - значение по умолчанию
+        CHECK(ParseArgs(commandLine, { "frames", "10", "frames=20" }));
+        CHECK(commandLine.GetUint("frames", 600) == 20);
+        CHECK(ParseArgs(commandLine, { "frames", "0" }));
+        CHECK(commandLine.Has("frames"));
+        CHECK(commandLine.GetUint("frames", 600) == 600);
+    }
+
+    void TestErrors() {
+        CommandLine commandLine;
+        CHECK(!ParseArgs(commandLine, { "--frame", "10" }));
+        CHECK(!commandLine.HelpRequested());
+        CHECK(commandLine.GetError().find("--frame") != std::string::npos);
+
+        CHECK(!ParseArgs(commandLine, { "instances" }));
+        CHECK(!ParseArgs(commandLine, { "instances", "many" }));
+        CHECK(!ParseArgs(commandLine, { "instances=-5" }));
+        CHECK(!ParseArgs(commandLine, { "benchframes=1" }));
+        CHECK(!commandLine.GetError().empty());
+
+        // После ошибки старые значения не остаются
+        CHECK(ParseArgs(commandLine, { "instances", "5" }));
+        CHECK(!ParseArgs(commandLine, { "unknown" }));
+        CHECK(!commandLine.Has("instances"));
+
+        CHECK(!ParseArgs(commandLine, { "--help" }));
+        CHECK(commandLine.HelpRequested());
+        CHECK(commandLine.GetError().empty());
+        CHECK(!ParseArgs(commandLine, { "/?" }));
+        CHECK(commandLine.HelpRequested());
+    }
+
+    void TestWide() {
+        CommandLine commandLine;
+        CHECK(commandLine.Parse(static_cast<const wchar_t*>(nullptr), Options, OptionCount));
+        CHECK(commandLine.Parse(L"", Options, OptionCount));
+
+        // Режим "benchframes" не путается с ключом "frames"
+        CHECK(commandLine.Parse(L"  benchframes  --instances=1000 \"path\" flythrough", Options, OptionCount));
+        CHECK(commandLine.Has("benchframes"));
+        CHECK(!commandLine.Has("frames"));
+        CHECK(commandLine.GetUint("instances", 23) == 1000);
+        CHECK(strcmp(commandLine.GetText("path"), "flythrough") == 0);
+
+        CHECK(!commandLine.Parse(L"instances 10 \x0444rames 5", Options, OptionCount));
+    }
+
+    void TestUsage() {
+        CHECK(CommandLine::GetUsage(Options, OptionCount) ==
+            "[benchframes] [instances N] [frames N] [path static|orbit|flythrough]");
+    }
+}
+
+int main() {
+    TestForms();
+    TestErrors();
+    TestWide();
+    TestUsage();
+    return TestResult();
+}
@@ -0,0 +1,188 @@
+#include "../LoaderHelpers.h"
+#include "TestCheck.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Разбор DDS из отображённого файла: цепочка BC1, пропуск мипов больше maxsize,
+// обрезанный DX10-куб и отсутствующий файл. Файлы пишутся в рабочий каталог теста
+using namespace DirectX;
+using namespace DirectX::LoaderHelpers;
+
+namespace
+{
+    // Раскладка D3D11_SUBRESOURCE_DATA
+    struct SubresourceData
+    {
+        const void* pSysMem;
+        uint32_t SysMemPitch;
+        uint32_t SysMemSlicePitch;
+    };
+
+    const uint32_t DimensionTexture2D = 3;
+    const uint32_t MiscTextureCube = 4;
+
+    std::vector<uint8_t> MakeHeader(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t fourCC) {
+        std::vector<uint8_t> data(sizeof(uint32_t) + sizeof(DDS_HEADER));
+        const uint32_t magic = DDS_MAGIC;
+        memcpy(data.data(), &magic, sizeof(magic));
+
+        DDS_HEADER header = {};
+        header.size = sizeof(DDS_HEADER);
+        header.flags = DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP;
+        header.width = width;
+        header.height = height;
+        header.mipMapCount = mipCount;
+        header.ddspf.size = sizeof(DDS_PIXELFORMAT);
+        header.ddspf.flags = DDS_FOURCC;
+        header.ddspf.fourCC = fourCC;
+        memcpy(data.data() + sizeof(magic), &header, sizeof(header));
+        return data;
+    }
+
+    std::vector<uint8_t> MakeDX10Header(uint32_t width, uint32_t height, uint32_t mipCount, DXGI_FORMAT format, uint32_t arraySize, bool cube) {
+        std::vector<uint8_t> data = MakeHeader(width, height, mipCount, MAKEFOURCC('D', 'X', '1', '0'));
+        DDS_HEADER_DXT10 extension = {};
+        extension.dxgiFormat = format;
+        extension.resourceDimension = DimensionTexture2D;
+        extension.miscFlag = cube ? MiscTextureCube : 0;
+        extension.arraySize = arraySize;
+        const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(&extension);
+        data.insert(data.end(), pBytes, pBytes + sizeof(extension));
+        return data;
+    }
+
+    bool WriteFile(const char* path, const std::vector<uint8_t>& data) {
+        FILE* pFile = fopen(path, "wb");
+        if (!pFile)
+            return false;
+        bool written = fwrite(data.data(), 1, data.size(), pFile) == data.size();
+        return fclose(pFile) == 0 && written;
+    }
+
+    size_t Bc1Bytes(size_t width, size_t height) {
+        return std::max<size_t>(1, (width + 3) / 4) * std::max<size_t>(1, (height + 3) / 4) * 8;
+    }
+
+    void TestBc1Chain() {
+        const uint32_t width = 256;
+        const uint32_t height = 128;
+        const uint32_t mipCount = 9;
+        std::vector<uint8_t> data = MakeHeader(width, height, mipCount, MAKEFOURCC('D', 'X', 'T', '1'));
+        size_t total = 0;
+        for (size_t w = width, h = height, mip = 0; mip < mipCount; ++mip, w = std::max<size_t>(1, w / 2), h = std::max<size_t>(1, h / 2))
+            total += Bc1Bytes(w, h);
+        data.resize(data.size() + total, 0xAB);
+        CHECK(WriteFile("dds_test_bc1.dds", data));
+
+        MappedFile file;
+        const DDS_HEADER* pHeader = nullptr;
+        const uint8_t* pBits = nullptr;
+        size_t bitSize = 0;
+        CHECK(SUCCEEDED(LoadTextureDataFromMappedFile(L"dds_test_bc1.dds", file, &pHeader, &pBits, &bitSize)));
+        if (!file.IsOpen())
+            return;
+        CHECK(bitSize == total);
+        CHECK(GetDXGIFormat(pHeader->ddspf) == DXGI_FORMAT_BC1_UNORM);
+        CHECK(pBits == file.GetData() + sizeof(uint32_t) + sizeof(DDS_HEADER));
+
+        // Все мипы указывают в отображение подряд, без копий
+        SubresourceData subresources[mipCount] = {};
+        size_t twidth = 0, theight = 0, tdepth = 0, skipMip = 0;
+        CHECK(SUCCEEDED(FillInitData(width, height, 1, mipCount, 1, DXGI_FORMAT_BC1_UNORM, 0, bitSize, pBits,
+            twidth, theight, tdepth, skipMip, subresources)));
+        CHECK(twidth == width && theight == height && tdepth == 1 && skipMip == 0);
+        const uint8_t* pExpected = pBits;
+        for (size_t mip = 0, w = width, h = height; mip < mipCount; ++mip, w = std::max<size_t>(1, w / 2), h = std::max<size_t>(1, h / 2)) {
+            CHECK(subresources[mip].pSysMem == pExpected);
+            CHECK(subresources[mip].SysMemPitch == std::max<size_t>(1, (w + 3) / 4) * 8);
+            CHECK(subresources[mip].SysMemSlicePitch == Bc1Bytes(w, h));
+            pExpected += Bc1Bytes(w, h);
+        }
+        CHECK(pExpected == file.GetData() + file.GetSize());
+
+        // maxsize 64: первые два мипа пропускаются, первый оставшийся - 64x32
+        SubresourceData limited[mipCount] = {};
+        CHECK(SUCCEEDED(FillInitData(width, height, 1, mipCount, 1, DXGI_FORMAT_BC1_UNORM, 64, bitSize, pBits,
+            twidth, theight, tdepth, skipMip, limited)));
+        CHECK(skipMip == 2 && twidth == 64 && theight == 32);
+        CHECK(limited[0].pSysMem == subresources[2].pSysMem);
+        CHECK(limited[mipCount - 3].pSysMem == subresources[mipCount - 1].pSysMem);
+
+        // Цепочка длиннее данных - конец файла, а не чтение за отображением
+        CHECK(FillInitData(width, height, 1, mipCount, 1, DXGI_FORMAT_BC1_UNORM, 0, bitSize - 1, pBits,
+            twidth, theight, tdepth, skipMip, subresources) == HRESULT_E_HANDLE_EOF);
+        file.Close();
+        remove("dds_test_bc1.dds");
+    }
+
+    void TestTruncatedCube() {
+        const uint32_t size = 4;
+        const uint32_t mipCount = 3;
+        const size_t faceBytes = (4 * 4 + 2 * 2 + 1) * 4;
+        std::vector<uint8_t> data = MakeDX10Header(size, size, mipCount, DXGI_FORMAT_R8G8B8A8_UNORM, 1, true);
+        data.resize(data.size() + faceBytes * 6 - 1);
+        CHECK(WriteFile("dds_test_cube.dds", data));
+
+        MappedFile file;
+        const DDS_HEADER* pHeader = nullptr;
+        const uint8_t* pBits = nullptr;
+        size_t bitSize = 0;
+        CHECK(SUCCEEDED(LoadTextureDataFromMappedFile(L"dds_test_cube.dds", file, &pHeader, &pBits, &bitSize)));
+        CHECK(bitSize == faceBytes * 6 - 1);
+        CHECK(pBits == file.GetData() + DDS_DX10_HEADER_SIZE);
+
+        // Пять граней целы, последний байт шестой отрезан
+        SubresourceData subresources[mipCount * 6] = {};
+        size_t twidth = 0, theight = 0, tdepth = 0, skipMip = 0;
+        CHECK(FillInitData(size, size, 1, mipCount, 6, DXGI_FORMAT_R8G8B8A8_UNORM, 0, bitSize, pBits,
+            twidth, theight, tdepth, skipMip, subresources) == HRESULT_E_HANDLE_EOF);
+        file.Close();
+
+        // Заголовок DX10 сам обрезан: файл не принимается и не остаётся открытым
+        std::vector<uint8_t> header = MakeDX10Header(size, size, mipCount, DXGI_FORMAT_R8G8B8A8_UNORM, 1, true);
+        header.resize(DDS_DX10_HEADER_SIZE - 1);
+        CHECK(WriteFile("dds_test_cube.dds", header));
+        CHECK(LoadTextureDataFromMappedFile(L"dds_test_cube.dds", file, &pHeader, &pBits, &bitSize) == E_FAIL);
+        CHECK(!file.IsOpen());
+        remove("dds_test_cube.dds");
+    }
+
+    void TestRejectedFiles() {
+        MappedFile file;
+        const DDS_HEADER* pHeader = nullptr;
+        const uint8_t* pBits = nullptr;
+        size_t bitSize = 0;
+        CHECK(LoadTextureDataFromMappedFile(L"dds_test_missing.dds", file, &pHeader, &pBits, &bitSize) == HRESULT_E_FILE_NOT_FOUND);
+        CHECK(!file.IsOpen());
+        CHECK(LoadTextureDataFromMappedFile(nullptr, file, &pHeader, &pBits, &bitSize) == E_INVALIDARG);
+
+        std::vector<uint8_t> data = MakeHeader(4, 4, 1, MAKEFOURCC('D', 'X', 'T', '1'));
+        data.resize(data.size() + 8);
+        data[0] = 'X';
+        CHECK(WriteFile("dds_test_magic.dds", data));
+        CHECK(LoadTextureDataFromMappedFile(L"dds_test_magic.dds", file, &pHeader, &pBits, &bitSize) == E_FAIL);
+        CHECK(!file.IsOpen());
+        remove("dds_test_magic.dds");
+    }
+
+    void TestSurfaceInfo() {
+        size_t numBytes = 0, rowBytes = 0, numRows = 0;
+        CHECK(SUCCEEDED(GetSurfaceInfo(5, 3, DXGI_FORMAT_BC7_UNORM, &numBytes, &rowBytes, &numRows)));
+        CHECK(rowBytes == 32 && numRows == 1 && numBytes == 32);
+        CHECK(SUCCEEDED(GetSurfaceInfo(3, 2, DXGI_FORMAT_R8G8B8A8_UNORM, &numBytes, &rowBytes, &numRows)));
+        CHECK(rowBytes == 12 && numRows == 2 && numBytes == 24);
+        CHECK(GetSurfaceInfo(4, 4, DXGI_FORMAT_UNKNOWN, &numBytes, &rowBytes, &numRows) == E_INVALIDARG);
+        CHECK(IsCompressed(DXGI_FORMAT_BC1_UNORM) && !IsCompressed(DXGI_FORMAT_R8G8B8A8_UNORM));
+        CHECK(BitsPerPixel(DXGI_FORMAT_BC1_UNORM) == 4 && BitsPerPixel(DXGI_FORMAT_R16G16B16A16_FLOAT) == 64);
+    }
+}
+
+int main() {
+    TestBc1Chain();
+    TestTruncatedCube();
+    TestRejectedFiles();
+    TestSurfaceInfo();
+    return TestResult();
+}
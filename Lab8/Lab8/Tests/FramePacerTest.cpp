@@ -0,0 +1,173 @@
+#include "../FramePacer.h"
+#include "TestCheck.h"
+#include <cmath>
+
+// Темп кадров на MockFrameClock: шаг сроков, сброс после пропуска, таймауты ожидания
+namespace
+{
+    bool Near(double a, double b) {
+        return fabs(a - b) < 1e-9;
+    }
+
+    void TestDeadlineStepping() {
+        MockFrameClock clock(0.001);
+        FramePacer pacer;
+        pacer.Init(&clock, nullptr);
+        pacer.SetMode(PresentMode::Capped);
+        pacer.SetFrameCap(100);
+
+        // Первый кадр только заводит срок и не ждёт
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 0);
+        CHECK(Near(clock.Now(), 0.0));
+
+        // Кадр короче периода: ждём ровно до срока (плюс просып таймера)
+        clock.Advance(0.004);
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 1);
+        CHECK(Near(clock.Now(), 0.011));
+        CHECK(Near(pacer.GetStats().lastWaitMs, 7.0));
+
+        // Сроки идут от предыдущего срока, а не от пробуждения: просып не накапливается
+        for (int frame = 2; frame <= 10; ++frame) {
+            clock.Advance(0.004);
+            pacer.BeginFrame();
+        }
+        CHECK(Near(clock.Now(), 0.101));
+        CHECK(Near(pacer.GetStats().lastIntervalMs, 10.0));
+        CHECK(pacer.GetStats().frames == 11);
+        CHECK(pacer.GetStats().missedDeadlines == 0);
+    }
+
+    void TestLateFrame() {
+        MockFrameClock clock;
+        FramePacer pacer;
+        pacer.Init(&clock, nullptr);
+        pacer.SetMode(PresentMode::Capped);
+        pacer.SetFrameCap(100);
+        pacer.BeginFrame();
+
+        // Опоздание меньше периода: кадр начинается сразу, следующий срок прежний
+        clock.Advance(0.015);
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 0);
+        CHECK(pacer.GetStats().missedDeadlines == 0);
+
+        clock.Advance(0.001);
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 1);
+        CHECK(Near(clock.Now(), 0.02));
+    }
+
+    void TestMissedDeadlineReset() {
+        MockFrameClock clock;
+        FramePacer pacer;
+        pacer.Init(&clock, nullptr);
+        pacer.SetMode(PresentMode::Capped);
+        pacer.SetFrameCap(100);
+        pacer.BeginFrame();
+
+        // Опоздание больше периода: срок пропущен, отсчёт заново от текущего времени без догонялок
+        clock.Advance(0.035);
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().missedDeadlines == 1);
+        CHECK(clock.GetSleepCount() == 0);
+
+        clock.Advance(0.002);
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 1);
+        CHECK(Near(clock.Now(), 0.045));
+        CHECK(pacer.GetStats().missedDeadlines == 1);
+
+        // Смена режима или частоты сбрасывает срок, но пропуском не считается
+        clock.Advance(0.5);
+        pacer.SetFrameCap(50);
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().missedDeadlines == 1);
+        CHECK(clock.GetSleepCount() == 1);
+
+        clock.Advance(0.005);
+        pacer.BeginFrame();
+        CHECK(clock.GetSleepCount() == 2);
+        CHECK(Near(clock.Now(), 0.565));
+    }
+
+    void TestUncappedModes() {
+        MockFrameClock clock;
+        FramePacer pacer;
+        pacer.Init(&clock, nullptr);
+
+        pacer.SetMode(PresentMode::VSync);
+        CHECK(pacer.GetSyncInterval() == 1 && !pacer.AllowTearing());
+        for (int frame = 0; frame < 3; ++frame) {
+            clock.Advance(0.001);
+            pacer.BeginFrame();
+        }
+
+        pacer.SetMode(PresentMode::Unlocked);
+        CHECK(pacer.GetSyncInterval() == 0 && pacer.AllowTearing());
+        for (int frame = 0; frame < 3; ++frame) {
+            clock.Advance(0.001);
+            pacer.BeginFrame();
+        }
+
+        // Без ограничения частоты таймер не спит
+        CHECK(clock.GetSleepCount() == 0);
+        CHECK(pacer.GetStats().frames == 6);
+        CHECK(Near(pacer.GetStats().lastIntervalMs, 1.0));
+    }
+
+    void TestWaitTimeouts() {
+        MockFrameClock clock;
+        MockFrameWaiter waiter(&clock);
+        FramePacer pacer;
+        pacer.Init(&clock, &waiter);
+
+        // Ожидание цепочки обмена входит во время ожидания кадра
+        waiter.SetWait(0.003, true);
+        pacer.BeginFrame();
+        CHECK(waiter.GetWaitCount() == 1);
+        CHECK(waiter.GetLastTimeoutMs() == FramePacer::WaitTimeoutMs);
+        CHECK(pacer.GetStats().waitTimeouts == 0);
+        CHECK(Near(pacer.GetStats().lastWaitMs, 3.0));
+
+        // Таймаут считается, но кадр не блокируется дольше таймаута
+        waiter.SetWait(0.0, false);
+        pacer.BeginFrame();
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().waitTimeouts == 2);
+        CHECK(pacer.GetStats().frames == 3);
+        CHECK(Near(pacer.GetStats().lastWaitMs, FramePacer::WaitTimeoutMs));
+
+        waiter.SetWait(0.0, true);
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().waitTimeouts == 2);
+
+        // После таймаута в режиме Capped срок тоже пропущен и отсчёт идёт заново
+        pacer.SetMode(PresentMode::Capped);
+        pacer.SetFrameCap(100);
+        pacer.BeginFrame();
+        waiter.SetWait(0.0, false);
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().waitTimeouts == 3);
+        CHECK(pacer.GetStats().missedDeadlines == 1);
+        CHECK(clock.GetSleepCount() == 0);
+    }
+
+    void TestNoClock() {
+        // Без Init кадр не меряется и не ждёт
+        FramePacer pacer;
+        pacer.BeginFrame();
+        CHECK(pacer.GetStats().frames == 0);
+    }
+}
+
+int main() {
+    TestDeadlineStepping();
+    TestLateFrame();
+    TestMissedDeadlineReset();
+    TestUncappedModes();
+    TestWaitTimeouts();
+    TestNoClock();
+    return TestResult();
+}
@@ -0,0 +1,282 @@
+#include "../MipGenerator.h"
+#include "TestCheck.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// MipGenerator против эталона в double и Scalar против SSE2 побитно
+namespace
+{
+    typedef MipGenerator::Filter Filter;
+
+    struct Image
+    {
+        uint32_t width;
+        uint32_t height;
+        std::vector<double> texels;
+    };
+
+    // Детерминированный шум, чтобы тест не зависел от реализации rand()
+    uint32_t NextRandom(uint32_t& state) {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    std::vector<uint8_t> MakePixels(uint32_t width, uint32_t height, uint32_t seed) {
+        std::vector<uint8_t> pixels(size_t(width) * height * 4);
+        uint32_t state = seed;
+        for (uint8_t& value : pixels)
+            value = static_cast<uint8_t>(NextRandom(state));
+        return pixels;
+    }
+
+    double SrgbToLinear(double value) {
+        return value <= 0.04045 ? value / 12.92 : pow((value + 0.055) / 1.055, 2.4);
+    }
+
+    double LinearToSrgb(double value) {
+        return value <= 0.0031308 ? value * 12.92 : 1.055 * pow(value, 1.0 / 2.4) - 0.055;
+    }
+
+    uint8_t EncodeReference(double value, bool srgb) {
+        value = value > 0.0 ? (value < 1.0 ? value : 1.0) : 0.0;
+        if (srgb)
+            value = LinearToSrgb(value);
+        return static_cast<uint8_t>(floor(value * 255.0 + 0.5));
+    }
+
+    double Sinc(double x) {
+        x *= 3.14159265358979323846;
+        return fabs(x) < 1e-9 ? 1.0 : sin(x) / x;
+    }
+
+    double BesselI0(double x) {
+        double sum = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 100; ++k) {
+            double half = x / (2.0 * k);
+            term *= half * half;
+            sum += term;
+        }
+        return sum;
+    }
+
+    double Kaiser(double t) {
+        const double alpha = 4.0;
+        return fabs(t) >= 1.0 ? 0.0 : BesselI0(alpha * sqrt(1.0 - t * t)) / BesselI0(alpha);
+    }
+
+    // Веса выходного текселя x по определению фильтра: за краем повторяется крайний тексель
+    std::vector<double> ReferenceWeights(uint32_t srcSize, uint32_t dstSize, uint32_t x, Filter filter) {
+        const double radius = 3.0;
+        const double scale = double(srcSize) / dstSize;
+        const double support = scale > 1.0 ? scale : 1.0;
+        const double center = (x + 0.5) * scale;
+        double lo = center - radius * support;
+        double hi = center + radius * support;
+        if (filter == Filter::Box) {
+            lo = x * scale;
+            hi = (x + 1) * scale;
+            if (hi - lo < 1.0) {
+                lo = floor(center);
+                hi = lo + 1.0;
+            }
+        }
+
+        std::vector<double> weights(srcSize, 0.0);
+        double sum = 0.0;
+        for (int i = static_cast<int>(floor(lo)); i < static_cast<int>(ceil(hi)); ++i) {
+            double weight = 0.0;
+            if (filter == Filter::Box) {
+                double a = lo > i ? lo : i;
+                double b = hi < i + 1 ? hi : i + 1;
+                weight = b > a ? b - a : 0.0;
+            } else {
+                double t = (i + 0.5 - center) / support;
+                weight = Sinc(t) * Kaiser(t / radius);
+            }
+            int clamped = i < 0 ? 0 : (i >= static_cast<int>(srcSize) ? static_cast<int>(srcSize) - 1 : i);
+            weights[clamped] += weight;
+            sum += weight;
+        }
+        for (double& weight : weights)
+            weight /= sum;
+        return weights;
+    }
+
+    Image ReferenceResample(const Image& source, uint32_t newWidth, uint32_t newHeight, Filter filter) {
+        Image rows = { newWidth, source.height, std::vector<double>(size_t(newWidth) * source.height * 4, 0.0) };
+        for (uint32_t x = 0; x < newWidth; ++x) {
+            std::vector<double> weights = ReferenceWeights(source.width, newWidth, x, filter);
+            for (uint32_t y = 0; y < source.height; ++y) {
+                for (uint32_t i = 0; i < source.width; ++i) {
+                    for (int c = 0; c < 4; ++c)
+                        rows.texels[(size_t(y) * newWidth + x) * 4 + c] += weights[i] * source.texels[(size_t(y) * source.width + i) * 4 + c];
+                }
+            }
+        }
+
+        Image result = { newWidth, newHeight, std::vector<double>(size_t(newWidth) * newHeight * 4, 0.0) };
+        for (uint32_t y = 0; y < newHeight; ++y) {
+            std::vector<double> weights = ReferenceWeights(source.height, newHeight, y, filter);
+            for (uint32_t i = 0; i < source.height; ++i) {
+                for (size_t k = 0; k < size_t(newWidth) * 4; ++k)
+                    result.texels[size_t(y) * newWidth * 4 + k] += weights[i] * rows.texels[size_t(i) * newWidth * 4 + k];
+            }
+        }
+        return result;
+    }
+
+    Image Decode(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, bool srgb) {
+        Image image = { width, height, std::vector<double>(pixels.size()) };
+        for (size_t i = 0; i < pixels.size(); ++i) {
+            double value = pixels[i] / 255.0;
+            image.texels[i] = srgb && i % 4 != 3 ? SrgbToLinear(value) : value;
+        }
+        return image;
+    }
+
+    // Отклонение от эталона не больше одного кода: float против double у границы округления
+    bool MatchesReference(const MipGenerator::Level& level, const Image& reference, bool srgb) {
+        for (uint32_t y = 0; y < level.height; ++y) {
+            const uint8_t* pRow = level.pPixels + y * level.rowPitch;
+            for (uint32_t i = 0; i < level.width * 4; ++i) {
+                int expected = EncodeReference(reference.texels[size_t(y) * level.width * 4 + i], srgb && i % 4 != 3);
+                int difference = pRow[i] - expected;
+                if (difference < -1 || difference > 1)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void TestChainAgainstReference(uint32_t width, uint32_t height, bool srgb, Filter filter) {
+        std::vector<uint8_t> pixels = MakePixels(width, height, width * 31 + height);
+        MipGenerator generator;
+        generator.SetPath(MipGenerator::Path::Scalar);
+        CHECK(generator.Generate(pixels.data(), width, height, size_t(width) * 4, srgb, filter));
+        CHECK(generator.GetLevelCount() == MipGenerator::CountMips(width, height));
+
+        // Эталон тоже строит каждый уровень из предыдущего, без промежуточного округления
+        Image reference = Decode(pixels, width, height, srgb);
+        for (uint32_t mip = 1; mip < generator.GetLevelCount(); ++mip) {
+            const MipGenerator::Level& level = generator.GetLevel(mip);
+            reference = ReferenceResample(reference, level.width, level.height, filter);
+            CHECK(MatchesReference(level, reference, srgb));
+        }
+    }
+
+    void TestResizeAgainstReference(bool srgb, Filter filter) {
+        const uint32_t width = 19;
+        const uint32_t height = 11;
+        std::vector<uint8_t> pixels = MakePixels(width, height, 7);
+        MipGenerator generator;
+        generator.SetPath(MipGenerator::Path::Scalar);
+
+        // Уменьшение и увеличение в нечётные размеры
+        const uint32_t sizes[2][2] = { { 7, 5 }, { 40, 23 } };
+        for (const uint32_t* size : sizes) {
+            std::vector<uint8_t> result;
+            CHECK(generator.Resize(pixels.data(), width, height, size_t(width) * 4, size[0], size[1], srgb, filter, result));
+            MipGenerator::Level level = { size[0], size[1], size_t(size[0]) * 4, result.data() };
+            CHECK(MatchesReference(level, ReferenceResample(Decode(pixels, width, height, srgb), size[0], size[1], filter), srgb));
+        }
+    }
+
+    void TestKnownValues() {
+        // 2x2 в 1x1 ящиком: среднее в линейном пространстве, а не в sRGB
+        const uint8_t pixels[16] = { 0, 0, 0, 0, 255, 255, 255, 255, 0, 0, 0, 0, 255, 255, 255, 255 };
+        MipGenerator generator;
+        CHECK(generator.Generate(pixels, 2, 2, 8, true, Filter::Box));
+        CHECK(generator.GetLevelCount() == 2);
+        const uint8_t* pLevel = generator.GetLevel(1).pPixels;
+        CHECK(pLevel[0] == 188 && pLevel[1] == 188 && pLevel[2] == 188);
+        CHECK(pLevel[3] == 128);
+
+        CHECK(generator.Generate(pixels, 2, 2, 8, false, Filter::Box));
+        CHECK(generator.GetLevel(1).pPixels[0] == 128);
+
+        CHECK(!generator.Generate(pixels, 0, 2, 8, false, Filter::Box));
+        CHECK(!generator.Generate(pixels, 2, 2, 4, false, Filter::Box));
+        CHECK(MipGenerator::CountMips(1, 1) == 1);
+        CHECK(MipGenerator::CountMips(256, 1) == 9);
+        CHECK(MipGenerator::CountMips(5, 3) == 3);
+    }
+
+    void TestPathsBitExact(uint32_t width, uint32_t height, size_t rowPitch, bool srgb, Filter filter) {
+        std::vector<uint8_t> pixels = MakePixels(static_cast<uint32_t>(rowPitch / 4), height, width + 5 * height);
+        MipGenerator scalar;
+        MipGenerator sse2;
+        scalar.SetPath(MipGenerator::Path::Scalar);
+        sse2.SetPath(MipGenerator::Path::SSE2);
+        CHECK(scalar.GetPath() == MipGenerator::Path::Scalar);
+        CHECK(scalar.Generate(pixels.data(), width, height, rowPitch, srgb, filter));
+        CHECK(sse2.Generate(pixels.data(), width, height, rowPitch, srgb, filter));
+        CHECK(scalar.GetLevelCount() == sse2.GetLevelCount());
+        for (uint32_t mip = 1; mip < scalar.GetLevelCount() && mip < sse2.GetLevelCount(); ++mip) {
+            const MipGenerator::Level& a = scalar.GetLevel(mip);
+            const MipGenerator::Level& b = sse2.GetLevel(mip);
+            CHECK(a.width == b.width && a.height == b.height);
+            CHECK(memcmp(a.pPixels, b.pPixels, size_t(a.width) * a.height * 4) == 0);
+        }
+    }
+
+    void TestKernelsBitExact() {
+        // Отдельные ядра на float вне [0, 1] и с NaN: кодирование обязано совпасть и на них
+        const uint32_t srcWidth = 13;
+        const uint32_t rows = 5;
+        std::vector<float> source(size_t(srcWidth) * rows * 4);
+        uint32_t state = 3;
+        for (float& value : source)
+            value = (NextRandom(state) % 3000) / 1000.0f - 1.0f;
+        source[5] = NAN;
+
+        const Filter filters[2] = { Filter::Box, Filter::Kaiser };
+        for (Filter filter : filters) {
+            const uint32_t dstWidth = 6;
+            MipGenerator::Taps tapsX;
+            MipGenerator::BuildTaps(srcWidth, dstWidth, filter, tapsX);
+            std::vector<float> a(size_t(dstWidth) * rows * 4);
+            std::vector<float> b(a.size());
+            MipGenerator::ResampleRowsScalar(source.data(), srcWidth, rows, tapsX, a.data(), dstWidth);
+            MipGenerator::ResampleRowsSSE2(source.data(), srcWidth, rows, tapsX, b.data(), dstWidth);
+            CHECK(memcmp(a.data(), b.data(), sizeof(float) * a.size()) == 0);
+
+            const uint32_t dstHeight = 3;
+            MipGenerator::Taps tapsY;
+            MipGenerator::BuildTaps(rows, dstHeight, filter, tapsY);
+            std::vector<float> c(size_t(dstWidth) * dstHeight * 4);
+            std::vector<float> d(c.size());
+            MipGenerator::ResampleColumnsScalar(a.data(), dstWidth, tapsY, c.data(), dstHeight);
+            MipGenerator::ResampleColumnsSSE2(a.data(), dstWidth, tapsY, d.data(), dstHeight);
+            CHECK(memcmp(c.data(), d.data(), sizeof(float) * c.size()) == 0);
+        }
+
+        const size_t texels = source.size() / 4;
+        for (int srgb = 0; srgb < 2; ++srgb) {
+            std::vector<uint8_t> a(source.size());
+            std::vector<uint8_t> b(source.size());
+            MipGenerator::EncodeScalar(source.data(), texels, srgb != 0, a.data());
+            MipGenerator::EncodeSSE2(source.data(), texels, srgb != 0, b.data());
+            CHECK(a == b);
+        }
+    }
+}
+
+int main() {
+    const Filter filters[2] = { Filter::Box, Filter::Kaiser };
+    for (Filter filter : filters) {
+        for (int srgb = 0; srgb < 2; ++srgb) {
+            TestChainAgainstReference(16, 16, srgb != 0, filter);
+            TestChainAgainstReference(13, 7, srgb != 0, filter);
+            TestChainAgainstReference(1, 9, srgb != 0, filter);
+            TestResizeAgainstReference(srgb != 0, filter);
+            TestPathsBitExact(64, 64, 64 * 4, srgb != 0, filter);
+            TestPathsBitExact(37, 23, 40 * 4, srgb != 0, filter);
+            TestPathsBitExact(3, 1, 3 * 4, srgb != 0, filter);
+        }
+    }
+    TestKnownValues();
+    TestKernelsBitExact();
+    return TestResult();
+}
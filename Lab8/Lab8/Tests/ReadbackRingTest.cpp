@@ -0,0 +1,114 @@
+#include "../ReadbackRing.h"
+#include "TestCheck.h"
+
+// Кольцо чтения поверх MockReadbackDevice: порядок кадров, занятый слот и переход через конец кольца
+namespace
+{
+    bool EnqueueValue(ReadbackRing& ring, uint64_t frame, uint32_t value) {
+        ReadbackCopy copy = { &value, 0, 0, sizeof(value) };
+        return ring.Enqueue(frame, &copy, 1);
+    }
+
+    void TestOrder() {
+        MockReadbackDevice device(2);
+        ReadbackRing ring;
+        CHECK(ring.Init(&device, 3, sizeof(uint32_t)));
+
+        uint32_t value = 0;
+        uint64_t frame = 0;
+        CHECK(EnqueueValue(ring, 1, 100));
+        CHECK(!ring.TryRead(&value, sizeof(value), &frame));
+
+        device.Advance();
+        CHECK(EnqueueValue(ring, 2, 200));
+        device.Advance();
+
+        // Готов только первый кадр: второй сигнализирован кадром позже
+        CHECK(ring.TryRead(&value, sizeof(value), &frame));
+        CHECK(value == 100 && frame == 1);
+        CHECK(ring.GetLatency() == 1);
+
+        device.Advance();
+        CHECK(ring.TryRead(&value, sizeof(value), &frame));
+        CHECK(value == 200 && frame == 2);
+        CHECK(!ring.TryRead(&value, sizeof(value), &frame));
+
+        // Из нескольких готовых берётся самый свежий, более старые отбрасываются
+        CHECK(EnqueueValue(ring, 3, 300));
+        CHECK(EnqueueValue(ring, 4, 400));
+        device.Advance();
+        device.Advance();
+        CHECK(ring.TryRead(&value, sizeof(value), &frame));
+        CHECK(value == 400 && frame == 4);
+        CHECK(!ring.TryRead(&value, sizeof(value), &frame));
+        CHECK(ring.GetLatency() == 0);
+    }
+
+    void TestBusySlot() {
+        MockReadbackDevice device(5);
+        ReadbackRing ring;
+        CHECK(ring.Init(&device, 2, sizeof(uint32_t)));
+
+        CHECK(EnqueueValue(ring, 1, 10));
+        CHECK(EnqueueValue(ring, 2, 20));
+        // Оба слота ещё в пути: кадр пропускается, а не ждёт GPU
+        CHECK(!EnqueueValue(ring, 3, 30));
+        CHECK(ring.GetDroppedFrames() == 1);
+
+        for (int i = 0; i < 5; ++i)
+            device.Advance();
+        // Слот готов, но не прочитан - его всё равно можно переписать
+        CHECK(EnqueueValue(ring, 4, 40));
+        CHECK(ring.GetDroppedFrames() == 1);
+
+        uint32_t value = 0;
+        uint64_t frame = 0;
+        CHECK(ring.TryRead(&value, sizeof(value), &frame));
+        CHECK(value == 20 && frame == 2);
+    }
+
+    void TestWrapAround() {
+        MockReadbackDevice device(1);
+        ReadbackRing ring;
+        CHECK(ring.Init(&device, 3, sizeof(uint32_t)));
+
+        // Десять кругов по трём слотам: каждый кадр читается на следующем
+        for (uint32_t f = 1; f <= 30; ++f) {
+            CHECK(EnqueueValue(ring, f, f * 7));
+            device.Advance();
+
+            uint32_t value = 0;
+            uint64_t frame = 0;
+            CHECK(ring.TryRead(&value, sizeof(value), &frame));
+            CHECK(value == f * 7 && frame == f);
+        }
+        CHECK(ring.GetDroppedFrames() == 0);
+    }
+
+    void TestCopyBounds() {
+        MockReadbackDevice device(0);
+        ReadbackRing ring;
+        CHECK(!ring.Init(&device, 0, 4));
+        CHECK(ring.Init(&device, 1, 2 * sizeof(uint32_t)));
+
+        // Копия за пределы слота отбрасывается, остальные доходят
+        uint32_t source[3] = { 1, 2, 3 };
+        ReadbackCopy copies[2] = {
+            { source, 0, 0, 2 * sizeof(uint32_t) },
+            { source, 0, sizeof(uint32_t), 2 * sizeof(uint32_t) }
+        };
+        CHECK(ring.Enqueue(1, copies, 2));
+
+        uint32_t result[2] = {};
+        CHECK(ring.TryRead(result, sizeof(result)));
+        CHECK(result[0] == 1 && result[1] == 2);
+    }
+}
+
+int main() {
+    TestOrder();
+    TestBusySlot();
+    TestWrapAround();
+    TestCopyBounds();
+    return TestResult();
+}
@@ -0,0 +1,187 @@
+#include "../RenderGraph.h"
+#include "TestCheck.h"
+
+// Compile: отбрасывание ненужных проходов, порядок с учётом записи после чтения,
+// делёж физических слотов по времени жизни и отказ на циклах и ошибках объявления
+namespace
+{
+    const RenderGraphTextureDesc ColorDesc = { 64, 64, 28, 0x28, 4 };
+    const RenderGraphTextureDesc HalfDesc = { 32, 32, 28, 0x28, 4 };
+
+    uint32_t PositionOf(const RenderGraph& graph, uint32_t pass) {
+        const std::vector<uint32_t>& order = graph.GetOrder();
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            if (order[i] == pass)
+                return i;
+        }
+        return RenderGraph::InvalidIndex;
+    }
+
+    void TestCulling() {
+        RenderGraph graph;
+        uint32_t first = graph.AddPass("first");
+        uint32_t overwrite = graph.AddPass("overwrite");
+        uint32_t unused = graph.AddPass("unused");
+        uint32_t present = graph.AddPass("present");
+
+        RenderGraph::Handle scene = graph.CreateTexture("scene", ColorDesc);
+        RenderGraph::Handle debug = graph.CreateTexture("debug", ColorDesc);
+        RenderGraph::Handle backBuffer = graph.ImportTexture("backbuffer");
+
+        // Первая запись перезаписана целиком без чтения - её проход не нужен
+        scene = graph.Write(first, scene);
+        scene = graph.Write(overwrite, scene);
+        graph.Read(unused, scene);
+        graph.Write(unused, debug);
+        graph.Read(present, scene);
+        graph.MarkOutput(graph.Write(present, backBuffer));
+
+        CHECK(graph.Compile());
+        CHECK(graph.IsCulled(first));
+        CHECK(!graph.IsCulled(overwrite));
+        CHECK(graph.IsCulled(unused));
+        CHECK(!graph.IsCulled(present));
+        CHECK(graph.GetOrder().size() == 2);
+        CHECK(PositionOf(graph, overwrite) < PositionOf(graph, present));
+        CHECK(graph.GetStats().passes == 4 && graph.GetStats().culledPasses == 2);
+
+        // Текстура, которой пользуются только отброшенные проходы, слота не получает
+        CHECK(graph.GetPhysical(graph.GetResource(debug)) == RenderGraph::InvalidIndex);
+        CHECK(graph.GetPhysical(graph.GetResource(backBuffer)) == RenderGraph::InvalidIndex);
+    }
+
+    void TestWriteAfterRead() {
+        RenderGraph graph;
+        uint32_t produce = graph.AddPass("produce");
+        uint32_t overwrite = graph.AddPass("overwrite");
+        uint32_t read = graph.AddPass("read");
+
+        RenderGraph::Handle scene = graph.CreateTexture("scene", ColorDesc);
+        RenderGraph::Handle result = graph.ImportTexture("result");
+        RenderGraph::Handle first = graph.Write(produce, scene);
+        RenderGraph::Handle second = graph.Write(overwrite, first);
+        graph.Read(read, first);
+        graph.MarkOutput(graph.Write(read, result));
+        graph.MarkOutput(second);
+
+        // overwrite объявлен раньше read, но обязан ждать, пока read дочитает первую версию
+        CHECK(graph.Compile());
+        CHECK(graph.GetOrder().size() == 3);
+        CHECK(PositionOf(graph, produce) < PositionOf(graph, read));
+        CHECK(PositionOf(graph, read) < PositionOf(graph, overwrite));
+    }
+
+    void TestDeclarationOrder() {
+        RenderGraph graph;
+        uint32_t a = graph.AddPass("a");
+        uint32_t b = graph.AddPass("b");
+        RenderGraph::Handle left = graph.ImportTexture("left");
+        RenderGraph::Handle right = graph.ImportTexture("right");
+        graph.MarkOutput(graph.Write(a, left));
+        graph.MarkOutput(graph.Write(b, right));
+
+        // Независимые проходы идут в порядке объявления
+        CHECK(graph.Compile());
+        CHECK(graph.GetOrder().size() == 2);
+        CHECK(graph.GetOrder()[0] == a && graph.GetOrder()[1] == b);
+    }
+
+    void TestAliasing() {
+        RenderGraph graph;
+        uint32_t p0 = graph.AddPass("p0");
+        uint32_t p1 = graph.AddPass("p1");
+        uint32_t p2 = graph.AddPass("p2");
+        uint32_t p3 = graph.AddPass("p3");
+
+        RenderGraph::Handle a = graph.CreateTexture("a", ColorDesc);
+        RenderGraph::Handle b = graph.CreateTexture("b", ColorDesc);
+        RenderGraph::Handle c = graph.CreateTexture("c", ColorDesc);
+        RenderGraph::Handle half = graph.CreateTexture("half", HalfDesc);
+        RenderGraph::Handle output = graph.ImportTexture("output");
+
+        // a живёт [0, 1], b - [1, 2], c - [2, 3]; half того же времени, что c, но другого размера
+        a = graph.Write(p0, a);
+        graph.Read(p1, a);
+        b = graph.Write(p1, b);
+        graph.Read(p2, b);
+        c = graph.Write(p2, c);
+        half = graph.Write(p2, half);
+        graph.Read(p3, c);
+        graph.Read(p3, half);
+        graph.MarkOutput(graph.Write(p3, output));
+
+        CHECK(graph.Compile());
+        uint32_t ra = graph.GetResource(a);
+        uint32_t rb = graph.GetResource(b);
+        uint32_t rc = graph.GetResource(c);
+        uint32_t rh = graph.GetResource(half);
+        CHECK(graph.GetFirstUse(ra) == 0 && graph.GetLastUse(ra) == 1);
+        CHECK(graph.GetFirstUse(rb) == 1 && graph.GetLastUse(rb) == 2);
+        CHECK(graph.GetFirstUse(rc) == 2 && graph.GetLastUse(rc) == 3);
+
+        // b начинается там, где a кончается: lastUse < firstUse не выполнено, слот свой.
+        // c начинается после конца a и занимает его слот
+        CHECK(graph.GetPhysical(ra) != graph.GetPhysical(rb));
+        CHECK(graph.GetPhysical(rc) == graph.GetPhysical(ra));
+        CHECK(graph.GetPhysical(rh) != graph.GetPhysical(ra) && graph.GetPhysical(rh) != graph.GetPhysical(rb));
+        CHECK(graph.GetPhysicalCount() == 3);
+
+        const RenderGraph::Stats& stats = graph.GetStats();
+        CHECK(stats.transientTextures == 4 && stats.physicalTextures == 3);
+        CHECK(stats.requestedBytes == 3ull * 64 * 64 * 4 + 32 * 32 * 4);
+        CHECK(stats.allocatedBytes == 2ull * 64 * 64 * 4 + 32 * 32 * 4);
+    }
+
+    void TestCycle() {
+        RenderGraph graph;
+        uint32_t a = graph.AddPass("a");
+        uint32_t b = graph.AddPass("b");
+        RenderGraph::Handle x = graph.CreateTexture("x", ColorDesc);
+        RenderGraph::Handle y = graph.CreateTexture("y", ColorDesc);
+
+        // a пишет x и читает y, который пишет b по x
+        x = graph.Write(a, x);
+        graph.Read(b, x);
+        y = graph.Write(b, y);
+        graph.Read(a, y);
+        graph.MarkOutput(y);
+
+        CHECK(!graph.Compile());
+        CHECK(graph.GetOrder().empty());
+    }
+
+    void TestInvalidDeclarations() {
+        RenderGraph graph;
+        uint32_t a = graph.AddPass("a");
+        RenderGraph::Handle x = graph.CreateTexture("x", ColorDesc);
+        RenderGraph::Handle x1 = graph.Write(a, x);
+        graph.MarkOutput(x1);
+        CHECK(graph.Compile());
+
+        // Запись в устаревшую версию ломает граф до Reset
+        CHECK(graph.Write(a, x) == RenderGraph::InvalidIndex);
+        CHECK(!graph.Compile());
+        CHECK(graph.GetOrder().empty());
+
+        graph.Reset();
+        a = graph.AddPass("a");
+        graph.Read(a + 1, 0);
+        CHECK(!graph.Compile());
+
+        graph.Reset();
+        a = graph.AddPass("a");
+        graph.MarkOutput(graph.Write(a, graph.ImportTexture("out")));
+        CHECK(graph.Compile());
+        CHECK(graph.GetOrder().size() == 1);
+    }
+}
+
+int main() {
+    TestCulling();
+    TestWriteAfterRead();
+    TestDeclarationOrder();
+    TestAliasing();
+    TestCycle();
+    TestInvalidDeclarations();
+    return TestResult();
+}
@@ -0,0 +1,182 @@
+#include "../RecordingStateContext.h"
+#include "TestCheck.h"
+
+// StateTrackerT поверх записывающего контекста: что доходит до контекста, а что отбрасывается
+namespace
+{
+    bool LastCallIs(const RecordingStateContext& context, const char* name, uint32_t startSlot, uint32_t count) {
+        if (context.GetCalls().empty())
+            return false;
+        const RecordedCall& call = context.GetCalls().back();
+        return call.name == name && call.startSlot == startSlot && call.count == count;
+    }
+
+    void TestCounters() {
+        RecordingStateContext context;
+        RecordingStateTracker tracker;
+        tracker.Init(&context, &context);
+
+        RecordedResource shader = { 1 };
+        RecordedResource other = { 2 };
+        tracker.VSSetShader(&shader);
+        tracker.VSSetShader(&shader);
+        tracker.VSSetShader(&other);
+        tracker.IASetPrimitiveTopology(4);
+        tracker.IASetPrimitiveTopology(4);
+
+        CHECK(context.CountCalls("VSSetShader") == 2);
+        CHECK(context.CountCalls("IASetPrimitiveTopology") == 1);
+        CHECK(tracker.GetIssuedCalls() == 3);
+        CHECK(tracker.GetDroppedCalls() == 2);
+        CHECK(tracker.GetFrameIssued() == 3 && tracker.GetFrameDropped() == 2);
+
+        tracker.BeginFrame();
+        CHECK(tracker.GetLastFrameIssued() == 3 && tracker.GetLastFrameDropped() == 2);
+        CHECK(tracker.GetFrameIssued() == 0 && tracker.GetFrameDropped() == 0);
+
+        // После Invalidate тот же шейдер снова доходит до контекста
+        tracker.Invalidate();
+        tracker.VSSetShader(&other);
+        CHECK(context.CountCalls("VSSetShader") == 3);
+        CHECK(tracker.GetIssuedCalls() == 4);
+    }
+
+    void TestPartialRanges() {
+        RecordingStateContext context;
+        RecordingStateTracker tracker;
+        tracker.Init(&context, &context);
+
+        RecordedResource views[6] = { { 1 }, { 2 }, { 3 }, { 4 }, { 5 }, { 6 } };
+        RecordedResource* first[4] = { &views[0], &views[1], &views[2], &views[3] };
+        tracker.PSSetShaderResources(0, 4, first);
+        CHECK(LastCallIs(context, "PSSetShaderResources", 0, 4));
+
+        // Изменились только слоты 1 и 2 - до контекста доходит только [1, 3)
+        RecordedResource* second[4] = { &views[0], &views[4], &views[5], &views[3] };
+        tracker.PSSetShaderResources(0, 4, second);
+        CHECK(LastCallIs(context, "PSSetShaderResources", 1, 2));
+
+        tracker.PSSetShaderResources(0, 4, second);
+        CHECK(context.CountCalls("PSSetShaderResources") == 2);
+
+        // Слоты за пределами копии не отслеживаются, вызов передаётся целиком
+        RecordedResource* wide[2] = { &views[0], &views[1] };
+        const uint32_t lastSlot = RecordingStateTracker::ResourceSlots - 1;
+        tracker.PSSetShaderResources(lastSlot, 2, wide);
+        tracker.PSSetShaderResources(lastSlot, 2, wide);
+        CHECK(context.CountCalls("PSSetShaderResources") == 4);
+        CHECK(LastCallIs(context, "PSSetShaderResources", lastSlot, 2));
+    }
+
+    void TestConstantBufferRanges() {
+        RecordingStateContext context;
+        RecordingStateTracker tracker;
+        tracker.Init(&context, &context);
+
+        RecordedResource ring = { 1 };
+        RecordedResource* buffers[1] = { &ring };
+        uint32_t firstConstant = 0;
+        uint32_t numConstants = 16;
+        tracker.VSSetConstantBuffers1(1, 1, buffers, &firstConstant, &numConstants);
+        tracker.VSSetConstantBuffers1(1, 1, buffers, &firstConstant, &numConstants);
+        CHECK(context.CountCalls("VSSetConstantBuffers1") == 1);
+
+        // Тот же буфер с другим участком - это новая привязка
+        firstConstant = 16;
+        tracker.VSSetConstantBuffers1(1, 1, buffers, &firstConstant, &numConstants);
+        CHECK(context.CountCalls("VSSetConstantBuffers1") == 2);
+        CHECK(LastCallIs(context, "VSSetConstantBuffers1", 1, 1));
+
+        // Обычная привязка хранится как участок 0/0 и не совпадает с участком *1
+        tracker.VSSetConstantBuffers(1, 1, buffers);
+        tracker.VSSetConstantBuffers(1, 1, buffers);
+        CHECK(context.CountCalls("VSSetConstantBuffers") == 1);
+    }
+
+    void TestResourceInvalidation() {
+        RecordingStateContext context;
+        RecordingStateTracker tracker;
+        tracker.Init(&context, &context);
+
+        RecordedResource texture = { 1 };
+        RecordedResource target = { 2 };
+        RecordedResource depth = { 3 };
+        RecordedResource uav = { 4 };
+        RecordedResource* views[1] = { &texture };
+        RecordedResource* targets[1] = { &target };
+        RecordedResource* uavs[1] = { &uav };
+
+        tracker.PSSetShaderResources(0, 1, views);
+        tracker.CSSetShaderResources(0, 1, views);
+        tracker.OMSetRenderTargets(1, targets, &depth);
+
+        // Смена целей могла отвязать SRV в контексте, поэтому повторная привязка доходит
+        tracker.PSSetShaderResources(0, 1, views);
+        tracker.CSSetShaderResources(0, 1, views);
+        CHECK(context.CountCalls("PSSetShaderResources") == 2);
+        CHECK(context.CountCalls("CSSetShaderResources") == 2);
+
+        // Отброшенная смена целей ничего не сбрасывает
+        tracker.OMSetRenderTargets(1, targets, &depth);
+        tracker.PSSetShaderResources(0, 1, views);
+        CHECK(context.CountCalls("OMSetRenderTargets") == 1);
+        CHECK(context.CountCalls("PSSetShaderResources") == 2);
+
+        tracker.CSSetUnorderedAccessViews(0, 1, uavs, nullptr);
+        tracker.CSSetShaderResources(0, 1, views);
+        CHECK(context.CountCalls("CSSetShaderResources") == 3);
+
+        // Тот же UAV без счётчиков отбрасывается и SRV не трогает
+        tracker.CSSetUnorderedAccessViews(0, 1, uavs, nullptr);
+        tracker.CSSetShaderResources(0, 1, views);
+        CHECK(context.CountCalls("CSSetUnorderedAccessViews") == 1);
+        CHECK(context.CountCalls("CSSetShaderResources") == 3);
+
+        // Со счётчиками вызов проходит всегда
+        uint32_t initialCount = 0;
+        tracker.CSSetUnorderedAccessViews(0, 1, uavs, &initialCount);
+        tracker.CSSetShaderResources(0, 1, views);
+        CHECK(context.CountCalls("CSSetUnorderedAccessViews") == 2);
+        CHECK(context.CountCalls("CSSetShaderResources") == 4);
+    }
+
+    void TestCompositeState() {
+        RecordingStateContext context;
+        RecordingStateTracker tracker;
+        tracker.Init(&context, &context);
+
+        RecordedResource blend = { 1 };
+        const float ones[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        tracker.OMSetBlendState(&blend, nullptr, 0xffffffff);
+        // nullptr вместо коэффициентов - то же, что { 1, 1, 1, 1 }
+        tracker.OMSetBlendState(&blend, ones, 0xffffffff);
+        tracker.OMSetBlendState(&blend, ones, 0x0000ffff);
+        CHECK(context.CountCalls("OMSetBlendState") == 2);
+
+        RecordedViewport viewport = { 0.0f, 0.0f, 640.0f, 480.0f, 0.0f, 1.0f };
+        tracker.RSSetViewports(1, &viewport);
+        tracker.RSSetViewports(1, &viewport);
+        viewport.width = 320.0f;
+        tracker.RSSetViewports(1, &viewport);
+        CHECK(context.CountCalls("RSSetViewports") == 2);
+
+        RecordedResource buffer = { 2 };
+        RecordedResource* buffers[1] = { &buffer };
+        uint32_t stride = 32;
+        uint32_t offset = 0;
+        tracker.IASetVertexBuffers(0, 1, buffers, &stride, &offset);
+        tracker.IASetVertexBuffers(0, 1, buffers, &stride, &offset);
+        offset = 64;
+        tracker.IASetVertexBuffers(0, 1, buffers, &stride, &offset);
+        CHECK(context.CountCalls("IASetVertexBuffers") == 2);
+    }
+}
+
+int main() {
+    TestCounters();
+    TestPartialRanges();
+    TestConstantBufferRanges();
+    TestResourceInvalidation();
+    TestCompositeState();
+    return TestResult();
+}
@@ -0,0 +1,26 @@
+// Заглушка winadapter.h из DirectX-Headers: ровно то, что нужно разбору DDS в LoaderHelpers.h
+// вне Windows. Подключается только тестами CMake.
+#pragma once
+
+#include <cstdint>
+
+typedef int32_t HRESULT;
+typedef uint32_t UINT;
+
+#define S_OK ((HRESULT)0)
+#define E_FAIL ((HRESULT)0x80004005L)
+#define E_POINTER ((HRESULT)0x80004003L)
+#define E_INVALIDARG ((HRESULT)0x80070057L)
+#define E_OUTOFMEMORY ((HRESULT)0x8007000EL)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+// Аннотации SAL без смысла для GCC и Clang
+#define _In_
+#define _In_z_
+#define _In_reads_(x)
+#define _In_reads_bytes_(x)
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _Out_writes_(x)
@@ -0,0 +1,27 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cstdio>
+
+// Минимальная проверка для тестов CMake: печатает место провала и считает провалы,
+// код возврата main - TestResult()
+inline int& TestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(expr) \
+    do { \
+        if (!(expr)) { \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+            ++TestFailures(); \
+        } \
+    } while (0)
+
+inline int TestResult() {
+    if (TestFailures() != 0)
+        fprintf(stderr, "%d check(s) failed\n", TestFailures());
+    return TestFailures() == 0 ? 0 : 1;
+}
+
+#endif
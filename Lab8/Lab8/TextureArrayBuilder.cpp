@@ -0,0 +1,70 @@
+#include "TextureArrayBuilder.h"
+#include <cstring>
+
+TextureArrayBuilder::TextureArrayBuilder() :
+    m_width(0),
+    m_height(0),
+    m_channels(Channels::RGBA),
+    m_srgb(false),
+    m_filter(MipGenerator::Filter::Box)
+{
+}
+
+void TextureArrayBuilder::Init(uint32_t layerCount, uint32_t width, uint32_t height, Channels channels, bool srgb, MipGenerator::Filter filter) {
+    m_layers.clear();
+    m_layers.resize(layerCount);
+    m_width = width;
+    m_height = height;
+    m_channels = channels;
+    m_srgb = srgb;
+    m_filter = filter;
+}
+
+bool TextureArrayBuilder::SetLayer(uint32_t layer, const Image& image) {
+    if (layer >= m_layers.size() || !image.pPixels || image.width == 0 || image.height == 0 || image.rowPitch < size_t(image.width) * 4)
+        return false;
+
+    Layer& target = m_layers[layer];
+    target.ready = false;
+    target.pixels.clear();
+
+    const uint8_t* pPixels = image.pPixels;
+    size_t rowPitch = image.rowPitch;
+    const size_t texels = size_t(m_width) * m_height;
+    if (image.width != m_width || image.height != m_height) {
+        if (!target.mips.Resize(image.pPixels, image.width, image.height, image.rowPitch, m_width, m_height, m_srgb, m_filter, target.pixels))
+            return false;
+        pPixels = target.pixels.data();
+        rowPitch = size_t(m_width) * 4;
+    }
+
+    if (image.channels != m_channels) {
+        if (target.pixels.empty()) {
+            target.pixels.resize(texels * 4);
+            for (uint32_t y = 0; y < m_height; ++y)
+                memcpy(&target.pixels[size_t(y) * m_width * 4], image.pPixels + y * image.rowPitch, size_t(m_width) * 4);
+            pPixels = target.pixels.data();
+            rowPitch = size_t(m_width) * 4;
+        }
+        SwapRedBlue(target.pixels.data(), texels);
+    }
+
+    target.ready = target.mips.Generate(pPixels, m_width, m_height, rowPitch, m_srgb, m_filter);
+    return target.ready;
+}
+
+bool TextureArrayBuilder::IsComplete() const {
+    for (const Layer& layer : m_layers) {
+        if (!layer.ready)
+            return false;
+    }
+    return !m_layers.empty();
+}
+
+void TextureArrayBuilder::SwapRedBlue(uint8_t* pPixels, size_t texels) {
+    for (size_t i = 0; i < texels; ++i, pPixels += 4) {
+        uint8_t red = pPixels[0];
+        pPixels[0] = pPixels[2];
+        pPixels[2] = red;
+    }
+}
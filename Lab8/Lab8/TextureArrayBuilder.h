@@ -0,0 +1,71 @@
+#ifndef TEXTURE_ARRAY_BUILDER_H
+#define TEXTURE_ARRAY_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "MipGenerator.h"
+
+// Готовит слои массива текстур: приводит картинки к общему размеру и порядку каналов
+// и строит каждой цепочку мипов, чтобы массив создавался одним вызовом со всеми
+// начальными данными. Слои независимы: SetLayer для разных индексов можно вызывать
+// из разных потоков. Не зависит от D3D11.
+class TextureArrayBuilder
+{
+public:
+    enum class Channels
+    {
+        RGBA,
+        BGRA
+    };
+
+    struct Image
+    {
+        const uint8_t* pPixels;
+        uint32_t width;
+        uint32_t height;
+        size_t rowPitch;
+        Channels channels;
+    };
+
+    TextureArrayBuilder();
+
+    // srgb - цвет во всех слоях хранится в sRGB и фильтруется в линейном пространстве
+    void Init(uint32_t layerCount, uint32_t width, uint32_t height, Channels channels, bool srgb, MipGenerator::Filter filter);
+
+    // Подходящая картинка не копируется и должна жить, пока нужны уровни;
+    // картинка другого размера или порядка каналов пересчитывается в свой буфер
+    bool SetLayer(uint32_t layer, const Image& image);
+
+    uint32_t GetLayerCount() const { return static_cast<uint32_t>(m_layers.size()); }
+    uint32_t GetWidth() const { return m_width; }
+    uint32_t GetHeight() const { return m_height; }
+    uint32_t GetMipCount() const { return MipGenerator::CountMips(m_width, m_height); }
+    Channels GetChannels() const { return m_channels; }
+    bool IsSRGB() const { return m_srgb; }
+
+    // Все слои получили картинки
+    bool IsComplete() const;
+    const MipGenerator::Level& GetLevel(uint32_t layer, uint32_t mip) const { return m_layers[layer].mips.GetLevel(mip); }
+
+private:
+    struct Layer
+    {
+        Layer() : ready(false) {}
+
+        std::vector<uint8_t> pixels;
+        MipGenerator mips;
+        bool ready;
+    };
+
+    static void SwapRedBlue(uint8_t* pPixels, size_t texels);
+
+    std::vector<Layer> m_layers;
+    uint32_t m_width;
+    uint32_t m_height;
+    Channels m_channels;
+    bool m_srgb;
+    MipGenerator::Filter m_filter;
+};
+
+#endif
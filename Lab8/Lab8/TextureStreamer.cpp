@@ -0,0 +1,173 @@
+#include "TextureStreamer.h"
+#include <algorithm>
+#include <cmath>
+
+TextureStreamer::TextureStreamer() :
+    m_budget(UINT64_MAX)
+{
+}
+
+uint32_t TextureStreamer::Add(const uint64_t* pMipBytes, uint32_t mipCount, uint32_t tailMip) {
+    TextureState texture = {};
+    texture.mipCount = mipCount < MaxMips ? mipCount : MaxMips;
+    texture.tailMip = std::min(tailMip, texture.mipCount - 1);
+    texture.allocatedMip = texture.tailMip;
+    texture.residentMip = texture.tailMip;
+    texture.wantedMip = texture.tailMip;
+    for (uint32_t i = 0; i < texture.mipCount; ++i)
+        texture.mipBytes[i] = pMipBytes[i];
+
+    m_textures.push_back(texture);
+    return static_cast<uint32_t>(m_textures.size() - 1);
+}
+
+void TextureStreamer::Clear() {
+    m_textures.clear();
+}
+
+void TextureStreamer::SetWantedMip(uint32_t texture, uint32_t mip) {
+    TextureState& state = m_textures[texture];
+    state.wantedMip = std::min(mip, state.tailMip);
+}
+
+uint64_t TextureStreamer::GetBytes(const TextureState& texture, uint32_t firstMip) {
+    uint64_t bytes = 0;
+    for (uint32_t i = firstMip; i < texture.mipCount; ++i)
+        bytes += texture.mipBytes[i];
+    return bytes;
+}
+
+uint64_t TextureStreamer::GetAllocatedBytes(uint32_t texture) const {
+    return GetBytes(m_textures[texture], m_textures[texture].allocatedMip);
+}
+
+uint64_t TextureStreamer::GetAllocatedBytes() const {
+    uint64_t bytes = 0;
+    for (const TextureState& texture : m_textures)
+        bytes += GetBytes(texture, texture.allocatedMip);
+    return bytes;
+}
+
+void TextureStreamer::Plan(std::vector<Action>& actions, uint32_t maxFetches) {
+    actions.clear();
+    const uint32_t count = GetTextureCount();
+    std::vector<uint32_t> allocated(count);
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        allocated[i] = m_textures[i].allocatedMip;
+        total += GetBytes(m_textures[i], allocated[i]);
+    }
+
+    // Кого выселять: сперва мипы детальнее нужного, затем текстуры с самым детальным верхним мипом
+    auto pickVictim = [&](bool onlyUnneeded) {
+        uint32_t victim = count;
+        for (uint32_t i = 0; i < count; ++i) {
+            const TextureState& texture = m_textures[i];
+            if (allocated[i] >= texture.tailMip)
+                continue;
+            if (onlyUnneeded && allocated[i] >= texture.wantedMip)
+                continue;
+            if (victim == count || texture.mipBytes[allocated[i]] > m_textures[victim].mipBytes[allocated[victim]])
+                victim = i;
+        }
+        return victim;
+    };
+    auto evict = [&](uint32_t victim) {
+        total -= m_textures[victim].mipBytes[allocated[victim]];
+        ++allocated[victim];
+    };
+
+    while (total > m_budget) {
+        uint32_t victim = pickVictim(true);
+        if (victim == count)
+            victim = pickVictim(false);
+        if (victim == count)
+            break;
+        evict(victim);
+    }
+
+    // Расширение: каждой недодетализированной текстуре - сколько влезет в бюджет,
+    // при нехватке место освобождают только ненужные другим мипы
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (m_textures[i].wantedMip < allocated[i])
+            order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return allocated[a] - m_textures[a].wantedMip > allocated[b] - m_textures[b].wantedMip;
+    });
+    for (uint32_t i : order) {
+        const TextureState& texture = m_textures[i];
+        while (allocated[i] > texture.wantedMip) {
+            uint64_t bytes = texture.mipBytes[allocated[i] - 1];
+            while (total + bytes > m_budget) {
+                uint32_t victim = pickVictim(true);
+                if (victim == count || victim == i)
+                    break;
+                evict(victim);
+            }
+            if (total + bytes > m_budget)
+                break;
+            total += bytes;
+            --allocated[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        if (allocated[i] != m_textures[i].allocatedMip)
+            actions.push_back({ ActionKind::Reallocate, i, allocated[i] });
+    }
+
+    // Загрузки идут от грубого к детальному, по одному мипу на текстуру
+    uint32_t fetching = 0;
+    for (const TextureState& texture : m_textures)
+        fetching += texture.fetching ? 1 : 0;
+
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < count; ++i) {
+        const TextureState& texture = m_textures[i];
+        uint32_t resident = std::max(texture.residentMip, allocated[i]);
+        if (!texture.fetching && resident > allocated[i] && resident > texture.wantedMip)
+            candidates.push_back(i);
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](uint32_t a, uint32_t b) {
+        return std::max(m_textures[a].residentMip, allocated[a]) - m_textures[a].wantedMip >
+            std::max(m_textures[b].residentMip, allocated[b]) - m_textures[b].wantedMip;
+    });
+    for (uint32_t i : candidates) {
+        if (fetching >= maxFetches)
+            break;
+        uint32_t resident = std::max(m_textures[i].residentMip, allocated[i]);
+        actions.push_back({ ActionKind::Fetch, i, resident - 1 });
+        m_textures[i].fetching = true;
+        ++fetching;
+    }
+}
+
+void TextureStreamer::OnReallocated(uint32_t texture, uint32_t mip) {
+    TextureState& state = m_textures[texture];
+    state.allocatedMip = std::min(mip, state.tailMip);
+    state.residentMip = std::max(state.residentMip, state.allocatedMip);
+}
+
+bool TextureStreamer::OnFetched(uint32_t texture, uint32_t mip, bool succeeded) {
+    TextureState& state = m_textures[texture];
+    state.fetching = false;
+    if (!succeeded || mip < state.allocatedMip || mip + 1 != state.residentMip)
+        return false;
+    state.residentMip = mip;
+    return true;
+}
+
+uint32_t TextureStreamer::SelectMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels) {
+    if (mipCount == 0)
+        return 0;
+    if (!(screenPixels > 1.0f))
+        return mipCount - 1;
+
+    float texels = static_cast<float>(std::max(width, height));
+    float mip = std::floor(std::log2(texels / screenPixels));
+    if (mip <= 0.0f)
+        return 0;
+    return std::min(static_cast<uint32_t>(mip), mipCount - 1);
+}
@@ -0,0 +1,76 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <cstdint>
+#include <vector>
+
+// Резидентность мипов потоковых текстур под бюджет видеопамяти. Не зависит от D3D11.
+// У текстуры три границы (мип 0 - самый детальный, хвост всегда в памяти):
+//   allocated - с какого мипа выделена память; её и считает бюджет;
+//   resident  - с какого мипа данные уже загружены, выборка ограничивается им (MinLOD);
+//   wanted    - какой мип нужен по размеру на экране.
+// Plan раздаёт действия: перевыделить (расширить до wanted или выкинуть верхний мип)
+// и загрузить следующий мип; выполняет их бэкенд и сообщает о готовности.
+class TextureStreamer
+{
+public:
+    static const uint32_t MaxMips = 16;
+
+    enum class ActionKind
+    {
+        Reallocate,     // пересоздать текстуру с мипа mip, сохранив загруженные мипы
+        Fetch           // прочитать данные мипа mip
+    };
+
+    struct Action
+    {
+        ActionKind kind;
+        uint32_t texture;
+        uint32_t mip;
+    };
+
+    struct TextureState
+    {
+        uint32_t mipCount;
+        uint32_t tailMip;
+        uint32_t allocatedMip;
+        uint32_t residentMip;
+        uint32_t wantedMip;
+        bool fetching;
+        uint64_t mipBytes[MaxMips];
+    };
+
+    TextureStreamer();
+
+    // Текстура появляется с выделенным и загруженным хвостом [tailMip, mipCount)
+    uint32_t Add(const uint64_t* pMipBytes, uint32_t mipCount, uint32_t tailMip);
+    void Clear();
+
+    void SetWantedMip(uint32_t texture, uint32_t mip);
+    void SetBudget(uint64_t bytes) { m_budget = bytes; }
+    uint64_t GetBudget() const { return m_budget; }
+
+    // Сначала выселение до бюджета (верхние мипы, начиная с ненужных), потом расширение
+    // и не больше maxFetches одновременных загрузок, самые недодетализированные - первыми
+    void Plan(std::vector<Action>& actions, uint32_t maxFetches);
+
+    // Бэкенд выполнил Reallocate
+    void OnReallocated(uint32_t texture, uint32_t mip);
+    // Данные мипа прочитаны. false - мип успели выселить (или чтение не удалось), писать его не нужно
+    bool OnFetched(uint32_t texture, uint32_t mip, bool succeeded);
+
+    const TextureState& GetTexture(uint32_t texture) const { return m_textures[texture]; }
+    uint32_t GetTextureCount() const { return static_cast<uint32_t>(m_textures.size()); }
+    uint64_t GetAllocatedBytes() const;
+    uint64_t GetAllocatedBytes(uint32_t texture) const;
+
+    // Мип, у которого на экранный пиксель приходится не меньше одного текселя
+    static uint32_t SelectMip(uint32_t width, uint32_t height, uint32_t mipCount, float screenPixels);
+    static uint64_t GetBytes(const TextureState& texture, uint32_t firstMip);
+
+private:
+    std::vector<TextureState> m_textures;
+    uint64_t m_budget;
+};
+
+#endif
@@ -0,0 +1,76 @@
+#include "UploadRing.h"
+
+bool UploadRingAllocator::Init(uint32_t capacity, uint32_t alignment) {
+    // Выравнивание - степень двойки, ёмкость кратна ему
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || capacity < alignment)
+        return false;
+
+    m_capacity = capacity & ~(alignment - 1);
+    m_alignment = alignment;
+    Reset();
+    return true;
+}
+
+void UploadRingAllocator::Reset() {
+    m_offset = 0;
+    m_needsDiscard = true;
+    m_totalBytes = 0;
+    m_totalDiscards = 0;
+    ResetStats(m_frame);
+    ResetStats(m_lastFrame);
+}
+
+void UploadRingAllocator::ResetStats(FrameStats& stats) {
+    stats.bytes = 0;
+    stats.allocations = 0;
+    stats.discards = 0;
+    stats.externalBytes = 0;
+    stats.externalRenames = 0;
+}
+
+bool UploadRingAllocator::Allocate(uint32_t size, uint32_t* pOffset, bool* pDiscard) {
+    if (size == 0 || m_capacity == 0)
+        return false;
+
+    uint64_t alignedSize = (static_cast<uint64_t>(size) + m_alignment - 1) & ~static_cast<uint64_t>(m_alignment - 1);
+    if (alignedSize > m_capacity)
+        return false;
+
+    // Оборачивать можно только между кадрами, см. Reserve
+    if (m_offset + alignedSize > m_capacity)
+        return false;
+
+    *pOffset = m_offset;
+    *pDiscard = m_needsDiscard;
+    if (m_needsDiscard) {
+        ++m_frame.discards;
+        ++m_totalDiscards;
+        m_needsDiscard = false;
+    }
+
+    m_offset += static_cast<uint32_t>(alignedSize);
+    m_frame.bytes += size;
+    ++m_frame.allocations;
+    m_totalBytes += size;
+    return true;
+}
+
+void UploadRingAllocator::Reserve(uint32_t bytes) {
+    // Кольцо начинается заново, старое содержимое GPU дочитает из прежней копии
+    if (static_cast<uint64_t>(m_offset) + bytes > m_capacity) {
+        m_offset = 0;
+        m_needsDiscard = true;
+    }
+}
+
+void UploadRingAllocator::RecordExternalUpload(uint64_t bytes, bool renamed) {
+    m_frame.externalBytes += bytes;
+    if (renamed)
+        ++m_frame.externalRenames;
+    m_totalBytes += bytes;
+}
+
+void UploadRingAllocator::BeginFrame() {
+    m_lastFrame = m_frame;
+    ResetStats(m_frame);
+}
@@ -0,0 +1,72 @@
+#ifndef UPLOAD_RING_H
+#define UPLOAD_RING_H
+
+#include <cstdint>
+
+// Линейный распределитель по кольцу для динамического буфера загрузки.
+// Каждое выделение пишется с WRITE_NO_OVERWRITE за предыдущими. В начало кольца распределитель
+// возвращается только в Reserve перед кадром и просит DISCARD - одно переименование на оборот
+// кольца вместо одного на каждое обновление. Посреди кадра кольцо не оборачивается: выделения,
+// сделанные раньше в этом кадре, ещё не прочитаны GPU и остались бы в старой копии буфера.
+// Сам от D3D11 не зависит.
+class UploadRingAllocator
+{
+public:
+    struct FrameStats
+    {
+        uint64_t bytes;
+        uint32_t allocations;
+        uint32_t discards;
+        uint64_t externalBytes;
+        uint32_t externalRenames;
+    };
+
+    UploadRingAllocator() :
+        m_capacity(0),
+        m_alignment(1),
+        m_offset(0),
+        m_needsDiscard(true),
+        m_totalBytes(0),
+        m_totalDiscards(0)
+    {
+        ResetStats(m_frame);
+        ResetStats(m_lastFrame);
+    }
+
+    bool Init(uint32_t capacity, uint32_t alignment);
+    void Reset();
+
+    // Смещение выделения; *pDiscard = true, если перед записью буфер нужно отобразить с DISCARD.
+    // Не помещается в хвост - false, кольцо не оборачивается
+    bool Allocate(uint32_t size, uint32_t* pOffset, bool* pDiscard);
+
+    // В начале кадра: если в хвосте меньше bytes, следующее выделение начнётся с нуля и с DISCARD
+    void Reserve(uint32_t bytes);
+
+    // Загрузки в обход кольца (UpdateSubresource, Map с DISCARD отдельных буферов) - только для статистики
+    void RecordExternalUpload(uint64_t bytes, bool renamed);
+
+    void BeginFrame();
+
+    uint32_t GetCapacity() const { return m_capacity; }
+    uint32_t GetAlignment() const { return m_alignment; }
+    uint32_t GetOffset() const { return m_offset; }
+    const FrameStats& GetFrameStats() const { return m_frame; }
+    const FrameStats& GetLastFrameStats() const { return m_lastFrame; }
+    uint64_t GetTotalBytes() const { return m_totalBytes; }
+    uint64_t GetTotalDiscards() const { return m_totalDiscards; }
+
+private:
+    static void ResetStats(FrameStats& stats);
+
+    uint32_t m_capacity;
+    uint32_t m_alignment;
+    uint32_t m_offset;
+    bool m_needsDiscard;
+    FrameStats m_frame;
+    FrameStats m_lastFrame;
+    uint64_t m_totalBytes;
+    uint64_t m_totalDiscards;
+};
+
+#endif
@@ -1,23 +1,23 @@
-﻿// header.h: включаемый файл для стандартных системных включаемых файлов
-// или включаемые файлы для конкретного проекта
-//
-
-#pragma once
-
-#include "targetver.h"
-#define WIN32_LEAN_AND_MEAN             // Исключите редко используемые компоненты из заголовков Windows
-// Файлы заголовков Windows
-#include <windows.h>
-// Файлы заголовков среды выполнения C
-#include <stdlib.h>
-#include <malloc.h>
-#include <memory.h>
-#include <tchar.h>
-
-#include <string>
-
-#include <dxgi.h>
-#include <d3d11.h>
-
-#include <DirectXMath.h>
-
+﻿// header.h: включаемый файл для стандартных системных включаемых файлов
+// или включаемые файлы для конкретного проекта
+//
+
+#pragma once
+
+#include "targetver.h"
+#define WIN32_LEAN_AND_MEAN             // Исключите редко используемые компоненты из заголовков Windows
+// Файлы заголовков Windows
+#include <windows.h>
+// Файлы заголовков среды выполнения C
+#include <stdlib.h>
+#include <malloc.h>
+#include <memory.h>
+#include <tchar.h>
+
+#include <string>
+
+#include <dxgi.h>
+#include <d3d11.h>
+
+#include <DirectXMath.h>
+
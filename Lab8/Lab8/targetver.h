@@ -1,6 +1,6 @@
-﻿#pragma once
-
-// // При включении SDKDDKVer.h будет задана самая новая из доступных платформ Windows.
-// Если вы планируете сборку приложения для предыдущей версии платформы Windows, включите WinSDKVer.h и
-// задайте желаемую платформу в макросе _WIN32_WINNT, прежде чем включать SDKDDKVer.h.
-#include <SDKDDKVer.h>
+﻿#pragma once
+
+// // При включении SDKDDKVer.h будет задана самая новая из доступных платформ Windows.
+// Если вы планируете сборку приложения для предыдущей версии платформы Windows, включите WinSDKVer.h и
+// задайте желаемую платформу в макросе _WIN32_WINNT, прежде чем включать SDKDDKVer.h.
+#include <SDKDDKVer.h>